@@ -0,0 +1,150 @@
+#include "Arduino.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+// ============================================================
+// HostClock
+// ============================================================
+
+namespace {
+
+std::atomic<bool> clockManual(false);
+std::atomic<uint64_t> manualMicros(0);
+const std::chrono::steady_clock::time_point clockStart = std::chrono::steady_clock::now();
+
+uint64_t realMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - clockStart).count();
+}
+
+}  // namespace
+
+namespace HostClock {
+
+void setManual(bool manual) {
+    if (manual && !clockManual) {
+        manualMicros = realMicros();  // Nahtlos weiterzählen
+    }
+    clockManual = manual;
+}
+
+bool isManual() {
+    return clockManual;
+}
+
+void advanceMicros(uint64_t us) {
+    if (clockManual) {
+        manualMicros += us;
+    }
+}
+
+void advanceMillis(uint32_t ms) {
+    advanceMicros((uint64_t)ms * 1000);
+}
+
+void setMicros(uint64_t us) {
+    manualMicros = us;
+}
+
+uint64_t nowMicros() {
+    return clockManual ? manualMicros.load() : realMicros();
+}
+
+}  // namespace HostClock
+
+// ============================================================
+// Zeit
+// ============================================================
+
+uint32_t millis() {
+    return (uint32_t)(HostClock::nowMicros() / 1000);
+}
+
+uint32_t micros() {
+    return (uint32_t)HostClock::nowMicros();
+}
+
+void delay(uint32_t ms) {
+    if (HostClock::isManual()) {
+        HostClock::advanceMillis(ms);
+    } else {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    }
+}
+
+void delayMicroseconds(uint32_t us) {
+    if (HostClock::isManual()) {
+        HostClock::advanceMicros(us);
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+// ============================================================
+// GPIO (No-Ops)
+// ============================================================
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+int digitalRead(uint8_t) { return HIGH; }
+void attachInterrupt(uint8_t, void (*)(), int) {}
+void detachInterrupt(uint8_t) {}
+
+// ============================================================
+// Mathe
+// ============================================================
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    if (in_max == in_min) return out_min;
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+long random(long howbig) {
+    if (howbig <= 0) return 0;
+    return rand() % howbig;
+}
+
+long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) return howsmall;
+    return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+    srand((unsigned)seed);
+}
+
+// ============================================================
+// Serial
+// ============================================================
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (!_out) return 1;
+    return fputc(c, _out) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    if (!_out) return size;
+    return fwrite(buffer, 1, size, _out);
+}
+
+void HardwareSerial::flush() {
+    if (_out) fflush(_out);
+}
+
+// ============================================================
+// ESP
+// ============================================================
+
+// Feste Werte in der Größenordnung eines ESP32 mit aktivem NimBLE
+uint32_t EspClass::getFreeHeap() { return 180 * 1024; }
+uint32_t EspClass::getMinFreeHeap() { return 160 * 1024; }
+uint32_t EspClass::getMaxAllocHeap() { return 110 * 1024; }
+void EspClass::restart() { exit(0); }
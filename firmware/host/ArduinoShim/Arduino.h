@@ -0,0 +1,125 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+/**
+ * Arduino-Shim für den Host-Build (env:native)
+ *
+ * Stellt die Teilmenge des ESP32-Arduino-Cores bereit, die lib/ benutzt:
+ * String, millis()/micros() aus HostClock, Serial auf stdout, ESP.*
+ * GPIO-Funktionen sind No-Ops.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+
+#include "WString.h"
+#include "Print.h"
+#include "HostClock.h"
+
+using std::max;
+using std::min;
+
+// ============================================================
+// Konstanten
+// ============================================================
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT         0x01
+#define OUTPUT        0x03
+#define INPUT_PULLUP  0x05
+
+#define RISING    0x01
+#define FALLING   0x02
+#define CHANGE    0x03
+
+#define SS 5
+
+#define IRAM_ATTR
+
+// ============================================================
+// Zeit
+// ============================================================
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// ============================================================
+// GPIO (No-Ops)
+// ============================================================
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode);
+void detachInterrupt(uint8_t pin);
+inline uint8_t digitalPinToInterrupt(uint8_t pin) { return pin; }
+
+// ============================================================
+// Mathe
+// ============================================================
+
+template <typename T, typename L, typename H>
+inline T constrain(T amt, L low, H high) {
+    return amt < (T)low ? (T)low : (amt > (T)high ? (T)high : amt);
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// ============================================================
+// Serial
+// ============================================================
+
+class HardwareSerial : public Stream {
+public:
+    HardwareSerial() : _out(stdout) {}
+
+    void begin(unsigned long baud) { (void)baud; }
+    void end() {}
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    void flush() override;
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    operator bool() const { return true; }
+
+    // Nur Host: Ausgabe umleiten, nullptr = stumm (z.B. für Benchmarks)
+    void setHostOutput(FILE* out) { _out = out; }
+
+private:
+    FILE* _out;
+};
+
+extern HardwareSerial Serial;
+
+// ============================================================
+// ESP
+// ============================================================
+
+class EspClass {
+public:
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    void restart();
+};
+
+extern EspClass ESP;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,180 @@
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include <atomic>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include "Arduino.h"
+
+/**
+ * FS-Shim für den Host-Build
+ *
+ * fs::File / fs::FS mit der API des ESP32-Cores, abgebildet auf ein
+ * Verzeichnis des Host-Dateisystems (siehe SDFS::setHostRoot).
+ */
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+class FileImpl;
+class FS;
+
+/**
+ * Nur Host: Zeitverhalten und Fehler der emulierten Karte
+ *
+ * Wartezeiten blockieren den Thread, der schreibt oder schließt, in Echtzeit
+ * (wie die SPI-Transaktion auf dem Gerät); die virtuelle Uhr läuft dabei
+ * nicht mit. Zufallswerte kommen aus einem festen Seed (FS::setHostSeed).
+ * Vorgaben für typische Karten: hostCardProfile().
+ */
+struct HostCardProfile {
+    uint32_t commitUs = 0;          // Schließen nach Schreiben, Löschen (FAT + Verzeichniseintrag)
+    uint32_t allocUs = 0;           // Pro neu belegtem Cluster (freien Cluster suchen, FAT-Kette)
+    uint32_t jitterUs = 0;          // Auf jeden Commit und jeden Cluster zusätzlich 0..jitterUs
+    uint32_t writeKBps = 0;         // Datenrate beim Schreiben, 0 = unbegrenzt
+    uint32_t spikeUs = 0;           // Ausreißer: Garbage Collection im Controller der Karte
+    float spikeChance = 0;          // ... Wahrscheinlichkeit pro Schreibzugriff
+    float writeErrorChance = 0;     // Schreibzugriff schlägt fehl (0 Bytes geschrieben)
+};
+
+// Nur Host: Zähler der emulierten Karte (FS::hostStats)
+struct HostCardStats {
+    uint64_t writes;                // Schreibzugriffe (File::write)
+    uint64_t bytesWritten;
+    uint32_t failedWrites;          // Injiziert, Karte voll/defekt oder entfernt
+    uint32_t commits;
+    uint32_t clusters;              // Neu belegt
+    uint32_t spikes;
+    uint64_t waitUs;                // Summe aller Wartezeiten
+    uint32_t maxWaitUs;             // Längste Wartezeit eines Zugriffs
+};
+
+// Nur Host: Vorgabe nach Name ("ideal", "class10", "slow", "spiky"), false = unbekannt
+bool hostCardProfile(const char* name, HostCardProfile& profile);
+
+class File : public Stream {
+public:
+    File() {}
+    explicit File(std::shared_ptr<FileImpl> impl) : _impl(impl) {}
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buf, size_t size) override;
+    using Print::write;
+    void flush() override;
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t read(uint8_t* buf, size_t size);
+    size_t readBytes(char* buf, size_t size) { return read((uint8_t*)buf, size); }
+
+    bool seek(uint32_t pos);
+    size_t position() const;
+    size_t size() const;
+    void close();
+    operator bool() const;
+
+    const char* name() const;   // Nur der Dateiname (wie Core 2.x)
+    const char* path() const;   // Voller Pfad auf der Karte
+    time_t getLastWrite();
+
+    bool isDirectory();
+    File openNextFile(const char* mode = FILE_READ);
+    void rewindDirectory();
+
+private:
+    std::shared_ptr<FileImpl> _impl;
+};
+
+class FS {
+public:
+    virtual ~FS() {}
+
+    File open(const char* path, const char* mode = FILE_READ, bool create = false);
+    File open(const String& path, const char* mode = FILE_READ, bool create = false) {
+        return open(path.c_str(), mode, create);
+    }
+
+    bool exists(const char* path);
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path);
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* pathFrom, const char* pathTo);
+    bool rename(const String& pathFrom, const String& pathTo) { return rename(pathFrom.c_str(), pathTo.c_str()); }
+    bool mkdir(const char* path);
+    bool mkdir(const String& path) { return mkdir(path.c_str()); }
+    bool rmdir(const char* path);
+    bool rmdir(const String& path) { return rmdir(path.c_str()); }
+
+    // Nur Host: Pfad auf dem Host-Dateisystem
+    std::string hostPath(const char* path) const;
+    // Nur Host: Zeitverhalten der Karte (siehe HostCardProfile)
+    void setHostProfile(const HostCardProfile& profile);
+    HostCardProfile hostProfile() const;
+    void setHostSeed(uint32_t seed);
+    // Nur Host: Kurzform - Wartezeit beim Schließen geschriebener Dateien und
+    // beim Löschen (SD-Commit: FAT und Verzeichniseintrag)
+    void setHostCommitDelayUs(uint32_t us);
+    uint32_t hostCommitDelayUs() const;
+    // Nur Host: Kurzform - Wartezeit pro Cluster, den ein Schreibzugriff neu
+    // belegt (freien Cluster in der FAT suchen, FAT-Kette aktualisieren)
+    void setHostAllocDelayUs(uint32_t us);
+    uint32_t hostAllocDelayUs() const;
+    static const uint32_t HOST_CLUSTER_BYTES = 32 * 1024;
+
+    // Nur Host: Fehler einspeisen. Die nächsten bytes Bytes werden noch
+    // geschrieben (ein Zugriff über die Grenze nur teilweise), danach schlägt
+    // jeder Schreibzugriff fehl - Karte voll, verschlissen oder schreibgeschützt
+    void hostFailWritesAfter(uint64_t bytes);
+    // Nur Host: der nächste Schreibzugriff wartet zusätzlich us
+    void hostStallNextWrite(uint32_t us);
+    void hostClearFaults();
+    // Nur Host: false zwischen SDFS::hostRemoveCard() und hostInsertCard()
+    bool hostCardPresent() const { return _present; }
+
+    HostCardStats hostStats() const;
+    void resetHostStats();
+
+protected:
+    friend class File;
+    friend class FileImpl;
+
+    std::string _root = "sdcard";
+    std::atomic<bool> _mounted{false};
+    std::atomic<bool> _present{true};
+    std::atomic<uint32_t> _generation{0};  // Pro Entnahme +1, ältere Dateien sind tot
+
+    // Schreibzugriff einer Datei aus generation über size Bytes ab position:
+    // wartet, belegt Cluster, Rückgabe: so viele Bytes dürfen geschrieben werden
+    size_t hostWrite(uint32_t generation, uint64_t position, size_t size, uint64_t& allocated);
+    void hostCommit();
+
+private:
+    mutable std::mutex _hostMutex;          // Profil, Fehler, Zähler, Zufall
+    std::mutex _busMutex;                   // Wartezeiten, einer nach dem anderen
+    HostCardProfile _profile;
+    HostCardStats _stats = {};
+    std::mt19937 _random{1};
+    bool _failWrites = false;
+    uint64_t _writableBytes = 0;            // Bei _failWrites: Rest bis zum Fehler
+    uint32_t _stallUs = 0;
+
+    // jitter/chance/countWait unter _hostMutex
+    uint32_t jitter();
+    bool chance(float probability);
+    void countWait(uint64_t us);
+    void busWait(uint64_t us);
+};
+
+}  // namespace fs
+
+using fs::File;
+using fs::FS;
+
+#endif // HOST_FS_H
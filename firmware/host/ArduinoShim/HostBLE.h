@@ -0,0 +1,25 @@
+#ifndef HOST_BLE_H
+#define HOST_BLE_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Advertisement-Injektor für den Host-Build
+ *
+ * Ersetzt das Radio: Simulationen und Benchmarks speisen hierüber
+ * Advertisements ein, die wie vom NimBLE-Stack an
+ * NimBLEAdvertisedDeviceCallbacks::onResult() gehen.
+ */
+
+namespace HostBLE {
+
+// Liefert false wenn kein Scan läuft (Advertisement verworfen)
+bool injectAdvert(const std::string& mac, int rssi, const std::string& mfgData = "");
+
+// iBeacon-Herstellerdaten (Apple 0x004C, Typ 0x02 0x15)
+std::string makeIBeacon(const uint8_t uuid[16], uint16_t major, uint16_t minor, int8_t txPower = -59);
+
+}  // namespace HostBLE
+
+#endif // HOST_BLE_H
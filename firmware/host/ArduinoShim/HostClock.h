@@ -0,0 +1,28 @@
+#ifndef HOST_CLOCK_H
+#define HOST_CLOCK_H
+
+#include <cstdint>
+
+/**
+ * Virtuelle Uhr für millis()/micros() im Host-Build
+ *
+ * Standard: läuft mit der Echtzeit (steady_clock ab Programmstart), damit
+ * Threads und Latenzmessungen realistisch sind.
+ * Manuell: Zeit steht, bis advance()/set() sie bewegt - deterministische
+ * Simulationen ganzer Rennen laufen so in Millisekunden.
+ */
+
+namespace HostClock {
+
+void setManual(bool manual);          // true = nur advance()/set() bewegen die Zeit
+bool isManual();
+
+void advanceMicros(uint64_t us);      // Nur im manuellen Modus wirksam
+void advanceMillis(uint32_t ms);
+void setMicros(uint64_t us);
+
+uint64_t nowMicros();
+
+}  // namespace HostClock
+
+#endif // HOST_CLOCK_H
@@ -0,0 +1,20 @@
+#ifndef HOST_NIMBLE_ADDRESS_H
+#define HOST_NIMBLE_ADDRESS_H
+
+#include <string>
+
+// BLE-Adresse im Host-Build: nur die String-Form wird gebraucht
+
+class NimBLEAddress {
+public:
+    NimBLEAddress() {}
+    explicit NimBLEAddress(const std::string& address) : _address(address) {}
+
+    std::string toString() const { return _address; }
+    bool operator==(const NimBLEAddress& other) const { return _address == other._address; }
+
+private:
+    std::string _address;
+};
+
+#endif // HOST_NIMBLE_ADDRESS_H
@@ -0,0 +1,39 @@
+#ifndef HOST_NIMBLE_ADVERTISED_DEVICE_H
+#define HOST_NIMBLE_ADVERTISED_DEVICE_H
+
+#include <string>
+#include "NimBLEAddress.h"
+
+/**
+ * Advertisement im Host-Build
+ *
+ * Wird von HostBLE::injectAdvert() befüllt und an die registrierten
+ * Scan-Callbacks übergeben.
+ */
+
+class NimBLEAdvertisedDevice {
+public:
+    NimBLEAdvertisedDevice() : _rssi(-127) {}
+    NimBLEAdvertisedDevice(const std::string& address, int rssi, const std::string& mfgData)
+        : _address(address), _rssi(rssi), _mfgData(mfgData) {}
+
+    NimBLEAddress getAddress() const { return _address; }
+    int getRSSI() const { return _rssi; }
+    std::string getManufacturerData() const { return _mfgData; }
+    bool haveManufacturerData() const { return !_mfgData.empty(); }
+    std::string getName() const { return ""; }
+    bool haveName() const { return false; }
+
+private:
+    NimBLEAddress _address;
+    int _rssi;
+    std::string _mfgData;
+};
+
+class NimBLEAdvertisedDeviceCallbacks {
+public:
+    virtual ~NimBLEAdvertisedDeviceCallbacks() {}
+    virtual void onResult(NimBLEAdvertisedDevice* advertisedDevice) = 0;
+};
+
+#endif // HOST_NIMBLE_ADVERTISED_DEVICE_H
@@ -0,0 +1,66 @@
+#include "NimBLEDevice.h"
+#include "HostBLE.h"
+#include "Arduino.h"
+
+bool NimBLEDevice::_initialized = false;
+
+// ============================================================
+// NimBLEDevice / NimBLEScan
+// ============================================================
+
+NimBLEScan* NimBLEDevice::getScan() {
+    static NimBLEScan scan;
+    return &scan;
+}
+
+bool NimBLEScan::start(uint32_t duration, bool isContinue) {
+    (void)isContinue;
+    _scanning = true;
+    _endMillis = duration == 0 ? 0 : millis() + duration * 1000;
+    return true;
+}
+
+bool NimBLEScan::stop() {
+    _scanning = false;
+    return true;
+}
+
+bool NimBLEScan::deliver(NimBLEAdvertisedDevice* device) {
+    if (_scanning && _endMillis != 0 && (int32_t)(millis() - _endMillis) >= 0) {
+        _scanning = false;  // Scan-Dauer abgelaufen
+    }
+    if (!_scanning || !_callbacks) {
+        return false;
+    }
+    _callbacks->onResult(device);
+    return true;
+}
+
+// ============================================================
+// HostBLE
+// ============================================================
+
+namespace HostBLE {
+
+bool injectAdvert(const std::string& mac, int rssi, const std::string& mfgData) {
+    NimBLEAdvertisedDevice device(mac, rssi, mfgData);
+    return NimBLEDevice::getScan()->deliver(&device);
+}
+
+std::string makeIBeacon(const uint8_t uuid[16], uint16_t major, uint16_t minor, int8_t txPower) {
+    std::string data;
+    data.reserve(25);
+    data.push_back((char)0x4C);
+    data.push_back((char)0x00);
+    data.push_back((char)0x02);
+    data.push_back((char)0x15);
+    data.append((const char*)uuid, 16);
+    data.push_back((char)(major >> 8));
+    data.push_back((char)(major & 0xFF));
+    data.push_back((char)(minor >> 8));
+    data.push_back((char)(minor & 0xFF));
+    data.push_back((char)txPower);
+    return data;
+}
+
+}  // namespace HostBLE
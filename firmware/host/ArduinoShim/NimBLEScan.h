@@ -0,0 +1,44 @@
+#ifndef HOST_NIMBLE_SCAN_H
+#define HOST_NIMBLE_SCAN_H
+
+#include <cstdint>
+#include "NimBLEAdvertisedDevice.h"
+
+/**
+ * Scan-Objekt im Host-Build
+ *
+ * Es gibt kein Radio: Advertisements kommen ausschließlich über
+ * HostBLE::injectAdvert() und werden nur bei laufendem Scan zugestellt.
+ */
+
+class NimBLEScan {
+public:
+    void setAdvertisedDeviceCallbacks(NimBLEAdvertisedDeviceCallbacks* callbacks, bool wantDuplicates = false) {
+        _callbacks = callbacks;
+        _wantDuplicates = wantDuplicates;
+    }
+    void setActiveScan(bool active) { _active = active; }
+    void setInterval(uint16_t intervalMSecs) { _interval = intervalMSecs; }
+    void setWindow(uint16_t windowMSecs) { _window = windowMSecs; }
+    void setDuplicateFilter(bool enabled) { _duplicateFilter = enabled; }
+
+    bool start(uint32_t duration, bool isContinue = false);
+    bool stop();
+    bool isScanning() const { return _scanning; }
+    void clearResults() {}
+
+    // Nur Host: ein Advertisement zustellen (siehe HostBLE.h)
+    bool deliver(NimBLEAdvertisedDevice* device);
+
+private:
+    NimBLEAdvertisedDeviceCallbacks* _callbacks = nullptr;
+    bool _wantDuplicates = false;
+    bool _active = false;
+    bool _duplicateFilter = true;
+    bool _scanning = false;
+    uint16_t _interval = 100;
+    uint16_t _window = 100;
+    uint32_t _endMillis = 0;
+};
+
+#endif // HOST_NIMBLE_SCAN_H
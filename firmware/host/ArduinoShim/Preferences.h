@@ -0,0 +1,99 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include <Arduino.h>
+#include <cstdlib>
+#include <map>
+#include <string>
+
+/**
+ * Preferences (NVS) für den Host-Build
+ *
+ * Alle Namespaces liegen im RAM und leben bis Prozessende; Werte werden
+ * als Text gespeichert, Blobs (putBytes) roh. Reicht für Tools, die
+ * Persistence benutzen.
+ */
+class Preferences {
+public:
+    Preferences() : store(nullptr), readOnly(false) {}
+
+    bool begin(const char* name, bool readOnlyMode = false) {
+        store = &namespaces()[name];
+        readOnly = readOnlyMode;
+        return true;
+    }
+
+    void end() { store = nullptr; }
+
+    bool clear() {
+        if (!store || readOnly) return false;
+        store->clear();
+        return true;
+    }
+
+    bool remove(const char* key) {
+        return store && !readOnly && store->erase(key) > 0;
+    }
+
+    bool isKey(const char* key) const {
+        return store && store->count(key) > 0;
+    }
+
+    size_t putString(const char* key, const String& value) { return put(key, value.c_str(), value.length()); }
+    size_t putUInt(const char* key, uint32_t value) { return put(key, std::to_string(value), 4); }
+    size_t putUChar(const char* key, uint8_t value) { return put(key, std::to_string(value), 1); }
+    size_t putChar(const char* key, int8_t value) { return put(key, std::to_string(value), 1); }
+    size_t putBool(const char* key, bool value) { return put(key, value ? "1" : "0", 1); }
+    size_t putBytes(const char* key, const void* value, size_t len) {
+        return put(key, std::string((const char*)value, len), len);
+    }
+
+    String getString(const char* key, const String& defaultValue = String()) const {
+        const std::string* value = find(key);
+        return value ? String(value->c_str()) : defaultValue;
+    }
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0) const { return (uint32_t)getNumber(key, defaultValue); }
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0) const { return (uint8_t)getNumber(key, defaultValue); }
+    int8_t getChar(const char* key, int8_t defaultValue = 0) const { return (int8_t)getNumber(key, defaultValue); }
+    bool getBool(const char* key, bool defaultValue = false) const { return getNumber(key, defaultValue) != 0; }
+    size_t getBytesLength(const char* key) const {
+        const std::string* value = find(key);
+        return value ? value->size() : 0;
+    }
+    size_t getBytes(const char* key, void* buffer, size_t maxLen) const {
+        const std::string* value = find(key);
+        if (!value || value->size() > maxLen) return 0;
+        memcpy(buffer, value->data(), value->size());
+        return value->size();
+    }
+
+private:
+    typedef std::map<std::string, std::string> Namespace;
+
+    Namespace* store;
+    bool readOnly;
+
+    static std::map<std::string, Namespace>& namespaces() {
+        static std::map<std::string, Namespace> all;
+        return all;
+    }
+
+    size_t put(const char* key, const std::string& value, size_t size) {
+        if (!store || readOnly) return 0;
+        (*store)[key] = value;
+        return size;
+    }
+
+    const std::string* find(const char* key) const {
+        if (!store) return nullptr;
+        auto it = store->find(key);
+        return it == store->end() ? nullptr : &it->second;
+    }
+
+    long long getNumber(const char* key, long long defaultValue) const {
+        const std::string* value = find(key);
+        return value ? strtoll(value->c_str(), nullptr, 10) : defaultValue;
+    }
+};
+
+#endif // HOST_PREFERENCES_H
@@ -0,0 +1,44 @@
+#include "Print.h"
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        if (write(*buffer++)) n++;
+        else break;
+    }
+    return n;
+}
+
+size_t Print::write(const char* str) {
+    if (!str) return 0;
+    return write((const uint8_t*)str, strlen(str));
+}
+
+size_t Print::printf(const char* format, ...) {
+    char local[128];
+    va_list args;
+    va_start(args, format);
+    va_list copy;
+    va_copy(copy, args);
+    int len = vsnprintf(local, sizeof(local), format, copy);
+    va_end(copy);
+    if (len < 0) {
+        va_end(args);
+        return 0;
+    }
+
+    size_t written;
+    if ((size_t)len < sizeof(local)) {
+        written = write((const uint8_t*)local, len);
+    } else {
+        std::vector<char> buf(len + 1);
+        vsnprintf(buf.data(), buf.size(), format, args);
+        written = write((const uint8_t*)buf.data(), len);
+    }
+    va_end(args);
+    return written;
+}
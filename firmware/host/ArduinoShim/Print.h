@@ -0,0 +1,53 @@
+#ifndef HOST_PRINT_H
+#define HOST_PRINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include "WString.h"
+
+/**
+ * Print / Stream für den Host-Build
+ *
+ * Wie im Arduino-Core: Ableitungen implementieren nur write(),
+ * print/println/printf bauen darauf auf.
+ */
+
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str);
+    size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+    virtual void flush() {}
+
+    size_t print(const String& s) { return write(s.c_str(), s.length()); }
+    size_t print(const char* str) { return write(str); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(int value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(unsigned int value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(long value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(unsigned long value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(long long value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(unsigned long long value, int base = 10) { return print(String(value, (unsigned char)base)); }
+    size_t print(double value, int digits = 2) { return print(String(value, (unsigned int)digits)); }
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(const T& value) { size_t n = print(value); return n + println(); }
+    template <typename T>
+    size_t println(const T& value, int format) { size_t n = print(value, format); return n + println(); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+#endif // HOST_PRINT_H
@@ -0,0 +1,547 @@
+#include "SD.h"
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+fs::SDFS SD;
+
+namespace fs {
+
+// ============================================================
+// FileImpl
+// ============================================================
+
+class FileImpl {
+public:
+    ~FileImpl() { close(); }
+
+    void close() {
+        if (fp) {
+            fclose(fp);
+            fp = nullptr;
+            if (written && alive()) {
+                // Verzeichniseintrag/FAT aktualisieren kostet auf der Karte Zeit
+                fs->hostCommit();
+            }
+        }
+        entries.clear();
+        isDir = false;
+        open = false;
+    }
+
+    // Karte steckt noch und wurde seit dem Öffnen nicht gezogen
+    bool alive() const {
+        return fs && fs->_present && fs->_generation == generation;
+    }
+
+    FS* fs = nullptr;
+    uint32_t generation = 0;
+    FILE* fp = nullptr;
+    bool open = false;
+    bool isDir = false;
+    bool written = false;
+    uint64_t allocated = 0;     // Belegte Bytes in ganzen Clustern
+    std::string path;       // Pfad auf der Karte (beginnt mit "/")
+    std::string name;       // Basename
+    std::string hostPath;   // Pfad auf dem Host
+    std::vector<std::string> entries;
+    size_t nextEntry = 0;
+};
+
+// ============================================================
+// File
+// ============================================================
+
+size_t File::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t* buf, size_t size) {
+    if (!_impl || !_impl->fp || size == 0) return 0;
+    size = _impl->fs->hostWrite(_impl->generation, (uint64_t)ftell(_impl->fp), size, _impl->allocated);
+    if (size == 0) return 0;
+    _impl->written = true;
+    return fwrite(buf, 1, size, _impl->fp);
+}
+
+void File::flush() {
+    if (_impl && _impl->fp && _impl->alive()) fflush(_impl->fp);
+}
+
+int File::available() {
+    if (!_impl || !_impl->fp) return 0;
+    size_t sz = size();
+    size_t pos = position();
+    return pos < sz ? (int)(sz - pos) : 0;
+}
+
+int File::read() {
+    if (!_impl || !_impl->fp || !_impl->alive()) return -1;
+    int c = fgetc(_impl->fp);
+    return c == EOF ? -1 : c;
+}
+
+int File::peek() {
+    if (!_impl || !_impl->fp || !_impl->alive()) return -1;
+    int c = fgetc(_impl->fp);
+    if (c == EOF) return -1;
+    ungetc(c, _impl->fp);
+    return c;
+}
+
+size_t File::read(uint8_t* buf, size_t size) {
+    if (!_impl || !_impl->fp || !_impl->alive()) return 0;
+    return fread(buf, 1, size, _impl->fp);
+}
+
+bool File::seek(uint32_t pos) {
+    if (!_impl || !_impl->fp || !_impl->alive()) return false;
+    return fseek(_impl->fp, pos, SEEK_SET) == 0;
+}
+
+size_t File::position() const {
+    if (!_impl || !_impl->fp) return 0;
+    long pos = ftell(_impl->fp);
+    return pos < 0 ? 0 : (size_t)pos;
+}
+
+size_t File::size() const {
+    if (!_impl || !_impl->open || _impl->isDir || !_impl->alive()) return 0;
+    if (_impl->fp) fflush(_impl->fp);
+    struct stat st;
+    if (stat(_impl->hostPath.c_str(), &st) != 0) return 0;
+    return (size_t)st.st_size;
+}
+
+void File::close() {
+    if (_impl) _impl->close();
+}
+
+File::operator bool() const {
+    return _impl && _impl->open;
+}
+
+const char* File::name() const {
+    return _impl ? _impl->name.c_str() : "";
+}
+
+const char* File::path() const {
+    return _impl ? _impl->path.c_str() : "";
+}
+
+time_t File::getLastWrite() {
+    if (!_impl) return 0;
+    struct stat st;
+    if (stat(_impl->hostPath.c_str(), &st) != 0) return 0;
+    return st.st_mtime;
+}
+
+bool File::isDirectory() {
+    return _impl && _impl->open && _impl->isDir;
+}
+
+File File::openNextFile(const char* mode) {
+    if (!isDirectory() || !_impl->alive()) return File();
+    if (_impl->nextEntry >= _impl->entries.size()) return File();
+
+    std::string child = _impl->path;
+    if (child.empty() || child.back() != '/') child += "/";
+    child += _impl->entries[_impl->nextEntry++];
+    return _impl->fs->open(child.c_str(), mode);
+}
+
+void File::rewindDirectory() {
+    if (_impl) _impl->nextEntry = 0;
+}
+
+// ============================================================
+// FS
+// ============================================================
+
+std::string FS::hostPath(const char* path) const {
+    std::string p = path ? path : "/";
+    if (p.empty() || p[0] != '/') p = "/" + p;
+    return _root + p;
+}
+
+File FS::open(const char* path, const char* mode, bool create) {
+    (void)create;
+    if (!_mounted || !path) return File();
+
+    auto impl = std::make_shared<FileImpl>();
+    impl->fs = this;
+    impl->generation = _generation;
+    impl->path = path;
+    if (impl->path.empty() || impl->path[0] != '/') impl->path = "/" + impl->path;
+    impl->hostPath = hostPath(impl->path.c_str());
+    size_t slash = impl->path.find_last_of('/');
+    impl->name = impl->path.substr(slash + 1);
+
+    struct stat st;
+    bool found = stat(impl->hostPath.c_str(), &st) == 0;
+
+    if (found && S_ISDIR(st.st_mode)) {
+        DIR* dir = opendir(impl->hostPath.c_str());
+        if (!dir) return File();
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != nullptr) {
+            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+            impl->entries.push_back(entry->d_name);
+        }
+        closedir(dir);
+        // FAT liefert Einträge in Anlage-Reihenfolge; sortiert ist reproduzierbar
+        std::sort(impl->entries.begin(), impl->entries.end());
+        impl->isDir = true;
+        impl->open = true;
+        return File(impl);
+    }
+
+    const char* fmode;
+    if (strcmp(mode, FILE_READ) == 0) {
+        if (!found) return File();
+        fmode = "rb";
+    } else if (strcmp(mode, FILE_APPEND) == 0) {
+        fmode = "ab+";
+    } else if (strcmp(mode, "r+") == 0) {
+        fmode = found ? "rb+" : "wb+";
+    } else {
+        fmode = "wb+";
+    }
+
+    impl->fp = fopen(impl->hostPath.c_str(), fmode);
+    if (!impl->fp) return File();
+    if (strcmp(mode, FILE_APPEND) == 0) fseek(impl->fp, 0, SEEK_END);
+    if (found && strcmp(fmode, "wb+") != 0) {
+        impl->allocated = ((uint64_t)st.st_size + HOST_CLUSTER_BYTES - 1) / HOST_CLUSTER_BYTES * HOST_CLUSTER_BYTES;
+    }
+    impl->open = true;
+    return File(impl);
+}
+
+bool FS::exists(const char* path) {
+    if (!_mounted) return false;
+    struct stat st;
+    return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char* path) {
+    if (!_mounted) return false;
+    if (unlink(hostPath(path).c_str()) != 0) return false;
+    // Löschen schreibt wie das Schließen FAT und Verzeichniseintrag
+    hostCommit();
+    return true;
+}
+
+bool FS::rename(const char* pathFrom, const char* pathTo) {
+    if (!_mounted) return false;
+    return ::rename(hostPath(pathFrom).c_str(), hostPath(pathTo).c_str()) == 0;
+}
+
+bool FS::mkdir(const char* path) {
+    if (!_mounted) return false;
+    int rc = ::mkdir(hostPath(path).c_str(), 0755);
+    return rc == 0 || errno == EEXIST;
+}
+
+bool FS::rmdir(const char* path) {
+    if (!_mounted) return false;
+    if (::rmdir(hostPath(path).c_str()) != 0) return false;
+    hostCommit();
+    return true;
+}
+
+// ============================================================
+// FS: emulierte Karte
+// ============================================================
+
+bool hostCardProfile(const char* name, HostCardProfile& profile) {
+    // Größenordnungen für SPI-Betrieb am ESP32 (Richtwerte, keine Messung)
+    profile = HostCardProfile();
+    if (strcmp(name, "ideal") == 0) {
+        return true;
+    }
+    if (strcmp(name, "class10") == 0) {
+        profile.commitUs = 1000;
+        profile.allocUs = 200;
+        profile.jitterUs = 300;
+        profile.writeKBps = 1500;
+        return true;
+    }
+    if (strcmp(name, "slow") == 0) {
+        profile.commitUs = 5000;
+        profile.allocUs = 1500;
+        profile.jitterUs = 3000;
+        profile.writeKBps = 300;
+        return true;
+    }
+    if (strcmp(name, "spiky") == 0) {
+        // Wie class10, aber die Karte räumt ab und zu intern auf
+        // (SD-Spezifikation: bis 250 ms pro Schreibzugriff erlaubt)
+        hostCardProfile("class10", profile);
+        profile.spikeUs = 250000;
+        profile.spikeChance = 0.05f;
+        return true;
+    }
+    return false;
+}
+
+void FS::setHostProfile(const HostCardProfile& profile) {
+    std::lock_guard<std::mutex> lock(_hostMutex);
+    _profile = profile;
+}
+
+HostCardProfile FS::hostProfile() const {
+    std::lock_guard<std::mutex> lock(_hostMutex);
+    return _profile;
+}
+
+void FS::setHostSeed(uint32_t seed) {
+    std::lock_guard<std::mutex> lock(_hostMutex);
+    _random.seed(seed);
+}
+
+void FS::setHostCommitDelayUs(uint32_t us) {
+    std::lock_guard<std::mutex> lock(_hostMutex);
+    _profile.commitUs = us;
+}
+
+uint32_t FS::hostCommitDelayUs() const {
+    std::lock_guard<std::mutex> lock(_hostMutex);
+    return _profile.commitUs;
+}
+
+void FS::setHostAllocDelayUs(uint32_t us) {
+    std::lock_guard<std::mutex> lock(_hostMutex);
+    _profile.allocUs = us;
+}
+
+uint32_t FS::hostAllocDelayUs() const {
+    std::lock_guard<std::mutex> lock(_hostMutex);
+    return _profile.allocUs;
+}
+
+void FS::hostFailWritesAfter(uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(_hostMutex);
+    _failWrites = true;
+    _writableBytes = bytes;
+}
+
+void FS::hostStallNextWrite(uint32_t us) {
+    std::lock_guard<std::mutex> lock(_hostMutex);
+    _stallUs = us;
+}
+
+void FS::hostClearFaults() {
+    std::lock_guard<std::mutex> lock(_hostMutex);
+    _failWrites = false;
+    _writableBytes = 0;
+    _stallUs = 0;
+}
+
+HostCardStats FS::hostStats() const {
+    std::lock_guard<std::mutex> lock(_hostMutex);
+    return _stats;
+}
+
+void FS::resetHostStats() {
+    std::lock_guard<std::mutex> lock(_hostMutex);
+    _stats = {};
+}
+
+uint32_t FS::jitter() {
+    if (_profile.jitterUs == 0) return 0;
+    return std::uniform_int_distribution<uint32_t>(0, _profile.jitterUs)(_random);
+}
+
+bool FS::chance(float probability) {
+    return probability > 0 && std::uniform_real_distribution<float>(0, 1)(_random) < probability;
+}
+
+void FS::countWait(uint64_t us) {
+    if (us == 0) return;
+    _stats.waitUs += us;
+    if (us > _stats.maxWaitUs) _stats.maxWaitUs = (uint32_t)std::min<uint64_t>(us, UINT32_MAX);
+}
+
+// Gewartet wird unter _busMutex statt _hostMutex: ein zweiter Thread, der
+// schreibt oder löscht, wartet mit (ein SPI-Bus), Profil und Zähler nicht
+void FS::busWait(uint64_t us) {
+    if (us == 0) return;
+    std::lock_guard<std::mutex> lock(_busMutex);
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+size_t FS::hostWrite(uint32_t generation, uint64_t position, size_t size, uint64_t& allocated) {
+    uint64_t waitUs = 0;
+    {
+        std::lock_guard<std::mutex> lock(_hostMutex);
+        _stats.writes++;
+        if (!_present || generation != _generation) {
+            // Gezogene Karte antwortet nicht, kein Warten
+            _stats.failedWrites++;
+            return 0;
+        }
+
+        waitUs = _stallUs;
+        _stallUs = 0;
+        if (chance(_profile.writeErrorChance)) {
+            size = 0;
+        } else if (_failWrites) {
+            size = (size_t)std::min<uint64_t>(size, _writableBytes);
+            _writableBytes -= size;
+        }
+        if (size == 0) {
+            _stats.failedWrites++;
+        }
+
+        // Schreiben über den letzten belegten Cluster hinaus belegt neue
+        const uint64_t cluster = HOST_CLUSTER_BYTES;
+        uint64_t end = position + size;
+        if (size > 0 && end > allocated) {
+            uint64_t clusters = (end - allocated + cluster - 1) / cluster;
+            allocated += clusters * cluster;
+            _stats.clusters += clusters;
+            for (uint64_t i = 0; i < clusters; i++) {
+                waitUs += _profile.allocUs + jitter();
+            }
+        }
+        if (size > 0 && chance(_profile.spikeChance)) {
+            waitUs += _profile.spikeUs;
+            _stats.spikes++;
+        }
+        if (_profile.writeKBps > 0) {
+            waitUs += (uint64_t)size * 1000000 / (_profile.writeKBps * 1024ULL);
+        }
+        _stats.bytesWritten += size;
+        countWait(waitUs);
+    }
+    busWait(waitUs);
+    return size;
+}
+
+void FS::hostCommit() {
+    uint64_t waitUs;
+    {
+        std::lock_guard<std::mutex> lock(_hostMutex);
+        _stats.commits++;
+        waitUs = _profile.commitUs > 0 ? _profile.commitUs + jitter() : 0;
+        countWait(waitUs);
+    }
+    busWait(waitUs);
+}
+
+// ============================================================
+// SDFS
+// ============================================================
+
+namespace {
+
+uint64_t usedBytesRecursive(const std::string& dirPath) {
+    uint64_t total = 0;
+    DIR* dir = opendir(dirPath.c_str());
+    if (!dir) return 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+        std::string child = dirPath + "/" + entry->d_name;
+        struct stat st;
+        if (stat(child.c_str(), &st) != 0) continue;
+        if (S_ISDIR(st.st_mode)) {
+            total += FS::HOST_CLUSTER_BYTES + usedBytesRecursive(child);
+        } else {
+            // Belegung in ganzen Clustern wie bei FAT
+            total += ((uint64_t)st.st_size + FS::HOST_CLUSTER_BYTES - 1) / FS::HOST_CLUSTER_BYTES * FS::HOST_CLUSTER_BYTES;
+        }
+    }
+    closedir(dir);
+    return total;
+}
+
+bool removeRecursive(const std::string& dirPath) {
+    DIR* dir = opendir(dirPath.c_str());
+    if (!dir) return false;
+    bool ok = true;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+        std::string child = dirPath + "/" + entry->d_name;
+        struct stat st;
+        if (lstat(child.c_str(), &st) != 0) continue;
+        if (S_ISDIR(st.st_mode)) {
+            ok = removeRecursive(child) && ::rmdir(child.c_str()) == 0 && ok;
+        } else {
+            ok = ::unlink(child.c_str()) == 0 && ok;
+        }
+    }
+    closedir(dir);
+    return ok;
+}
+
+}  // namespace
+
+bool SDFS::begin(uint8_t ssPin) {
+    (void)ssPin;
+    if (!_present) {
+        _mounted = false;
+        return false;
+    }
+    if (!_rootFromEnv) {
+        const char* env = getenv("MORA_SD_ROOT");
+        if (env && *env) _root = env;
+    }
+    while (_root.size() > 1 && _root.back() == '/') _root.pop_back();
+
+    ::mkdir(_root.c_str(), 0755);
+    struct stat st;
+    _mounted = stat(_root.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+    return _mounted;
+}
+
+void SDFS::end() {
+    _mounted = false;
+}
+
+sdcard_type_t SDFS::cardType() {
+    return _mounted ? CARD_SDHC : CARD_NONE;
+}
+
+uint64_t SDFS::cardSize() {
+    return _mounted ? _capacity : 0;
+}
+
+uint64_t SDFS::totalBytes() {
+    return _mounted ? _capacity : 0;
+}
+
+uint64_t SDFS::usedBytes() {
+    return _mounted ? usedBytesRecursive(_root) : 0;
+}
+
+bool SDFS::hostFormat() {
+    if (!_mounted) return false;
+    if (!removeRecursive(_root)) return false;
+    hostCommit();
+    return true;
+}
+
+void SDFS::hostRemoveCard() {
+    _present = false;
+    _mounted = false;
+    _generation++;
+}
+
+void SDFS::hostInsertCard() {
+    _present = true;
+}
+
+void SDFS::setHostRoot(const std::string& root) {
+    _root = root;
+    _rootFromEnv = true;  // Explizit gesetzt hat Vorrang vor MORA_SD_ROOT
+}
+
+}  // namespace fs
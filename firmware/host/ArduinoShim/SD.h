@@ -0,0 +1,58 @@
+#ifndef HOST_SD_H
+#define HOST_SD_H
+
+#include "FS.h"
+
+/**
+ * SD-Shim für den Host-Build
+ *
+ * Die "Karte" ist ein Verzeichnis auf dem Host. Standard ist ./sdcard,
+ * überschreibbar per setHostRoot() oder Umgebungsvariable MORA_SD_ROOT.
+ * Zeitverhalten und Fehler der Karte: FS::setHostProfile() und folgende,
+ * Karte ziehen/stecken: hostRemoveCard()/hostInsertCard().
+ */
+
+typedef enum {
+    CARD_NONE,
+    CARD_MMC,
+    CARD_SD,
+    CARD_SDHC,
+    CARD_UNKNOWN
+} sdcard_type_t;
+
+namespace fs {
+
+class SDFS : public FS {
+public:
+    bool begin(uint8_t ssPin = SS);
+    void end();
+
+    sdcard_type_t cardType();
+    uint64_t cardSize();
+    uint64_t totalBytes();
+    uint64_t usedBytes();
+
+    // Nur Host
+    void setHostRoot(const std::string& root);
+    const std::string& getHostRoot() const { return _root; }
+    void setHostCapacity(uint64_t bytes) { _capacity = bytes; }
+    // Nur Host: wie f_mkfs - leeres Dateisystem (Cluster immer HOST_CLUSTER_BYTES)
+    bool hostFormat();
+    // Nur Host: Karte ziehen - alle Zugriffe schlagen fehl, auch über schon
+    // geöffnete Dateien, cardType() liefert CARD_NONE, begin() scheitert
+    void hostRemoveCard();
+    // Nur Host: Karte wieder stecken, danach wie auf dem Gerät end()/begin()
+    void hostInsertCard();
+
+private:
+    uint64_t _capacity = 8ULL * 1024 * 1024 * 1024;  // 8 GB SDHC
+    bool _rootFromEnv = false;
+};
+
+}  // namespace fs
+
+extern fs::SDFS SD;
+
+using namespace fs;
+
+#endif // HOST_SD_H
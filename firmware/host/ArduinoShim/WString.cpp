@@ -0,0 +1,199 @@
+#include "WString.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+
+// ============================================================
+// Konstruktoren
+// ============================================================
+
+static std::string formatUnsigned(unsigned long long value, unsigned char base) {
+    if (base < 2 || base > 36) base = 10;
+    if (value == 0) return "0";
+    std::string out;
+    while (value > 0) {
+        unsigned digit = value % base;
+        out += (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+        value /= base;
+    }
+    std::reverse(out.begin(), out.end());
+    return out;
+}
+
+static std::string formatSigned(long long value, unsigned char base) {
+    if (value < 0 && base == 10) {
+        return "-" + formatUnsigned((unsigned long long)(-(value + 1)) + 1, base);
+    }
+    return formatUnsigned((unsigned long long)value, base);
+}
+
+static std::string formatFloat(double value, unsigned int decimalPlaces) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimalPlaces, value);
+    return buf;
+}
+
+String::String(unsigned char value, unsigned char base) : _str(formatUnsigned(value, base)) {}
+String::String(int value, unsigned char base) : _str(formatSigned(value, base)) {}
+String::String(unsigned int value, unsigned char base) : _str(formatUnsigned(value, base)) {}
+String::String(long value, unsigned char base) : _str(formatSigned(value, base)) {}
+String::String(unsigned long value, unsigned char base) : _str(formatUnsigned(value, base)) {}
+String::String(long long value, unsigned char base) : _str(formatSigned(value, base)) {}
+String::String(unsigned long long value, unsigned char base) : _str(formatUnsigned(value, base)) {}
+String::String(float value, unsigned int decimalPlaces) : _str(formatFloat(value, decimalPlaces)) {}
+String::String(double value, unsigned int decimalPlaces) : _str(formatFloat(value, decimalPlaces)) {}
+
+// ============================================================
+// Vergleich & Suche
+// ============================================================
+
+bool String::equalsIgnoreCase(const String& s) const {
+    if (_str.size() != s._str.size()) return false;
+    for (size_t i = 0; i < _str.size(); i++) {
+        if (tolower((unsigned char)_str[i]) != tolower((unsigned char)s._str[i])) return false;
+    }
+    return true;
+}
+
+bool String::startsWith(const String& prefix) const {
+    return _str.compare(0, prefix._str.size(), prefix._str) == 0;
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+    if (offset > _str.size()) return false;
+    return _str.compare(offset, prefix._str.size(), prefix._str) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+    if (suffix._str.size() > _str.size()) return false;
+    return _str.compare(_str.size() - suffix._str.size(), suffix._str.size(), suffix._str) == 0;
+}
+
+int String::indexOf(char c, unsigned int fromIndex) const {
+    size_t pos = _str.find(c, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String& s, unsigned int fromIndex) const {
+    size_t pos = _str.find(s._str, fromIndex);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(char c) const {
+    size_t pos = _str.rfind(c);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(const String& s) const {
+    size_t pos = _str.rfind(s._str);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int beginIndex) const {
+    if (beginIndex >= _str.size()) return String();
+    return String(_str.substr(beginIndex));
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const {
+    // Arduino-Semantik: vertauschte Grenzen werden getauscht
+    if (beginIndex > endIndex) std::swap(beginIndex, endIndex);
+    if (beginIndex >= _str.size()) return String();
+    if (endIndex > _str.size()) endIndex = _str.size();
+    return String(_str.substr(beginIndex, endIndex - beginIndex));
+}
+
+// ============================================================
+// Modifikation
+// ============================================================
+
+void String::replace(char find, char replace) {
+    std::replace(_str.begin(), _str.end(), find, replace);
+}
+
+void String::replace(const String& find, const String& replace) {
+    if (find._str.empty()) return;
+    size_t pos = 0;
+    while ((pos = _str.find(find._str, pos)) != std::string::npos) {
+        _str.replace(pos, find._str.size(), replace._str);
+        pos += replace._str.size();
+    }
+}
+
+void String::remove(unsigned int index) {
+    if (index < _str.size()) _str.erase(index);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index < _str.size()) _str.erase(index, count);
+}
+
+void String::toLowerCase() {
+    for (auto& c : _str) c = (char)tolower((unsigned char)c);
+}
+
+void String::toUpperCase() {
+    for (auto& c : _str) c = (char)toupper((unsigned char)c);
+}
+
+void String::trim() {
+    size_t begin = _str.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) {
+        _str.clear();
+        return;
+    }
+    size_t end = _str.find_last_not_of(" \t\r\n");
+    _str = _str.substr(begin, end - begin + 1);
+}
+
+// ============================================================
+// Konvertierung
+// ============================================================
+
+long String::toInt() const {
+    return strtol(_str.c_str(), nullptr, 10);
+}
+
+float String::toFloat() const {
+    return strtof(_str.c_str(), nullptr);
+}
+
+double String::toDouble() const {
+    return strtod(_str.c_str(), nullptr);
+}
+
+// ============================================================
+// Operatoren
+// ============================================================
+
+String operator+(const String& lhs, const String& rhs) {
+    String result(lhs);
+    result += rhs;
+    return result;
+}
+
+String operator+(const String& lhs, const char* rhs) {
+    String result(lhs);
+    result += rhs;
+    return result;
+}
+
+String operator+(const char* lhs, const String& rhs) {
+    String result(lhs);
+    result += rhs;
+    return result;
+}
+
+String operator+(const String& lhs, char rhs) {
+    String result(lhs);
+    result += rhs;
+    return result;
+}
+
+bool operator==(const char* lhs, const String& rhs) {
+    return rhs == lhs;
+}
+
+bool operator!=(const char* lhs, const String& rhs) {
+    return rhs != lhs;
+}
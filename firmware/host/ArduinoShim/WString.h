@@ -0,0 +1,110 @@
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Arduino String für den Host-Build
+ *
+ * Deckt die Teilmenge ab, die lib/ und src/ nutzen. Intern ein std::string,
+ * damit Verhalten und Kosten auf dem Host nachvollziehbar bleiben.
+ */
+
+class String {
+public:
+    String() {}
+    String(const char* cstr) : _str(cstr ? cstr : "") {}
+    String(const std::string& str) : _str(str) {}
+    String(const String& other) = default;
+    String(String&& other) = default;
+    explicit String(char c) : _str(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(long long value, unsigned char base = 10);
+    explicit String(unsigned long long value, unsigned char base = 10);
+    explicit String(float value, unsigned int decimalPlaces = 2);
+    explicit String(double value, unsigned int decimalPlaces = 2);
+
+    String& operator=(const String& other) = default;
+    String& operator=(String&& other) = default;
+    String& operator=(const char* cstr) { _str = cstr ? cstr : ""; return *this; }
+
+    // Zugriff
+    const char* c_str() const { return _str.c_str(); }
+    unsigned int length() const { return (unsigned int)_str.size(); }
+    bool isEmpty() const { return _str.empty(); }
+    bool reserve(unsigned int size) { _str.reserve(size); return true; }
+    char charAt(unsigned int index) const { return index < _str.size() ? _str[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char& operator[](unsigned int index) { return _str[index]; }
+    const std::string& toStdString() const { return _str; }
+
+    // Anhängen
+    bool concat(const String& s) { _str += s._str; return true; }
+    bool concat(const char* cstr) { if (cstr) _str += cstr; return true; }
+    bool concat(const char* cstr, unsigned int length) { if (cstr) _str.append(cstr, length); return true; }
+    bool concat(char c) { _str += c; return true; }
+    String& operator+=(const String& s) { concat(s); return *this; }
+    String& operator+=(const char* cstr) { concat(cstr); return *this; }
+    String& operator+=(char c) { concat(c); return *this; }
+    String& operator+=(unsigned char v) { return *this += String(v); }
+    String& operator+=(int v) { return *this += String(v); }
+    String& operator+=(unsigned int v) { return *this += String(v); }
+    String& operator+=(long v) { return *this += String(v); }
+    String& operator+=(unsigned long v) { return *this += String(v); }
+
+    // Vergleich
+    int compareTo(const String& s) const { return _str.compare(s._str); }
+    bool equals(const String& s) const { return _str == s._str; }
+    bool equalsIgnoreCase(const String& s) const;
+    bool operator==(const String& s) const { return _str == s._str; }
+    bool operator==(const char* cstr) const { return _str == (cstr ? cstr : ""); }
+    bool operator!=(const String& s) const { return !(*this == s); }
+    bool operator!=(const char* cstr) const { return !(*this == cstr); }
+    bool operator<(const String& s) const { return _str < s._str; }
+    bool operator>(const String& s) const { return _str > s._str; }
+    bool operator<=(const String& s) const { return _str <= s._str; }
+    bool operator>=(const String& s) const { return _str >= s._str; }
+    bool startsWith(const String& prefix) const;
+    bool startsWith(const String& prefix, unsigned int offset) const;
+    bool endsWith(const String& suffix) const;
+
+    // Suche
+    int indexOf(char c, unsigned int fromIndex = 0) const;
+    int indexOf(const String& s, unsigned int fromIndex = 0) const;
+    int lastIndexOf(char c) const;
+    int lastIndexOf(const String& s) const;
+    String substring(unsigned int beginIndex) const;
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    // Modifikation
+    void replace(char find, char replace);
+    void replace(const String& find, const String& replace);
+    void remove(unsigned int index);
+    void remove(unsigned int index, unsigned int count);
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+
+    // Konvertierung
+    long toInt() const;
+    float toFloat() const;
+    double toDouble() const;
+
+private:
+    std::string _str;
+};
+
+String operator+(const String& lhs, const String& rhs);
+String operator+(const String& lhs, const char* rhs);
+String operator+(const char* lhs, const String& rhs);
+String operator+(const String& lhs, char rhs);
+bool operator==(const char* lhs, const String& rhs);
+bool operator!=(const char* lhs, const String& rhs);
+
+#endif // HOST_WSTRING_H
@@ -0,0 +1,22 @@
+#ifndef HOST_ESP_HEAP_CAPS_H
+#define HOST_ESP_HEAP_CAPS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Auf dem Host gibt es keine getrennten Heaps: jede Anfrage passt
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+inline size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    (void)caps;
+    return 1024 * 1024;
+}
+
+inline size_t heap_caps_get_free_size(uint32_t caps) {
+    (void)caps;
+    return 4 * 1024 * 1024;
+}
+
+#endif // HOST_ESP_HEAP_CAPS_H
@@ -0,0 +1,49 @@
+#ifndef HOST_DISPLAY_H
+#define HOST_DISPLAY_H
+
+#include <cstdint>
+
+/**
+ * Framebuffer und SPI-Kostenmodell des Host-Displays
+ *
+ * Das zuletzt per init() gestartete LGFX_Device zeichnet in einen
+ * RGB565-Framebuffer im RAM. Jeder Schreibzugriff aufs Panel wird wie
+ * beim ST7789 gezählt: pro Adressfenster CASET/RASET/RAMWR (11 Bytes)
+ * plus 2 Bytes pro Pixel. Sprites kosten erst beim Push aufs Panel.
+ */
+
+namespace HostDisplay {
+
+#define HOST_SPI_WINDOW_BYTES 11   // CASET(1+4) + RASET(1+4) + RAMWR(1)
+
+struct SpiStats {
+    uint32_t transactions;   // startWrite()/endWrite()-Klammern (bzw. einzelne Aufrufe)
+    uint32_t windows;        // Adressfenster
+    uint64_t pixels;
+    uint64_t bytes;          // Inkl. Fenster-Overhead
+    uint32_t freqHz;         // Bus_SPI freq_write
+
+    // Reine Übertragungszeit auf dem Bus
+    uint64_t busMicros() const { return freqHz ? bytes * 8 * 1000000ULL / freqHz : 0; }
+};
+
+const SpiStats& stats();
+void resetStats();
+
+// Framebuffer (Zeilen hintereinander, nach setRotation())
+const uint16_t* framebuffer();
+int32_t width();
+int32_t height();
+
+// Binäres PPM (P6), 8 Bit pro Kanal
+bool writePPM(const char* path);
+// Anzahl abweichender Pixel gegenüber einem PPM, -1 = fehlt/andere Größe
+int64_t diffPPM(const char* path);
+
+// Touch-Injektor für LGFX_Device::getTouch()
+void injectTouch(uint16_t x, uint16_t y);
+void releaseTouch();
+
+}  // namespace HostDisplay
+
+#endif // HOST_DISPLAY_H
@@ -0,0 +1,665 @@
+#include "LovyanGFX.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// ============================================================
+// 5x7-Font in 6x8-Zellen (klassischer GLCD-Font, ASCII 0x20..0x7E)
+// Ein Byte pro Spalte, Bit 0 = oberste Zeile
+// ============================================================
+
+static const uint8_t glcdFont[95][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, // ' ' '!'
+    {0x00, 0x07, 0x00, 0x07, 0x00}, {0x14, 0x7F, 0x14, 0x7F, 0x14}, // '"' '#'
+    {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62}, // '$' '%'
+    {0x36, 0x49, 0x56, 0x20, 0x50}, {0x00, 0x08, 0x07, 0x03, 0x00}, // '&' '''
+    {0x00, 0x1C, 0x22, 0x41, 0x00}, {0x00, 0x41, 0x22, 0x1C, 0x00}, // '(' ')'
+    {0x2A, 0x1C, 0x7F, 0x1C, 0x2A}, {0x08, 0x08, 0x3E, 0x08, 0x08}, // '*' '+'
+    {0x00, 0x80, 0x70, 0x30, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, // ',' '-'
+    {0x00, 0x00, 0x60, 0x60, 0x00}, {0x20, 0x10, 0x08, 0x04, 0x02}, // '.' '/'
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00}, // '0' '1'
+    {0x72, 0x49, 0x49, 0x49, 0x46}, {0x21, 0x41, 0x49, 0x4D, 0x33}, // '2' '3'
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, {0x27, 0x45, 0x45, 0x45, 0x39}, // '4' '5'
+    {0x3C, 0x4A, 0x49, 0x49, 0x31}, {0x41, 0x21, 0x11, 0x09, 0x07}, // '6' '7'
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x46, 0x49, 0x49, 0x29, 0x1E}, // '8' '9'
+    {0x00, 0x00, 0x14, 0x00, 0x00}, {0x00, 0x40, 0x34, 0x00, 0x00}, // ':' ';'
+    {0x00, 0x08, 0x14, 0x22, 0x41}, {0x14, 0x14, 0x14, 0x14, 0x14}, // '<' '='
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x59, 0x09, 0x06}, // '>' '?'
+    {0x3E, 0x41, 0x5D, 0x59, 0x4E}, {0x7C, 0x12, 0x11, 0x12, 0x7C}, // '@' 'A'
+    {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22}, // 'B' 'C'
+    {0x7F, 0x41, 0x41, 0x41, 0x3E}, {0x7F, 0x49, 0x49, 0x49, 0x41}, // 'D' 'E'
+    {0x7F, 0x09, 0x09, 0x09, 0x01}, {0x3E, 0x41, 0x41, 0x51, 0x73}, // 'F' 'G'
+    {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00}, // 'H' 'I'
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, // 'J' 'K'
+    {0x7F, 0x40, 0x40, 0x40, 0x40}, {0x7F, 0x02, 0x1C, 0x02, 0x7F}, // 'L' 'M'
+    {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E}, // 'N' 'O'
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, // 'P' 'Q'
+    {0x7F, 0x09, 0x19, 0x29, 0x46}, {0x26, 0x49, 0x49, 0x49, 0x32}, // 'R' 'S'
+    {0x03, 0x01, 0x7F, 0x01, 0x03}, {0x3F, 0x40, 0x40, 0x40, 0x3F}, // 'T' 'U'
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, // 'V' 'W'
+    {0x63, 0x14, 0x08, 0x14, 0x63}, {0x03, 0x04, 0x78, 0x04, 0x03}, // 'X' 'Y'
+    {0x61, 0x59, 0x49, 0x4D, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x41}, // 'Z' '['
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x41, 0x7F}, // '\' ']'
+    {0x04, 0x02, 0x01, 0x02, 0x04}, {0x40, 0x40, 0x40, 0x40, 0x40}, // '^' '_'
+    {0x00, 0x03, 0x07, 0x08, 0x00}, {0x20, 0x54, 0x54, 0x78, 0x40}, // '`' 'a'
+    {0x7F, 0x28, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x28}, // 'b' 'c'
+    {0x38, 0x44, 0x44, 0x28, 0x7F}, {0x38, 0x54, 0x54, 0x54, 0x18}, // 'd' 'e'
+    {0x00, 0x08, 0x7E, 0x09, 0x02}, {0x18, 0xA4, 0xA4, 0x9C, 0x78}, // 'f' 'g'
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, // 'h' 'i'
+    {0x20, 0x40, 0x40, 0x3D, 0x00}, {0x7F, 0x10, 0x28, 0x44, 0x00}, // 'j' 'k'
+    {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x78, 0x04, 0x78}, // 'l' 'm'
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, // 'n' 'o'
+    {0xFC, 0x18, 0x24, 0x24, 0x18}, {0x18, 0x24, 0x24, 0x18, 0xFC}, // 'p' 'q'
+    {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x24}, // 'r' 's'
+    {0x04, 0x04, 0x3F, 0x44, 0x24}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, // 't' 'u'
+    {0x1C, 0x20, 0x40, 0x20, 0x1C}, {0x3C, 0x40, 0x30, 0x40, 0x3C}, // 'v' 'w'
+    {0x44, 0x28, 0x10, 0x28, 0x44}, {0x4C, 0x90, 0x90, 0x90, 0x7C}, // 'x' 'y'
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, // 'z' '{'
+    {0x00, 0x00, 0x77, 0x00, 0x00}, {0x00, 0x41, 0x36, 0x08, 0x00}, // '|' '}'
+    {0x02, 0x01, 0x02, 0x04, 0x02}                                  // '~'
+};
+
+#define GLYPH_WIDTH  6
+#define GLYPH_HEIGHT 8
+
+// ============================================================
+// Host-Display-Zustand
+// ============================================================
+
+static lgfx::LGFX_Device* hostDevice = nullptr;
+static HostDisplay::SpiStats spiStats = {};
+static bool touchActive = false;
+static uint16_t touchX = 0;
+static uint16_t touchY = 0;
+
+namespace lgfx {
+
+// ============================================================
+// LGFXBase
+// ============================================================
+
+LGFXBase::LGFXBase()
+    : _buffer(nullptr)
+    , _width(0)
+    , _height(0)
+    , _writeDepth(0)
+    , _clipActive(false)
+    , _clipX(0)
+    , _clipY(0)
+    , _clipW(0)
+    , _clipH(0)
+    , _textSize(1)
+    , _textColor(0xFFFF)
+    , _textBackground(0x0000)
+    , _textFill(false)
+    , _textDatum(TL_DATUM)
+    , _textPadding(0)
+    , _cursorX(0)
+    , _cursorY(0)
+{
+}
+
+void LGFXBase::startWrite() {
+    if (_writeDepth++ == 0) {
+        countTransaction();
+    }
+}
+
+void LGFXBase::endWrite() {
+    if (_writeDepth > 0) {
+        _writeDepth--;
+    }
+}
+
+void LGFXBase::setClipRect(int32_t x, int32_t y, int32_t w, int32_t h) {
+    _clipActive = true;
+    _clipX = x;
+    _clipY = y;
+    _clipW = w;
+    _clipH = h;
+}
+
+void LGFXBase::clearClipRect() {
+    _clipActive = false;
+}
+
+bool LGFXBase::clip(int32_t& x, int32_t& y, int32_t& w, int32_t& h) const {
+    int32_t left = _clipActive ? std::max<int32_t>(_clipX, 0) : 0;
+    int32_t top = _clipActive ? std::max<int32_t>(_clipY, 0) : 0;
+    int32_t right = _clipActive ? std::min<int32_t>(_clipX + _clipW, _width) : _width;
+    int32_t bottom = _clipActive ? std::min<int32_t>(_clipY + _clipH, _height) : _height;
+
+    if (x < left) { w -= left - x; x = left; }
+    if (y < top) { h -= top - y; y = top; }
+    if (x + w > right) w = right - x;
+    if (y + h > bottom) h = bottom - y;
+    return _buffer && w > 0 && h > 0;
+}
+
+void LGFXBase::writeRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+    if (!clip(x, y, w, h)) return;
+    countWindow(w, h);
+    for (int32_t row = y; row < y + h; row++) {
+        std::fill_n(_buffer + row * _width + x, w, color);
+    }
+}
+
+void LGFXBase::plot(int32_t x, int32_t y, uint16_t color) {
+    int32_t w = 1, h = 1;
+    if (clip(x, y, w, h)) {
+        _buffer[y * _width + x] = color;
+    }
+}
+
+void LGFXBase::drawPixel(int32_t x, int32_t y, uint32_t color) {
+    startWrite();
+    writeRect(x, y, 1, 1, color);
+    endWrite();
+}
+
+void LGFXBase::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+    startWrite();
+    writeRect(x, y, w, 1, color);
+    endWrite();
+}
+
+void LGFXBase::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+    startWrite();
+    writeRect(x, y, 1, h, color);
+    endWrite();
+}
+
+void LGFXBase::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+    if (y0 == y1) {
+        drawFastHLine(std::min(x0, x1), y0, abs(x1 - x0) + 1, color);
+        return;
+    }
+    if (x0 == x1) {
+        drawFastVLine(x0, std::min(y0, y1), abs(y1 - y0) + 1, color);
+        return;
+    }
+
+    // Bresenham, ein Fenster pro Pixel
+    startWrite();
+    int32_t dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int32_t dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int32_t err = dx + dy;
+    while (true) {
+        writeRect(x0, y0, 1, 1, color);
+        if (x0 == x1 && y0 == y1) break;
+        int32_t e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x0 += sx; }
+        if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+    endWrite();
+}
+
+void LGFXBase::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    startWrite();
+    writeRect(x, y, w, 1, color);
+    writeRect(x, y + h - 1, w, 1, color);
+    writeRect(x, y + 1, 1, h - 2, color);
+    writeRect(x + w - 1, y + 1, 1, h - 2, color);
+    endWrite();
+}
+
+void LGFXBase::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    startWrite();
+    writeRect(x, y, w, h, color);
+    endWrite();
+}
+
+void LGFXBase::fillScreen(uint32_t color) {
+    fillRect(0, 0, _width, _height, color);
+}
+
+// Kreise wie Adafruit-GFX (Midpoint), damit Rundungen pixelgleich bleiben
+void LGFXBase::drawCircleHelper(int32_t x0, int32_t y0, int32_t r, uint8_t corners, uint16_t color) {
+    int32_t f = 1 - r;
+    int32_t ddFx = 1;
+    int32_t ddFy = -2 * r;
+    int32_t x = 0;
+    int32_t y = r;
+
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddFy += 2;
+            f += ddFy;
+        }
+        x++;
+        ddFx += 2;
+        f += ddFx;
+        if (corners & 0x4) {
+            writeRect(x0 + x, y0 + y, 1, 1, color);
+            writeRect(x0 + y, y0 + x, 1, 1, color);
+        }
+        if (corners & 0x2) {
+            writeRect(x0 + x, y0 - y, 1, 1, color);
+            writeRect(x0 + y, y0 - x, 1, 1, color);
+        }
+        if (corners & 0x8) {
+            writeRect(x0 - y, y0 + x, 1, 1, color);
+            writeRect(x0 - x, y0 + y, 1, 1, color);
+        }
+        if (corners & 0x1) {
+            writeRect(x0 - y, y0 - x, 1, 1, color);
+            writeRect(x0 - x, y0 - y, 1, 1, color);
+        }
+    }
+}
+
+void LGFXBase::fillCircleHelper(int32_t x0, int32_t y0, int32_t r, uint8_t corners, int32_t delta, uint16_t color) {
+    int32_t f = 1 - r;
+    int32_t ddFx = 1;
+    int32_t ddFy = -2 * r;
+    int32_t x = 0;
+    int32_t y = r;
+
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddFy += 2;
+            f += ddFy;
+        }
+        x++;
+        ddFx += 2;
+        f += ddFx;
+        if (corners & 0x1) {
+            writeRect(x0 + x, y0 - y, 1, 2 * y + 1 + delta, color);
+            writeRect(x0 + y, y0 - x, 1, 2 * x + 1 + delta, color);
+        }
+        if (corners & 0x2) {
+            writeRect(x0 - x, y0 - y, 1, 2 * y + 1 + delta, color);
+            writeRect(x0 - y, y0 - x, 1, 2 * x + 1 + delta, color);
+        }
+    }
+}
+
+void LGFXBase::drawCircle(int32_t x, int32_t y, int32_t r, uint32_t color) {
+    startWrite();
+    writeRect(x, y + r, 1, 1, color);
+    writeRect(x, y - r, 1, 1, color);
+    writeRect(x + r, y, 1, 1, color);
+    writeRect(x - r, y, 1, 1, color);
+    drawCircleHelper(x, y, r, 0xF, color);
+    endWrite();
+}
+
+void LGFXBase::fillCircle(int32_t x, int32_t y, int32_t r, uint32_t color) {
+    startWrite();
+    writeRect(x, y - r, 1, 2 * r + 1, color);
+    fillCircleHelper(x, y, r, 0x3, 0, color);
+    endWrite();
+}
+
+void LGFXBase::drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color) {
+    r = std::min(r, std::min(w, h) / 2);
+    startWrite();
+    writeRect(x + r, y, w - 2 * r, 1, color);
+    writeRect(x + r, y + h - 1, w - 2 * r, 1, color);
+    writeRect(x, y + r, 1, h - 2 * r, color);
+    writeRect(x + w - 1, y + r, 1, h - 2 * r, color);
+    drawCircleHelper(x + r, y + r, r, 0x1, color);
+    drawCircleHelper(x + w - r - 1, y + r, r, 0x2, color);
+    drawCircleHelper(x + w - r - 1, y + h - r - 1, r, 0x4, color);
+    drawCircleHelper(x + r, y + h - r - 1, r, 0x8, color);
+    endWrite();
+}
+
+void LGFXBase::fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color) {
+    r = std::min(r, std::min(w, h) / 2);
+    startWrite();
+    writeRect(x + r, y, w - 2 * r, h, color);
+    fillCircleHelper(x + w - r - 1, y + r, r, 0x1, h - 2 * r - 1, color);
+    fillCircleHelper(x + r, y + r, r, 0x2, h - 2 * r - 1, color);
+    endWrite();
+}
+
+void LGFXBase::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const swap565_t* data) {
+    int32_t cx = x, cy = y, cw = w, ch = h;
+    if (!clip(cx, cy, cw, ch)) return;
+
+    startWrite();
+    countWindow(cw, ch);
+    for (int32_t row = 0; row < ch; row++) {
+        const swap565_t* src = data + (cy - y + row) * w + (cx - x);
+        uint16_t* dst = _buffer + (cy + row) * _width + cx;
+        for (int32_t col = 0; col < cw; col++) {
+            dst[col] = src[col].raw;
+        }
+    }
+    endWrite();
+}
+
+// ============================================================
+// Text
+// ============================================================
+
+void LGFXBase::setTextSize(float size) {
+    _textSize = size < 1 ? 1 : (uint8_t)size;
+}
+
+void LGFXBase::setTextColor(uint32_t color) {
+    _textColor = color;
+    _textFill = false;
+}
+
+void LGFXBase::setTextColor(uint32_t color, uint32_t background) {
+    _textColor = color;
+    _textBackground = background;
+    // Wie LovyanGFX: gleiche Farben = transparenter Hintergrund
+    _textFill = (uint16_t)color != (uint16_t)background;
+}
+
+int32_t LGFXBase::textWidth(const char* text) const {
+    return (int32_t)strlen(text) * GLYPH_WIDTH * _textSize;
+}
+
+void LGFXBase::drawChar(int32_t x, int32_t y, char c) {
+    uint8_t index = (uint8_t)c;
+    const uint8_t* glyph = glcdFont[(index >= 0x20 && index <= 0x7E) ? index - 0x20 : 0];
+    int32_t size = _textSize;
+
+    if (_textFill) {
+        // Mit Hintergrund: ein Fenster für die ganze Zelle
+        int32_t cx = x, cy = y, cw = GLYPH_WIDTH * size, ch = GLYPH_HEIGHT * size;
+        if (!clip(cx, cy, cw, ch)) return;
+        countWindow(cw, ch);
+        for (int32_t col = 0; col < GLYPH_WIDTH; col++) {
+            uint8_t bits = col < 5 ? glyph[col] : 0;
+            for (int32_t row = 0; row < GLYPH_HEIGHT; row++) {
+                uint16_t color = (bits >> row) & 1 ? _textColor : _textBackground;
+                for (int32_t dy = 0; dy < size; dy++) {
+                    for (int32_t dx = 0; dx < size; dx++) {
+                        plot(x + col * size + dx, y + row * size + dy, color);
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    // Transparent: ein Fenster pro senkrechtem Pixel-Lauf
+    for (int32_t col = 0; col < 5; col++) {
+        uint8_t bits = glyph[col];
+        int32_t row = 0;
+        while (row < GLYPH_HEIGHT) {
+            if (!((bits >> row) & 1)) {
+                row++;
+                continue;
+            }
+            int32_t start = row;
+            while (row < GLYPH_HEIGHT && ((bits >> row) & 1)) {
+                row++;
+            }
+            writeRect(x + col * size, y + start * size, size, (row - start) * size, _textColor);
+        }
+    }
+}
+
+size_t LGFXBase::drawString(const char* text, int32_t x, int32_t y) {
+    int32_t width = textWidth(text);
+    int32_t height = fontHeight();
+
+    switch (_textDatum & 3) {
+        case 1: x -= width / 2; break;
+        case 2: x -= width; break;
+    }
+    switch (_textDatum >> 2) {
+        case 1: y -= height / 2; break;
+        case 2: y -= height; break;
+    }
+
+    startWrite();
+    // Padding füllt den Rest der Breite mit der Hintergrundfarbe
+    int32_t padding = (int32_t)_textPadding - width;
+    if (_textFill && padding > 0) {
+        switch (_textDatum & 3) {
+            case 0:
+                writeRect(x + width, y, padding, height, _textBackground);
+                break;
+            case 1:
+                writeRect(x - padding / 2, y, padding / 2, height, _textBackground);
+                writeRect(x + width, y, padding - padding / 2, height, _textBackground);
+                break;
+            case 2:
+                writeRect(x - padding, y, padding, height, _textBackground);
+                break;
+        }
+    }
+    for (const char* c = text; *c; c++) {
+        drawChar(x, y, *c);
+        x += GLYPH_WIDTH * _textSize;
+    }
+    endWrite();
+    return width;
+}
+
+size_t LGFXBase::write(uint8_t c) {
+    if (c == '\n') {
+        _cursorX = 0;
+        _cursorY += GLYPH_HEIGHT * _textSize;
+        return 1;
+    }
+    if (c == '\r') {
+        return 1;
+    }
+    startWrite();
+    drawChar(_cursorX, _cursorY, (char)c);
+    endWrite();
+    _cursorX += GLYPH_WIDTH * _textSize;
+    return 1;
+}
+
+// ============================================================
+// LGFX_Sprite
+// ============================================================
+
+LGFX_Sprite::LGFX_Sprite(LGFXBase* parent) : _parent(parent) {
+}
+
+LGFX_Sprite::~LGFX_Sprite() {
+    deleteSprite();
+}
+
+void* LGFX_Sprite::createSprite(int32_t w, int32_t h) {
+    deleteSprite();
+    _buffer = (uint16_t*)calloc((size_t)w * h, sizeof(uint16_t));
+    if (_buffer) {
+        _width = w;
+        _height = h;
+    }
+    return _buffer;
+}
+
+void LGFX_Sprite::deleteSprite() {
+    free(_buffer);
+    _buffer = nullptr;
+    _width = 0;
+    _height = 0;
+}
+
+void LGFX_Sprite::pushSprite(int32_t x, int32_t y) {
+    if (_parent && _buffer) {
+        _parent->pushImage(x, y, _width, _height, (const swap565_t*)_buffer);
+    }
+}
+
+// ============================================================
+// LGFX_Device
+// ============================================================
+
+LGFX_Device::LGFX_Device() : _panel(nullptr), _rotation(0) {
+    memset(_touchCalibration, 0, sizeof(_touchCalibration));
+}
+
+LGFX_Device::~LGFX_Device() {
+    free(_buffer);
+    if (hostDevice == this) {
+        hostDevice = nullptr;
+    }
+}
+
+void LGFX_Device::allocate() {
+    int32_t w = _panel ? _panel->config().panel_width : 240;
+    int32_t h = _panel ? _panel->config().panel_height : 320;
+    if (_rotation & 1) {
+        std::swap(w, h);
+    }
+    free(_buffer);
+    _buffer = (uint16_t*)calloc((size_t)w * h, sizeof(uint16_t));
+    _width = w;
+    _height = h;
+}
+
+uint32_t LGFX_Device::busFrequency() const {
+    return (_panel && _panel->getBus()) ? _panel->getBus()->config().freq_write : 0;
+}
+
+bool LGFX_Device::init() {
+    allocate();
+    hostDevice = this;
+    HostDisplay::resetStats();
+    return _buffer != nullptr;
+}
+
+void LGFX_Device::setRotation(uint8_t rotation) {
+    _rotation = rotation & 3;
+    allocate();
+}
+
+void LGFX_Device::setTouchCalibrate(uint16_t* parameters) {
+    memcpy(_touchCalibration, parameters, sizeof(_touchCalibration));
+}
+
+uint_fast8_t LGFX_Device::getTouch(uint16_t* x, uint16_t* y) {
+    if (!touchActive) return 0;
+    *x = touchX;
+    *y = touchY;
+    return 1;
+}
+
+uint_fast8_t LGFX_Device::getTouchRaw(touch_point_t* tp, uint_fast8_t count) {
+    if (!touchActive || count == 0) return 0;
+    tp->x = touchX * HOST_TOUCH_RAW_SCALE;
+    tp->y = touchY * HOST_TOUCH_RAW_SCALE;
+    tp->size = 1000;
+    return 1;
+}
+
+void LGFX_Device::convertRawXY(touch_point_t* tp, uint_fast8_t count) const {
+    for (uint_fast8_t i = 0; i < count; i++) {
+        tp[i].x /= HOST_TOUCH_RAW_SCALE;
+        tp[i].y /= HOST_TOUCH_RAW_SCALE;
+    }
+}
+
+void LGFX_Device::countTransaction() {
+    spiStats.transactions++;
+}
+
+void LGFX_Device::countWindow(int32_t w, int32_t h) {
+    uint64_t pixels = (uint64_t)w * h;
+    spiStats.windows++;
+    spiStats.pixels += pixels;
+    spiStats.bytes += HOST_SPI_WINDOW_BYTES + pixels * 2;
+}
+
+}  // namespace lgfx
+
+// ============================================================
+// HostDisplay
+// ============================================================
+
+namespace HostDisplay {
+
+const SpiStats& stats() {
+    return spiStats;
+}
+
+void resetStats() {
+    spiStats = {};
+    spiStats.freqHz = hostDevice ? hostDevice->busFrequency() : 0;
+}
+
+const uint16_t* framebuffer() {
+    return hostDevice ? hostDevice->framebufferData() : nullptr;
+}
+
+int32_t width() {
+    return hostDevice ? hostDevice->width() : 0;
+}
+
+int32_t height() {
+    return hostDevice ? hostDevice->height() : 0;
+}
+
+static void toRGB888(uint16_t color, uint8_t* rgb) {
+    rgb[0] = ((color >> 11) & 0x1F) * 255 / 31;
+    rgb[1] = ((color >> 5) & 0x3F) * 255 / 63;
+    rgb[2] = (color & 0x1F) * 255 / 31;
+}
+
+bool writePPM(const char* path) {
+    const uint16_t* pixels = framebuffer();
+    if (!pixels) return false;
+
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+
+    fprintf(file, "P6\n%d %d\n255\n", (int)width(), (int)height());
+    int64_t count = (int64_t)width() * height();
+    for (int64_t i = 0; i < count; i++) {
+        uint8_t rgb[3];
+        toRGB888(pixels[i], rgb);
+        fwrite(rgb, 1, 3, file);
+    }
+    fclose(file);
+    return true;
+}
+
+int64_t diffPPM(const char* path) {
+    const uint16_t* pixels = framebuffer();
+    if (!pixels) return -1;
+
+    FILE* file = fopen(path, "rb");
+    if (!file) return -1;
+
+    int w = 0, h = 0, maxValue = 0;
+    if (fscanf(file, "P6 %d %d %d", &w, &h, &maxValue) != 3 || maxValue != 255 ||
+        w != width() || h != height()) {
+        fclose(file);
+        return -1;
+    }
+    fgetc(file);  // Ein Whitespace nach dem Header
+
+    int64_t differing = 0;
+    int64_t count = (int64_t)w * h;
+    for (int64_t i = 0; i < count; i++) {
+        uint8_t expected[3], actual[3];
+        if (fread(expected, 1, 3, file) != 3) {
+            fclose(file);
+            return -1;
+        }
+        toRGB888(pixels[i], actual);
+        if (memcmp(expected, actual, 3) != 0) {
+            differing++;
+        }
+    }
+    fclose(file);
+    return differing;
+}
+
+void injectTouch(uint16_t x, uint16_t y) {
+    touchActive = true;
+    touchX = x;
+    touchY = y;
+}
+
+void releaseTouch() {
+    touchActive = false;
+}
+
+}  // namespace HostDisplay
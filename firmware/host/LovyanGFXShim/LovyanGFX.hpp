@@ -0,0 +1,293 @@
+#ifndef HOST_LOVYANGFX_HPP
+#define HOST_LOVYANGFX_HPP
+
+#include <Arduino.h>
+#include "HostDisplay.h"
+
+/**
+ * LovyanGFX für den Host-Build (headless)
+ *
+ * Teilmenge der API, die src/ultralight_v2 benutzt: Panel-/Bus-/Touch-
+ * Konfiguration (wird nur gespeichert), Grafik-Primitive, Text im
+ * eingebauten 6x8-Font (skaliert), Sprites und pushImageDMA.
+ * Gezeichnet wird in einen RGB565-Framebuffer, die SPI-Kosten landen in
+ * HostDisplay::stats(). Farben sind immer RGB565.
+ *
+ * Sprites speichern Pixel auf dem Host in nativer Byte-Reihenfolge;
+ * swap565_t ist nur ein Typ-Alias für die Casts im Display-Code.
+ */
+
+#define HOST_TOUCH_RAW_SCALE 12
+
+#ifndef VSPI_HOST
+#define HSPI_HOST 1
+#define VSPI_HOST 2
+#endif
+
+enum : uint8_t {
+    TL_DATUM = 0, TC_DATUM = 1, TR_DATUM = 2,
+    ML_DATUM = 4, MC_DATUM = 5, MR_DATUM = 6,
+    BL_DATUM = 8, BC_DATUM = 9, BR_DATUM = 10
+};
+
+namespace lgfx {
+
+struct swap565_t {
+    uint16_t raw;
+};
+
+struct touch_point_t {
+    int16_t x = -1;
+    int16_t y = -1;
+    uint16_t size = 0;  // XPT2046: Druck
+    uint16_t id = 0;
+};
+
+// ============================================================
+// Zeichenfläche (Panel oder Sprite)
+// ============================================================
+
+class LGFXBase : public Print {
+public:
+    LGFXBase();
+    virtual ~LGFXBase() {}
+
+    int32_t width() const { return _width; }
+    int32_t height() const { return _height; }
+
+    // Klammert mehrere Zugriffe in eine SPI-Transaktion
+    void startWrite();
+    void endWrite();
+
+    // Zeichnen nur innerhalb des Rechtecks
+    void setClipRect(int32_t x, int32_t y, int32_t w, int32_t h);
+    void clearClipRect();
+
+    void drawPixel(int32_t x, int32_t y, uint32_t color);
+    void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color);
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color);
+    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color);
+    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+    void fillScreen(uint32_t color);
+    void drawCircle(int32_t x, int32_t y, int32_t r, uint32_t color);
+    void fillCircle(int32_t x, int32_t y, int32_t r, uint32_t color);
+    void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color);
+    void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color);
+
+    void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const swap565_t* data);
+    void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, const swap565_t* data) {
+        pushImage(x, y, w, h, data);
+    }
+
+    // Text
+    void setTextSize(float size);
+    void setTextColor(uint32_t color);
+    void setTextColor(uint32_t color, uint32_t background);
+    void setTextDatum(uint8_t datum) { _textDatum = datum; }
+    void setTextPadding(uint32_t padding) { _textPadding = padding; }
+    void setCursor(int32_t x, int32_t y) { _cursorX = x; _cursorY = y; }
+    int32_t textWidth(const char* text) const;
+    int32_t fontHeight() const { return 8 * _textSize; }
+    size_t drawString(const char* text, int32_t x, int32_t y);
+    size_t drawString(const String& text, int32_t x, int32_t y) { return drawString(text.c_str(), x, y); }
+
+    // Print (print/printf am Cursor)
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+protected:
+    uint16_t* _buffer;
+    int32_t _width;
+    int32_t _height;
+
+    // SPI-Kosten: nur das Panel zählt, Sprites liegen im RAM
+    virtual void countTransaction() {}
+    virtual void countWindow(int32_t w, int32_t h) { (void)w; (void)h; }
+
+private:
+    uint8_t _writeDepth;
+    bool _clipActive;
+    int32_t _clipX;
+    int32_t _clipY;
+    int32_t _clipW;
+    int32_t _clipH;
+    uint8_t _textSize;
+    uint16_t _textColor;
+    uint16_t _textBackground;
+    bool _textFill;
+    uint8_t _textDatum;
+    uint32_t _textPadding;
+    int32_t _cursorX;
+    int32_t _cursorY;
+
+    bool clip(int32_t& x, int32_t& y, int32_t& w, int32_t& h) const;
+    void writeRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+    void plot(int32_t x, int32_t y, uint16_t color);
+    void drawChar(int32_t x, int32_t y, char c);
+    void drawCircleHelper(int32_t x0, int32_t y0, int32_t r, uint8_t corners, uint16_t color);
+    void fillCircleHelper(int32_t x0, int32_t y0, int32_t r, uint8_t corners, int32_t delta, uint16_t color);
+};
+
+// ============================================================
+// Sprite
+// ============================================================
+
+class LGFX_Sprite : public LGFXBase {
+public:
+    explicit LGFX_Sprite(LGFXBase* parent = nullptr);
+    ~LGFX_Sprite();
+
+    void setColorDepth(int bits) { (void)bits; }    // Immer 16 Bit
+    void setPsram(bool enabled) { (void)enabled; }
+    void* createSprite(int32_t w, int32_t h);
+    void deleteSprite();
+    void fillSprite(uint32_t color) { fillScreen(color); }
+    void* getBuffer() const { return _buffer; }
+    void pushSprite(int32_t x, int32_t y);
+
+private:
+    LGFXBase* _parent;
+};
+
+// ============================================================
+// Panel-Konfiguration (wird nur gespeichert)
+// ============================================================
+
+class Bus_SPI {
+public:
+    struct config_t {
+        int spi_host = VSPI_HOST;
+        uint8_t spi_mode = 0;
+        uint32_t freq_write = 16000000;
+        uint32_t freq_read = 8000000;
+        bool spi_3wire = true;
+        bool use_lock = true;
+        int dma_channel = 0;
+        int16_t pin_sclk = -1;
+        int16_t pin_mosi = -1;
+        int16_t pin_miso = -1;
+        int16_t pin_dc = -1;
+    };
+
+    const config_t& config() const { return _cfg; }
+    void config(const config_t& cfg) { _cfg = cfg; }
+
+private:
+    config_t _cfg;
+};
+
+class Touch_XPT2046 {
+public:
+    struct config_t {
+        uint16_t x_min = 0;
+        uint16_t x_max = 4095;
+        uint16_t y_min = 0;
+        uint16_t y_max = 4095;
+        int16_t pin_int = -1;
+        bool bus_shared = true;
+        uint8_t offset_rotation = 0;
+        int spi_host = HSPI_HOST;
+        uint32_t freq = 1000000;
+        int16_t pin_sclk = -1;
+        int16_t pin_mosi = -1;
+        int16_t pin_miso = -1;
+        int16_t pin_cs = -1;
+    };
+
+    const config_t& config() const { return _cfg; }
+    void config(const config_t& cfg) { _cfg = cfg; }
+
+private:
+    config_t _cfg;
+};
+
+class Panel_Device {
+public:
+    struct config_t {
+        int16_t pin_cs = -1;
+        int16_t pin_rst = -1;
+        int16_t pin_busy = -1;
+        uint16_t memory_width = 240;
+        uint16_t memory_height = 320;
+        uint16_t panel_width = 240;
+        uint16_t panel_height = 320;
+        int16_t offset_x = 0;
+        int16_t offset_y = 0;
+        uint8_t offset_rotation = 0;
+        uint8_t dummy_read_pixel = 8;
+        uint8_t dummy_read_bits = 1;
+        bool readable = true;
+        bool invert = false;
+        bool rgb_order = false;
+        bool dlen_16bit = false;
+        bool bus_shared = true;
+    };
+
+    Panel_Device() : _bus(nullptr), _touch(nullptr) {}
+    virtual ~Panel_Device() {}
+
+    const config_t& config() const { return _cfg; }
+    void config(const config_t& cfg) { _cfg = cfg; }
+    void setBus(Bus_SPI* bus) { _bus = bus; }
+    void setTouch(Touch_XPT2046* touch) { _touch = touch; }
+    Bus_SPI* getBus() const { return _bus; }
+
+private:
+    config_t _cfg;
+    Bus_SPI* _bus;
+    Touch_XPT2046* _touch;
+};
+
+class Panel_ST7789 : public Panel_Device {};
+
+// ============================================================
+// Display
+// ============================================================
+
+class LGFX_Device : public LGFXBase {
+public:
+    LGFX_Device();
+    ~LGFX_Device();
+
+    void setPanel(Panel_Device* panel) { _panel = panel; }
+
+    // Legt den Framebuffer an und macht dieses Display zu HostDisplay
+    bool init();
+    void setRotation(uint8_t rotation);
+
+    void setTouchCalibrate(uint16_t* parameters);
+    // Keine Hardware: liefert die aktuelle Kalibrierung zurück
+    template <typename T>
+    void calibrateTouch(uint16_t* parameters, const T& foreground, const T& background, uint8_t size = 10) {
+        (void)foreground;
+        (void)background;
+        (void)size;
+        memcpy(parameters, _touchCalibration, sizeof(_touchCalibration));
+    }
+    uint_fast8_t getTouch(uint16_t* x, uint16_t* y);
+    // Host: Rohwert = Bildschirmkoordinate * HOST_TOUCH_RAW_SCALE, keine Drehung
+    uint_fast8_t getTouchRaw(touch_point_t* tp, uint_fast8_t count = 1);
+    void convertRawXY(touch_point_t* tp, uint_fast8_t count) const;
+
+    // Für HostDisplay
+    const uint16_t* framebufferData() const { return _buffer; }
+    uint32_t busFrequency() const;
+
+protected:
+    void countTransaction() override;
+    void countWindow(int32_t w, int32_t h) override;
+
+private:
+    Panel_Device* _panel;
+    uint8_t _rotation;
+    uint16_t _touchCalibration[8];
+
+    void allocate();
+};
+
+}  // namespace lgfx
+
+using lgfx::LGFX_Sprite;
+
+#endif // HOST_LOVYANGFX_HPP
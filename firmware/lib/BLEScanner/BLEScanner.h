@@ -63,6 +63,7 @@ public:
     
     // Utils
     static float rssiToDistance(int8_t rssi, int8_t txPower = -59);
+    static bool parseIBeacon(NimBLEAdvertisedDevice* device, BeaconData& beacon);
     
 private:
     NimBLEScan* pBLEScan;
@@ -78,9 +79,6 @@ private:
     class AdvertisedDeviceCallbacks;
     
     AdvertisedDeviceCallbacks* callbacks;
-    
-    // Helper
-    bool parseIBeacon(NimBLEAdvertisedDevice* device, BeaconData& beacon);
 };
 
 #endif // BLE_SCANNER_H
@@ -0,0 +1,254 @@
+#ifndef CANVAS_H
+#define CANVAS_H
+
+#include <Arduino.h>
+#include "WidgetTree.h"
+
+/**
+ * Gemeinsame UI-Elemente für TFT_eSPI und LovyanGFX, ohne virtuelle Aufrufe
+ *
+ * Canvas<Backend> ist eine CRTP-Basis: das Backend erbt davon und liefert
+ * die Primitive, die Basis baut daraus Header, Buttons, Listeneinträge,
+ * Widgets und Meldungsboxen - bisher in jeder Variante doppelt vorhanden.
+ * Alles wird zur Compile-Zeit aufgelöst, im Zeichenpfad gibt es keinen
+ * vtable-Sprung und der Compiler kann die Primitive inlinen.
+ *
+ * Ein Backend stellt bereit (gleiche Namen wie in beiden Libraries):
+ *   width(), height(), fillScreen(c)
+ *   fillRect/drawRect(x, y, w, h, c), fillRoundRect/drawRoundRect(x, y, w, h, r, c)
+ *   fillCircle/drawCircle(x, y, r, c), drawFastHLine(x, y, w, c), drawFastVLine(x, y, h, c)
+ *   setTextColor(fg), setTextColor(fg, bg), setTextSize(s), setTextDatum(CanvasDatum)
+ *   drawString(const char*, x, y), textWidth(const char*), fontHeight()
+ *
+ * Backends: TftCanvas (src/ultralight), LgfxCanvas (src/ultralight_v2,
+ * Display, Sprites und Host-Shim), CountingCanvas (hier, headless).
+ * Das Aussehen der Variante steckt in CanvasTheme.
+ */
+
+// Textausrichtung, die Backends übersetzen in ihre eigenen Konstanten
+// (TFT_eSPI und LovyanGFX nummerieren unterschiedlich)
+enum CanvasDatum : uint8_t {
+    DATUM_TOP_LEFT,
+    DATUM_TOP_CENTER,
+    DATUM_TOP_RIGHT,
+    DATUM_MIDDLE_LEFT,
+    DATUM_MIDDLE_CENTER,
+    DATUM_MIDDLE_RIGHT
+};
+
+struct CanvasTheme {
+    int16_t screenWidth;
+    int16_t screenHeight;
+    uint16_t background;
+    uint16_t text;
+
+    int16_t headerHeight;
+    uint16_t headerBackground;
+    uint16_t headerText;
+    uint8_t headerTextSize;
+    bool headerCentered;        // false: linksbündig, "[<]" rechts bei showBack
+
+    uint8_t buttonRadius;
+    bool buttonBordered;
+    uint16_t buttonBorder;
+    uint16_t buttonText;
+    uint8_t backTextSize;       // "<" im Zurück-Widget
+    uint8_t listRadius;
+
+    bool messageOverlay;        // true: Box über dem Screen, false: ganzer Screen
+    uint16_t messageButton;     // OK-Button der Box
+};
+
+template <typename Backend>
+class Canvas {
+public:
+    explicit Canvas(const CanvasTheme& theme) : theme(theme) {}
+
+    const CanvasTheme& getTheme() const { return theme; }
+
+    void header(const char* title, bool showBack = false) {
+        Backend& b = backend();
+        b.fillRect(0, 0, theme.screenWidth, theme.headerHeight, theme.headerBackground);
+        b.setTextColor(theme.headerText);
+        b.setTextSize(theme.headerTextSize);
+        if (theme.headerCentered) {
+            b.setTextDatum(DATUM_MIDDLE_CENTER);
+            b.drawString(title, theme.screenWidth / 2, theme.headerHeight / 2);
+            return;
+        }
+        b.setTextDatum(DATUM_TOP_LEFT);
+        b.drawString(title, 10, 8);
+        if (showBack) {
+            b.drawString("[<]", theme.screenWidth - 50, 8);
+        }
+    }
+
+    void button(int32_t x, int32_t y, int32_t w, int32_t h, const char* text,
+                uint16_t color, uint8_t textSize) {
+        Backend& b = backend();
+        b.fillRoundRect(x, y, w, h, theme.buttonRadius, color);
+        if (theme.buttonBordered) {
+            b.drawRoundRect(x, y, w, h, theme.buttonRadius, theme.buttonBorder);
+        }
+        b.setTextColor(theme.buttonText);
+        b.setTextSize(textSize);
+        b.setTextDatum(DATUM_MIDDLE_CENTER);
+        b.drawString(text, x + w / 2, y + h / 2);
+    }
+
+    // Listeneintrag/Eingabefeld, mit Auswahlpunkt bei WIDGET_CHECKBOX
+    void listItem(const Widget& widget) {
+        Backend& b = backend();
+        b.fillRoundRect(widget.x, widget.y, widget.w, widget.h, theme.listRadius, widget.color);
+        b.drawRoundRect(widget.x, widget.y, widget.w, widget.h, theme.listRadius, 0x4208);
+
+        int32_t textX = widget.x + 5;
+        if (widget.kind == WIDGET_CHECKBOX) {
+            b.fillCircle(widget.x + 15, widget.y + widget.h / 2, 6, widget.checked ? 0x0000 : 0xFFFF);
+            b.drawCircle(widget.x + 15, widget.y + widget.h / 2, 6, 0x0000);
+            textX = widget.x + 28;
+        }
+
+        b.setTextColor(widget.textColor);
+        b.setTextSize(widget.textSize);
+        b.setTextDatum(DATUM_TOP_LEFT);
+        b.drawString(widget.text.c_str(), textX, widget.y + 8);
+        if (widget.detail.length() > 0) {
+            b.drawString(widget.detail.c_str(), textX, widget.y + widget.h - 18);
+        }
+    }
+
+    // Renderer für den Widget-Baum: zeichnet genau das Rechteck des Widgets
+    void widget(const Widget& widget) {
+        Backend& b = backend();
+
+        // Ausgeblendet: Fläche mit dem Hintergrund darunter überschreiben
+        if (!widget.visible) {
+            uint16_t background = widget.kind == WIDGET_BACK ? theme.headerBackground : theme.background;
+            b.fillRect(widget.x, widget.y, widget.w, widget.h, background);
+            return;
+        }
+
+        switch (widget.kind) {
+            case WIDGET_BUTTON:
+                button(widget.x, widget.y, widget.w, widget.h, widget.text.c_str(),
+                       widget.color, widget.textSize);
+                break;
+
+            case WIDGET_BACK:
+                b.fillRoundRect(widget.x, widget.y, widget.w, widget.h, 5, widget.color);
+                b.setTextColor(theme.buttonText);
+                b.setTextSize(theme.backTextSize);
+                b.setTextDatum(DATUM_MIDDLE_CENTER);
+                b.drawString(widget.text.c_str(), widget.x + widget.w / 2, widget.y + widget.h / 2);
+                break;
+
+            case WIDGET_LABEL:
+                b.fillRect(widget.x, widget.y, widget.w, widget.h, widget.color);
+                b.setTextColor(widget.textColor);
+                b.setTextSize(widget.textSize);
+                b.setTextDatum(DATUM_TOP_LEFT);
+                b.drawString(widget.text.c_str(), widget.x, widget.y);
+                break;
+
+            case WIDGET_LIST_ITEM:
+            case WIDGET_CHECKBOX:
+                listItem(widget);
+                break;
+        }
+    }
+
+    // Meldung: als Box mit OK-Button über dem Screen oder bildschirmfüllend
+    void message(const char* title, const char* text, uint16_t color,
+                 uint8_t titleSize, uint8_t textSize) {
+        Backend& b = backend();
+        int32_t centerX = theme.screenWidth / 2;
+
+        if (!theme.messageOverlay) {
+            b.fillScreen(theme.background);
+            b.setTextColor(color);
+            b.setTextSize(titleSize);
+            b.setTextDatum(DATUM_TOP_CENTER);
+            b.drawString(title, centerX, 80);
+            b.setTextColor(theme.text);
+            b.setTextSize(textSize);
+            b.drawString(text, centerX, 120);
+            return;
+        }
+
+        int32_t boxW = theme.screenWidth - 40;
+        int32_t boxH = 140;
+        int32_t boxX = 20;
+        int32_t boxY = (theme.screenHeight - boxH) / 2;
+        b.fillRoundRect(boxX, boxY, boxW, boxH, 10, 0xFFFF);
+        b.drawRoundRect(boxX, boxY, boxW, boxH, 10, color);
+
+        b.setTextColor(color);
+        b.setTextSize(titleSize);
+        b.setTextDatum(DATUM_TOP_CENTER);
+        b.drawString(title, centerX, boxY + 20);
+
+        b.setTextColor(theme.text);
+        b.setTextSize(textSize);
+        b.drawString(text, centerX, boxY + 60);
+
+        button(boxX + boxW / 2 - 50, boxY + boxH - 40, 100, 35, "OK", theme.messageButton, textSize);
+    }
+
+protected:
+    CanvasTheme theme;      // Kopie: Canvas lebt oft nur für einen Aufruf
+
+    Backend& backend() { return static_cast<Backend&>(*this); }
+};
+
+// ============================================================
+// Headless-Backend
+// ============================================================
+
+/**
+ * Zeichnet nichts, zählt nur Aufrufe und berührte Pixel (Text als
+ * 6x8-Zellen je Zeichen, wie die eingebauten Fonts). Misst die Kosten der
+ * UI-Logik ohne Rasterung und zeigt, wie viel ein Screen überhaupt anfasst.
+ */
+class CountingCanvas : public Canvas<CountingCanvas> {
+public:
+    explicit CountingCanvas(const CanvasTheme& theme)
+        : Canvas<CountingCanvas>(theme), calls(0), pixels(0), textSize(1) {}
+
+    uint32_t getCalls() const { return calls; }
+    uint64_t getPixels() const { return pixels; }
+    void resetStats() { calls = 0; pixels = 0; }
+
+    int32_t width() const { return theme.screenWidth; }
+    int32_t height() const { return theme.screenHeight; }
+
+    void fillScreen(uint16_t) { count((int64_t)theme.screenWidth * theme.screenHeight); }
+    void fillRect(int32_t, int32_t, int32_t w, int32_t h, uint16_t) { count((int64_t)w * h); }
+    void drawRect(int32_t, int32_t, int32_t w, int32_t h, uint16_t) { count(2 * (w + h)); }
+    void fillRoundRect(int32_t, int32_t, int32_t w, int32_t h, int32_t, uint16_t) { count((int64_t)w * h); }
+    void drawRoundRect(int32_t, int32_t, int32_t w, int32_t h, int32_t, uint16_t) { count(2 * (w + h)); }
+    void fillCircle(int32_t, int32_t, int32_t r, uint16_t) { count(3 * r * r); }
+    void drawCircle(int32_t, int32_t, int32_t r, uint16_t) { count(6 * r); }
+    void drawFastHLine(int32_t, int32_t, int32_t w, uint16_t) { count(w); }
+    void drawFastVLine(int32_t, int32_t, int32_t h, uint16_t) { count(h); }
+
+    void setTextColor(uint16_t) {}
+    void setTextColor(uint16_t, uint16_t) {}
+    void setTextSize(uint8_t size) { textSize = size; }
+    void setTextDatum(CanvasDatum) {}
+    int32_t textWidth(const char* text) const { return (int32_t)strlen(text) * 6 * textSize; }
+    int32_t fontHeight() const { return 8 * textSize; }
+    void drawString(const char* text, int32_t, int32_t) { count((int64_t)textWidth(text) * fontHeight()); }
+
+private:
+    uint32_t calls;
+    uint64_t pixels;
+    uint8_t textSize;
+
+    void count(int64_t area) {
+        calls++;
+        pixels += area > 0 ? area : 0;
+    }
+};
+
+#endif // CANVAS_H
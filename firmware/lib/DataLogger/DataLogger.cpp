@@ -1,16 +1,55 @@
 #include "DataLogger.h"
+#include "CsvReader.h"
+#include <unistd.h>
+#ifndef NATIVE_BUILD
+#include <SPI.h>
+#include "ff.h"
+#include "sd_diskio.h"
+#endif
+
+#define LOG_FILE_UPDATE "r+"        // Lesen/Schreiben ab beliebiger Position, ohne Kürzen
 
 DataLogger::DataLogger() 
     : initialized(false)
+    , csPin(5)
     , currentRaceFile("")
-    , raceStartTime(0) {
+    , raceStartTime(0)
+    , currentRaceId(0)
+    , retainRaces(LOG_RETAIN_RACES)
+    , retainBytes(LOG_RETAIN_BYTES)
+    , lastPruneMs(0)
+    , raceFileSize(0)
+    , raceFileChecksum(0)
+    , raceStatsValid(false)
+    , pendingBytes(0)
+    , pendingRecords(0)
+    , firstPendingMs(0)
+    , fileBytes(0)
+    , fileReserved(0)
+    , rssiCurrent(nullptr)
+    , rssiReady(nullptr)
+    , rssiBlock(nullptr)
+    , rssiFile("")
+    , rssiActive(false)
+    , rssiFirstMs(0)
+    , rssiFileBytes(0)
+    , rssiCurrentWritten(0)
+    , rssiReadyWritten(0) {
+    memset(teamSlots, LAP_LOG_MAX_TEAMS, sizeof(teamSlots));
+    memset(&formatStats, 0, sizeof(formatStats));
+    resetLogStats();
 }
 
 DataLogger::~DataLogger() {
+    delete rssiCurrent;
+    delete rssiReady;
+    delete[] rssiBlock;
 }
 
 bool DataLogger::begin(uint8_t csPin) {
+    RtosLock lock(storeMutex);
     Serial.printf("[DataLogger] Initializing SD card (CS Pin: %u)...\n", csPin);
+    this->csPin = csPin;
     
     if (!SD.begin(csPin)) {
         Serial.println("[DataLogger] ERROR: SD card initialization failed");
@@ -44,6 +83,9 @@ bool DataLogger::begin(uint8_t csPin) {
         Serial.println("[DataLogger] Created /races directory");
     }
     
+    // Rennliste laden, nach einem Kartenwechsel neu aufbauen
+    raceCatalog.begin(SD);
+    
     initialized = true;
     Serial.println("[DataLogger] Initialized successfully");
     return true;
@@ -82,19 +124,90 @@ String DataLogger::readFile(const String& path) {
         return "";
     }
     
+    // Platz einmal reservieren, dann blockweise anhängen
+    String content = "";
+    content.reserve(getFileSize(path));
+    uint8_t block[LOG_SECTOR_BYTES];
+    streamFile(path, block, sizeof(block), [&content](const uint8_t* data, size_t length, uint32_t) {
+        return content.concat((const char*)data, length);
+    });
+    return content;
+}
+
+bool DataLogger::streamFile(const String& path, uint8_t* buffer, size_t bufferSize,
+                            const FileBlockVisitor& visitor, uint32_t offset,
+                            uint32_t length, uint32_t* streamed) {
+    if (streamed) {
+        *streamed = 0;
+    }
+    if (!initialized || !buffer || bufferSize == 0) {
+        return false;
+    }
+    
     File file = SD.open(path.c_str(), FILE_READ);
     if (!file) {
         Serial.printf("[DataLogger] ERROR: Failed to open file: %s\n", path.c_str());
-        return "";
+        return false;
     }
     
-    String content = "";
-    while (file.available()) {
-        content += (char)file.read();
+    uint32_t size = file.size();
+    if (offset > size || (offset > 0 && !file.seek(offset))) {
+        Serial.printf("[DataLogger] ERROR: Offset %lu beyond %s (%lu bytes)\n",
+                      (unsigned long)offset, path.c_str(), (unsigned long)size);
+        file.close();
+        return false;
+    }
+    uint32_t end = (length > size - offset) ? size : offset + length;
+    
+    // Ein read() pro Block, der Block gehört bis zum nächsten read() dem visitor
+    bool ok = true;
+    uint32_t pos = offset;
+    while (pos < end) {
+        size_t chunk = (end - pos < bufferSize) ? end - pos : bufferSize;
+        size_t read = file.read(buffer, chunk);
+        if (read == 0) {
+            Serial.printf("[DataLogger] ERROR: Read failed at %lu: %s\n", (unsigned long)pos, path.c_str());
+            ok = false;
+            break;
+        }
+        if (!visitor(buffer, read, pos)) {
+            ok = false;
+            break;
+        }
+        pos += read;
     }
     file.close();
     
-    return content;
+    if (streamed) {
+        *streamed = pos - offset;
+    }
+    return ok;
+}
+
+uint32_t DataLogger::getFileSize(const String& path) {
+    if (!initialized) {
+        return 0;
+    }
+    
+    File file = SD.open(path.c_str(), FILE_READ);
+    if (!file) {
+        return 0;
+    }
+    uint32_t size = file.size();
+    file.close();
+    return size;
+}
+
+File DataLogger::openFile(const String& path) {
+    if (!initialized) {
+        return File();
+    }
+    
+    File file = SD.open(path.c_str(), FILE_READ);
+    if (!file) {
+        Serial.printf("[DataLogger] ERROR: Failed to open file: %s\n", path.c_str());
+    }
+    return file;
 }
 
 bool DataLogger::deleteFile(const String& path) {
@@ -102,8 +215,12 @@ bool DataLogger::deleteFile(const String& path) {
         return false;
     }
     
+    RtosLock lock(storeMutex);
     if (SD.remove(path.c_str())) {
         Serial.printf("[DataLogger] Deleted: %s\n", path.c_str());
+        if (path.startsWith(RACE_CATALOG_DIR "/")) {
+            raceCatalog.removeRace(path);
+        }
         return true;
     } else {
         Serial.printf("[DataLogger] ERROR: Failed to delete: %s\n", path.c_str());
@@ -129,46 +246,136 @@ bool DataLogger::createCSVHeader(const String& filename, const String& header) {
     return writeFile(filename, header + "\n", false);
 }
 
-bool DataLogger::startNewRace(const String& raceName) {
+bool DataLogger::startNewRace(const String& raceName, const LapLogTeam* teams, uint16_t teamCount,
+                              uint32_t durationMs) {
     if (!initialized) {
         return false;
     }
     
+    RtosLock lock(storeMutex);
+    // Reste eines nicht beendeten Rennens gehören noch in dessen Datei
+    closeRaceFile();
+    closeRssiFile();
+    pendingBytes = 0;
+    pendingRecords = 0;
+    
+    // Platz für das ganze Rennen jetzt schaffen, nicht erst mittendrin
+    uint32_t budget = estimateRaceBytes(teamCount, durationMs);
+    logStats.raceBudgetBytes = budget;
+    uint64_t freeBytes = getFreeSpace();
+    while (freeBytes < budget + LOG_MIN_FREE_BYTES && pruneOldestRace()) {
+        freeBytes = getFreeSpace();
+    }
+    if (freeBytes < budget + LOG_MIN_FREE_BYTES) {
+        Serial.printf("[DataLogger] WARNING: %llu KB free, race needs %lu KB\n",
+                      (unsigned long long)(freeBytes / 1024), (unsigned long)(budget / 1024));
+    }
+    
     currentRaceFile = generateRaceFilename(raceName);
     raceStartTime = millis();
     
     Serial.printf("[DataLogger] New race started: %s\n", currentRaceFile.c_str());
     
-    // CSV Header erstellen
-    String header = "Team ID,Team Name,Lap Number,Timestamp (ms),Duration (ms),Time of Day";
-    return createCSVHeader(currentRaceFile, header);
+    if (teamCount > LAP_LOG_MAX_TEAMS) {
+        teamCount = LAP_LOG_MAX_TEAMS;
+    }
+    memset(teamSlots, LAP_LOG_MAX_TEAMS, sizeof(teamSlots));
+    for (uint16_t i = 0; i < teamCount; i++) {
+        teamSlots[teams[i].teamId] = i;
+    }
+    
+    raceStats.clear();
+    raceFileSize = 0;
+    raceFileChecksum = 0;
+    raceStatsValid = true;
+    
+    // Header + Teamtabelle, danach nur noch Datensätze
+    LapLogHeader header;
+    lapLogInitHeader(header, raceName.c_str(), raceStartTime, teams, teamCount);
+    size_t tableBytes = teamCount * sizeof(LapLogTeam);
+    File file = SD.open(currentRaceFile.c_str(), FILE_WRITE);
+    bool ok = file &&
+              file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+              file.write((const uint8_t*)teams, tableBytes) == tableBytes;
+    fileBytes = ok ? sizeof(header) + tableBytes : 0;
+    fileReserved = fileBytes;
+    
+    // Platz für alle erwarteten Runden jetzt belegen statt Cluster für Cluster im Rennen
+    if (ok && durationMs > 0) {
+        uint64_t records = (uint64_t)teamCount * durationMs / LOG_PREALLOC_LAP_MS;
+        uint64_t bytes = fileBytes + records * sizeof(LapLogRecord);
+        bytes = (bytes + LOG_SECTOR_BYTES - 1) / LOG_SECTOR_BYTES * LOG_SECTOR_BYTES;
+        if (bytes > LOG_PREALLOC_MAX_BYTES) {
+            bytes = LOG_PREALLOC_MAX_BYTES;
+        }
+        if (bytes > fileBytes) {
+            preallocate(file, bytes);
+        }
+    }
+    file.close();
+    if (!ok) {
+        Serial.printf("[DataLogger] ERROR: Failed to write header: %s\n", currentRaceFile.c_str());
+        raceStatsValid = false;
+        return false;
+    }
+    trackRaceBytes(&header, sizeof(header));
+    trackRaceBytes(teams, tableBytes);
+    currentRaceId = raceCatalog.addRace(currentRaceFile, header.raceName, raceStartTime, teamCount);
+    openRssiFile();
+    return true;
 }
 
 bool DataLogger::logLap(uint8_t teamId, const String& teamName, uint16_t lapNumber, 
                         uint32_t timestamp, uint32_t duration) {
+    RtosLock lock(storeMutex);
     if (!initialized || currentRaceFile.isEmpty()) {
         Serial.println("[DataLogger] ERROR: No active race");
         return false;
     }
     
-    // Time of Day formatieren (HH:MM:SS)
-    uint32_t seconds = (timestamp - raceStartTime) / 1000;
-    uint32_t hours = seconds / 3600;
-    uint32_t minutes = (seconds % 3600) / 60;
-    uint32_t secs = seconds % 60;
+    // Fester Datensatz statt CSV-Zeile: kein Formatieren, Name steht im Header
+    LapLogRecord record;
+    uint8_t slot = teamSlots[teamId];
+    if (slot < LAP_LOG_MAX_TEAMS) {
+        lapLogInitRecord(record, slot, 0, lapNumber, timestamp, duration);
+    } else {
+        lapLogInitRecord(record, teamId, LAP_FLAG_UNLISTED, lapNumber, timestamp, duration);
+    }
+    const size_t length = sizeof(record);
     
-    char timeStr[16];
-    sprintf(timeStr, "%02lu:%02lu:%02lu", hours, minutes, secs);
+    // Kein Platz: bis zur Sektorgrenze der Datei schreiben, Rest bleibt im Puffer
+    if (pendingBytes + length > LOG_BATCH_BYTES) {
+        logStats.fullFlushes++;
+        size_t aligned = (fileBytes + pendingBytes) / LOG_SECTOR_BYTES * LOG_SECTOR_BYTES - fileBytes;
+        if (aligned == 0 || pendingBytes - aligned + length > LOG_BATCH_BYTES) {
+            aligned = pendingBytes;
+        }
+        if (!writePending(aligned) && pendingBytes + length > LOG_BATCH_BYTES) {
+            // Karte schreibt nicht und der Puffer ist voll: diese Runde geht verloren
+            logStats.droppedRecords++;
+            raceStatsValid = false;
+            return false;
+        }
+    }
     
-    // CSV Zeile erstellen
-    String csvLine = String(teamId) + ",";
-    csvLine += teamName + ",";
-    csvLine += String(lapNumber) + ",";
-    csvLine += String(timestamp) + ",";
-    csvLine += String(duration) + ",";
-    csvLine += String(timeStr);
+    if (pendingRecords == 0) {
+        firstPendingMs = millis();
+    }
+    memcpy(logBuffer + pendingBytes, &record, length);
+    pendingBytes += length;
+    pendingRecords++;
+    logStats.records++;
+    if (pendingBytes > logStats.maxPendingBytes) {
+        logStats.maxPendingBytes = pendingBytes;
+    }
     
-    return logCSV(currentRaceFile, csvLine);
+    raceStats.addLap(teamId, teamName.c_str(), teamName.length(), duration);
+    trackRaceBytes(&record, length);
+    
+    if (pendingRecords >= LOG_FLUSH_RECORDS) {
+        return flushLog();
+    }
+    return true;
 }
 
 bool DataLogger::finishRace() {
@@ -176,11 +383,16 @@ bool DataLogger::finishRace() {
         return false;
     }
     
+    RtosLock lock(storeMutex);
+    // Alle gepufferten Runden auf die Karte, bevor irgendetwas anderes passiert
+    closeRaceFile();
+    closeRssiFile();
+    
     Serial.printf("[DataLogger] Race finished: %s\n", currentRaceFile.c_str());
     
     // Race-Summary schreiben
     String summaryFile = currentRaceFile;
-    summaryFile.replace(".csv", "_summary.txt");
+    summaryFile.replace(".lap", "_summary.txt");
     
     uint32_t raceDuration = millis() - raceStartTime;
     String summary = "Race finished\n";
@@ -188,13 +400,408 @@ bool DataLogger::finishRace() {
     summary += "File: " + currentRaceFile + "\n";
     
     writeFile(summaryFile, summary, false);
+    writeRaceSummary();
+    raceCatalog.finishRace(currentRaceId, raceStats.getLapCount(), fileBytes);
     
     currentRaceFile = "";
+    currentRaceId = 0;
     raceStartTime = 0;
+    pendingBytes = 0;
+    pendingRecords = 0;
+    
+    return true;
+}
+
+// ============================================================
+// Rundenpuffer
+// ============================================================
+
+bool DataLogger::flushLog() {
+    RtosLock lock(storeMutex);
+    if (pendingBytes == 0) {
+        return true;
+    }
+    return writePending(pendingBytes);
+}
+
+bool DataLogger::flushIfDue() {
+    RtosLock lock(storeMutex);
+    bool ok = writeRssi(false);
+    if (pendingRecords == 0 || millis() - firstPendingMs < LOG_FLUSH_MS) {
+        return ok;
+    }
+    return flushLog() && ok;
+}
+
+void DataLogger::resetLogStats() {
+    memset(&logStats, 0, sizeof(logStats));
+    flushLatency.reset();
+}
+
+// Die ersten length Bytes des Puffers an fileBytes schreiben, ein open/close
+// pro Block. In der Vorbelegung überschreibt das nur Nullen, dahinter hängt es an
+bool DataLogger::writePending(size_t length) {
+    if (length == 0 || currentRaceFile.isEmpty()) {
+        return length == 0;
+    }
+    
+    uint32_t start = micros();
+    File file = SD.open(currentRaceFile.c_str(), LOG_FILE_UPDATE);
+    if (!file || !file.seek(fileBytes)) {
+        logStats.writeErrors++;
+        Serial.printf("[DataLogger] ERROR: Failed to open file: %s\n", currentRaceFile.c_str());
+        return false;
+    }
+    size_t written = file.write((const uint8_t*)logBuffer, length);
+    file.close();
+    
+    uint32_t elapsed = micros() - start;
+    logStats.flushes++;
+    logStats.bytesWritten += written;
+    if (elapsed > logStats.maxFlushUs) {
+        logStats.maxFlushUs = elapsed;
+    }
+    flushLatency.record(elapsed);
+    
+    // Geschriebenes vorne entfernen, ein angeschnittener Datensatz zählt noch als offen
+    memmove(logBuffer, logBuffer + written, pendingBytes - written);
+    pendingBytes -= written;
+    fileBytes += written;
+    if (fileBytes > fileReserved) {
+        fileReserved = fileBytes;
+    }
+    pendingRecords = (pendingBytes + sizeof(LapLogRecord) - 1) / sizeof(LapLogRecord);
+    
+    if (written != length) {
+        logStats.writeErrors++;
+        Serial.printf("[DataLogger] ERROR: Write failed (%u/%u bytes)\n",
+                      (unsigned)written, (unsigned)length);
+        return false;
+    }
+    return true;
+}
+
+// ============================================================
+// RSSI-Telemetrie
+// ============================================================
+
+String DataLogger::rssiPath(const String& racePath) {
+    return racePath.substring(0, racePath.lastIndexOf('.')) + ".rssi";
+}
+
+bool DataLogger::logRssi(uint8_t teamId, uint32_t timestamp, int8_t rssi, bool* blockReady) {
+    RtosLock lock(rssiMutex);
+    if (!rssiActive) {
+        return false;
+    }
+    if (rssiCurrent->getSampleCount() == rssiCurrentWritten) {
+        rssiFirstMs = millis();
+    }
+    
+    // Block voll: an den Logger-Task übergeben, wenn der den letzten schon hat
+    if (!rssiCurrent->add(teamId, timestamp, rssi)) {
+        if (!rssiReady->isEmpty()) {
+            logStats.rssiDropped++;
+            return false;
+        }
+        std::swap(rssiCurrent, rssiReady);
+        rssiReadyWritten = rssiCurrentWritten;
+        rssiCurrentWritten = 0;
+        rssiFirstMs = millis();
+        rssiCurrent->add(teamId, timestamp, rssi);
+        if (blockReady) {
+            *blockReady = true;
+        }
+    }
+    logStats.rssiSamples++;
+    return true;
+}
+
+// Puffer beim ersten Rennen anlegen und behalten, Datei leer anlegen
+void DataLogger::openRssiFile() {
+#if LOG_RSSI_ENABLED
+    if (!rssiBlock) {
+        rssiCurrent = new RssiFrameEncoder();
+        rssiReady = new RssiFrameEncoder();
+        rssiBlock = new uint8_t[RSSI_LOG_BLOCK_BYTES];
+    }
+    rssiFile = rssiPath(currentRaceFile);
+    File file = SD.open(rssiFile.c_str(), FILE_WRITE);
+    file.close();
+    
+    RtosLock lock(rssiMutex);
+    rssiCurrent->clear();
+    rssiReady->clear();
+    rssiFileBytes = 0;
+    rssiCurrentWritten = 0;
+    rssiReadyWritten = 0;
+    rssiActive = true;
+#endif
+}
+
+// Keine neuen Samples mehr, Volles und Angefangenes schreiben
+void DataLogger::closeRssiFile() {
+    if (rssiFile.isEmpty()) {
+        return;
+    }
+    {
+        RtosLock lock(rssiMutex);
+        rssiActive = false;
+    }
+    writeRssi(true);
+    rssiFile = "";
+}
+
+// Vollen Block (rssiReady) an rssiFileBytes schreiben. Der angefangene
+// (rssiCurrent) kommt nach LOG_RSSI_FLUSH_MS bzw. mit force als kurzer Frame
+// dahinter und wird bei jedem Flush an derselben Stelle neu geschrieben, bis
+// er voll ist: die Datei wächst nur um die neuen Samples, nicht um 4 KB
+bool DataLogger::writeRssi(bool force) {
+    if (rssiFile.isEmpty()) {
+        return true;
+    }
+    bool ok = true;
+    bool full;
+    {
+        RtosLock lock(rssiMutex);
+        full = !rssiReady->isEmpty();
+    }
+    if (full) {
+        // Ohne Lock: logRssi() füllt derweil rssiCurrent und lässt rssiReady in Ruhe
+        rssiReady->finish(rssiBlock);
+        ok = writeRssiBlock(RSSI_LOG_BLOCK_BYTES);
+        
+        RtosLock lock(rssiMutex);
+        if (ok && rssiReadyWritten == 0) {
+            logStats.rssiBlocks++;
+        } else if (!ok) {
+            logStats.writeErrors++;
+            logStats.rssiDropped += rssiReady->getSampleCount() - rssiReadyWritten;
+        }
+        // Steht schon ein Stand des Blocks in der Datei, bleibt der dort
+        if (ok || rssiReadyWritten > 0) {
+            rssiFileBytes += RSSI_LOG_BLOCK_BYTES;
+        }
+        rssiReady->clear();
+        rssiReadyWritten = 0;
+    }
+    
+    // Angefangenen Block unter dem Lock in rssiBlock kodieren (logRssi()
+    // schreibt gleichzeitig hinein), ohne Lock schreiben
+    RssiFrameEncoder* open;
+    uint16_t count;
+    size_t bytes;
+    {
+        RtosLock lock(rssiMutex);
+        count = rssiCurrent->getSampleCount();
+        if (!rssiReady->isEmpty() || count == rssiCurrentWritten ||
+            (!force && millis() - rssiFirstMs < LOG_RSSI_FLUSH_MS)) {
+            return ok;
+        }
+        bytes = rssiCurrent->finish(rssiBlock);
+        open = rssiCurrent;
+    }
+    bool written = writeRssiBlock(bytes);
+    
+    // Ist der Block inzwischen voll geworden, ist er jetzt rssiReady
+    RtosLock lock(rssiMutex);
+    uint16_t& done = open == rssiCurrent ? rssiCurrentWritten : rssiReadyWritten;
+    if (written) {
+        if (done == 0) {
+            logStats.rssiBlocks++;
+        }
+        done = count;
+    } else {
+        logStats.writeErrors++;
+        if (force) {
+            logStats.rssiDropped += count - done;
+        }
+    }
+    rssiFirstMs = millis();
+    return ok && written;
+}
+
+// rssiBlock (bytes davon) an rssiFileBytes schreiben, "r+" überschreibt
+// einen dort schon stehenden Stand des Blocks
+bool DataLogger::writeRssiBlock(size_t bytes) {
+    File file = SD.open(rssiFile.c_str(), LOG_FILE_UPDATE);
+    bool ok = file && file.seek(rssiFileBytes) && file.write(rssiBlock, bytes) == bytes;
+    file.close();
+    if (!ok) {
+        Serial.printf("[DataLogger] ERROR: Failed to write telemetry: %s\n", rssiFile.c_str());
+    }
+    return ok;
+}
+
+// ============================================================
+// Vorbelegung
+// ============================================================
+
+// Datei mit Nullen auf bytes verlängern. Belegt alle Cluster auf einmal
+// (FAT-Suche und -Update nur hier), Null-Datensätze gelten im Log als leer
+bool DataLogger::preallocate(File& file, uint32_t bytes) {
+    uint32_t start = micros();
+    memset(logBuffer, 0, sizeof(logBuffer));
+    uint32_t size = fileBytes;
+    while (size < bytes) {
+        size_t chunk = bytes - size < sizeof(logBuffer) ? bytes - size : sizeof(logBuffer);
+        size_t written = file.write((const uint8_t*)logBuffer, chunk);
+        size += written;
+        if (written != chunk) {
+            break;
+        }
+    }
+    fileReserved = size;
+    logStats.preallocBytes = size - fileBytes;
+    logStats.preallocUs = micros() - start;
     
+    if (size < bytes) {
+        // Karte voll: mit dem belegten Teil weitermachen, danach wird angehängt
+        Serial.printf("[DataLogger] WARNING: Preallocated only %lu of %lu bytes\n",
+                      (unsigned long)size, (unsigned long)bytes);
+        return false;
+    }
+    Serial.printf("[DataLogger] Preallocated %lu bytes in %lu ms\n",
+                  (unsigned long)logStats.preallocBytes, (unsigned long)(logStats.preallocUs / 1000));
     return true;
 }
 
+// Puffer schreiben und die ungenutzte Vorbelegung abschneiden
+bool DataLogger::closeRaceFile() {
+    if (currentRaceFile.isEmpty()) {
+        return true;
+    }
+    
+    bool ok = flushLog();
+    if (!ok) {
+        Serial.printf("[DataLogger] ERROR: %u laps could not be written\n", pendingRecords);
+    }
+    
+    if (fileReserved > fileBytes) {
+        if (truncateFile(currentRaceFile, fileBytes)) {
+            fileReserved = fileBytes;
+        } else {
+            // Bleibt lesbar: LapLogReader überspringt die Null-Datensätze
+            Serial.printf("[DataLogger] ERROR: Failed to truncate %s\n", currentRaceFile.c_str());
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+bool DataLogger::truncateFile(const String& path, uint32_t size) {
+    // Arduino-File kann nicht kürzen, POSIX über das VFS schon
+#ifdef NATIVE_BUILD
+    std::string fullPath = SD.hostPath(path.c_str());
+#else
+    String fullPath = String(LOG_MOUNT_POINT) + path;
+#endif
+    return truncate(fullPath.c_str(), size) == 0;
+}
+
+// ============================================================
+// Speicherplatz und Aufräumen
+// ============================================================
+
+// Log wie bei der Vorbelegung (eine Runde pro Team alle LOG_PREALLOC_LAP_MS),
+// dazu .sum, Textzusammenfassung und Telemetrie (2 Bytes pro Advertisement)
+uint32_t DataLogger::estimateRaceBytes(uint16_t teamCount, uint32_t durationMs) {
+    if (teamCount > LAP_LOG_MAX_TEAMS) {
+        teamCount = LAP_LOG_MAX_TEAMS;
+    }
+    if (durationMs == 0) {
+        durationMs = LOG_BUDGET_DEFAULT_MS;
+    }
+    uint64_t records = (uint64_t)teamCount * durationMs / LOG_PREALLOC_LAP_MS;
+    uint64_t bytes = sizeof(LapLogHeader) + teamCount * sizeof(LapLogTeam) +
+                     records * sizeof(LapLogRecord) +
+                     sizeof(RaceSummaryHeader) + teamCount * sizeof(RaceSummaryEntry) +
+                     LOG_SECTOR_BYTES;
+#if LOG_RSSI_ENABLED
+    bytes += (uint64_t)teamCount * durationMs / LOG_RSSI_SAMPLE_MS * 2 + RSSI_LOG_BLOCK_BYTES;
+#endif
+    return bytes > UINT32_MAX ? UINT32_MAX : (uint32_t)bytes;
+}
+
+void DataLogger::setRetention(uint16_t maxRaces, uint64_t maxBytes) {
+    retainRaces = maxRaces;
+    retainBytes = maxBytes;
+}
+
+bool DataLogger::setRacePinned(const String& racePath, bool pinned) {
+    RtosLock lock(storeMutex);
+    return initialized && raceCatalog.setPinned(racePath, pinned);
+}
+
+bool DataLogger::needsPruning() {
+    if (retainRaces > 0 && raceCatalog.getUnpinnedCount() > retainRaces) {
+        return true;
+    }
+    if (retainBytes > 0 && raceCatalog.getUnpinnedBytes() > retainBytes) {
+        return true;
+    }
+    
+    // Der Rest des laufenden Rennens muss noch auf die Karte passen
+    uint32_t remaining = 0;
+    if (!currentRaceFile.isEmpty() && logStats.raceBudgetBytes > fileReserved) {
+        remaining = logStats.raceBudgetBytes - fileReserved;
+    }
+    return getFreeSpace() < remaining + LOG_MIN_FREE_BYTES;
+}
+
+// Höchstens ein Rennen pro Aufruf, nie mit gepufferten Runden dazwischen
+bool DataLogger::pruneIfDue() {
+    if (!initialized || millis() - lastPruneMs < LOG_PRUNE_INTERVAL_MS) {
+        return true;
+    }
+    lastPruneMs = millis();
+    RtosLock lock(storeMutex);
+    if (pendingRecords > 0 || !needsPruning()) {
+        return true;
+    }
+    return pruneOldestRace();
+}
+
+bool DataLogger::pruneOldestRace() {
+    RaceCatalogEntry entry;
+    if (!raceCatalog.findOldestUnpinned(entry, currentRaceId)) {
+        return false;
+    }
+    
+    uint32_t start = micros();
+    String path = RaceCatalog::racePath(entry);
+    uint32_t files = deleteRaceFiles(path);
+    bool removed = raceCatalog.removeRace(path);
+    uint32_t elapsed = micros() - start;
+    
+    logStats.prunedRaces++;
+    if (elapsed > logStats.maxPruneUs) {
+        logStats.maxPruneUs = elapsed;
+    }
+    Serial.printf("[DataLogger] Pruned %s (%lu files, %lu KB) in %lu ms\n", path.c_str(),
+                  (unsigned long)files, (unsigned long)(entry.logBytes / 1024), (unsigned long)(elapsed / 1000));
+    return removed;
+}
+
+// Log und alles, was daneben zum Rennen gehört
+uint32_t DataLogger::deleteRaceFiles(const String& racePath) {
+    String base = racePath.substring(0, racePath.lastIndexOf('.'));
+    String paths[] = {
+        racePath,
+        RaceResults::summaryPath(racePath),
+        base + "_summary.txt",
+        base + ".csv",          // Export, bei einer älteren CSV schon racePath
+        rssiPath(racePath),
+    };
+    uint32_t deleted = 0;
+    for (const String& path : paths) {
+        if (SD.exists(path.c_str()) && SD.remove(path.c_str())) {
+            deleted++;
+        }
+    }
+    return deleted;
+}
+
 uint64_t DataLogger::getFreeSpace() {
     if (!initialized) {
         return 0;
@@ -246,50 +853,154 @@ bool DataLogger::formatSD() {
     
     Serial.println("[DataLogger] WARNING: Formatting SD card - ALL DATA WILL BE LOST!");
     
-    // Close any open files
+    // Logger-Task (logLap, flushIfDue, pruneIfDue) wartet, bis alles neu steht
+    RtosLock lock(storeMutex);
+    
+    // Close any open files, gepufferte Runden und Telemetrie verwerfen
+    {
+        RtosLock rssiLock(rssiMutex);
+        rssiActive = false;
+        if (rssiBlock) {
+            rssiCurrent->clear();
+            rssiReady->clear();
+        }
+        rssiFileBytes = 0;
+        rssiCurrentWritten = 0;
+        rssiReadyWritten = 0;
+    }
+    rssiFile = "";
     currentRaceFile = "";
+    currentRaceId = 0;
+    pendingBytes = 0;
+    pendingRecords = 0;
+    fileBytes = 0;
+    fileReserved = 0;
     
-    // Note: ESP32 SD library doesn't support format directly
-    // We need to use SDFat library or delete all files
-    // For now, we'll delete all files in /races directory
+    formatStats.writeKBpsBefore = measureWriteSpeed(LOG_SPEED_TEST_BYTES);
     
-    File root = SD.open("/");
-    if (!root) {
-        Serial.println("[DataLogger] ERROR: Cannot open root directory");
-        return false;
+    // Neues Dateisystem statt jede Datei einzeln zu löschen (jedes remove
+    // schreibt FAT und Verzeichnis, bei hunderten Rennen Minuten)
+    uint32_t start = millis();
+    formatStats.mkfs = formatCard();
+    if (!initialized) {
+        return false;   // Karte nach mkfs nicht wieder eingebunden
     }
+    if (!formatStats.mkfs) {
+        Serial.println("[DataLogger] WARNING: mkfs failed, deleting files instead");
+        uint32_t deleted = deleteAllFiles("/");
+        Serial.printf("[DataLogger] Deleted %lu files\n", (unsigned long)deleted);
+    }
+    formatStats.formatMs = millis() - start;
     
-    // Delete all files recursively
-    deleteAllFiles("/");
-    
-    // Recreate races directory
+    // Verzeichnis und Katalog gleich am Anfang der leeren Karte anlegen
     if (!SD.exists("/races")) {
         SD.mkdir("/races");
     }
+    raceCatalog.rebuild();
+    raceCatalog.reserve(LOG_FORMAT_CATALOG_RACES);
     
-    Serial.println("[DataLogger] SD card 'formatted' (all files deleted)");
+    formatStats.writeKBpsAfter = measureWriteSpeed(LOG_SPEED_TEST_BYTES);
+    
+    Serial.printf("[DataLogger] SD card %s in %lu ms, write %lu -> %lu KB/s\n",
+                  formatStats.mkfs ? "formatted" : "cleared", (unsigned long)formatStats.formatMs,
+                  (unsigned long)formatStats.writeKBpsBefore, (unsigned long)formatStats.writeKBpsAfter);
     return true;
 }
 
-void DataLogger::deleteAllFiles(const String& dirPath) {
+// FAT32 mit LOG_FORMAT_CLUSTER_BYTES anlegen und die Karte neu einbinden.
+// Nur FM_FAT32: ist die Karte dafür zu klein, scheitert f_mkfs und
+// formatSD() löscht stattdessen die Dateien
+bool DataLogger::formatCard() {
+#ifdef NATIVE_BUILD
+    return SD.hostFormat();
+#else
+    // Karte aushängen und ohne Volume selbst beim Kartentreiber anmelden,
+    // das FatFs-Laufwerk liefert sdcard_init()
+    SD.end();
+    FRESULT result = FR_NOT_READY;
+    uint8_t pdrv = sdcard_init(csPin, &SPI, LOG_FORMAT_SPI_HZ);
+    if (pdrv != 0xFF) {
+        char drive[3] = {(char)('0' + pdrv), ':', 0};
+        void* work = malloc(LOG_FORMAT_WORK_BYTES);
+        if (work) {
+            MKFS_PARM options = {FM_FAT32, 0, 0, 0, LOG_FORMAT_CLUSTER_BYTES};
+            result = f_mkfs(drive, &options, work, LOG_FORMAT_WORK_BYTES);
+            free(work);
+        } else {
+            result = FR_NOT_ENOUGH_CORE;
+        }
+        sdcard_uninit(pdrv);
+    }
+    if (result != FR_OK) {
+        Serial.printf("[DataLogger] ERROR: f_mkfs failed (%d)\n", (int)result);
+    }
+    
+    // SD.begin() bindet VFS und Volume wie beim Start neu ein
+    if (!SD.begin(csPin)) {
+        Serial.println("[DataLogger] ERROR: SD card remount failed");
+        initialized = false;
+        return false;
+    }
+    return result == FR_OK;
+#endif
+}
+
+// Schreibrate in KB/s: bytes Nullen in Blöcken von LOG_BATCH_BYTES in eine
+// neue Datei, danach wieder löschen. 0 = aus oder Fehler
+uint32_t DataLogger::measureWriteSpeed(uint32_t bytes) {
+    if (bytes == 0) {
+        return 0;
+    }
+    File file = SD.open("/speedtest.tmp", FILE_WRITE);
+    if (!file) {
+        return 0;
+    }
+    
+    memset(logBuffer, 0, sizeof(logBuffer));
+    uint32_t start = micros();
+    uint32_t size = 0;
+    while (size < bytes) {
+        size_t chunk = bytes - size < sizeof(logBuffer) ? bytes - size : sizeof(logBuffer);
+        if (file.write((const uint8_t*)logBuffer, chunk) != chunk) {
+            break;
+        }
+        size += chunk;
+    }
+    file.close();
+    uint32_t elapsed = micros() - start;
+    SD.remove("/speedtest.tmp");
+    
+    if (size < bytes || elapsed == 0) {
+        return 0;
+    }
+    return (uint32_t)((uint64_t)size * 1000000 / elapsed / 1024);
+}
+
+// Ohne Ausgabe pro Datei (Serial kostet bei hunderten Rennen mehr als das
+// Löschen), Rückgabe: gelöschte Dateien
+uint32_t DataLogger::deleteAllFiles(const String& dirPath) {
     File dir = SD.open(dirPath.c_str());
     if (!dir || !dir.isDirectory()) {
-        return;
+        return 0;
     }
     
+    uint32_t deleted = 0;
     File file = dir.openNextFile();
     while (file) {
-        String filePath = String(file.name());
-        if (file.isDirectory()) {
-            deleteAllFiles(filePath);
+        // name() ist seit Core 2.x nur der Dateiname
+        String filePath = String(file.path());
+        bool isDir = file.isDirectory();
+        file.close();
+        if (isDir) {
+            deleted += deleteAllFiles(filePath);
             SD.rmdir(filePath.c_str());
-        } else {
-            SD.remove(filePath.c_str());
-            Serial.printf("[DataLogger] Deleted: %s\n", filePath.c_str());
+        } else if (SD.remove(filePath.c_str())) {
+            deleted++;
         }
         file = dir.openNextFile();
     }
     dir.close();
+    return deleted;
 }
 
 String DataLogger::getRaceFileList(uint8_t maxFiles) {
@@ -297,59 +1008,117 @@ String DataLogger::getRaceFileList(uint8_t maxFiles) {
         return "";
     }
     
-    String fileList = "";
-    File dir = SD.open("/races");
-    if (!dir || !dir.isDirectory()) {
-        return "";
+    // Neueste zuerst direkt aus dem Katalog, kein Aufzählen und Sortieren.
+    // getPage() räumt dabei fehlende Dateien aus, daher unter storeMutex
+    std::vector<RaceCatalogEntry> races;
+    {
+        RtosLock lock(storeMutex);
+        raceCatalog.getPage(0, maxFiles, races);
     }
     
-    // Collect all CSV files with their timestamps
-    struct FileInfo {
-        String name;
-        unsigned long timestamp;
-    };
-    
-    // Use simple array (max 20 files)
-    FileInfo files[20];
-    uint8_t fileCount = 0;
+    String fileList = "";
+    for (size_t i = 0; i < races.size(); i++) {
+        if (i > 0) fileList += "\n";
+        fileList += races[i].file;
+    }
     
-    File file = dir.openNextFile();
-    while (file && fileCount < 20) {
-        String fileName = String(file.name());
-        if (fileName.endsWith(".csv")) {
-            files[fileCount].name = fileName;
-            files[fileCount].timestamp = file.getLastWrite();
-            fileCount++;
-        }
-        file = dir.openNextFile();
+    return fileList;
+}
+
+bool DataLogger::loadRaceResults(const String& racePath, RaceResults& results) {
+    if (!initialized) {
+        return false;
+    }
+    return results.loadRace(SD, racePath);
+}
+
+bool DataLogger::exportRaceCSV(const String& logPath, const String& csvPath) {
+    if (!initialized) {
+        return false;
     }
-    dir.close();
     
-    // Sort by timestamp (newest first) - simple bubble sort
-    for (uint8_t i = 0; i < fileCount - 1; i++) {
-        for (uint8_t j = 0; j < fileCount - i - 1; j++) {
-            if (files[j].timestamp < files[j + 1].timestamp) {
-                FileInfo temp = files[j];
-                files[j] = files[j + 1];
-                files[j + 1] = temp;
-            }
-        }
+    File log = SD.open(logPath.c_str(), FILE_READ);
+    LapLogReader reader(log);
+    if (!log || !reader.begin()) {
+        Serial.printf("[DataLogger] ERROR: Not a lap log: %s\n", logPath.c_str());
+        return false;
+    }
+    File csv = SD.open(csvPath.c_str(), FILE_WRITE);
+    if (!csv) {
+        Serial.printf("[DataLogger] ERROR: Failed to open file: %s\n", csvPath.c_str());
+        return false;
     }
     
-    // Build result list
-    uint8_t count = (fileCount < maxFiles) ? fileCount : maxFiles;
-    for (uint8_t i = 0; i < count; i++) {
-        if (i > 0) fileList += "\n";
-        fileList += files[i].name;
+    // Zeilen sammeln und in Sektorblöcken schreiben
+    char block[LOG_SECTOR_BYTES];
+    size_t used = strlen(LAP_LOG_CSV_HEADER);
+    memcpy(block, LAP_LOG_CSV_HEADER, used);
+    bool ok = true;
+    uint32_t lines = 0;
+    LapLogRecord record;
+    while (ok && reader.next(record)) {
+        char line[LAP_LOG_CSV_LINE_MAX];
+        size_t length = lapLogFormatCsv(line, sizeof(line), record, reader.getTeamId(record),
+                                        reader.getTeamName(record), reader.getHeader().startTime);
+        if (used + length > sizeof(block)) {
+            ok = csv.write((const uint8_t*)block, used) == used;
+            used = 0;
+        }
+        memcpy(block + used, line, length);
+        used += length;
+        lines++;
     }
+    ok = ok && csv.write((const uint8_t*)block, used) == used;
+    csv.close();
+    log.close();
     
-    return fileList;
+    Serial.printf("[DataLogger] Exported %lu laps to %s (%lu bad records skipped)%s\n",
+                  (unsigned long)lines, csvPath.c_str(), (unsigned long)reader.getBadRecords(),
+                  ok ? "" : " - WRITE FAILED");
+    return ok;
 }
 
 // ============================================================
 // Private Helper
 // ============================================================
 
+// Größe und CRC-32 des Runden-Logs fortschreiben (Bytes in Schreibreihenfolge)
+void DataLogger::trackRaceBytes(const void* data, size_t length) {
+    raceFileChecksum = crc32Update(raceFileChecksum, data, length);
+    raceFileSize += length;
+}
+
+bool DataLogger::writeRaceSummary() {
+    String path = RaceResults::summaryPath(currentRaceFile);
+    
+    // Mitgezählt passt nur, wenn die Datei genau das enthält, was wir geschrieben haben
+    File log = SD.open(currentRaceFile.c_str(), FILE_READ);
+    if (!log) {
+        return false;
+    }
+    bool tracked = raceStatsValid && log.size() == raceFileSize;
+    log.close();
+    
+    if (!tracked) {
+        // Sonst einmal durch das Log streamen, legt die .sum gleich mit an
+        RaceResults rebuilt;
+        bool ok = rebuilt.loadRace(SD, currentRaceFile);
+        Serial.printf("[DataLogger] Summary rebuilt from log: %s\n", ok ? path.c_str() : "FAILED");
+        return ok;
+    }
+    
+    File out = SD.open(path.c_str(), FILE_WRITE);
+    if (!out) {
+        Serial.printf("[DataLogger] ERROR: Failed to open file: %s\n", path.c_str());
+        return false;
+    }
+    bool ok = raceStats.writeSummary(out, raceFileSize, raceFileChecksum);
+    out.close();
+    Serial.printf("[DataLogger] Summary: %s (%u teams, %lu laps)\n", path.c_str(),
+                  raceStats.getTeamCount(), (unsigned long)raceStats.getLapCount());
+    return ok;
+}
+
 String DataLogger::sanitizeFilename(const String& name) {
     String clean = name;
     
@@ -374,7 +1143,7 @@ String DataLogger::sanitizeFilename(const String& name) {
 }
 
 String DataLogger::generateRaceFilename(const String& raceName) {
-    // Format: /races/YYYYMMDD_HHMMSS_RaceName.csv
+    // Format: /races/YYYYMMDD_HHMMSS_RaceName.lap
     
     // Timestamp (falls RTC verfügbar, sonst millis())
     uint32_t timestamp = millis() / 1000;
@@ -384,11 +1153,18 @@ String DataLogger::generateRaceFilename(const String& raceName) {
     
     // Datum generieren (Platzhalter ohne RTC)
     char filename[64];
-    sprintf(filename, "/races/%08lu_%02lu%02lu%02lu_%s.csv",
+    String base = "/races/";
+    sprintf(filename, "%08lu_%02lu%02lu%02lu_%s",
             timestamp, hours, minutes, seconds,
             sanitizeFilename(raceName).c_str());
+    base += filename;
     
-    return String(filename);
+    // Das Log beginnt mit einem Header, nie an eine bestehende Datei anhängen
+    String path = base + ".lap";
+    for (uint8_t n = 2; SD.exists(path.c_str()) && n < 100; n++) {
+        path = base + "_" + String(n) + ".lap";
+    }
+    return path;
 }
 
 
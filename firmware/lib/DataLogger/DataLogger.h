@@ -4,14 +4,171 @@
 #include <Arduino.h>
 #include <SD.h>
 #include <FS.h>
+#include <functional>
+#include "RaceResults.h"
+#include "LapLog.h"
+#include "RaceCatalog.h"
+#include "RssiLog.h"
+#include "Diagnostics.h"
+#include "RtosCompat.h"
 
 /**
  * Data Logger für SD-Karte
  * 
  * Loggt Rennendaten, Rundenzeiten, Telemetrie auf SD-Karte
  * Beide Varianten (FullBlown & UltraLight) nutzen diese Library
+ *
+ * Rennen landen als binäres Runden-Log in /races/<...>.lap (Format siehe
+ * LapLog.h): Header mit Teamtabelle bei startNewRace(), dann ein 24-Byte-
+ * Datensatz pro Runde. CSV gibt es nur noch als Export (exportRaceCSV()).
+ * Die Rennliste kommt aus dem Katalog (RaceCatalog.h), den startNewRace(),
+ * finishRace() und deleteFile() fortschreiben und begin() bei Bedarf neu
+ * aufbaut.
+ *
+ * Runden werden nicht einzeln geschrieben (open/print/close kostet pro
+ * Runde zig ms), sondern im RAM gesammelt und in Blöcken angehängt:
+ * - Puffer voll: nur bis zur nächsten 512-Byte-Grenze der Datei schreiben,
+ *   der Rest bleibt im Puffer (ganze Sektoren, kein Read-Modify-Write)
+ * - Haltbarkeit: spätestens nach LOG_FLUSH_RECORDS Runden oder LOG_FLUSH_MS
+ *   alles schreiben (flushIfDue() aus dem Logger-Task bzw. loop())
+ * - finishRace() schreibt immer alles, bevor die Zusammenfassung entsteht
+ * Bei einem Stromausfall gehen höchstens die ungeschriebenen Runden verloren.
+ *
+ * Vorbelegung: Jeder Schreibzugriff, der die Datei über ihren letzten
+ * Cluster hinaus verlängert, sucht in der FAT einen freien Cluster und
+ * schreibt FAT-Kette und Verzeichniseintrag - auf vollen oder fragmentierten
+ * Karten Ausreißer von 100+ ms mitten im Rennen. Mit bekannter Renndauer
+ * legt startNewRace() die Datei deshalb gleich in voller Länge an (Teams x
+ * Dauer / LOG_PREALLOC_LAP_MS Datensätze, mit Nullen gefüllt), die Runden
+ * überschreiben danach nur noch belegte Sektoren ("r+" an fileBytes).
+ * finishRace() kürzt auf die echte Länge; nach einem Stromausfall bleiben
+ * Null-Datensätze am Ende, die LapLogReader als ungenutzt überspringt.
+ *
+ * Speicherplatz: startNewRace() schätzt den Bedarf des Rennens (wie die
+ * Vorbelegung, ohne Renndauer LOG_BUDGET_DEFAULT_MS) und löscht alte
+ * Rennen, bis er plus LOG_MIN_FREE_BYTES frei ist. Während des Rennens
+ * hält pruneIfDue() die Aufräumregel ein (höchstens LOG_RETAIN_RACES
+ * Rennen bzw. LOG_RETAIN_BYTES Logs, angeheftete zählen nicht und bleiben)
+ * und den Platz für den Rest des Rennens frei - ein Rennen pro
+ * LOG_PRUNE_INTERVAL_MS, aus dem Logger-Task, wenn keine Runden anstehen.
+ *
+ * Formatieren: formatSD() legt mit f_mkfs ein neues FAT32 an (Cluster
+ * LOG_FORMAT_CLUSTER_BYTES, groß für lange angehängte Logs) statt jede
+ * Datei einzeln zu löschen - Sekunden statt Minuten bei vielen Rennen, und
+ * danach ist die Karte nicht mehr fragmentiert. Anschließend entstehen
+ * /races und der Katalog mit Platz für LOG_FORMAT_CATALOG_RACES Einträge
+ * neu. Dauer und Schreibrate vorher/nachher stehen in getFormatStats().
+ * formatSD() hält storeMutex die ganze Zeit, der Logger-Task schreibt
+ * solange nichts.
+ *
+ * RSSI-Telemetrie: logRssi() nimmt im Rennen jedes Advertisement eines
+ * Teams auf (aus dem Lap-Task, O(1) unter eigenem Lock) und kodiert es
+ * sofort in einen 4-KB-Block (Format siehe RssiLog.h, unter 2 Bytes pro
+ * Sample). Volle Blöcke wandern in einen zweiten Puffer, den flushIfDue()
+ * im Logger-Task an <rennen>.rssi anhängt. Den angefangenen schreibt er
+ * spätestens nach LOG_RSSI_FLUSH_MS und bei finishRace() nur so lang wie
+ * sein Inhalt dahinter und überschreibt ihn dort, bis er voll ist. Ist der
+ * zweite Puffer bei vollem Block noch nicht geschrieben, gehen Samples
+ * verloren (rssiDropped), der Lap-Task wartet nie auf die Karte.
  */
 
+// In config.h überschreibbar
+#ifndef LOG_BATCH_BYTES
+#define LOG_BATCH_BYTES 2048        // Rundenpuffer, Vielfaches von LOG_SECTOR_BYTES
+#endif
+#ifndef LOG_FLUSH_RECORDS
+#define LOG_FLUSH_RECORDS 16        // Spätestens nach N Runden schreiben, 1 = jede sofort
+#endif
+#ifndef LOG_FLUSH_MS
+#define LOG_FLUSH_MS 2000           // Spätestens T ms nach der ältesten ungeschriebenen Runde
+#endif
+
+#ifndef LOG_PREALLOC_LAP_MS
+#define LOG_PREALLOC_LAP_MS 10000   // Kürzeste erwartete Runde (wie MIN_LAP_TIME)
+#endif
+#ifndef LOG_PREALLOC_MAX_BYTES
+#define LOG_PREALLOC_MAX_BYTES (512UL * 1024)
+#endif
+
+#ifndef LOG_RETAIN_RACES
+#define LOG_RETAIN_RACES 100        // Nicht angeheftete Rennen behalten, 0 = unbegrenzt
+#endif
+#ifndef LOG_RETAIN_BYTES
+#define LOG_RETAIN_BYTES (64ULL * 1024 * 1024)  // Logs nicht angehefteter Rennen, 0 = unbegrenzt
+#endif
+#ifndef LOG_MIN_FREE_BYTES
+#define LOG_MIN_FREE_BYTES (1024ULL * 1024)     // Immer frei (Zusammenfassung, Export, Katalog)
+#endif
+#ifndef LOG_BUDGET_DEFAULT_MS
+#define LOG_BUDGET_DEFAULT_MS (60UL * 60 * 1000)  // Renndauer für die Schätzung, wenn unbekannt
+#endif
+#ifndef LOG_PRUNE_INTERVAL_MS
+#define LOG_PRUNE_INTERVAL_MS 1000  // Höchstens ein Rennen pro Intervall im Hintergrund löschen
+#endif
+
+#ifndef LOG_RSSI_ENABLED
+#define LOG_RSSI_ENABLED 1          // RSSI-Telemetrie (im Rennen ~22 KB Heap), 0 = aus
+#endif
+#ifndef LOG_RSSI_FLUSH_MS
+#define LOG_RSSI_FLUSH_MS 10000     // Neue Samples spätestens nach T ms schreiben
+#endif
+#ifndef LOG_RSSI_SAMPLE_MS
+#define LOG_RSSI_SAMPLE_MS 100      // Advertising-Intervall, nur für die Platzschätzung
+#endif
+
+#ifndef LOG_FORMAT_CLUSTER_BYTES
+#define LOG_FORMAT_CLUSTER_BYTES 32768  // Cluster bei formatSD(), 0 = Standard von f_mkfs
+#endif
+#ifndef LOG_FORMAT_CATALOG_RACES
+#define LOG_FORMAT_CATALOG_RACES 256    // Katalogeinträge nach formatSD() vorbelegen, 0 = keine
+#endif
+#ifndef LOG_FORMAT_WORK_BYTES
+#define LOG_FORMAT_WORK_BYTES 16384     // Arbeitspuffer für f_mkfs (Heap, nur währenddessen)
+#endif
+#ifndef LOG_FORMAT_SPI_HZ
+#define LOG_FORMAT_SPI_HZ 4000000       // SPI-Takt für f_mkfs, wie SD.begin()
+#endif
+#ifndef LOG_SPEED_TEST_BYTES
+#define LOG_SPEED_TEST_BYTES (256UL * 1024)   // Schreibtest vor/nach formatSD(), 0 = aus
+#endif
+
+#define LOG_SECTOR_BYTES 512
+#define LOG_MOUNT_POINT "/sd"       // VFS-Pfad der Karte (Standard von SD.begin())
+
+#define FILE_STREAM_TO_END 0xFFFFFFFFUL     // streamFile(): bis zum Dateiende
+
+// Ein Block aus streamFile(): data zeigt in den Puffer des Aufrufers und gilt
+// nur während des Aufrufs, offset = Position in der Datei. false = abbrechen
+typedef std::function<bool(const uint8_t* data, size_t length, uint32_t offset)> FileBlockVisitor;
+
+// Zähler des Rundenpuffers
+struct LogStats {
+    uint32_t records;           // Gepufferte Runden
+    uint32_t flushes;           // Schreibvorgänge auf die Karte
+    uint32_t bytesWritten;
+    uint32_t fullFlushes;       // Davon ausgelöst durch vollen Puffer
+    uint32_t writeErrors;
+    uint32_t droppedRecords;    // Puffer voll und Karte schreibt nicht
+    uint16_t maxPendingBytes;   // Höchster Füllstand
+    uint32_t maxFlushUs;
+    uint32_t preallocBytes;     // Vorbelegt beim letzten startNewRace()
+    uint32_t preallocUs;        // Dauer der Vorbelegung
+    uint32_t raceBudgetBytes;   // Geschätzter Bedarf des laufenden Rennens
+    uint32_t prunedRaces;       // Automatisch gelöschte Rennen
+    uint32_t maxPruneUs;        // Längster Löschvorgang
+    uint32_t rssiSamples;       // Aufgenommene RSSI-Samples
+    uint32_t rssiBlocks;        // Geschriebene Telemetrie-Blöcke
+    uint32_t rssiDropped;       // Puffer voll oder Block nicht geschrieben
+};
+
+// Letztes formatSD()
+struct FormatStats {
+    bool mkfs;                  // false: f_mkfs fehlgeschlagen, Dateien einzeln gelöscht
+    uint32_t formatMs;          // Formatieren bzw. Löschen, ohne Schreibtests
+    uint32_t writeKBpsBefore;   // Schreibrate vorher (LOG_SPEED_TEST_BYTES), 0 = nicht gemessen
+    uint32_t writeKBpsAfter;
+};
+
 class DataLogger {
 public:
     DataLogger();
@@ -24,6 +181,16 @@ public:
     // File Operations
     bool writeFile(const String& path, const String& data, bool append = true);
     String readFile(const String& path);
+    File openFile(const String& path);  // Lesen in Blöcken, z.B. mit CsvReader
+    
+    // Bytes [offset, offset + length) blockweise in buffer lesen und jeden
+    // Block an visitor geben, ohne die Datei im RAM zu halten. Für Downloads
+    // mit Fortsetzen (HTTP Range). false: Datei fehlt, offset hinter dem Ende,
+    // Lesefehler oder visitor hat abgebrochen; streamed = gelieferte Bytes
+    bool streamFile(const String& path, uint8_t* buffer, size_t bufferSize,
+                    const FileBlockVisitor& visitor, uint32_t offset = 0,
+                    uint32_t length = FILE_STREAM_TO_END, uint32_t* streamed = nullptr);
+    uint32_t getFileSize(const String& path);   // 0 wenn nicht vorhanden
     bool deleteFile(const String& path);
     bool exists(const String& path);
     
@@ -31,31 +198,121 @@ public:
     bool logCSV(const String& filename, const String& data);
     bool createCSVHeader(const String& filename, const String& header);
     
-    // Race Data
-    bool startNewRace(const String& raceName);
+    // Race Data (Teams ohne Tabelleneintrag werden mit ihrer ID geloggt).
+    // durationMs > 0: Datei für so ein langes Rennen vorbelegen
+    bool startNewRace(const String& raceName, const LapLogTeam* teams = nullptr, uint16_t teamCount = 0,
+                      uint32_t durationMs = 0);
     bool logLap(uint8_t teamId, const String& teamName, uint16_t lapNumber, 
                 uint32_t timestamp, uint32_t duration);
-    bool finishRace();
+    bool finishRace();  // Schreibt den Puffer und die Zusammenfassung (.sum, siehe RaceResults)
+    
+    // RSSI-Telemetrie des laufenden Rennens, aus jedem Task aufrufbar.
+    // false: kein Rennen, Telemetrie aus oder Sample verworfen.
+    // blockReady: ein voller Block wartet jetzt auf flushIfDue()
+    bool logRssi(uint8_t teamId, uint32_t timestamp, int8_t rssi, bool* blockReady = nullptr);
+    static String rssiPath(const String& racePath);     // race.lap -> race.rssi
+    
+    // Rundenpuffer
+    bool flushLog();                // Alles Gepufferte jetzt schreiben
+    bool flushIfDue();              // Nur wenn LOG_FLUSH_MS abgelaufen
+    uint16_t getPendingRecords() const { return pendingRecords; }
+    const LogStats& getLogStats() const { return logStats; }
+    const LatencyHistogram& getFlushLatency() const { return flushLatency; }
+    void resetLogStats();
+    
+    // Vergangenes Rennen über die Zusammenfassung laden (O(Teams)), fehlt
+    // sie oder ist sie veraltet, wird sie aus dem Log (bzw. der CSV) neu erzeugt
+    bool loadRaceResults(const String& racePath, RaceResults& results);
+    
+    // Runden-Log als CSV exportieren (gleiche Spalten wie die frühere Race-CSV)
+    bool exportRaceCSV(const String& logPath, const String& csvPath);
     
     // Utility
     uint64_t getFreeSpace();
     uint64_t getUsedSpace();
     String listFiles(const String& dir = "/");
     bool formatSD();  // Format SD card to FAT32
+    const FormatStats& getFormatStats() const { return formatStats; }
+    
+    // Aufräumen: Regel zur Laufzeit ändern (0 = unbegrenzt), angeheftete
+    // Rennen werden nie gelöscht. pruneIfDue() aus dem Logger-Task bzw. loop()
+    void setRetention(uint16_t maxRaces, uint64_t maxBytes);
+    bool setRacePinned(const String& racePath, bool pinned);
+    bool pruneIfDue();
     
     // Export
     String getCurrentRaceFile();
-    String getRaceFileList(uint8_t maxFiles = 10);  // Get list of race files
+    String getRaceFileList(uint8_t maxFiles = 10);  // Neueste Rennen aus dem Katalog (.lap, ältere .csv)
+    // Seitenweise, Suche. Läuft die LapPipeline, nur unter getStoreMutex()
+    RaceCatalog& getRaceCatalog() { return raceCatalog; }
+    RtosMutex& getStoreMutex() { return storeMutex; }
     
 private:
     bool initialized;
+    uint8_t csPin;              // Für das Neu-Einbinden nach formatSD()
     String currentRaceFile;
     uint32_t raceStartTime;
+    uint32_t currentRaceId;     // ID im Katalog, 0 = nicht eingetragen
+    RaceCatalog raceCatalog;
+    // Katalog und /races ändern der Logger-Task (Rennen, Runden, Aufräumen)
+    // und die UI (Liste, Löschen, Anheften, Formatieren) - beide nur unter
+    // storeMutex (rekursiv)
+    RtosMutex storeMutex;
+    uint16_t retainRaces;
+    uint64_t retainBytes;
+    uint32_t lastPruneMs;
+    
+    // Beim Loggen mitgezählt, damit finishRace() das Log nicht neu lesen muss
+    RaceResults raceStats;
+    uint32_t raceFileSize;
+    uint32_t raceFileChecksum;
+    bool raceStatsValid;    // false: Schreibfehler
+    
+    uint8_t teamSlots[256];     // teamId -> Index in der Teamtabelle, LAP_LOG_MAX_TEAMS = keiner
+    
+    char logBuffer[LOG_BATCH_BYTES];
+    uint16_t pendingBytes;
+    uint16_t pendingRecords;
+    uint32_t firstPendingMs;
+    uint32_t fileBytes;     // Bereits geschriebene Bytes des Runden-Logs (für die Sektorgrenze)
+    uint32_t fileReserved;  // Dateilänge inkl. Vorbelegung, > fileBytes bis finishRace()
+    LogStats logStats;
+    LatencyHistogram flushLatency;  // Pro Schreibvorgang (open, write, close)
+    FormatStats formatStats;
+    
+    // RSSI-Telemetrie: rssiCurrent füllt logRssi(), rssiReady schreibt der
+    // Logger-Task; beide und rssiActive nur unter rssiMutex
+    RtosMutex rssiMutex;
+    RssiFrameEncoder* rssiCurrent;
+    RssiFrameEncoder* rssiReady;
+    uint8_t* rssiBlock;
+    String rssiFile;            // Leer = keine Telemetrie
+    bool rssiActive;
+    uint32_t rssiFirstMs;       // millis() beim ersten noch nicht geschriebenen Sample
+    uint32_t rssiFileBytes;     // Volle Blöcke in der Datei, dahinter der angefangene
+    uint16_t rssiCurrentWritten;    // Samples von rssiCurrent schon in der Datei
+    uint16_t rssiReadyWritten;      // dito rssiReady
     
     // Helper
     String sanitizeFilename(const String& name);
     String generateRaceFilename(const String& raceName);
-    void deleteAllFiles(const String& dirPath);
+    uint32_t deleteAllFiles(const String& dirPath);
+    bool formatCard();
+    uint32_t measureWriteSpeed(uint32_t bytes);
+    void trackRaceBytes(const void* data, size_t length);
+    bool writePending(size_t length);
+    bool preallocate(File& file, uint32_t bytes);
+    bool closeRaceFile();
+    bool truncateFile(const String& path, uint32_t size);
+    uint32_t estimateRaceBytes(uint16_t teamCount, uint32_t durationMs);
+    bool needsPruning();
+    bool pruneOldestRace();
+    uint32_t deleteRaceFiles(const String& racePath);
+    bool writeRaceSummary();
+    void openRssiFile();
+    void closeRssiFile();
+    bool writeRssi(bool force);
+    bool writeRssiBlock(size_t bytes);
 };
 
 #endif // DATA_LOGGER_H
@@ -0,0 +1,128 @@
+#include "Diagnostics.h"
+
+Diagnostics diagnostics;
+
+// ============================================================
+// LatencyHistogram
+// ============================================================
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::record(uint32_t us) {
+    uint8_t index = us == 0 ? 0 : 32 - __builtin_clz(us);
+    if (index >= HISTOGRAM_BUCKETS) {
+        index = HISTOGRAM_BUCKETS - 1;
+    }
+    buckets[index]++;
+    count++;
+    totalUs += us;
+    if (us > maxUs) {
+        maxUs = us;
+    }
+}
+
+void LatencyHistogram::reset() {
+    memset(buckets, 0, sizeof(buckets));
+    count = 0;
+    maxUs = 0;
+    totalUs = 0;
+}
+
+uint32_t LatencyHistogram::percentile(uint8_t pct) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    uint32_t target = ((uint64_t)count * pct + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < HISTOGRAM_BUCKETS - 1; i++) {
+        seen += buckets[i];
+        if (seen >= target) {
+            // Nicht über das gemessene Maximum hinaus schätzen
+            uint32_t limit = bucketLimit(i);
+            return limit < maxUs ? limit : maxUs;
+        }
+    }
+    return maxUs;
+}
+
+// ============================================================
+// Diagnostics
+// ============================================================
+
+Diagnostics::Diagnostics() {
+    for (int i = 0; i < DIAG_COUNTER_COUNT; i++) {
+        counters[i] = 0;
+    }
+}
+
+void Diagnostics::recordDraw(uint8_t screen, uint32_t us) {
+    if (screen < DIAG_MAX_SCREENS) {
+        draw[screen].record(us);
+    }
+}
+
+const LatencyHistogram& Diagnostics::getDraw(uint8_t screen) const {
+    return draw[screen < DIAG_MAX_SCREENS ? screen : 0];
+}
+
+const char* Diagnostics::counterName(DiagCounter counter) {
+    switch (counter) {
+        case DIAG_ADVERTS_RECEIVED: return "adverts";
+        case DIAG_ADVERTS_DROPPED:  return "advDrop";
+        case DIAG_LAPS_ACCEPTED:    return "laps";
+        case DIAG_LAPS_REJECTED:    return "lapRej";
+        case DIAG_LOGS_DROPPED:     return "logDrop";
+        case DIAG_DISPLAY_BYTES:    return "dispBytes";
+        default:                    return "?";
+    }
+}
+
+void Diagnostics::printHistogram(const char* name, const LatencyHistogram& histogram) {
+    if (histogram.getCount() == 0) {
+        return;
+    }
+    Serial.printf("[Diag] %-8s n=%-7lu avg=%-6lu p50=%-6lu p99=%-6lu max=%lu\n",
+                  name, (unsigned long)histogram.getCount(),
+                  (unsigned long)histogram.getAverage(),
+                  (unsigned long)histogram.percentile(50),
+                  (unsigned long)histogram.percentile(99),
+                  (unsigned long)histogram.getMax());
+}
+
+void Diagnostics::printReport() {
+    Serial.print("[Diag]");
+    for (int i = 0; i < DIAG_COUNTER_COUNT; i++) {
+        Serial.printf(" %s=%lu", counterName((DiagCounter)i), (unsigned long)counters[i].load());
+    }
+    Serial.println();
+    Serial.println("[Diag] Latenzen in us (p50/p99 = obere Bucket-Grenze)");
+
+    printHistogram("loop", loopTime);
+    printHistogram("jitter", timerJitter);
+    printHistogram("adv>lap", advertToLap);
+    printHistogram("sdWrite", sdWrite);
+    printHistogram("touch", touchToAction);
+
+    char name[12];
+    for (uint8_t screen = 0; screen < DIAG_MAX_SCREENS; screen++) {
+        snprintf(name, sizeof(name), "draw[%u]", screen);
+        printHistogram(name, draw[screen]);
+    }
+}
+
+void Diagnostics::reset() {
+    loopTime.reset();
+    timerJitter.reset();
+    advertToLap.reset();
+    sdWrite.reset();
+    touchToAction.reset();
+    for (uint8_t screen = 0; screen < DIAG_MAX_SCREENS; screen++) {
+        draw[screen].reset();
+    }
+    for (int i = 0; i < DIAG_COUNTER_COUNT; i++) {
+        counters[i] = 0;
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include <Arduino.h>
+#include <atomic>
+
+/**
+ * Laufzeit-Diagnose: Latenz-Histogramme und Zähler
+ *
+ * Feste Buckets in Zweierpotenzen (µs), damit record() nur ein
+ * clz + Inkrement kostet und nie allokiert. Jedes Histogramm hat genau
+ * einen schreibenden Task (loop, Lap-Task bzw. Logger-Task); Lesen aus
+ * der UI ist ohne Lock erlaubt, einzelne Werte können dabei um eine
+ * Messung auseinanderliegen.
+ */
+
+#define HISTOGRAM_BUCKETS 20     // Bucket i: < 2^i µs, letzter = Überlauf (>= ~262 ms)
+#define DIAG_MAX_SCREENS 16
+
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(uint32_t us);
+    void reset();
+
+    uint32_t getCount() const { return count; }
+    uint32_t getMax() const { return maxUs; }
+    uint32_t getAverage() const { return count > 0 ? (uint32_t)(totalUs / count) : 0; }
+    uint32_t getBucket(uint8_t index) const { return index < HISTOGRAM_BUCKETS ? buckets[index] : 0; }
+    // Obere Bucket-Grenze, unter der pct % der Messungen liegen
+    uint32_t percentile(uint8_t pct) const;
+
+    static uint32_t bucketLimit(uint8_t index) { return 1UL << index; }
+
+private:
+    uint32_t buckets[HISTOGRAM_BUCKETS];
+    uint32_t count;
+    uint32_t maxUs;
+    uint64_t totalUs;
+};
+
+enum DiagCounter : uint8_t {
+    DIAG_ADVERTS_RECEIVED,
+    DIAG_ADVERTS_DROPPED,      // Ingest-Queue voll
+    DIAG_LAPS_ACCEPTED,
+    DIAG_LAPS_REJECTED,        // Unter MIN_LAP_TIME
+    DIAG_LOGS_DROPPED,         // Logger-Queue voll
+    DIAG_DISPLAY_BYTES,        // Über SPI ans Display geschobene Bytes (Race-Screen)
+    DIAG_COUNTER_COUNT
+};
+
+class Diagnostics {
+public:
+    Diagnostics();
+
+    LatencyHistogram loopTime;      // Arbeitszeit pro loop()-Durchlauf
+    LatencyHistogram timerJitter;   // Verspätung fälliger Timer
+    LatencyHistogram advertToLap;   // Advertisement empfangen -> Runde gezählt
+    LatencyHistogram sdWrite;       // DataLogger::logLap()
+    LatencyHistogram touchToAction; // Touch-IRQ -> Aktion in loop() ausgeführt
+
+    void recordDraw(uint8_t screen, uint32_t us);
+    const LatencyHistogram& getDraw(uint8_t screen) const;
+
+    void count(DiagCounter counter, uint32_t n = 1) { counters[counter] += n; }
+    uint32_t getCounter(DiagCounter counter) const { return counters[counter]; }
+    static const char* counterName(DiagCounter counter);
+
+    // Kompakter Report über Serial
+    void printReport();
+    void reset();
+
+private:
+    LatencyHistogram draw[DIAG_MAX_SCREENS];
+    std::atomic<uint32_t> counters[DIAG_COUNTER_COUNT];
+
+    static void printHistogram(const char* name, const LatencyHistogram& histogram);
+};
+
+extern Diagnostics diagnostics;
+
+#endif // DIAGNOSTICS_H
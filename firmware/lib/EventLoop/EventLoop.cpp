@@ -0,0 +1,277 @@
+#include "EventLoop.h"
+
+EventLoop::EventLoop()
+    : queue(EVENT_QUEUE_LENGTH)
+    , currentScreen(0)
+    , sleepUs(0)
+    , busyUs(0)
+    , wakeups(0)
+    , droppedEvents(0) {
+    for (int i = 0; i < EVENT_TYPE_COUNT; i++) {
+        pending[i] = false;
+    }
+}
+
+// ============================================================
+// Registrierung
+// ============================================================
+
+int EventLoop::addTimer(const char* name, uint32_t intervalMs, TimerHandler handler,
+                        uint32_t screenMask) {
+    Timer timer;
+    timer.intervalMs = intervalMs;
+    timer.nextDue = millis() + intervalMs;
+    timer.screenMask = screenMask;
+    timer.enabled = true;
+    timer.handler = handler;
+    timer.statsId = addStats(name);
+    timers.push_back(timer);
+    return timers.size() - 1;
+}
+
+void EventLoop::setTimerEnabled(int timerId, bool enabled) {
+    if (timerId < 0 || timerId >= (int)timers.size()) {
+        return;
+    }
+    Timer& timer = timers[timerId];
+    if (enabled && !timer.enabled) {
+        timer.nextDue = millis() + timer.intervalMs;
+    }
+    timer.enabled = enabled;
+}
+
+void EventLoop::setTimerInterval(int timerId, uint32_t intervalMs) {
+    if (timerId < 0 || timerId >= (int)timers.size()) {
+        return;
+    }
+    timers[timerId].intervalMs = intervalMs;
+    timers[timerId].nextDue = millis() + intervalMs;
+}
+
+int EventLoop::on(EventType type, const char* name, EventHandler handler, uint32_t screenMask) {
+    Listener listener;
+    listener.type = type;
+    listener.screenMask = screenMask;
+    listener.handler = handler;
+    listener.statsId = addStats(name);
+    listeners.push_back(listener);
+    return listeners.size() - 1;
+}
+
+int EventLoop::afterDispatch(const char* name, TimerHandler handler) {
+    Hook hook;
+    hook.handler = handler;
+    hook.statsId = addStats(name);
+    hooks.push_back(hook);
+    return hooks.size() - 1;
+}
+
+int EventLoop::addStats(const char* name) {
+    HandlerStats entry;
+    entry.name = name;
+    entry.calls = 0;
+    entry.totalUs = 0;
+    entry.maxUs = 0;
+    stats.push_back(entry);
+    return stats.size() - 1;
+}
+
+// ============================================================
+// Events einreihen
+// ============================================================
+
+bool EventLoop::post(EventType type, uint32_t arg) {
+    if (type >= EVENT_TYPE_COUNT) {
+        return false;
+    }
+
+    // Scanner/Lap/Redraw: ein ausstehendes Event reicht
+    if (type != EVENT_TOUCH && pending[type].exchange(true)) {
+        return true;
+    }
+
+    Event event;
+    event.type = type;
+    event.arg = arg;
+    event.postedUs = rtosMicros();
+    if (!queue.send(event, 0)) {
+        pending[type] = false;
+        droppedEvents++;
+        return false;
+    }
+    return true;
+}
+
+bool EventLoop::postFromISR(EventType type, uint32_t arg) {
+    if (type >= EVENT_TYPE_COUNT) {
+        return false;
+    }
+
+    if (type != EVENT_TOUCH && pending[type].exchange(true)) {
+        return true;
+    }
+
+    Event event;
+    event.type = type;
+    event.arg = arg;
+    event.postedUs = rtosMicros();
+    if (!queue.sendFromISR(event)) {
+        pending[type] = false;
+        droppedEvents++;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================
+// Scheduler
+// ============================================================
+
+void EventLoop::setScreen(uint8_t screen) {
+    if (screen == currentScreen) {
+        return;
+    }
+    currentScreen = screen;
+
+    // Timer, die auf dem neuen Screen aktiv werden, starten ab jetzt
+    uint32_t now = millis();
+    for (Timer& timer : timers) {
+        if (timer.enabled && isActive(timer.screenMask)) {
+            timer.nextDue = now + timer.intervalMs;
+        }
+    }
+}
+
+bool EventLoop::isActive(uint32_t screenMask) const {
+    return currentScreen < 32 && (screenMask & EVENT_SCREEN(currentScreen)) != 0;
+}
+
+uint32_t EventLoop::msUntilNextTimer(uint32_t now, uint32_t maxSleepMs) const {
+    uint32_t wait = maxSleepMs;
+    for (const Timer& timer : timers) {
+        if (!timer.enabled || !isActive(timer.screenMask)) {
+            continue;
+        }
+        int32_t remaining = (int32_t)(timer.nextDue - now);
+        if (remaining <= 0) {
+            return 0;
+        }
+        if ((uint32_t)remaining < wait) {
+            wait = remaining;
+        }
+    }
+    return wait;
+}
+
+void EventLoop::runOnce(uint32_t maxSleepMs) {
+    uint32_t wait = msUntilNextTimer(millis(), maxSleepMs);
+
+    // Schlafen bis Event oder Timer fällig
+    Event event;
+    uint64_t sleepStart = rtosMicros();
+    bool received = queue.receive(event, wait);
+    uint64_t wake = rtosMicros();
+    sleepUs += wake - sleepStart;
+    wakeups++;
+
+    if (received) {
+        dispatch(event);
+        while (queue.receive(event, 0)) {
+            dispatch(event);
+        }
+    }
+
+    runTimers();
+
+    for (Hook& hook : hooks) {
+        uint64_t start = rtosMicros();
+        hook.handler();
+        record(hook.statsId, start);
+    }
+
+    uint32_t busy = (uint32_t)(rtosMicros() - wake);
+    busyUs += busy;
+    diagnostics.loopTime.record(busy);
+}
+
+void EventLoop::dispatch(const Event& event) {
+    pending[event.type] = false;
+
+    for (Listener& listener : listeners) {
+        if (listener.type != event.type || !isActive(listener.screenMask)) {
+            continue;
+        }
+        uint64_t start = rtosMicros();
+        listener.handler(event);
+        record(listener.statsId, start);
+    }
+}
+
+void EventLoop::runTimers() {
+    uint32_t now = millis();
+
+    for (Timer& timer : timers) {
+        if (!timer.enabled || !isActive(timer.screenMask)) {
+            continue;
+        }
+        if ((int32_t)(now - timer.nextDue) < 0) {
+            continue;
+        }
+
+        diagnostics.timerJitter.record((now - timer.nextDue) * 1000);
+
+        // Verpasste Perioden nicht nachholen
+        timer.nextDue += timer.intervalMs;
+        if ((int32_t)(now - timer.nextDue) >= 0) {
+            timer.nextDue = now + timer.intervalMs;
+        }
+
+        uint64_t start = rtosMicros();
+        timer.handler();
+        record(timer.statsId, start);
+    }
+}
+
+void EventLoop::record(int statsId, uint64_t startUs) {
+    uint32_t elapsed = (uint32_t)(rtosMicros() - startUs);
+    HandlerStats& entry = stats[statsId];
+    entry.calls++;
+    entry.totalUs += elapsed;
+    if (elapsed > entry.maxUs) {
+        entry.maxUs = elapsed;
+    }
+}
+
+// ============================================================
+// Statistik
+// ============================================================
+
+void EventLoop::printStats() {
+    uint64_t total = sleepUs + busyUs;
+    Serial.printf("[EventLoop] wakeups=%lu busy=%lu ms sleep=%lu ms (%lu%% idle) dropped=%lu\n",
+                  (unsigned long)wakeups, (unsigned long)(busyUs / 1000),
+                  (unsigned long)(sleepUs / 1000),
+                  (unsigned long)(total > 0 ? sleepUs * 100 / total : 0),
+                  (unsigned long)droppedEvents.load());
+
+    for (const HandlerStats& entry : stats) {
+        if (entry.calls == 0) {
+            continue;
+        }
+        Serial.printf("[EventLoop]   %-16s calls=%-6lu avg=%lu us max=%lu us\n",
+                      entry.name, (unsigned long)entry.calls,
+                      (unsigned long)(entry.totalUs / entry.calls), (unsigned long)entry.maxUs);
+    }
+}
+
+void EventLoop::resetStats() {
+    for (HandlerStats& entry : stats) {
+        entry.calls = 0;
+        entry.totalUs = 0;
+        entry.maxUs = 0;
+    }
+    sleepUs = 0;
+    busyUs = 0;
+    wakeups = 0;
+    droppedEvents = 0;
+}
@@ -0,0 +1,133 @@
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <functional>
+#include <vector>
+#include "Diagnostics.h"
+#include "RtosCompat.h"
+
+/**
+ * Kooperativer Scheduler für loop()
+ *
+ * Ersetzt die Kette aus "if (millis() - lastX > N)" + delay(10):
+ * - Timer (periodisch, z.B. Rennuhr, Beacon-Cleanup)
+ * - Events aus anderen Tasks/ISRs (Touch, Scanner, Runde, Redraw)
+ *
+ * runOnce() blockiert auf der Event-Queue bis zum nächsten fälligen Timer,
+ * dazwischen läuft der Idle-Task (CPU schläft). Timer und Handler können
+ * auf Screens beschränkt werden, die Laufzeit jedes Handlers wird gemessen.
+ */
+
+#ifndef EVENT_QUEUE_LENGTH
+#define EVENT_QUEUE_LENGTH 16
+#endif
+
+#define EVENT_ALL_SCREENS 0xFFFFFFFFUL
+#define EVENT_SCREEN(screen) (1UL << (screen))
+
+enum EventType : uint8_t {
+    EVENT_TOUCH,        // TouchInput hat Events (Queue dort, hier nur Wecken)
+    EVENT_SCANNER,      // Neue Beacon-Daten (zusammengefasst)
+    EVENT_LAP,          // Runde gezählt (zusammengefasst)
+    EVENT_REDRAW,       // Screen neu zeichnen (zusammengefasst)
+    EVENT_TYPE_COUNT
+};
+
+struct Event {
+    EventType type;
+    uint32_t arg;
+    uint64_t postedUs;  // rtosMicros() beim Einreihen
+};
+
+typedef std::function<void(const Event&)> EventHandler;
+typedef std::function<void()> TimerHandler;
+
+// Laufzeit-Statistik pro Timer/Handler
+struct HandlerStats {
+    const char* name;
+    uint32_t calls;
+    uint64_t totalUs;
+    uint32_t maxUs;
+};
+
+class EventLoop {
+public:
+    EventLoop();
+
+    // Registrierung (nur aus setup()/loop())
+    int addTimer(const char* name, uint32_t intervalMs, TimerHandler handler,
+                 uint32_t screenMask = EVENT_ALL_SCREENS);
+    void setTimerEnabled(int timerId, bool enabled);
+    void setTimerInterval(int timerId, uint32_t intervalMs);
+    int on(EventType type, const char* name, EventHandler handler,
+           uint32_t screenMask = EVENT_ALL_SCREENS);
+    int afterDispatch(const char* name, TimerHandler handler);  // Nach jeder Runde (z.B. Redraw)
+
+    // Aus beliebigem Task bzw. ISR, blockiert nie
+    bool post(EventType type, uint32_t arg = 0);
+    bool postFromISR(EventType type, uint32_t arg = 0);
+
+    // Aktiver Screen (filtert Timer und Handler)
+    void setScreen(uint8_t screen);
+    uint8_t getScreen() const { return currentScreen; }
+
+    // Wartet auf das nächste Event/den nächsten Timer und arbeitet alles Fällige ab
+    void runOnce(uint32_t maxSleepMs = 1000);
+
+    // Statistik
+    const std::vector<HandlerStats>& getStats() const { return stats; }
+    uint64_t getSleepUs() const { return sleepUs; }
+    uint64_t getBusyUs() const { return busyUs; }
+    uint32_t getWakeups() const { return wakeups; }
+    uint32_t getDroppedEvents() const { return droppedEvents; }
+    void printStats();
+    void resetStats();
+
+private:
+    struct Timer {
+        uint32_t intervalMs;
+        uint32_t nextDue;
+        uint32_t screenMask;
+        bool enabled;
+        TimerHandler handler;
+        int statsId;
+    };
+
+    struct Listener {
+        EventType type;
+        uint32_t screenMask;
+        EventHandler handler;
+        int statsId;
+    };
+
+    struct Hook {
+        TimerHandler handler;
+        int statsId;
+    };
+
+    RtosQueue<Event> queue;
+    std::atomic<bool> pending[EVENT_TYPE_COUNT];  // Zusammenfassen (außer Touch)
+
+    std::vector<Timer> timers;
+    std::vector<Listener> listeners;
+    std::vector<Hook> hooks;
+    std::vector<HandlerStats> stats;
+
+    uint8_t currentScreen;
+
+    uint64_t sleepUs;
+    uint64_t busyUs;
+    uint32_t wakeups;
+    std::atomic<uint32_t> droppedEvents;
+
+    int addStats(const char* name);
+    bool isActive(uint32_t screenMask) const;
+    uint32_t msUntilNextTimer(uint32_t now, uint32_t maxSleepMs) const;
+    void dispatch(const Event& event);
+    void runTimers();
+    void record(int statsId, uint64_t startUs);
+};
+
+#endif // EVENT_LOOP_H
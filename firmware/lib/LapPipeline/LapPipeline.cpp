@@ -0,0 +1,430 @@
+#include "LapPipeline.h"
+
+LapPipeline::LapPipeline(LapCounter& lapCounter, DataLogger& dataLogger)
+    : lapCounter(lapCounter)
+    , dataLogger(dataLogger)
+    , ingestQueue(INGEST_QUEUE_LENGTH)
+    , logQueue(LOG_QUEUE_LENGTH)
+    , threaded(false)
+    , running(false)
+    , activeTasks(0)
+    , pendingAdverts(0)
+    , pendingLogs(0)
+    , finishRequested(false)
+    , rssiNear(-65)
+    , rssiFar(-80)
+    , presenceTimeout(0)
+    , lastTimeoutCheck(0)
+    , lapListener(nullptr)
+    , maxLatencyUs(0)
+    , maxIngestUs(0)
+    , lapEvents(0)
+    , droppedEvents(0) {
+}
+
+LapPipeline::~LapPipeline() {
+    end();
+}
+
+bool LapPipeline::begin() {
+    if (threaded) {
+        return true;
+    }
+
+    running = true;
+    activeTasks = 2;
+
+    if (!rtosStartTask(lapTaskEntry, "lapTask", LAP_TASK_STACK, this,
+                       LAP_TASK_PRIORITY, LAP_TASK_CORE)) {
+        running = false;
+        activeTasks = 0;
+        Serial.println("[LapPipeline] ERROR: Lap task failed, processing inline");
+        return false;
+    }
+
+    if (!rtosStartTask(logTaskEntry, "logTask", LOG_TASK_STACK, this,
+                       LOG_TASK_PRIORITY, LOG_TASK_CORE)) {
+        activeTasks--;
+        running = false;
+        while (activeTasks > 0) {
+            rtosSleepMs(5);
+        }
+        Serial.println("[LapPipeline] ERROR: Logger task failed, processing inline");
+        return false;
+    }
+
+    threaded = true;
+    Serial.printf("[LapPipeline] Tasks started (lap: core %d prio %d, log: core %d prio %d)\n",
+                  LAP_TASK_CORE, LAP_TASK_PRIORITY, LOG_TASK_CORE, LOG_TASK_PRIORITY);
+    return true;
+}
+
+void LapPipeline::end() {
+    if (!threaded) {
+        return;
+    }
+
+    waitIdle(1000);
+    threaded = false;
+    running = false;
+    while (activeTasks > 0) {
+        rtosSleepMs(5);
+    }
+}
+
+// ============================================================
+// Ingest (BLE-Callback)
+// ============================================================
+
+void LapPipeline::ingest(const BeaconData& beacon) {
+    uint64_t start = rtosMicros();
+
+    AdvertEvent event;
+    strncpy(event.mac, beacon.macAddress.c_str(), sizeof(event.mac) - 1);
+    event.mac[sizeof(event.mac) - 1] = '\0';
+    event.rssi = beacon.rssi;
+    event.seenMs = beacon.lastSeen;
+    event.receivedUs = start;
+
+    diagnostics.count(DIAG_ADVERTS_RECEIVED);
+
+    if (threaded) {
+        pendingAdverts++;
+        if (!ingestQueue.send(event, 0)) {
+            pendingAdverts--;
+            droppedEvents++;
+            diagnostics.count(DIAG_ADVERTS_DROPPED);
+        }
+    } else {
+        processAdvert(event);
+    }
+
+    updateMax(maxIngestUs, (uint32_t)(rtosMicros() - start));
+}
+
+// ============================================================
+// Rundenerkennung
+// ============================================================
+
+void LapPipeline::setRssiThresholds(int8_t near, int8_t far) {
+    RtosLock lock(mutex);
+    rssiNear = near;
+    rssiFar = far;
+}
+
+void LapPipeline::setPresenceTimeout(uint32_t timeoutMs) {
+    RtosLock lock(mutex);
+    presenceTimeout = timeoutMs;
+}
+
+void LapPipeline::onLap(LapListener listener) {
+    RtosLock lock(mutex);
+    lapListener = listener;
+}
+
+void LapPipeline::resetRace() {
+    RtosLock lock(mutex);
+    lapCounter.reset();
+    presence.clear();
+    lastSeen.clear();
+    Serial.println("[LapPipeline] Race state reset");
+}
+
+void LapPipeline::poll() {
+    if (!threaded) {
+        checkPresenceTimeouts();
+        if (dataLogger.isReady()) {
+            dataLogger.flushIfDue();
+            dataLogger.pruneIfDue();
+        }
+    }
+}
+
+void LapPipeline::processAdvert(const AdvertEvent& event) {
+    LapEvent lap;
+    LapListener listener;
+
+    {
+        RtosLock lock(mutex);
+
+        TeamData* team = lapCounter.getTeamByBeacon(String(event.mac));
+        if (!team) {
+            return;  // Unbekannter Beacon
+        }
+
+        lastSeen[team->teamId] = event.seenMs;
+        // Jedes Sample als Telemetrie, nur im Rennen (O(1), wartet nie auf die Karte).
+        // Vollen Block gleich schreiben lassen statt beim nächsten Timeout
+        bool blockReady = false;
+        dataLogger.logRssi(team->teamId, event.seenMs, event.rssi, &blockReady);
+        if (blockReady && threaded) {
+            LogEvent log;
+            log.type = LOG_TELEMETRY;
+            memset(&log.lap, 0, sizeof(log.lap));
+            log.raceName[0] = '\0';
+            log.raceDurationMs = 0;
+            pendingLogs++;
+            if (!logQueue.send(log, 0)) {
+                pendingLogs--;      // Queue voll: der Logger-Task ist ohnehin wach
+            }
+        }
+
+        // RSSI-Hysterese: NAH > rssiNear, WEG < rssiFar, dazwischen Status halten
+        if (event.rssi < rssiFar) {
+            presence[team->teamId] = false;
+            return;
+        }
+        if (event.rssi <= rssiNear || presence[team->teamId]) {
+            return;
+        }
+
+        // War WEG, jetzt NAH -> Runde zählen
+        presence[team->teamId] = true;
+        if (!lapCounter.recordLap(team->teamId, event.seenMs)) {
+            diagnostics.count(DIAG_LAPS_REJECTED);
+            return;
+        }
+
+        lap.teamId = team->teamId;
+        strncpy(lap.teamName, team->teamName.c_str(), sizeof(lap.teamName) - 1);
+        lap.teamName[sizeof(lap.teamName) - 1] = '\0';
+        lap.lapCount = team->lapCount;
+        lap.timestamp = event.seenMs;
+        if (team->laps.empty()) {
+            lap.lapNumber = 0;
+            lap.duration = 0;
+        } else {
+            lap.lapNumber = team->laps.back().lapNumber;
+            lap.duration = team->laps.back().duration;
+        }
+        listener = lapListener;
+    }
+
+    lap.latencyUs = (uint32_t)(rtosMicros() - event.receivedUs);
+    updateMax(maxLatencyUs, lap.latencyUs);
+    lapEvents++;
+    diagnostics.count(DIAG_LAPS_ACCEPTED);
+    diagnostics.advertToLap.record(lap.latencyUs);
+
+    if (lap.lapNumber > 0) {
+        LogEvent log;
+        log.type = LOG_LAP;
+        log.lap = lap;
+        log.raceName[0] = '\0';
+        log.raceDurationMs = 0;
+        submitLog(log);
+    }
+
+    if (listener) {
+        listener(lap);
+    }
+}
+
+void LapPipeline::checkPresenceTimeouts() {
+    uint32_t now = millis();
+    if (now - lastTimeoutCheck < 500) {
+        return;
+    }
+    lastTimeoutCheck = now;
+
+    RtosLock lock(mutex);
+    if (presenceTimeout == 0) {
+        return;
+    }
+
+    // Beacon zu lange nicht gesehen -> "weg"
+    for (auto& pair : lastSeen) {
+        if (presence[pair.first] && now - pair.second > presenceTimeout) {
+            Serial.printf("[Lap] Team %u: WEG (timeout)\n", pair.first);
+            presence[pair.first] = false;
+        }
+    }
+}
+
+// ============================================================
+// SD-Logging
+// ============================================================
+
+void LapPipeline::logRaceStart(const String& raceName, uint32_t durationMs) {
+    LogEvent log;
+    log.type = LOG_RACE_START;
+    memset(&log.lap, 0, sizeof(log.lap));
+    strncpy(log.raceName, raceName.c_str(), sizeof(log.raceName) - 1);
+    log.raceName[sizeof(log.raceName) - 1] = '\0';
+    log.raceDurationMs = durationMs;
+    submitLog(log);
+}
+
+void LapPipeline::logRaceFinish() {
+    LogEvent log;
+    log.type = LOG_RACE_FINISH;
+    memset(&log.lap, 0, sizeof(log.lap));
+    log.raceName[0] = '\0';
+    log.raceDurationMs = 0;
+    submitLog(log);
+
+    // Ergebnis-Screen liest die Datei direkt danach
+    uint64_t start = rtosMicros();
+    while (pendingLogs > 0 && rtosMicros() - start < 2000000ULL) {
+        rtosSleepMs(1);
+    }
+}
+
+void LapPipeline::requestRaceFinish() {
+    finishRequested = true;
+}
+
+void LapPipeline::finishRequestedRace() {
+    if (finishRequested.exchange(false)) {
+        logRaceFinish();
+    }
+}
+
+void LapPipeline::submitLog(const LogEvent& event) {
+    if (!threaded) {
+        writeLog(event);
+        return;
+    }
+
+    // Runden nicht endlos stauen, falls die Karte hängt
+    uint32_t timeoutMs = event.type == LOG_LAP ? 50 : RTOS_WAIT_FOREVER;
+    pendingLogs++;
+    if (!logQueue.send(event, timeoutMs)) {
+        pendingLogs--;
+        droppedEvents++;
+        diagnostics.count(DIAG_LOGS_DROPPED);
+        Serial.printf("[LapPipeline] ERROR: Log queue full, lap %u of team %u not written\n",
+                      event.lap.lapNumber, event.lap.teamId);
+    }
+}
+
+void LapPipeline::writeLog(const LogEvent& event) {
+    if (!dataLogger.isReady()) {
+        return;
+    }
+
+    switch (event.type) {
+        case LOG_LAP: {
+            uint64_t start = rtosMicros();
+            dataLogger.logLap(event.lap.teamId, String(event.lap.teamName),
+                              event.lap.lapNumber, event.lap.timestamp, event.lap.duration);
+            diagnostics.sdWrite.record((uint32_t)(rtosMicros() - start));
+            break;
+        }
+        case LOG_RACE_START: {
+            // Teamtabelle für den Header des Runden-Logs
+            std::vector<LapLogTeam> teams;
+            {
+                RtosLock lock(mutex);
+                for (TeamData* team : lapCounter.getAllTeams()) {
+                    LapLogTeam entry;
+                    lapLogInitTeam(entry, team->teamId, team->teamName.c_str());
+                    teams.push_back(entry);
+                }
+            }
+            dataLogger.startNewRace(String(event.raceName), teams.data(), teams.size(),
+                                    event.raceDurationMs);
+            break;
+        }
+        case LOG_RACE_FINISH:
+            dataLogger.finishRace();
+            break;
+        case LOG_TELEMETRY:
+            break;  // flushIfDue() im Logger-Task schreibt den Block
+    }
+}
+
+// ============================================================
+// Tasks
+// ============================================================
+
+void LapPipeline::lapTaskEntry(void* arg) {
+    LapPipeline* pipeline = static_cast<LapPipeline*>(arg);
+    pipeline->lapTaskLoop();
+    pipeline->activeTasks--;
+    rtosEndTask();
+}
+
+void LapPipeline::logTaskEntry(void* arg) {
+    LapPipeline* pipeline = static_cast<LapPipeline*>(arg);
+    pipeline->logTaskLoop();
+    pipeline->activeTasks--;
+    rtosEndTask();
+}
+
+void LapPipeline::lapTaskLoop() {
+    while (running) {
+        AdvertEvent event;
+        if (ingestQueue.receive(event, 100)) {
+            processAdvert(event);
+            pendingAdverts--;
+        }
+        checkPresenceTimeouts();
+    }
+}
+
+void LapPipeline::logTaskLoop() {
+    while (running) {
+        LogEvent event;
+        bool received = logQueue.receive(event, 100);
+        if (received) {
+            writeLog(event);
+            pendingLogs--;
+        }
+        // Gepufferte Runden spätestens nach LOG_FLUSH_MS auf die Karte,
+        // alte Rennen nur löschen, wenn nichts ansteht
+        if (dataLogger.isReady()) {
+            dataLogger.flushIfDue();
+            if (!received) {
+                dataLogger.pruneIfDue();
+            }
+        }
+    }
+}
+
+// ============================================================
+// Statistik
+// ============================================================
+
+bool LapPipeline::waitIdle(uint32_t timeoutMs) {
+    uint64_t start = rtosMicros();
+    while (pendingAdverts > 0 || pendingLogs > 0) {
+        if (rtosMicros() - start > (uint64_t)timeoutMs * 1000) {
+            return false;
+        }
+        rtosSleepMs(1);
+    }
+    return true;
+}
+
+void LapPipeline::getStandings(std::vector<TeamStanding>& standings) {
+    RtosLock lock(mutex);
+
+    std::vector<TeamData*> leaderboard = lapCounter.getLeaderboard(true);
+    standings.clear();
+    standings.reserve(leaderboard.size());
+
+    for (TeamData* team : leaderboard) {
+        TeamStanding standing;
+        standing.teamId = team->teamId;
+        standing.teamName = team->teamName;
+        standing.laps = team->lapCount > 0 ? team->lapCount - 1 : 0;
+        standing.lastLapDuration = team->laps.empty() ? 0 : team->laps.back().duration;
+        standing.bestLapDuration = team->laps.empty() ? 0 : team->bestLapDuration;
+        standing.totalDuration = team->totalDuration;
+        standings.push_back(standing);
+    }
+}
+
+void LapPipeline::resetStats() {
+    maxLatencyUs = 0;
+    maxIngestUs = 0;
+    lapEvents = 0;
+    droppedEvents = 0;
+}
+
+void LapPipeline::updateMax(std::atomic<uint32_t>& value, uint32_t sample) {
+    uint32_t current = value.load();
+    while (sample > current && !value.compare_exchange_weak(current, sample)) {
+    }
+}
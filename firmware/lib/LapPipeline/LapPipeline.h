@@ -0,0 +1,184 @@
+#ifndef LAP_PIPELINE_H
+#define LAP_PIPELINE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <vector>
+#include "BLEScanner.h"
+#include "LapCounter.h"
+#include "DataLogger.h"
+#include "Diagnostics.h"
+#include "RtosCompat.h"
+
+/**
+ * Lap-Pipeline: BLE-Events -> Rundenerkennung -> SD-Log
+ *
+ * Trennt die Rundenzählung von UI und SD-Karte:
+ * - BLE-Callback reiht Advertisements nur ein (ingest, blockiert nie)
+ * - Lap-Task (Core 0, hohe Priorität): Hysterese, LapCounter
+ * - Logger-Task (Core 1): alle SD-Schreibzugriffe während eines Rennens,
+ *   Runden gepuffert im DataLogger (flushIfDue() bei jedem Aufwachen),
+ *   ebenso die RSSI-Telemetrie, die der Lap-Task pro Advertisement einreiht
+ * - UI (Arduino loop, Core 1, Priorität 1): liest über stateMutex()
+ *   bzw. getStandings(). Unter stateMutex wartet der Lap-Task, deshalb
+ *   merkt ein Touch-Handler das Rennende nur vor (requestRaceFinish()),
+ *   geschrieben wird es nach dem Lock (finishRequestedRace())
+ *
+ * Ohne begin() läuft alles synchron im Aufrufer (Verhalten wie bisher).
+ */
+
+// Task-Konfiguration (in config.h überschreibbar)
+#ifndef LAP_TASK_CORE
+#define LAP_TASK_CORE 0
+#endif
+#ifndef LAP_TASK_PRIORITY
+#define LAP_TASK_PRIORITY 5      // Über loop() (1), unter NimBLE-Host
+#endif
+#ifndef LAP_TASK_STACK
+#define LAP_TASK_STACK 4096
+#endif
+#ifndef LOG_TASK_CORE
+#define LOG_TASK_CORE 1
+#endif
+#ifndef LOG_TASK_PRIORITY
+#define LOG_TASK_PRIORITY 2
+#endif
+#ifndef LOG_TASK_STACK
+#define LOG_TASK_STACK 6144      // SD/FATFS + String
+#endif
+#ifndef INGEST_QUEUE_LENGTH
+#define INGEST_QUEUE_LENGTH 64
+#endif
+#ifndef LOG_QUEUE_LENGTH
+#define LOG_QUEUE_LENGTH 32
+#endif
+
+#define LAP_NAME_LENGTH 32
+
+// Gezählte Runde (bzw. Start bei lapNumber == 0)
+struct LapEvent {
+    uint8_t teamId;
+    char teamName[LAP_NAME_LENGTH];
+    uint16_t lapNumber;     // 0 = Team gestartet, noch keine Runde
+    uint16_t lapCount;      // TeamData::lapCount nach dem Zählen
+    uint32_t timestamp;     // millis() des auslösenden Advertisements
+    uint32_t duration;      // ms
+    uint32_t latencyUs;     // Advertisement empfangen -> Runde gezählt
+};
+
+// Kopie einer Ranglisten-Zeile für die UI (ohne Lock zeichenbar)
+struct TeamStanding {
+    uint8_t teamId;
+    String teamName;
+    uint16_t laps;              // Abgeschlossene Runden
+    uint32_t lastLapDuration;   // 0 = noch keine Runde
+    uint32_t bestLapDuration;
+    uint32_t totalDuration;
+};
+
+typedef std::function<void(const LapEvent&)> LapListener;
+
+class LapPipeline {
+public:
+    LapPipeline(LapCounter& lapCounter, DataLogger& dataLogger);
+    ~LapPipeline();
+
+    // Tasks starten / stoppen
+    bool begin();
+    void end();
+    bool isThreaded() const { return threaded; }
+
+    // Aufruf aus dem BLE-Callback
+    void ingest(const BeaconData& beacon);
+
+    // Rundenerkennung
+    void setRssiThresholds(int8_t near, int8_t far);
+    void setPresenceTimeout(uint32_t timeoutMs);  // 0 = nur RSSI-Hysterese
+    void onLap(LapListener listener);             // Läuft im Lap-Task!
+    void resetRace();                             // LapCounter + Presence zurücksetzen
+    void poll();                                  // Ohne Tasks: Timeouts und Log-Flush im loop()
+
+    // SD (im Logger-Task)
+    void logRaceStart(const String& raceName, uint32_t durationMs = 0);   // Dauer: Log-Datei vorbelegen
+    void logRaceFinish();                         // Wartet bis alle Runden geschrieben sind, nie unter stateMutex
+    void requestRaceFinish();                     // Unter stateMutex: logRaceFinish() vormerken
+    void finishRequestedRace();                   // Ohne Lock: vorgemerktes logRaceFinish()
+
+    // UI-Zugriff
+    RtosMutex& stateMutex() { return mutex; }
+    void getStandings(std::vector<TeamStanding>& standings);
+
+    // Wartet bis alle eingereihten Events verarbeitet sind
+    bool waitIdle(uint32_t timeoutMs);
+
+    // Statistik
+    uint32_t getMaxLatencyUs() const { return maxLatencyUs; }
+    uint32_t getMaxIngestUs() const { return maxIngestUs; }
+    uint32_t getLapEvents() const { return lapEvents; }
+    uint32_t getDroppedEvents() const { return droppedEvents; }
+    void resetStats();
+
+private:
+    struct AdvertEvent {
+        char mac[18];
+        int8_t rssi;
+        uint32_t seenMs;
+        uint64_t receivedUs;
+    };
+
+    enum LogType : uint8_t {
+        LOG_LAP,
+        LOG_RACE_START,
+        LOG_RACE_FINISH,
+        LOG_TELEMETRY           // Nur aufwecken: voller RSSI-Block wartet
+    };
+
+    struct LogEvent {
+        LogType type;
+        LapEvent lap;
+        char raceName[LAP_NAME_LENGTH];
+        uint32_t raceDurationMs;
+    };
+
+    LapCounter& lapCounter;
+    DataLogger& dataLogger;
+
+    RtosMutex mutex;        // LapCounter + Presence
+    RtosQueue<AdvertEvent> ingestQueue;
+    RtosQueue<LogEvent> logQueue;
+
+    bool threaded;
+    std::atomic<bool> running;
+    std::atomic<int> activeTasks;
+    std::atomic<int> pendingAdverts;
+    std::atomic<int> pendingLogs;
+    std::atomic<bool> finishRequested;
+
+    int8_t rssiNear;
+    int8_t rssiFar;
+    uint32_t presenceTimeout;
+    std::map<uint8_t, bool> presence;
+    std::map<uint8_t, uint32_t> lastSeen;
+    uint32_t lastTimeoutCheck;
+    LapListener lapListener;
+
+    std::atomic<uint32_t> maxLatencyUs;
+    std::atomic<uint32_t> maxIngestUs;
+    std::atomic<uint32_t> lapEvents;
+    std::atomic<uint32_t> droppedEvents;
+
+    static void lapTaskEntry(void* arg);
+    static void logTaskEntry(void* arg);
+    void lapTaskLoop();
+    void logTaskLoop();
+
+    void processAdvert(const AdvertEvent& event);
+    void checkPresenceTimeouts();
+    void submitLog(const LogEvent& event);
+    void writeLog(const LogEvent& event);
+    static void updateMax(std::atomic<uint32_t>& value, uint32_t sample);
+};
+
+#endif // LAP_PIPELINE_H
@@ -0,0 +1,188 @@
+#include "CsvReader.h"
+
+#ifndef NATIVE_BUILD
+#include <rom/crc.h>
+#endif
+
+// ============================================================
+// CRC-32
+// ============================================================
+
+uint32_t crc32Update(uint32_t crc, const void* data, size_t length) {
+#ifndef NATIVE_BUILD
+    // Tabelle liegt im ROM des ESP32, kompatibel zu zlib
+    return crc32_le(crc, (const uint8_t*)data, length);
+#else
+    static uint32_t table[256];
+    if (table[1] == 0) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int bit = 0; bit < 8; bit++) {
+                c = (c & 1) ? (c >> 1) ^ 0xEDB88320 : c >> 1;
+            }
+            table[i] = c;
+        }
+    }
+    const uint8_t* bytes = (const uint8_t*)data;
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = (crc >> 8) ^ table[(crc ^ bytes[i]) & 0xFF];
+    }
+    return ~crc;
+#endif
+}
+
+// ============================================================
+// Felder
+// ============================================================
+
+uint32_t CsvField::toUInt() const {
+    uint32_t value = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        char c = data[i];
+        if (c < '0' || c > '9') {
+            break;
+        }
+        value = value * 10 + (c - '0');
+    }
+    return value;
+}
+
+String CsvField::toString() const {
+    String text;
+    text.concat(data, length);
+    return text;
+}
+
+// ============================================================
+// Reader
+// ============================================================
+
+CsvReader::CsvReader(fs::File& file)
+    : file(&file), memory(nullptr), memoryLength(0), memoryPos(0)
+    , bufferStart(0), bufferEnd(0), eof(false), bytesRead(0), checksum(0)
+    , fieldCount(0), lineNumber(0), skippedLines(0) {
+}
+
+CsvReader::CsvReader(const char* data, size_t length)
+    : file(nullptr), memory(data), memoryLength(length), memoryPos(0)
+    , bufferStart(0), bufferEnd(0), eof(true), bytesRead(0), checksum(0)
+    , fieldCount(0), lineNumber(0), skippedLines(0) {
+}
+
+bool CsvReader::next() {
+    const char* line;
+    size_t length;
+    if (!nextLine(line, length)) {
+        fieldCount = 0;
+        return false;
+    }
+    lineNumber++;
+    split(line, length);
+    return true;
+}
+
+bool CsvReader::nextLine(const char*& line, size_t& length) {
+    // Speicherbereich: Zeile direkt aus den Daten
+    if (!file) {
+        if (memoryPos >= memoryLength) {
+            return false;
+        }
+        line = memory + memoryPos;
+        const char* newline = (const char*)memchr(line, '\n', memoryLength - memoryPos);
+        length = newline ? (size_t)(newline - line) : memoryLength - memoryPos;
+        memoryPos += length + 1;
+        return true;
+    }
+
+    bool skipping = false;
+    while (true) {
+        char* start = buffer + bufferStart;
+        char* newline = (char*)memchr(start, '\n', bufferEnd - bufferStart);
+        if (newline) {
+            bufferStart = newline - buffer + 1;
+            if (skipping) {
+                // Rest einer zu langen Zeile
+                skipping = false;
+                skippedLines++;
+                lineNumber++;
+                continue;
+            }
+            line = start;
+            length = newline - start;
+            return true;
+        }
+
+        // Puffer voll ohne Zeilenende: Zeile zu lang, bis zum nächsten '\n' verwerfen
+        if (skipping || (bufferStart == 0 && bufferEnd == CSV_READER_BLOCK)) {
+            skipping = true;
+            bufferStart = 0;
+            bufferEnd = 0;
+        }
+
+        if (!fill()) {
+            if (skipping) {
+                skippedLines++;
+                lineNumber++;
+                return false;
+            }
+            if (bufferStart < bufferEnd) {
+                // Letzte Zeile ohne '\n'
+                line = buffer + bufferStart;
+                length = bufferEnd - bufferStart;
+                bufferStart = bufferEnd;
+                return true;
+            }
+            return false;
+        }
+    }
+}
+
+bool CsvReader::fill() {
+    if (eof) {
+        return false;
+    }
+
+    // Angefangene Zeile an den Pufferanfang schieben, dahinter nachladen
+    uint16_t remaining = bufferEnd - bufferStart;
+    if (bufferStart > 0) {
+        memmove(buffer, buffer + bufferStart, remaining);
+        bufferStart = 0;
+        bufferEnd = remaining;
+    }
+
+    size_t read = file->read((uint8_t*)buffer + bufferEnd, CSV_READER_BLOCK - bufferEnd);
+    if (read == 0) {
+        eof = true;
+        return false;
+    }
+    checksum = crc32Update(checksum, buffer + bufferEnd, read);
+    bytesRead += read;
+    bufferEnd += read;
+    return true;
+}
+
+void CsvReader::split(const char* line, size_t length) {
+    if (length > 0 && line[length - 1] == '\r') {
+        length--;
+    }
+
+    fieldCount = 0;
+    if (length == 0) {
+        return;
+    }
+
+    const char* end = line + length;
+    const char* pos = line;
+    while (fieldCount < CSV_MAX_FIELDS) {
+        const char* comma = (const char*)memchr(pos, ',', end - pos);
+        const char* fieldEnd = comma ? comma : end;
+        fields[fieldCount].data = pos;
+        fields[fieldCount].length = fieldEnd - pos;
+        fieldCount++;
+        if (!comma) {
+            break;
+        }
+        pos = comma + 1;
+    }
+}
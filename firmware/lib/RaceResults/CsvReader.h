@@ -0,0 +1,81 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <Arduino.h>
+#include <FS.h>
+
+/**
+ * Streaming-CSV-Tokenizer mit fester Puffergröße
+ *
+ * Liest Zeile für Zeile aus einer Datei (blockweise, CSV_READER_BLOCK Bytes)
+ * oder direkt aus einem Speicherbereich. Felder sind Zeiger in den Puffer
+ * bzw. in den Speicherbereich - nichts wird kopiert, kein String pro Zeile.
+ * Speicherbedarf unabhängig von der Dateigröße.
+ *
+ * Die Felder einer Zeile gelten bis zum nächsten next(). Zeilen länger als
+ * der Puffer werden übersprungen (getSkippedLines()). Kein Quoting: das
+ * Format des DataLoggers enthält keine Kommas in Feldern.
+ */
+
+// In config.h überschreibbar
+#ifndef CSV_READER_BLOCK
+#define CSV_READER_BLOCK 512        // Bytes, auch max. Zeilenlänge
+#endif
+
+#define CSV_MAX_FIELDS 8
+
+// CRC-32 (IEEE, wie zlib), crc = 0 am Anfang
+uint32_t crc32Update(uint32_t crc, const void* data, size_t length);
+
+struct CsvField {
+    const char* data;
+    uint16_t length;
+
+    // Dezimalzahl ohne Vorzeichen, bricht beim ersten Nicht-Ziffer-Zeichen ab
+    uint32_t toUInt() const;
+    String toString() const;
+};
+
+class CsvReader {
+public:
+    explicit CsvReader(fs::File& file);
+    CsvReader(const char* data, size_t length);
+
+    // Nächste Zeile zerlegen, false = Ende
+    bool next();
+
+    uint8_t getFieldCount() const { return fieldCount; }
+    const CsvField& getField(uint8_t index) const { return fields[index]; }
+
+    uint32_t getLineNumber() const { return lineNumber; }
+    uint32_t getSkippedLines() const { return skippedLines; }
+
+    // Datei-Modus: gelesene Bytes und ihre CRC-32 (nach dem letzten next()
+    // die der ganzen Datei)
+    uint32_t getBytesRead() const { return bytesRead; }
+    uint32_t getChecksum() const { return checksum; }
+
+private:
+    fs::File* file;
+    const char* memory;
+    size_t memoryLength;
+    size_t memoryPos;
+
+    char buffer[CSV_READER_BLOCK];
+    uint16_t bufferStart;
+    uint16_t bufferEnd;
+    bool eof;
+    uint32_t bytesRead;
+    uint32_t checksum;
+
+    CsvField fields[CSV_MAX_FIELDS];
+    uint8_t fieldCount;
+    uint32_t lineNumber;
+    uint32_t skippedLines;
+
+    bool nextLine(const char*& line, size_t& length);
+    bool fill();
+    void split(const char* line, size_t length);
+};
+
+#endif // CSV_READER_H
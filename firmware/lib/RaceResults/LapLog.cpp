@@ -0,0 +1,208 @@
+#include "LapLog.h"
+#include "CsvReader.h"
+
+const char LAP_LOG_CSV_HEADER[] =
+    "Team ID,Team Name,Lap Number,Timestamp (ms),Duration (ms),Time of Day\n";
+
+// ============================================================
+// CRC-8
+// ============================================================
+
+uint8_t crc8Update(uint8_t crc, const void* data, size_t length) {
+    static uint8_t table[256];
+    if (table[1] == 0) {
+        for (uint16_t i = 0; i < 256; i++) {
+            uint8_t c = i;
+            for (int bit = 0; bit < 8; bit++) {
+                c = (c & 0x80) ? (c << 1) ^ 0x07 : c << 1;
+            }
+            table[i] = c;
+        }
+    }
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[crc ^ bytes[i]];
+    }
+    return crc;
+}
+
+// ============================================================
+// Schreiben
+// ============================================================
+
+void lapLogInitHeader(LapLogHeader& header, const char* raceName, uint64_t startTime,
+                      const LapLogTeam* teams, uint16_t teamCount) {
+    memset(&header, 0, sizeof(header));
+    header.magic = LAP_LOG_MAGIC;
+    header.version = LAP_LOG_VERSION;
+    header.recordSize = sizeof(LapLogRecord);
+    header.startTime = startTime;
+    strncpy(header.raceName, raceName, LAP_LOG_RACE_NAME_LEN - 1);
+    header.teamCount = teamCount;
+    header.teamSize = sizeof(LapLogTeam);
+    header.checksum = lapLogHeaderChecksum(header, teams);
+}
+
+void lapLogInitTeam(LapLogTeam& team, uint8_t teamId, const char* name) {
+    memset(&team, 0, sizeof(team));
+    team.teamId = teamId;
+    strncpy(team.name, name, LAP_LOG_TEAM_NAME_LEN - 1);
+}
+
+void lapLogInitRecord(LapLogRecord& record, uint8_t teamIndex, uint8_t flags,
+                      uint16_t lapNumber, uint64_t timestamp, uint32_t duration) {
+    memset(&record, 0, sizeof(record));
+    record.timestamp = timestamp;
+    record.duration = duration;
+    record.lapNumber = lapNumber;
+    record.teamIndex = teamIndex;
+    record.flags = flags;
+    record.crc = crc8Update(0, &record, offsetof(LapLogRecord, crc));
+}
+
+// ============================================================
+// Prüfen
+// ============================================================
+
+bool lapLogCheckHeader(const LapLogHeader& header) {
+    return header.magic == LAP_LOG_MAGIC && header.version == LAP_LOG_VERSION &&
+           header.recordSize == sizeof(LapLogRecord) && header.teamSize == sizeof(LapLogTeam) &&
+           header.teamCount <= LAP_LOG_MAX_TEAMS;
+}
+
+uint32_t lapLogHeaderChecksum(const LapLogHeader& header, const LapLogTeam* teams) {
+    LapLogHeader copy = header;
+    copy.checksum = 0;
+    uint32_t crc = crc32Update(0, &copy, sizeof(copy));
+    return crc32Update(crc, teams, header.teamCount * sizeof(LapLogTeam));
+}
+
+bool lapLogCheckRecord(const LapLogRecord& record) {
+    return crc8Update(0, &record, offsetof(LapLogRecord, crc)) == record.crc;
+}
+
+bool lapLogIsEmpty(const LapLogRecord& record) {
+    const uint32_t* words = (const uint32_t*)&record;
+    for (size_t i = 0; i < sizeof(record) / sizeof(uint32_t); i++) {
+        if (words[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================
+// CSV-Export
+// ============================================================
+
+size_t lapLogFormatCsv(char* line, size_t size, const LapLogRecord& record,
+                       uint8_t teamId, const char* teamName, uint64_t startTime) {
+    // Name nach RFC 4180 quoten, wenn nötig
+    char name[2 * LAP_LOG_TEAM_NAME_LEN + 3];
+    size_t nameLength = 0;
+    if (strpbrk(teamName, ",\"\r\n")) {
+        name[nameLength++] = '"';
+        for (const char* c = teamName; *c && nameLength < sizeof(name) - 3; c++) {
+            if (*c == '"') {
+                name[nameLength++] = '"';
+            }
+            name[nameLength++] = *c;
+        }
+        name[nameLength++] = '"';
+        name[nameLength] = '\0';
+    } else {
+        strncpy(name, teamName, sizeof(name) - 1);
+        name[sizeof(name) - 1] = '\0';
+    }
+
+    // Time of Day (HH:MM:SS) seit Rennstart
+    uint64_t elapsed = record.timestamp > startTime ? record.timestamp - startTime : 0;
+    unsigned long seconds = (unsigned long)(elapsed / 1000);
+    int length = snprintf(line, size, "%u,%s,%u,%llu,%lu,%02lu:%02lu:%02lu\n",
+                          teamId, name, record.lapNumber,
+                          (unsigned long long)record.timestamp, (unsigned long)record.duration,
+                          seconds / 3600, (seconds % 3600) / 60, seconds % 60);
+    if (length <= 0 || length >= (int)size) {
+        return 0;
+    }
+    return length;
+}
+
+// ============================================================
+// Reader
+// ============================================================
+
+LapLogReader::LapLogReader(fs::File& file)
+    : file(file), bufferPos(0), bufferCount(0)
+    , badRecords(0), emptyRecords(0), truncatedBytes(0), bytesRead(0), checksum(0) {
+    memset(&header, 0, sizeof(header));
+}
+
+bool LapLogReader::begin() {
+    if (readTracked(&header, sizeof(header)) != sizeof(header) || !lapLogCheckHeader(header)) {
+        return false;
+    }
+
+    teams.resize(header.teamCount);
+    size_t size = teams.size() * sizeof(LapLogTeam);
+    if (readTracked(teams.data(), size) != size) {
+        return false;
+    }
+    return lapLogHeaderChecksum(header, teams.data()) == header.checksum;
+}
+
+bool LapLogReader::next(LapLogRecord& record) {
+    while (true) {
+        if (bufferPos >= bufferCount) {
+            size_t read = readTracked(buffer, sizeof(buffer));
+            bufferPos = 0;
+            bufferCount = read / sizeof(LapLogRecord);
+            if (bufferCount == 0) {
+                truncatedBytes += read;
+                return false;
+            }
+            // Angefangener Datensatz kann nur am Dateiende stehen
+            truncatedBytes += read % sizeof(LapLogRecord);
+        }
+
+        const LapLogRecord& candidate = buffer[bufferPos++];
+        if (lapLogIsEmpty(candidate)) {
+            emptyRecords++;
+            continue;
+        }
+        if (lapLogCheckRecord(candidate)) {
+            record = candidate;
+            return true;
+        }
+        badRecords++;
+    }
+}
+
+uint8_t LapLogReader::getTeamId(const LapLogRecord& record) const {
+    if ((record.flags & LAP_FLAG_UNLISTED) || record.teamIndex >= teams.size()) {
+        return record.teamIndex;
+    }
+    return teams[record.teamIndex].teamId;
+}
+
+const char* LapLogReader::getTeamName(const LapLogRecord& record) const {
+    if ((record.flags & LAP_FLAG_UNLISTED) || record.teamIndex >= teams.size()) {
+        return "";
+    }
+    const LapLogTeam& team = teams[record.teamIndex];
+    return team.name[LAP_LOG_TEAM_NAME_LEN - 1] == '\0' ? team.name : "";
+}
+
+size_t LapLogReader::readTracked(void* data, size_t length) {
+    size_t read = 0;
+    while (read < length) {
+        size_t chunk = file.read((uint8_t*)data + read, length - read);
+        if (chunk == 0) {
+            break;
+        }
+        read += chunk;
+    }
+    checksum = crc32Update(checksum, data, read);
+    bytesRead += read;
+    return read;
+}
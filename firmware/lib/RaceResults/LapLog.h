@@ -0,0 +1,141 @@
+#ifndef LAP_LOG_H
+#define LAP_LOG_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <vector>
+
+/**
+ * Binäres Runden-Log (.lap), Speicherformat des DataLoggers
+ *
+ * Aufbau der Datei:
+ *   LapLogHeader            Renn-Metadaten, CRC-32 über Header + Teamtabelle
+ *   LapLogTeam[teamCount]   Teamtabelle: ID und Name, einmal pro Rennen
+ *   LapLogRecord...         eine feste Größe pro Runde, eigene CRC-8
+ *
+ * Der Name steht nur in der Tabelle statt in jeder Zeile, ein Datensatz
+ * verweist über teamIndex darauf. Kein Formatieren beim Schreiben, kein
+ * Zerlegen beim Lesen, Kommas im Teamnamen sind kein Problem mehr.
+ * Kaputte Datensätze (CRC) werden einzeln übersprungen, ein angefangener
+ * Datensatz am Ende (Stromausfall beim Schreiben) ebenfalls. Ein Datensatz
+ * aus lauter Nullen ist leer: vorbelegter, noch nicht beschriebener Platz
+ * (DataLogger belegt die Datei beim Start vor). Echte Runden haben immer
+ * lapNumber >= 1 und sind deshalb nie ganz Null.
+ *
+ * Structs werden roh geschrieben (little-endian wie ESP32 und x86).
+ * CSV ist nur noch Exportformat: lapLogFormatCsv(), DataLogger::exportRaceCSV()
+ * und src/host/laplog_convert.cpp (CSV/JSON am PC).
+ */
+
+#define LAP_LOG_MAGIC 0x474C4C4D        // "MLLG"
+#define LAP_LOG_VERSION 1
+#define LAP_LOG_RACE_NAME_LEN 32
+#define LAP_LOG_TEAM_NAME_LEN 28
+#define LAP_LOG_MAX_TEAMS 255           // teamIndex ist ein Byte
+#define LAP_LOG_CSV_LINE_MAX 112
+
+// Record-Flags
+#define LAP_FLAG_UNLISTED 0x01          // Team nicht in der Tabelle, teamIndex = teamId
+
+struct LapLogHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;        // sizeof(LapLogRecord)
+    uint64_t startTime;         // ms, millis() beim Start (ohne RTC)
+    char raceName[LAP_LOG_RACE_NAME_LEN];
+    uint16_t teamCount;
+    uint16_t teamSize;          // sizeof(LapLogTeam)
+    uint32_t checksum;          // CRC-32 über Header (mit checksum = 0) + Teamtabelle
+};
+
+struct LapLogTeam {
+    uint8_t teamId;
+    uint8_t reserved[3];
+    char name[LAP_LOG_TEAM_NAME_LEN];
+};
+
+struct LapLogRecord {
+    uint64_t timestamp;         // ms, gleiche Uhr wie startTime
+    uint32_t duration;          // ms
+    uint16_t lapNumber;
+    uint8_t teamIndex;          // Position in der Teamtabelle (siehe LAP_FLAG_UNLISTED)
+    uint8_t flags;
+    uint8_t reserved[7];
+    uint8_t crc;                // CRC-8 über die Bytes davor
+};
+
+static_assert(sizeof(LapLogHeader) == 56, "LapLogHeader layout");
+static_assert(sizeof(LapLogTeam) == 32, "LapLogTeam layout");
+static_assert(sizeof(LapLogRecord) == 24, "LapLogRecord layout");
+
+extern const char LAP_LOG_CSV_HEADER[];     // Mit '\n'
+
+// CRC-8 (Polynom 0x07, Start 0)
+uint8_t crc8Update(uint8_t crc, const void* data, size_t length);
+
+// Schreiben
+void lapLogInitHeader(LapLogHeader& header, const char* raceName, uint64_t startTime,
+                      const LapLogTeam* teams, uint16_t teamCount);
+void lapLogInitTeam(LapLogTeam& team, uint8_t teamId, const char* name);
+void lapLogInitRecord(LapLogRecord& record, uint8_t teamIndex, uint8_t flags,
+                      uint16_t lapNumber, uint64_t timestamp, uint32_t duration);
+
+// Prüfen
+bool lapLogCheckHeader(const LapLogHeader& header);     // Format, ohne Checksumme
+uint32_t lapLogHeaderChecksum(const LapLogHeader& header, const LapLogTeam* teams);
+bool lapLogCheckRecord(const LapLogRecord& record);
+bool lapLogIsEmpty(const LapLogRecord& record);         // Vorbelegung, keine Runde
+
+// Eine CSV-Zeile im Format der bisherigen Race-CSV (mit '\n'), Namen mit
+// Komma oder Anführungszeichen werden gequotet. Rückgabe: Länge, 0 = zu lang
+size_t lapLogFormatCsv(char* line, size_t size, const LapLogRecord& record,
+                       uint8_t teamId, const char* teamName, uint64_t startTime);
+
+/**
+ * Liest ein .lap blockweise aus einer geöffneten Datei
+ *
+ * begin() prüft Header und Teamtabelle, next() liefert nur Datensätze mit
+ * gültiger CRC und überspringt leere. Speicher: ein Block Datensätze plus
+ * die Teamtabelle.
+ */
+#define LAP_LOG_READ_RECORDS 21         // 504 Bytes pro Lesezugriff
+
+class LapLogReader {
+public:
+    explicit LapLogReader(fs::File& file);
+
+    bool begin();
+    bool next(LapLogRecord& record);
+
+    const LapLogHeader& getHeader() const { return header; }
+    const std::vector<LapLogTeam>& getTeams() const { return teams; }
+    uint8_t getTeamId(const LapLogRecord& record) const;
+    const char* getTeamName(const LapLogRecord& record) const;     // "" wenn nicht in der Tabelle
+
+    uint32_t getBadRecords() const { return badRecords; }
+    uint32_t getEmptyRecords() const { return emptyRecords; }
+    uint32_t getTruncatedBytes() const { return truncatedBytes; }
+
+    // Gelesene Bytes und ihre CRC-32 (nach dem letzten next() die der ganzen Datei)
+    uint32_t getBytesRead() const { return bytesRead; }
+    uint32_t getChecksum() const { return checksum; }
+
+private:
+    fs::File& file;
+    LapLogHeader header;
+    std::vector<LapLogTeam> teams;
+
+    LapLogRecord buffer[LAP_LOG_READ_RECORDS];
+    uint16_t bufferPos;
+    uint16_t bufferCount;
+
+    uint32_t badRecords;
+    uint32_t emptyRecords;
+    uint32_t truncatedBytes;
+    uint32_t bytesRead;
+    uint32_t checksum;
+
+    size_t readTracked(void* data, size_t length);
+};
+
+#endif // LAP_LOG_H
@@ -0,0 +1,597 @@
+#include "RaceCatalog.h"
+#include "LapLog.h"
+#include "RaceResults.h"
+#include <algorithm>
+
+#define RACE_CATALOG_READ_ENTRIES 4     // 512 Bytes pro Lesezugriff
+
+// ============================================================
+// Einträge
+// ============================================================
+
+static void sealEntry(RaceCatalogEntry& entry) {
+    entry.crc = crc8Update(0, &entry, offsetof(RaceCatalogEntry, crc));
+}
+
+static bool checkEntry(const RaceCatalogEntry& entry) {
+    return crc8Update(0, &entry, offsetof(RaceCatalogEntry, crc)) == entry.crc &&
+           entry.id > 0 && entry.id <= RACE_CATALOG_MAX_RACES &&
+           entry.state >= RACE_RUNNING && entry.state <= RACE_DELETED &&
+           entry.name[RACE_CATALOG_NAME_LEN - 1] == '\0' &&
+           entry.file[RACE_CATALOG_FILE_LEN - 1] == '\0';
+}
+
+// Text in ein festes Feld: abgeschnitten, immer mit '\0' abgeschlossen und
+// mit Nullen aufgefüllt (die CRC sieht das ganze Feld)
+template <size_t N>
+static void setField(char (&field)[N], const char* text) {
+    size_t length = strnlen(text, N - 1);
+    memcpy(field, text, length);
+    memset(field + length, 0, N - length);
+}
+
+static bool isEmptyEntry(const RaceCatalogEntry& entry) {
+    const uint8_t* bytes = (const uint8_t*)&entry;
+    for (size_t i = 0; i < sizeof(entry); i++) {
+        if (bytes[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static String fileName(const String& path) {
+    return path.substring(path.lastIndexOf('/') + 1);
+}
+
+static bool isRaceFile(fs::FS& fs, const String& name) {
+    if (name.endsWith(".lap")) {
+        return true;
+    }
+    // CSV-Export neben seinem Log ist kein eigenes Rennen
+    return name.endsWith(".csv") &&
+           !fs.exists(String(RACE_CATALOG_DIR) + "/" + name.substring(0, name.length() - 4) + ".lap");
+}
+
+static bool containsIgnoreCase(const char* text, const char* pattern) {
+    size_t length = strlen(pattern);
+    if (length == 0) {
+        return true;
+    }
+    for (const char* start = text; *start; start++) {
+        size_t i = 0;
+        while (i < length && start[i] && tolower((uint8_t)start[i]) == tolower((uint8_t)pattern[i])) {
+            i++;
+        }
+        if (i == length) {
+            return true;
+        }
+    }
+    return false;
+}
+
+String RaceCatalog::racePath(const RaceCatalogEntry& entry) {
+    return String(RACE_CATALOG_DIR) + "/" + entry.file;
+}
+
+String RaceCatalog::pinPath(const String& racePath) {
+    int dot = racePath.lastIndexOf('.');
+    return (dot > 0 ? racePath.substring(0, dot) : racePath) + ".pin";
+}
+
+// ============================================================
+// Laden und Neuaufbau
+// ============================================================
+
+RaceCatalog::RaceCatalog()
+    : fs(nullptr), raceCount(0), unpinnedCount(0), unpinnedBytes(0), entryCount(0), catalogBytes(0) {
+}
+
+void RaceCatalog::clear() {
+    slots.clear();
+    raceCount = 0;
+    unpinnedCount = 0;
+    unpinnedBytes = 0;
+    entryCount = 0;
+    catalogBytes = 0;
+}
+
+// Neuer gültiger Eintrag einer ID: alten Stand aus den Zählern nehmen, neuen dazu
+void RaceCatalog::setSlot(const RaceCatalogEntry& entry, uint32_t offset) {
+    if (entry.id > slots.size()) {
+        slots.resize(entry.id, Slot{0, 0, 0});
+    }
+    Slot& slot = slots[entry.id - 1];
+    if (slot.offset != 0) {
+        raceCount--;
+        if (!slot.pinned) {
+            unpinnedCount--;
+            unpinnedBytes -= slot.logBytes;
+        }
+    }
+
+    slot.offset = entry.state == RACE_DELETED ? 0 : offset;
+    slot.logBytes = entry.logBytes & 0x7FFFFFFF;
+    slot.pinned = (entry.flags & RACE_FLAG_PINNED) != 0;
+    if (slot.offset != 0) {
+        raceCount++;
+        if (!slot.pinned) {
+            unpinnedCount++;
+            unpinnedBytes += slot.logBytes;
+        }
+    }
+}
+
+bool RaceCatalog::begin(fs::FS& fs) {
+    this->fs = &fs;
+    if (!load() || !matchesCard()) {
+        return rebuild();
+    }
+    if (entryCount > 2 * raceCount + 16) {
+        compact();
+    }
+    Serial.printf("[RaceCatalog] %lu races (%lu entries)\n",
+                  (unsigned long)raceCount, (unsigned long)entryCount);
+    return true;
+}
+
+bool RaceCatalog::load() {
+    clear();
+    File file = fs->open(RACE_CATALOG_PATH, FILE_READ);
+    if (!file) {
+        return false;
+    }
+
+    RaceCatalogHeader header;
+    uint32_t size = file.size();
+    if (file.read((uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+        header.magic != RACE_CATALOG_MAGIC || header.version != RACE_CATALOG_VERSION ||
+        header.entrySize != sizeof(RaceCatalogEntry) ||
+        (size - sizeof(header)) % sizeof(RaceCatalogEntry) != 0) {
+        // Auch ein halb angehängter Eintrag (Stromausfall) landet hier
+        Serial.println("[RaceCatalog] Catalog invalid or truncated");
+        file.close();
+        return false;
+    }
+
+    // Letzter Eintrag pro ID gewinnt, Nullen = vorbelegter Rest
+    RaceCatalogEntry block[RACE_CATALOG_READ_ENTRIES];
+    uint32_t offset = sizeof(header);
+    bool reserved = false;
+    size_t read;
+    while (!reserved && (read = file.read((uint8_t*)block, sizeof(block))) > 0) {
+        for (size_t i = 0; i < read / sizeof(RaceCatalogEntry); i++) {
+            const RaceCatalogEntry& entry = block[i];
+            if (isEmptyEntry(entry)) {
+                reserved = true;
+                break;
+            }
+            if (!checkEntry(entry)) {
+                Serial.printf("[RaceCatalog] Bad entry at %lu\n", (unsigned long)offset);
+                file.close();
+                clear();
+                return false;
+            }
+            setSlot(entry, offset);
+            offset += sizeof(RaceCatalogEntry);
+            entryCount++;
+        }
+    }
+    file.close();
+
+    catalogBytes = offset;
+    return true;
+}
+
+// Katalog gehört zu dieser Karte: das neueste Rennen existiert, ein leerer
+// Katalog nur bei einem Verzeichnis ohne Rennen
+bool RaceCatalog::matchesCard() {
+    if (raceCount > 0) {
+        File file = fs->open(RACE_CATALOG_PATH, FILE_READ);
+        RaceCatalogEntry entry;
+        uint32_t id = slots.size();
+        while (slots[id - 1].offset == 0) {
+            id--;
+        }
+        bool found = file && readEntry(file, id, entry) && fs->exists(racePath(entry));
+        file.close();
+        return found;
+    }
+
+    File dir = fs->open(RACE_CATALOG_DIR);
+    if (!dir || !dir.isDirectory()) {
+        return true;
+    }
+    bool empty = true;
+    File file = dir.openNextFile();
+    while (file && empty) {
+        empty = !isRaceFile(*fs, file.name());
+        file = dir.openNextFile();
+    }
+    dir.close();
+    return empty;
+}
+
+bool RaceCatalog::rebuild() {
+    clear();
+    if (!fs) {
+        return false;
+    }
+    uint32_t start = millis();
+
+    // Einmal durch /races, älteste zuerst bekommen die kleinsten IDs
+    struct Found {
+        String name;
+        time_t lastWrite;
+    };
+    std::vector<Found> found;
+    File dir = fs->open(RACE_CATALOG_DIR);
+    if (dir && dir.isDirectory()) {
+        File file = dir.openNextFile();
+        while (file) {
+            String name = file.name();
+            if (isRaceFile(*fs, name)) {
+                found.push_back({name, file.getLastWrite()});
+            }
+            file = dir.openNextFile();
+        }
+    }
+    dir.close();
+    std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) {
+        return a.lastWrite != b.lastWrite ? a.lastWrite < b.lastWrite : strcmp(a.name.c_str(), b.name.c_str()) < 0;
+    });
+
+    std::vector<RaceCatalogEntry> entries;
+    for (const Found& race : found) {
+        RaceCatalogEntry entry;
+        if (scanRace(race.name, entry) && entries.size() < RACE_CATALOG_MAX_RACES) {
+            entry.id = entries.size() + 1;
+            entries.push_back(entry);
+        }
+    }
+
+    bool ok = writeAll(entries) && load();
+    Serial.printf("[RaceCatalog] Rebuilt from %s: %lu races in %lu ms%s\n", RACE_CATALOG_DIR,
+                  (unsigned long)raceCount, (unsigned long)(millis() - start), ok ? "" : " - WRITE FAILED");
+    return ok;
+}
+
+// Eintrag für eine vorhandene Datei: Name und Startzeit aus dem Header,
+// Teams und Runden über die .sum (legt sie bei Bedarf an)
+bool RaceCatalog::scanRace(const String& name, RaceCatalogEntry& entry) {
+    memset(&entry, 0, sizeof(entry));
+    if (name.length() >= RACE_CATALOG_FILE_LEN) {
+        Serial.printf("[RaceCatalog] File name too long, skipped: %s\n", name.c_str());
+        return false;
+    }
+    String path = String(RACE_CATALOG_DIR) + "/" + name;
+    setField(entry.file, name.c_str());
+    entry.state = RACE_FINISHED;
+    if (fs->exists(pinPath(path))) {
+        entry.flags |= RACE_FLAG_PINNED;
+    }
+
+    RaceResults results;
+    bool loaded = results.loadRace(*fs, path);
+    File file = fs->open(path, FILE_READ);
+    if (!file) {
+        return false;
+    }
+    entry.logBytes = file.size();
+    if (name.endsWith(".lap")) {
+        LapLogReader reader(file);
+        if (!reader.begin()) {
+            file.close();
+            return false;
+        }
+        const LapLogHeader& header = reader.getHeader();
+        setField(entry.name, header.raceName);
+        entry.startTime = header.startTime;
+        entry.teamCount = header.teamCount;
+    } else {
+        setField(entry.name, name.substring(0, name.length() - 4).c_str());
+        entry.teamCount = results.getTeamCount();
+    }
+    file.close();
+    entry.lapCount = loaded ? results.getLapCount() : 0;
+    return true;
+}
+
+// Nur die gültigen Einträge, nach ID
+bool RaceCatalog::compact() {
+    std::vector<RaceCatalogEntry> entries;
+    entries.reserve(raceCount);
+    forEachRace([&entries](const RaceCatalogEntry& entry) {
+        entries.push_back(entry);
+        return true;
+    });
+    std::sort(entries.begin(), entries.end(), [](const RaceCatalogEntry& a, const RaceCatalogEntry& b) {
+        return a.id < b.id;
+    });
+
+    uint32_t before = entryCount;
+    bool ok = writeAll(entries) && load();
+    Serial.printf("[RaceCatalog] Compacted %lu -> %lu entries%s\n",
+                  (unsigned long)before, (unsigned long)entryCount, ok ? "" : " - WRITE FAILED");
+    return ok;
+}
+
+// Neue Datei daneben schreiben und erst dann ersetzen
+bool RaceCatalog::writeAll(const std::vector<RaceCatalogEntry>& entries) {
+    String tmpPath = String(RACE_CATALOG_PATH) + ".tmp";
+    File file = fs->open(tmpPath, FILE_WRITE);
+    if (!file) {
+        return false;
+    }
+
+    RaceCatalogHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = RACE_CATALOG_MAGIC;
+    header.version = RACE_CATALOG_VERSION;
+    header.entrySize = sizeof(RaceCatalogEntry);
+    bool ok = file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header);
+    for (size_t i = 0; ok && i < entries.size(); i++) {
+        RaceCatalogEntry entry = entries[i];
+        sealEntry(entry);
+        ok = file.write((const uint8_t*)&entry, sizeof(entry)) == sizeof(entry);
+    }
+    file.close();
+
+    if (!ok) {
+        fs->remove(tmpPath);
+        return false;
+    }
+    fs->remove(RACE_CATALOG_PATH);
+    return fs->rename(tmpPath, RACE_CATALOG_PATH);
+}
+
+bool RaceCatalog::reserve(uint32_t entries) {
+    if (!fs || entries == 0) {
+        return true;
+    }
+    File file = fs->open(RACE_CATALOG_PATH, "r+");
+    if (!file) {
+        return false;
+    }
+    uint32_t size = file.size();
+    uint32_t target = catalogBytes + entries * sizeof(RaceCatalogEntry);
+    bool ok = file.seek(size);
+    RaceCatalogEntry zero[RACE_CATALOG_READ_ENTRIES];
+    memset(zero, 0, sizeof(zero));
+    while (ok && size < target) {
+        size_t chunk = target - size < sizeof(zero) ? target - size : sizeof(zero);
+        ok = file.write((const uint8_t*)zero, chunk) == chunk;
+        size += chunk;
+    }
+    file.close();
+    return ok;
+}
+
+// ============================================================
+// Ändern (nur anhängen)
+// ============================================================
+
+bool RaceCatalog::append(RaceCatalogEntry& entry) {
+    if (!fs) {
+        return false;
+    }
+    // Hinter den letzten Eintrag, in der Vorbelegung oder am Dateiende
+    sealEntry(entry);
+    File file = fs->open(RACE_CATALOG_PATH, "r+");
+    bool ok = file && file.seek(catalogBytes) &&
+              file.write((const uint8_t*)&entry, sizeof(entry)) == sizeof(entry);
+    file.close();
+    if (!ok) {
+        Serial.printf("[RaceCatalog] ERROR: Failed to append entry %lu\n", (unsigned long)entry.id);
+        return false;
+    }
+
+    setSlot(entry, catalogBytes);
+    catalogBytes += sizeof(entry);
+    entryCount++;
+    return true;
+}
+
+uint32_t RaceCatalog::addRace(const String& path, const char* name, uint64_t startTime, uint16_t teamCount) {
+    String file = fileName(path);
+    uint32_t id = slots.size() + 1;
+    if (file.length() >= RACE_CATALOG_FILE_LEN || id > RACE_CATALOG_MAX_RACES) {
+        Serial.printf("[RaceCatalog] ERROR: Cannot add %s\n", path.c_str());
+        return 0;
+    }
+
+    RaceCatalogEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.id = id;
+    entry.state = RACE_RUNNING;
+    entry.teamCount = teamCount;
+    entry.startTime = startTime;
+    setField(entry.name, name);
+    setField(entry.file, file.c_str());
+    return append(entry) ? id : 0;
+}
+
+bool RaceCatalog::finishRace(uint32_t id, uint32_t lapCount, uint32_t logBytes) {
+    if (!fs || id == 0 || id > slots.size() || slots[id - 1].offset == 0) {
+        return false;
+    }
+    File file = fs->open(RACE_CATALOG_PATH, FILE_READ);
+    RaceCatalogEntry entry;
+    bool found = file && readEntry(file, id, entry);
+    file.close();
+    if (!found) {
+        return false;
+    }
+
+    entry.state = RACE_FINISHED;
+    entry.lapCount = lapCount;
+    entry.logBytes = logBytes;
+    return append(entry);
+}
+
+bool RaceCatalog::removeRace(const String& path) {
+    RaceCatalogEntry entry;
+    if (!find(path, entry)) {
+        return false;
+    }
+    entry.state = RACE_DELETED;
+    return append(entry);
+}
+
+// Pin steht auch als leere Datei race.pin neben dem Log, damit er einen
+// Neuaufbau des Katalogs übersteht
+bool RaceCatalog::setPinned(const String& path, bool pinned) {
+    RaceCatalogEntry entry;
+    if (!find(path, entry)) {
+        return false;
+    }
+    String marker = pinPath(racePath(entry));
+    if (pinned) {
+        File file = fs->open(marker, FILE_WRITE);
+        file.close();
+        entry.flags |= RACE_FLAG_PINNED;
+    } else {
+        fs->remove(marker);
+        entry.flags &= ~RACE_FLAG_PINNED;
+    }
+    return append(entry);
+}
+
+// ============================================================
+// Abfragen
+// ============================================================
+
+bool RaceCatalog::readEntry(fs::File& file, uint32_t id, RaceCatalogEntry& entry) {
+    return id > 0 && id <= slots.size() && slots[id - 1].offset != 0 &&
+           file.seek(slots[id - 1].offset) &&
+           file.read((uint8_t*)&entry, sizeof(entry)) == sizeof(entry) &&
+           checkEntry(entry) && entry.id == id;
+}
+
+// Gültige Einträge in Dateireihenfolge, blockweise gelesen. false vom visitor = fertig
+bool RaceCatalog::forEachRace(const std::function<bool(const RaceCatalogEntry&)>& visitor) {
+    if (!fs) {
+        return false;
+    }
+    File file = fs->open(RACE_CATALOG_PATH, FILE_READ);
+    if (!file || !file.seek(sizeof(RaceCatalogHeader))) {
+        return false;
+    }
+
+    RaceCatalogEntry block[RACE_CATALOG_READ_ENTRIES];
+    uint32_t offset = sizeof(RaceCatalogHeader);
+    size_t read;
+    while ((read = file.read((uint8_t*)block, sizeof(block))) > 0) {
+        for (size_t i = 0; i < read / sizeof(RaceCatalogEntry); i++) {
+            const RaceCatalogEntry& entry = block[i];
+            bool current = entry.id > 0 && entry.id <= slots.size() && slots[entry.id - 1].offset == offset;
+            offset += sizeof(RaceCatalogEntry);
+            if (current && !visitor(entry)) {
+                file.close();
+                return true;
+            }
+        }
+    }
+    file.close();
+    return true;
+}
+
+uint16_t RaceCatalog::getPage(uint32_t page, uint16_t pageSize, std::vector<RaceCatalogEntry>& entries) {
+    entries.clear();
+    if (!fs || pageSize == 0) {
+        return 0;
+    }
+    File file = fs->open(RACE_CATALOG_PATH, FILE_READ);
+    if (!file) {
+        return 0;
+    }
+
+    // IDs absteigend = neueste zuerst, ein seek + read pro Rennen der Seite
+    std::vector<RaceCatalogEntry> missing;
+    uint32_t skip = page * pageSize;
+    for (uint32_t id = slots.size(); id > 0 && entries.size() < pageSize; id--) {
+        if (slots[id - 1].offset == 0) {
+            continue;
+        }
+        if (skip > 0) {
+            skip--;
+            continue;
+        }
+        RaceCatalogEntry entry;
+        if (!readEntry(file, id, entry)) {
+            continue;
+        }
+        if (!fs->exists(racePath(entry))) {
+            missing.push_back(entry);
+            continue;
+        }
+        entries.push_back(entry);
+    }
+    file.close();
+
+    // Am PC gelöschte Rennen austragen
+    for (RaceCatalogEntry& entry : missing) {
+        Serial.printf("[RaceCatalog] Missing, removed: %s\n", entry.file);
+        entry.state = RACE_DELETED;
+        append(entry);
+    }
+    return entries.size();
+}
+
+uint16_t RaceCatalog::search(const String& text, std::vector<RaceCatalogEntry>& entries, uint16_t maxResults) {
+    entries.clear();
+    if (maxResults == 0) {
+        return 0;
+    }
+
+    // Nur die maxResults neuesten Treffer behalten
+    auto newer = [](const RaceCatalogEntry& a, const RaceCatalogEntry& b) { return a.id > b.id; };
+    forEachRace([&](const RaceCatalogEntry& entry) {
+        if (!containsIgnoreCase(entry.name, text.c_str()) && !containsIgnoreCase(entry.file, text.c_str())) {
+            return true;
+        }
+        if (entries.size() < maxResults) {
+            entries.push_back(entry);
+            std::push_heap(entries.begin(), entries.end(), newer);
+        } else if (entry.id > entries.front().id) {
+            std::pop_heap(entries.begin(), entries.end(), newer);
+            entries.back() = entry;
+            std::push_heap(entries.begin(), entries.end(), newer);
+        }
+        return true;
+    });
+    std::sort(entries.begin(), entries.end(), newer);
+    return entries.size();
+}
+
+bool RaceCatalog::find(const String& path, RaceCatalogEntry& entry) {
+    String name = fileName(path);
+    bool found = false;
+    forEachRace([&](const RaceCatalogEntry& candidate) {
+        if (name == candidate.file) {
+            entry = candidate;
+            found = true;
+        }
+        return !found;
+    });
+    return found;
+}
+
+bool RaceCatalog::findOldestUnpinned(RaceCatalogEntry& entry, uint32_t excludeId) {
+    if (!fs || unpinnedCount == 0) {
+        return false;
+    }
+    File file = fs->open(RACE_CATALOG_PATH, FILE_READ);
+    if (!file) {
+        return false;
+    }
+    bool found = false;
+    for (uint32_t id = 1; id <= slots.size() && !found; id++) {
+        const Slot& slot = slots[id - 1];
+        if (slot.offset != 0 && !slot.pinned && id != excludeId) {
+            found = readEntry(file, id, entry);
+        }
+    }
+    file.close();
+    return found;
+}
@@ -0,0 +1,134 @@
+#ifndef RACE_CATALOG_H
+#define RACE_CATALOG_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <functional>
+#include <vector>
+
+/**
+ * Katalog der gespeicherten Rennen (/races/catalog.idx)
+ *
+ * Statt /races bei jeder Rennliste aufzuzählen und nach Änderungsdatum zu
+ * sortieren, steht jedes Rennen als Eintrag fester Größe in einer Datei,
+ * die nur angehängt wird:
+ *   RaceCatalogHeader
+ *   RaceCatalogEntry...     eigene CRC-8 pro Eintrag
+ *
+ * startNewRace() hängt einen Eintrag an (RACE_RUNNING), finishRace() einen
+ * zweiten mit derselben ID und Teams/Runden (RACE_FINISHED), Löschen einen
+ * mit RACE_DELETED, Anheften (RACE_FLAG_PINNED, von der Aufräumregel des
+ * DataLoggers ausgenommen) ebenso. Es gilt jeweils der letzte Eintrag einer
+ * ID. Im RAM liegen nur dessen Position, Loggröße und Pin pro ID (8 Bytes
+ * pro Rennen), Seiten werden direkt aus der Datei gelesen. IDs sind fortlaufend, neuere Rennen haben
+ * größere IDs - "neueste zuerst" braucht keine Sortierung.
+ *
+ * begin() lädt den Katalog und baut ihn aus dem Verzeichnis neu auf, wenn
+ * er fehlt, kaputt ist oder nicht zur Karte passt (neuestes Rennen fehlt,
+ * z.B. nach einem Kartenwechsel). Einträge, deren Datei inzwischen fehlt,
+ * entfernt getPage() beim Anzeigen. Überholte Einträge werden beim Laden
+ * weggeräumt, sobald sie die Mehrheit stellen.
+ *
+ * reserve() legt Platz für weitere Einträge als Nullen an (nach dem
+ * Formatieren: zusammenhängend am Kartenanfang). Ein Eintrag aus lauter
+ * Nullen beendet den Katalog, angehängt wird dann an seiner Stelle.
+ */
+
+#define RACE_CATALOG_PATH "/races/catalog.idx"
+#define RACE_CATALOG_DIR "/races"
+#define RACE_CATALOG_MAGIC 0x3143524D   // "MRC1"
+#define RACE_CATALOG_VERSION 1
+#define RACE_CATALOG_NAME_LEN 32
+#define RACE_CATALOG_FILE_LEN 56
+#define RACE_CATALOG_MAX_RACES 4096     // IDs darüber gelten als kaputt
+
+// Eintrags-Flags
+#define RACE_FLAG_PINNED 0x01           // Archiviert, wird nie automatisch gelöscht
+
+enum RaceCatalogState : uint8_t {
+    RACE_RUNNING = 1,       // Gestartet; nach einem Neustart: nie beendet
+    RACE_FINISHED = 2,
+    RACE_DELETED = 3
+};
+
+struct RaceCatalogHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entrySize;         // sizeof(RaceCatalogEntry)
+    uint32_t reserved[2];
+};
+
+struct RaceCatalogEntry {
+    uint32_t id;                // Ab 1, fortlaufend
+    uint8_t state;              // RaceCatalogState
+    uint8_t flags;              // RACE_FLAG_*
+    uint16_t teamCount;
+    uint32_t lapCount;
+    uint32_t logBytes;          // Größe des Logs bei finishRace() (wie sourceSize der .sum)
+    uint64_t startTime;         // ms, wie LapLogHeader::startTime
+    char name[RACE_CATALOG_NAME_LEN];
+    char file[RACE_CATALOG_FILE_LEN];   // Dateiname in /races
+    uint8_t reserved[15];
+    uint8_t crc;                // CRC-8 über die Bytes davor
+};
+
+static_assert(sizeof(RaceCatalogHeader) == 16, "RaceCatalogHeader layout");
+static_assert(sizeof(RaceCatalogEntry) == 128, "RaceCatalogEntry layout");
+
+class RaceCatalog {
+public:
+    RaceCatalog();
+
+    // Laden, bei Bedarf aus /races neu aufbauen
+    bool begin(fs::FS& fs);
+    bool rebuild();
+    bool reserve(uint32_t entries);     // Platz für so viele weitere Einträge vorbelegen
+
+    // Neues Rennen, Rückgabe: ID (0 = Fehler)
+    uint32_t addRace(const String& path, const char* name, uint64_t startTime, uint16_t teamCount);
+    bool finishRace(uint32_t id, uint32_t lapCount, uint32_t logBytes);
+    bool removeRace(const String& path);
+    bool setPinned(const String& path, bool pinned);
+
+    // Seite page (ab 0) mit bis zu pageSize Rennen, neueste zuerst
+    uint16_t getPage(uint32_t page, uint16_t pageSize, std::vector<RaceCatalogEntry>& entries);
+    // Rennen, deren Name oder Datei text enthält (ohne Groß/Klein), neueste zuerst
+    uint16_t search(const String& text, std::vector<RaceCatalogEntry>& entries, uint16_t maxResults);
+    bool find(const String& path, RaceCatalogEntry& entry);
+    // Ältestes nicht angeheftetes Rennen außer excludeId (laufendes Rennen)
+    bool findOldestUnpinned(RaceCatalogEntry& entry, uint32_t excludeId);
+
+    uint32_t getRaceCount() const { return raceCount; }
+    uint32_t getUnpinnedCount() const { return unpinnedCount; }
+    uint64_t getUnpinnedBytes() const { return unpinnedBytes; }     // Summe logBytes
+    uint32_t getEntryCount() const { return entryCount; }
+    static String racePath(const RaceCatalogEntry& entry);
+    static String pinPath(const String& racePath);      // race.lap -> race.pin
+
+private:
+    fs::FS* fs;
+    struct Slot {
+        uint32_t offset;            // Position des gültigen Eintrags, 0 = keiner
+        uint32_t logBytes : 31;
+        uint32_t pinned : 1;
+    };
+    std::vector<Slot> slots;        // ID - 1
+    uint32_t raceCount;
+    uint32_t unpinnedCount;
+    uint64_t unpinnedBytes;
+    uint32_t entryCount;
+    uint32_t catalogBytes;
+
+    bool load();
+    bool matchesCard();
+    bool compact();
+    bool writeAll(const std::vector<RaceCatalogEntry>& entries);
+    bool append(RaceCatalogEntry& entry);
+    void setSlot(const RaceCatalogEntry& entry, uint32_t offset);
+    bool readEntry(fs::File& file, uint32_t id, RaceCatalogEntry& entry);
+    bool forEachRace(const std::function<bool(const RaceCatalogEntry&)>& visitor);
+    bool scanRace(const String& fileName, RaceCatalogEntry& entry);
+    void clear();
+};
+
+#endif // RACE_CATALOG_H
@@ -0,0 +1,214 @@
+#include "RaceResults.h"
+#include "CsvReader.h"
+#include "LapLog.h"
+#include <algorithm>
+
+bool RaceResults::parseCSV(const String& content) {
+    CsvReader reader(content.c_str(), content.length());
+    return parse(reader);
+}
+
+bool RaceResults::parseFile(fs::File& file) {
+    CsvReader reader(file);
+    return parse(reader);
+}
+
+bool RaceResults::parse(CsvReader& reader) {
+    clear();
+    
+    // Header überspringen
+    if (!reader.next()) {
+        return false;
+    }
+    
+    while (reader.next()) {
+        // Felder: 0=Team ID, 1=Team Name, 2=Lap Number, 3=Timestamp, 4=Duration, 5=Time of Day
+        if (reader.getFieldCount() < 6) {
+            continue;
+        }
+        
+        const CsvField& name = reader.getField(1);
+        addLap(reader.getField(0).toUInt(), name.data, name.length, reader.getField(4).toUInt());
+    }
+    
+    sourceChecksum = reader.getChecksum();
+    return !teams.empty();
+}
+
+bool RaceResults::parseLapLog(fs::File& file) {
+    LapLogReader reader(file);
+    return parse(reader);
+}
+
+bool RaceResults::parse(LapLogReader& reader) {
+    clear();
+    
+    if (!reader.begin()) {
+        return false;
+    }
+    
+    LapLogRecord record;
+    char fallback[12];
+    while (reader.next(record)) {
+        uint8_t teamId = reader.getTeamId(record);
+        const char* name = reader.getTeamName(record);
+        if (name[0] == '\0') {
+            // Team erst nach dem Start angelegt, Name steht nicht in der Tabelle
+            snprintf(fallback, sizeof(fallback), "Team %u", teamId);
+            name = fallback;
+        }
+        addLap(teamId, name, strlen(name), record.duration);
+    }
+    
+    if (reader.getBadRecords() > 0 || reader.getTruncatedBytes() > 0) {
+        Serial.printf("[RaceResults] Lap log: %lu bad records, %lu trailing bytes skipped\n",
+                      (unsigned long)reader.getBadRecords(), (unsigned long)reader.getTruncatedBytes());
+    }
+    sourceChecksum = reader.getChecksum();
+    return !teams.empty();
+}
+
+void RaceResults::addLap(uint8_t teamId, const char* teamName, uint16_t nameLength, uint32_t duration) {
+    auto it = teams.find(teamId);
+    if (it == teams.end()) {
+        RaceTeamStats stats;
+        stats.teamId = teamId;
+        stats.teamName.concat(teamName, nameLength);
+        it = teams.insert(std::make_pair(teamId, stats)).first;
+    }
+    
+    RaceTeamStats& stats = it->second;
+    stats.lapCount++;
+    stats.totalDuration += duration;
+    if (duration < stats.bestLapDuration) {
+        stats.bestLapDuration = duration;
+    }
+    lapCount++;
+}
+
+// ============================================================
+// Zusammenfassung
+// ============================================================
+
+String RaceResults::summaryPath(const String& racePath) {
+    String path = racePath;
+    if (path.endsWith(".csv") || path.endsWith(".lap")) {
+        path = path.substring(0, path.length() - 4);
+    }
+    return path + ".sum";
+}
+
+bool RaceResults::writeSummary(fs::File& file, uint32_t sourceSize, uint32_t sourceChecksum) const {
+    std::vector<const RaceTeamStats*> leaderboard = getLeaderboard();
+    std::vector<RaceSummaryEntry> entries(leaderboard.size());
+    for (size_t i = 0; i < leaderboard.size(); i++) {
+        const RaceTeamStats* stats = leaderboard[i];
+        RaceSummaryEntry& entry = entries[i];
+        memset(&entry, 0, sizeof(entry));
+        entry.teamId = stats->teamId;
+        entry.rank = i + 1;
+        entry.lapCount = stats->lapCount;
+        entry.bestLapDuration = stats->bestLapDuration;
+        entry.totalDuration = stats->totalDuration;
+        strncpy(entry.teamName, stats->teamName.c_str(), RACE_SUMMARY_NAME_LEN - 1);
+    }
+    
+    RaceSummaryHeader header;
+    header.magic = RACE_SUMMARY_MAGIC;
+    header.version = RACE_SUMMARY_VERSION;
+    header.teamCount = entries.size();
+    header.sourceSize = sourceSize;
+    header.sourceChecksum = sourceChecksum;
+    header.lapCount = lapCount;
+    header.entriesChecksum = crc32Update(0, entries.data(), entries.size() * sizeof(RaceSummaryEntry));
+    
+    size_t size = entries.size() * sizeof(RaceSummaryEntry);
+    return file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+           file.write((const uint8_t*)entries.data(), size) == size;
+}
+
+bool RaceResults::readSummary(fs::File& file, uint32_t sourceSize) {
+    clear();
+    
+    RaceSummaryHeader header;
+    if (file.read((uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+        header.magic != RACE_SUMMARY_MAGIC || header.version != RACE_SUMMARY_VERSION ||
+        header.sourceSize != sourceSize) {
+        return false;
+    }
+    
+    std::vector<RaceSummaryEntry> entries(header.teamCount);
+    size_t size = entries.size() * sizeof(RaceSummaryEntry);
+    if (file.read((uint8_t*)entries.data(), size) != size ||
+        crc32Update(0, entries.data(), size) != header.entriesChecksum) {
+        return false;
+    }
+    
+    for (const RaceSummaryEntry& entry : entries) {
+        RaceTeamStats stats;
+        stats.teamId = entry.teamId;
+        stats.teamName.concat(entry.teamName, strnlen(entry.teamName, RACE_SUMMARY_NAME_LEN));
+        stats.lapCount = entry.lapCount;
+        stats.bestLapDuration = entry.bestLapDuration;
+        stats.totalDuration = entry.totalDuration;
+        teams[entry.teamId] = stats;
+    }
+    lapCount = header.lapCount;
+    sourceChecksum = header.sourceChecksum;
+    fromSummary = true;
+    return !teams.empty();
+}
+
+bool RaceResults::loadRace(fs::FS& fs, const String& racePath) {
+    File source = fs.open(racePath, FILE_READ);
+    if (!source) {
+        clear();
+        return false;
+    }
+    uint32_t sourceSize = source.size();
+    
+    String sumPath = summaryPath(racePath);
+    File summary = fs.open(sumPath, FILE_READ);
+    if (summary) {
+        bool loaded = readSummary(summary, sourceSize);
+        summary.close();
+        if (loaded) {
+            source.close();
+            return true;
+        }
+        Serial.printf("[RaceResults] Summary stale or invalid, rebuilding: %s\n", sumPath.c_str());
+    }
+    
+    // Neu aufbauen: einmal streamen, dann für das nächste Mal ablegen
+    bool parsed = racePath.endsWith(".lap") ? parseLapLog(source) : parseFile(source);
+    source.close();
+    if (parsed) {
+        File out = fs.open(sumPath, FILE_WRITE);
+        if (out) {
+            writeSummary(out, sourceSize, sourceChecksum);
+            out.close();
+        }
+    }
+    return parsed;
+}
+
+// ============================================================
+// Rangliste
+// ============================================================
+
+std::vector<const RaceTeamStats*> RaceResults::getLeaderboard() const {
+    std::vector<const RaceTeamStats*> leaderboard;
+    for (auto& pair : teams) {
+        leaderboard.push_back(&pair.second);
+    }
+    
+    std::sort(leaderboard.begin(), leaderboard.end(),
+              [](const RaceTeamStats* a, const RaceTeamStats* b) {
+                  if (a->lapCount != b->lapCount) {
+                      return a->lapCount > b->lapCount;
+                  }
+                  return a->bestLapDuration < b->bestLapDuration;
+              });
+    
+    return leaderboard;
+}
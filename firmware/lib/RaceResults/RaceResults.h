@@ -0,0 +1,104 @@
+#ifndef RACE_RESULTS_H
+#define RACE_RESULTS_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <map>
+#include <vector>
+
+/**
+ * Auswertung gespeicherter Rennen
+ * 
+ * Liest das Runden-Log des DataLoggers (.lap, siehe LapLog.h) oder eine
+ * Race-CSV (ältere Rennen, Export) und berechnet pro Team Rundenanzahl,
+ * beste Runde und Gesamtzeit.
+ * CSV-Format: Team ID,Team Name,Lap Number,Timestamp,Duration,Time of Day
+ *
+ * Ein Durchlauf über LapLogReader bzw. CsvReader: die Datei wird nie ganz
+ * geladen, Speicher wächst nur mit der Anzahl der Teams.
+ *
+ * Zusammenfassung: neben race.lap liegt race.sum (binär, fertige Rangliste
+ * mit Größe und CRC-32 der Quelldatei). loadRace() liest nur die - O(Teams),
+ * unabhängig von der Renndauer. Fehlt sie oder passt die Größe der Quelle
+ * nicht mehr, wird die Quelle einmal gestreamt und die .sum neu geschrieben.
+ */
+
+class CsvReader;
+class LapLogReader;
+
+#define RACE_SUMMARY_MAGIC 0x3153524D   // "MRS1"
+#define RACE_SUMMARY_VERSION 1
+#define RACE_SUMMARY_NAME_LEN 24
+
+struct RaceSummaryHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t teamCount;
+    uint32_t sourceSize;        // Bytes der Quelle (.lap/.csv) beim Schreiben (Staleness-Check)
+    uint32_t sourceChecksum;    // CRC-32 der Quelle
+    uint32_t lapCount;
+    uint32_t entriesChecksum;   // CRC-32 der Einträge dahinter
+};
+
+// Ein Eintrag pro Team, nach Rang sortiert
+struct RaceSummaryEntry {
+    uint8_t teamId;
+    uint8_t rank;               // 1 = Sieger
+    uint16_t lapCount;
+    uint32_t bestLapDuration;   // ms, UINT32_MAX = keine
+    uint32_t totalDuration;     // ms
+    char teamName[RACE_SUMMARY_NAME_LEN];
+};
+
+struct RaceTeamStats {
+    uint8_t teamId;
+    String teamName;
+    uint16_t lapCount;
+    uint32_t bestLapDuration;    // ms
+    uint32_t totalDuration;      // ms
+    
+    RaceTeamStats() : teamId(0), lapCount(0), bestLapDuration(UINT32_MAX), totalDuration(0) {}
+};
+
+class RaceResults {
+public:
+    // CSV-Inhalt (inkl. Header-Zeile) auswerten, ersetzt vorherige Daten
+    bool parseCSV(const String& content);
+    // Dasselbe blockweise aus einer geöffneten Datei
+    bool parseFile(fs::File& file);
+    // Zeilen aus einem beliebigen Reader (erste Zeile = Header)
+    bool parse(CsvReader& reader);
+    // Binäres Runden-Log, Datensätze mit falscher CRC werden übersprungen
+    bool parseLapLog(fs::File& file);
+    bool parse(LapLogReader& reader);
+    
+    // Eine Runde hinzufügen (beim Loggen mitzählen statt später neu parsen)
+    void addLap(uint8_t teamId, const char* teamName, uint16_t nameLength, uint32_t duration);
+    
+    // Zusammenfassung schreiben/lesen. readSummary() ist false bei falschem
+    // Format, kaputten Einträgen oder wenn sourceSize nicht passt (veraltet)
+    bool writeSummary(fs::File& file, uint32_t sourceSize, uint32_t sourceChecksum) const;
+    bool readSummary(fs::File& file, uint32_t sourceSize);
+    static String summaryPath(const String& racePath);
+    
+    // Vergangenes Rennen: Zusammenfassung, sonst Quelle streamen und .sum
+    // neu anlegen. .lap als Runden-Log, alles andere als CSV
+    bool loadRace(fs::FS& fs, const String& racePath);
+    bool isFromSummary() const { return fromSummary; }
+    uint32_t getSourceChecksum() const { return sourceChecksum; }
+    
+    // Rangliste: Runden absteigend, dann beste Runde aufsteigend
+    std::vector<const RaceTeamStats*> getLeaderboard() const;
+    
+    uint8_t getTeamCount() const { return teams.size(); }
+    uint32_t getLapCount() const { return lapCount; }
+    void clear() { teams.clear(); lapCount = 0; fromSummary = false; sourceChecksum = 0; }
+    
+private:
+    std::map<uint8_t, RaceTeamStats> teams;
+    uint32_t lapCount = 0;
+    bool fromSummary = false;
+    uint32_t sourceChecksum = 0;
+};
+
+#endif // RACE_RESULTS_H
@@ -0,0 +1,243 @@
+#include "RssiLog.h"
+#include "CsvReader.h"
+
+#define RSSI_LOG_NO_RUN 0xFFFF
+#define RSSI_LOG_COUNT_BYTES 2          // Varint für count <= RSSI_LOG_BLOCK_BYTES
+
+// ============================================================
+// Varint / Zigzag
+// ============================================================
+
+static uint32_t zigzag(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static size_t varintSize(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+static size_t writeVarint(uint8_t* out, uint64_t value) {
+    size_t size = 0;
+    while (value >= 0x80) {
+        out[size++] = (uint8_t)value | 0x80;
+        value >>= 7;
+    }
+    out[size++] = (uint8_t)value;
+    return size;
+}
+
+// false: über end hinaus oder länger als 64 Bit
+static bool readVarint(const uint8_t*& in, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && in < end; shift += 7) {
+        uint8_t byte = *in++;
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================
+// Encoder
+// ============================================================
+
+RssiFrameEncoder::RssiFrameEncoder() {
+    clear();
+}
+
+void RssiFrameEncoder::clear() {
+    memset(runOf, 0xFF, sizeof(runOf));
+    runs.clear();
+    arenaBytes = 0;
+    sampleCount = 0;
+    baseTime = 0;
+    encodedBytes = sizeof(RssiFrameHeader);
+}
+
+bool RssiFrameEncoder::add(uint8_t teamId, uint32_t timestamp, int8_t rssi) {
+    if (sampleCount == 0) {
+        baseTime = timestamp;
+    }
+
+    // Erstes Sample des Teams im Block: Run-Kopf mit Zeit und RSSI
+    uint16_t index = runOf[teamId];
+    if (index == RSSI_LOG_NO_RUN) {
+        size_t need = 1 + RSSI_LOG_COUNT_BYTES +
+                      varintSize(zigzag((int32_t)(timestamp - baseTime))) + 1;
+        if (encodedBytes + need > RSSI_LOG_BLOCK_BYTES) {
+            return false;
+        }
+        Run run;
+        run.firstTime = timestamp;
+        run.lastTime = timestamp;
+        run.lastDelta = 0;
+        run.count = 1;
+        run.bodyBytes = 0;
+        run.teamId = teamId;
+        run.firstRssi = rssi;
+        run.lastRssi = rssi;
+        runOf[teamId] = runs.size();
+        runs.push_back(run);
+        encodedBytes += need;
+        sampleCount++;
+        return true;
+    }
+
+    // Weitere: Abstands-Änderung und RSSI-Differenz in einem Varint
+    Run& run = runs[index];
+    int32_t delta = (int32_t)(timestamp - run.lastTime);
+    uint32_t rssiDelta = zigzag(rssi - run.lastRssi);
+    bool escape = rssiDelta >= RSSI_LOG_RSSI_ESCAPE;
+    uint64_t value = ((uint64_t)zigzag(delta - run.lastDelta) << 3) |
+                     (escape ? RSSI_LOG_RSSI_ESCAPE : rssiDelta);
+    size_t need = varintSize(value) + (escape ? 1 : 0);
+    if (encodedBytes + need > RSSI_LOG_BLOCK_BYTES || arenaBytes + 1 + need > sizeof(arena)) {
+        return false;
+    }
+
+    arena[arenaBytes++] = teamId;
+    arenaBytes += writeVarint(arena + arenaBytes, value);
+    if (escape) {
+        arena[arenaBytes++] = (uint8_t)rssi;
+    }
+    run.lastTime = timestamp;
+    run.lastDelta = delta;
+    run.lastRssi = rssi;
+    run.count++;
+    run.bodyBytes += need;
+    encodedBytes += need;
+    sampleCount++;
+    return true;
+}
+
+size_t RssiFrameEncoder::finish(uint8_t* block) {
+    memset(block, 0, RSSI_LOG_BLOCK_BYTES);
+    uint8_t* payload = block + sizeof(RssiFrameHeader);
+
+    // Run-Köpfe schreiben, dahinter Platz für die Samples des Teams
+    std::vector<uint16_t> cursor(runs.size());
+    size_t offset = 0;
+    for (size_t i = 0; i < runs.size(); i++) {
+        const Run& run = runs[i];
+        payload[offset++] = run.teamId;
+        offset += writeVarint(payload + offset, run.count);
+        offset += writeVarint(payload + offset, zigzag((int32_t)(run.firstTime - baseTime)));
+        payload[offset++] = (uint8_t)run.firstRssi;
+        cursor[i] = offset;
+        offset += run.bodyBytes;
+    }
+
+    // Ein Durchgang durch die Arena, jedes Sample an den Cursor seines Teams
+    size_t pos = 0;
+    while (pos < arenaBytes) {
+        uint16_t index = runOf[arena[pos++]];
+        size_t start = pos;
+        bool escape = (arena[pos] & 0x07) == RSSI_LOG_RSSI_ESCAPE;
+        while (arena[pos++] & 0x80) {
+        }
+        if (escape) {
+            pos++;
+        }
+        memcpy(payload + cursor[index], arena + start, pos - start);
+        cursor[index] += pos - start;
+    }
+
+    RssiFrameHeader header;
+    header.magic = RSSI_LOG_MAGIC;
+    header.version = RSSI_LOG_VERSION;
+    header.payloadBytes = offset;
+    header.baseTime = baseTime;
+    header.sampleCount = sampleCount;
+    header.runCount = runs.size();
+    header.checksum = 0;
+    uint32_t crc = crc32Update(0, &header, sizeof(header));
+    header.checksum = crc32Update(crc, payload, offset);
+    memcpy(block, &header, sizeof(header));
+    return sizeof(header) + offset;
+}
+
+// ============================================================
+// Decoder
+// ============================================================
+
+bool rssiLogIsEmpty(const uint8_t* block) {
+    for (size_t i = 0; i < RSSI_LOG_BLOCK_BYTES; i++) {
+        if (block[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool rssiLogDecodeBlock(const uint8_t* block, std::vector<RssiSample>& samples) {
+    RssiFrameHeader header;
+    memcpy(&header, block, sizeof(header));
+    if (header.magic != RSSI_LOG_MAGIC || header.version != RSSI_LOG_VERSION ||
+        header.payloadBytes > RSSI_LOG_BLOCK_BYTES - sizeof(header)) {
+        return false;
+    }
+    const uint8_t* in = block + sizeof(header);
+    const uint8_t* end = in + header.payloadBytes;
+    uint32_t checksum = header.checksum;
+    header.checksum = 0;
+    if (crc32Update(crc32Update(0, &header, sizeof(header)), in, header.payloadBytes) != checksum) {
+        return false;
+    }
+
+    size_t first = samples.size();
+    for (uint16_t r = 0; r < header.runCount; r++) {
+        uint64_t count;
+        uint64_t offset;
+        if (in >= end) {
+            break;
+        }
+        uint8_t teamId = *in++;
+        if (!readVarint(in, end, count) || !readVarint(in, end, offset) || in >= end ||
+            count == 0 || count > header.sampleCount) {
+            break;
+        }
+        RssiSample sample;
+        sample.teamId = teamId;
+        sample.timestamp = header.baseTime + unzigzag((uint32_t)offset);
+        sample.rssi = (int8_t)*in++;
+        samples.push_back(sample);
+
+        int32_t delta = 0;
+        for (uint64_t i = 1; i < count; i++) {
+            uint64_t value;
+            if (!readVarint(in, end, value)) {
+                break;
+            }
+            uint32_t rssiDelta = value & 0x07;
+            delta += unzigzag((uint32_t)(value >> 3));
+            sample.timestamp += delta;
+            if (rssiDelta == RSSI_LOG_RSSI_ESCAPE) {
+                if (in >= end) {
+                    break;
+                }
+                sample.rssi = (int8_t)*in++;
+            } else {
+                sample.rssi += unzigzag(rssiDelta);
+            }
+            samples.push_back(sample);
+        }
+    }
+
+    // CRC stimmt, Aufbau nicht: Encoder-Fehler, nichts übernehmen
+    if (in != end || samples.size() - first != header.sampleCount) {
+        samples.resize(first);
+        return false;
+    }
+    return true;
+}
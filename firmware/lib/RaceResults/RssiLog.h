@@ -0,0 +1,116 @@
+#ifndef RSSI_LOG_H
+#define RSSI_LOG_H
+
+#include <Arduino.h>
+#include <vector>
+
+/**
+ * RSSI-Telemetrie (.rssi): jedes Advertisement eines Team-Beacons im Rennen
+ *
+ * Zum Einstellen der Rundenerkennung, nicht für die Wertung. Bei 50 Teams x
+ * 10 Advertisements/s wären das als CSV-Zeile ~20 Bytes pro Sample, hier
+ * sind es im Mittel unter 2:
+ *
+ * Die Datei besteht aus Blöcken zu RSSI_LOG_BLOCK_BYTES, jeder Block ist ein
+ * eigenständiger Frame (ein kaputter Block kostet nur seine Samples):
+ *   RssiFrameHeader         Zeitbasis, Anzahl, CRC-32 über Header + Payload
+ *   Run...                  ein Lauf pro Team (Team-ID steht einmal pro Block)
+ *   Nullen bis Blockende
+ *
+ * Der letzte Block einer Datei darf kürzer sein (nur Header + Payload, der
+ * Logger schreibt den angefangenen Block so lange an dieselbe Stelle, bis er
+ * voll ist); Leser füllen ihn mit Nullen auf.
+ *
+ * Run:
+ *   teamId                  1 Byte
+ *   count                   Varint, Samples im Lauf
+ *   firstTime - baseTime    Zigzag-Varint, ms
+ *   firstRssi               1 Byte (int8)
+ *   (count - 1) x Sample    Varint v, ggf. + 1 Byte RSSI
+ *
+ * Sample: Zeit als Änderung des Abstands zum vorigen Sample desselben Teams
+ * (Advertising-Intervall ist fast konstant, übrig bleibt der Jitter), RSSI
+ * als Differenz zum vorigen Wert: v = zigzag(Abstand - voriger Abstand) << 3
+ * | zigzag(RSSI-Differenz). Passt die RSSI-Differenz nicht in [-3, 3], stehen
+ * in den unteren Bits 7 und der RSSI-Wert folgt als eigenes Byte. Typisch
+ * ist v damit ein Byte.
+ *
+ * Innerhalb eines Teams bleibt die Reihenfolge erhalten, zwischen Teams
+ * nicht; rssiLogDecodeBlock() liefert Lauf für Lauf, nach Zeit sortieren
+ * ist Sache des Lesers (laplog_convert am PC).
+ */
+
+#define RSSI_LOG_MAGIC 0x5352524D       // "MRRS"
+#define RSSI_LOG_VERSION 1
+#define RSSI_LOG_BLOCK_BYTES 4096
+#define RSSI_LOG_RSSI_ESCAPE 7          // Untere Bits von v: RSSI folgt als Byte
+
+struct RssiFrameHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t payloadBytes;      // Runs, ohne Header und Nullen
+    uint32_t baseTime;          // ms, erstes Sample im Block
+    uint16_t sampleCount;
+    uint16_t runCount;
+    uint32_t checksum;          // CRC-32 über Header (mit checksum = 0) + Payload
+};
+
+struct RssiSample {
+    uint32_t timestamp;         // ms, millis() wie LapLogRecord::timestamp
+    uint8_t teamId;
+    int8_t rssi;                // dBm
+};
+
+static_assert(sizeof(RssiFrameHeader) == 20, "RssiFrameHeader layout");
+
+/**
+ * Sammelt Samples kodiert für genau einen Block
+ *
+ * add() kodiert sofort (O(1), kein Sortieren), merkt sich pro Team nur den
+ * letzten Zeitpunkt, Abstand und RSSI. Die Bytes der Teams liegen
+ * durcheinander im Arbeitsspeicher, finish() sortiert sie in einem Durchgang
+ * in ihre Runs. Speicher: zwei Blöcke plus 16 Bytes pro Team.
+ */
+class RssiFrameEncoder {
+public:
+    RssiFrameEncoder();
+
+    void clear();
+    // false: Block voll, Sample nicht übernommen (finish(), clear(), erneut)
+    bool add(uint8_t teamId, uint32_t timestamp, int8_t rssi);
+    // Block schreiben: Header, Runs, Nullen bis RSSI_LOG_BLOCK_BYTES.
+    // Ändert den Encoder nicht (beliebig oft aufrufbar), Rückgabe: Bytes bis
+    // Payload-Ende
+    size_t finish(uint8_t* block);
+
+    bool isEmpty() const { return sampleCount == 0; }
+    uint16_t getSampleCount() const { return sampleCount; }
+    size_t getEncodedBytes() const { return encodedBytes; }     // Obergrenze inkl. Header
+
+private:
+    struct Run {
+        uint32_t firstTime;
+        uint32_t lastTime;
+        int32_t lastDelta;
+        uint16_t count;
+        uint16_t bodyBytes;     // Samples nach dem ersten
+        uint8_t teamId;
+        int8_t firstRssi;
+        int8_t lastRssi;
+    };
+
+    uint16_t runOf[256];        // teamId -> Index in runs, 0xFFFF = keiner
+    std::vector<Run> runs;
+    uint8_t arena[2 * RSSI_LOG_BLOCK_BYTES];    // Pro Sample: teamId, v, ggf. RSSI
+    uint16_t arenaBytes;
+    uint16_t sampleCount;
+    uint32_t baseTime;
+    size_t encodedBytes;
+};
+
+// Ein Block aus lauter Nullen ist leer (nicht beschrieben)
+bool rssiLogIsEmpty(const uint8_t* block);
+// Samples eines Blocks anhängen; false: kein gültiger Frame (Magic, CRC, Aufbau)
+bool rssiLogDecodeBlock(const uint8_t* block, std::vector<RssiSample>& samples);
+
+#endif // RSSI_LOG_H
@@ -0,0 +1,93 @@
+#include "RtosCompat.h"
+
+#ifdef NATIVE_BUILD
+#include <thread>
+#else
+#include <esp_timer.h>
+#endif
+
+// ============================================================
+// Tasks
+// ============================================================
+
+bool rtosStartTask(RtosTaskFunction fn, const char* name, uint32_t stackBytes,
+                   void* arg, uint8_t priority, int8_t core) {
+#ifdef NATIVE_BUILD
+    (void)name;
+    (void)stackBytes;
+    (void)priority;
+    (void)core;
+    std::thread(fn, arg).detach();
+    return true;
+#else
+    // ESP32: Stack-Größe in Bytes
+    BaseType_t result = xTaskCreatePinnedToCore(fn, name, stackBytes, arg, priority, nullptr,
+                                                core < 0 ? tskNO_AFFINITY : core);
+    if (result != pdPASS) {
+        Serial.printf("[RTOS] ERROR: Failed to start task %s\n", name);
+        return false;
+    }
+    return true;
+#endif
+}
+
+void rtosEndTask() {
+#ifndef NATIVE_BUILD
+    vTaskDelete(nullptr);
+#endif
+}
+
+void rtosSleepMs(uint32_t ms) {
+#ifdef NATIVE_BUILD
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+#else
+    vTaskDelay(pdMS_TO_TICKS(ms));
+#endif
+}
+
+int rtosCoreId() {
+#ifdef NATIVE_BUILD
+    return 0;
+#else
+    return xPortGetCoreID();
+#endif
+}
+
+uint64_t rtosMicros() {
+#ifdef NATIVE_BUILD
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+#else
+    return esp_timer_get_time();
+#endif
+}
+
+// ============================================================
+// Mutex
+// ============================================================
+
+#ifdef NATIVE_BUILD
+
+RtosMutex::RtosMutex() {}
+RtosMutex::~RtosMutex() {}
+void RtosMutex::lock() { mutex.lock(); }
+void RtosMutex::unlock() { mutex.unlock(); }
+
+#else
+
+RtosMutex::RtosMutex() : handle(xSemaphoreCreateRecursiveMutex()) {}
+
+RtosMutex::~RtosMutex() {
+    if (handle) vSemaphoreDelete(handle);
+}
+
+void RtosMutex::lock() {
+    xSemaphoreTakeRecursive(handle, portMAX_DELAY);
+}
+
+void RtosMutex::unlock() {
+    xSemaphoreGiveRecursive(handle);
+}
+
+#endif
@@ -0,0 +1,197 @@
+#ifndef RTOS_COMPAT_H
+#define RTOS_COMPAT_H
+
+#include <Arduino.h>
+#include <type_traits>
+
+#ifdef NATIVE_BUILD
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+
+/**
+ * RTOS-Abstraktion für Tasks, Mutex und Queues
+ * 
+ * ESP32: FreeRTOS, Tasks an Cores gepinnt.
+ * Host-Build (NATIVE_BUILD): std::thread, Core und Priorität werden ignoriert.
+ */
+
+#define RTOS_WAIT_FOREVER 0xFFFFFFFF
+
+typedef void (*RtosTaskFunction)(void* arg);
+
+// Task starten (core < 0 = beliebiger Core)
+bool rtosStartTask(RtosTaskFunction fn, const char* name, uint32_t stackBytes,
+                   void* arg, uint8_t priority, int8_t core);
+// Am Ende einer Task-Funktion aufrufen (FreeRTOS-Tasks dürfen nicht returnen)
+void rtosEndTask();
+void rtosSleepMs(uint32_t ms);
+int rtosCoreId();
+// Monotone Echtzeit in µs, unabhängig von der virtuellen Uhr im Host-Build
+uint64_t rtosMicros();
+
+// ============================================================
+// Mutex (rekursiv)
+// ============================================================
+
+class RtosMutex {
+public:
+    RtosMutex();
+    ~RtosMutex();
+    
+    void lock();
+    void unlock();
+    
+private:
+    RtosMutex(const RtosMutex&) = delete;
+    RtosMutex& operator=(const RtosMutex&) = delete;
+    
+#ifdef NATIVE_BUILD
+    std::recursive_mutex mutex;
+#else
+    SemaphoreHandle_t handle;
+#endif
+};
+
+class RtosLock {
+public:
+    explicit RtosLock(RtosMutex& mutex) : mutex(mutex) { mutex.lock(); }
+    ~RtosLock() { mutex.unlock(); }
+    
+private:
+    RtosLock(const RtosLock&) = delete;
+    RtosLock& operator=(const RtosLock&) = delete;
+    
+    RtosMutex& mutex;
+};
+
+// ============================================================
+// Queue (begrenzt, kopiert Elemente)
+// ============================================================
+
+template <typename T>
+class RtosQueue {
+    // FreeRTOS kopiert Elemente byteweise
+    static_assert(std::is_trivially_copyable<T>::value, "RtosQueue: T must be trivially copyable");
+    
+public:
+    explicit RtosQueue(size_t capacity) : queueCapacity(capacity) {
+#ifndef NATIVE_BUILD
+        handle = xQueueCreate(capacity, sizeof(T));
+#endif
+    }
+    
+    ~RtosQueue() {
+#ifndef NATIVE_BUILD
+        if (handle) vQueueDelete(handle);
+#endif
+    }
+    
+    // false = Queue voll (nach timeoutMs)
+    bool send(const T& item, uint32_t timeoutMs = 0) {
+#ifdef NATIVE_BUILD
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!waitFor(lock, notFull, timeoutMs, [this] { return items.size() < queueCapacity; })) {
+            return false;
+        }
+        items.push_back(item);
+        notEmpty.notify_one();
+        return true;
+#else
+        return handle && xQueueSend(handle, &item, toTicks(timeoutMs)) == pdTRUE;
+#endif
+    }
+    
+    // Aus ISR senden (blockiert nie)
+    bool sendFromISR(const T& item) {
+#ifdef NATIVE_BUILD
+        return send(item, 0);
+#else
+        BaseType_t woken = pdFALSE;
+        bool ok = handle && xQueueSendFromISR(handle, &item, &woken) == pdTRUE;
+        if (woken) portYIELD_FROM_ISR();
+        return ok;
+#endif
+    }
+    
+    // false = Timeout
+    bool receive(T& item, uint32_t timeoutMs = RTOS_WAIT_FOREVER) {
+#ifdef NATIVE_BUILD
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!waitFor(lock, notEmpty, timeoutMs, [this] { return !items.empty(); })) {
+            return false;
+        }
+        item = items.front();
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+#else
+        return handle && xQueueReceive(handle, &item, toTicks(timeoutMs)) == pdTRUE;
+#endif
+    }
+    
+    size_t count() {
+#ifdef NATIVE_BUILD
+        std::lock_guard<std::mutex> lock(mutex);
+        return items.size();
+#else
+        return handle ? uxQueueMessagesWaiting(handle) : 0;
+#endif
+    }
+    
+    size_t capacity() const { return queueCapacity; }
+    
+#ifndef NATIVE_BUILD
+    // Für ISRs mit IRAM_ATTR: sendFromISR() ist Template-Code und liegt im
+    // Flash, bei abgeschaltetem Cache (NVS-Schreiben) direkt xQueueSendFromISR()
+    QueueHandle_t nativeHandle() const { return handle; }
+#endif
+    
+    void clear() {
+#ifdef NATIVE_BUILD
+        std::lock_guard<std::mutex> lock(mutex);
+        items.clear();
+        notFull.notify_all();
+#else
+        if (handle) xQueueReset(handle);
+#endif
+    }
+    
+private:
+    RtosQueue(const RtosQueue&) = delete;
+    RtosQueue& operator=(const RtosQueue&) = delete;
+    
+    size_t queueCapacity;
+    
+#ifdef NATIVE_BUILD
+    template <typename Pred>
+    static bool waitFor(std::unique_lock<std::mutex>& lock, std::condition_variable& cv,
+                        uint32_t timeoutMs, Pred pred) {
+        if (timeoutMs == RTOS_WAIT_FOREVER) {
+            cv.wait(lock, pred);
+            return true;
+        }
+        return cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), pred);
+    }
+    
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::deque<T> items;
+#else
+    static TickType_t toTicks(uint32_t timeoutMs) {
+        return timeoutMs == RTOS_WAIT_FOREVER ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+    }
+    
+    QueueHandle_t handle;
+#endif
+};
+
+#endif // RTOS_COMPAT_H
@@ -0,0 +1,244 @@
+#include "ScrollList.h"
+#include <math.h>
+
+ScrollList::ScrollList()
+    : viewX(0), viewY(0), viewW(0), viewH(0)
+    , count(0), rowHeight(1), paged(false)
+    , position(0), offset(0)
+    , tracking(false), dragging(false), caughtAnimation(false)
+    , pressY(0), lastY(0), lastUs(0), velocity(0)
+    , mode(MODE_IDLE), target(0), animUs(0) {
+}
+
+// ============================================================
+// Aufbau und Geometrie
+// ============================================================
+
+void ScrollList::setViewport(int16_t x, int16_t y, int16_t w, int16_t h) {
+    viewX = x;
+    viewY = y;
+    viewW = w;
+    viewH = h;
+    setPosition(position);
+}
+
+void ScrollList::setRows(uint16_t count, int16_t rowHeight) {
+    this->count = count;
+    this->rowHeight = rowHeight > 0 ? rowHeight : 1;
+    if (mode == MODE_SNAP) {
+        target = clampOffset(target);
+    }
+    setPosition(position);
+}
+
+int32_t ScrollList::getMaxOffset() const {
+    if (paged) {
+        // Letzte Seite beginnt an einer Seitengrenze, auch wenn sie nicht voll ist
+        return (int32_t)(pageCount() - 1) * rowsPerPage() * rowHeight;
+    }
+    int32_t content = (int32_t)count * rowHeight;
+    return content > viewH ? content - viewH : 0;
+}
+
+uint16_t ScrollList::firstVisible() const {
+    return (uint16_t)(offset / rowHeight);
+}
+
+uint16_t ScrollList::visibleEnd() const {
+    int32_t end = (offset + viewH + rowHeight - 1) / rowHeight;
+    return (uint16_t)(end < count ? end : count);
+}
+
+int32_t ScrollList::rowTop(uint16_t row) const {
+    return viewY + (int32_t)row * rowHeight - offset;
+}
+
+int ScrollList::rowAt(int16_t y) const {
+    if (y < viewY || y >= viewY + viewH) {
+        return -1;
+    }
+    int32_t row = (y - viewY + offset) / rowHeight;
+    return row < count ? (int)row : -1;
+}
+
+uint16_t ScrollList::rowsPerPage() const {
+    int16_t rows = viewH / rowHeight;
+    return rows > 0 ? rows : 1;
+}
+
+uint16_t ScrollList::pageCount() const {
+    uint16_t pages = (count + rowsPerPage() - 1) / rowsPerPage();
+    return pages > 0 ? pages : 1;
+}
+
+uint16_t ScrollList::getPage() const {
+    float pageHeight = (float)rowsPerPage() * rowHeight;
+    float at = mode == MODE_SNAP ? target : position;
+    return (uint16_t)lroundf(at / pageHeight);
+}
+
+int32_t ScrollList::clampOffset(float value) const {
+    int32_t maxOffset = getMaxOffset();
+    if (value < 0) {
+        return 0;
+    }
+    if (value > maxOffset) {
+        return maxOffset;
+    }
+    return (int32_t)lroundf(value);
+}
+
+void ScrollList::setPosition(float value) {
+    int32_t maxOffset = getMaxOffset();
+    position = value < 0 ? 0 : (value > maxOffset ? maxOffset : value);
+    offset = (int32_t)lroundf(position);
+}
+
+// ============================================================
+// Touch
+// ============================================================
+
+void ScrollList::press(int16_t y, uint64_t us) {
+    // Drücken hält eine rollende Liste an, wie bei Smartphones
+    caughtAnimation = mode != MODE_IDLE;
+    mode = MODE_IDLE;
+
+    tracking = true;
+    dragging = false;
+    pressY = y;
+    lastY = y;
+    lastUs = us;
+    velocity = 0;
+}
+
+bool ScrollList::drag(int16_t y, uint64_t us) {
+    if (!tracking) {
+        return false;
+    }
+    if (!dragging) {
+        if (abs(y - pressY) < SCROLL_TAP_SLOP) {
+            return false;
+        }
+        // Ab hier zieht der Finger die Liste, ohne Sprung um den Schwellwert
+        dragging = true;
+        lastY = y;
+        lastUs = us;
+        return false;
+    }
+
+    int16_t dy = y - lastY;
+    if (us > lastUs) {
+        // Geschwindigkeit geglättet, einzelne Abtastungen streuen
+        float instant = -dy * 1000000.0f / (float)(us - lastUs);
+        velocity = 0.6f * instant + 0.4f * velocity;
+    }
+    lastY = y;
+    lastUs = us;
+
+    int32_t before = offset;
+    setPosition(position - dy);
+    return offset != before;
+}
+
+int ScrollList::release(int16_t y, uint64_t us) {
+    if (!tracking) {
+        return -1;
+    }
+    tracking = false;
+
+    if (!dragging) {
+        if (caughtAnimation) {
+            // Nur angehalten, kein Tipp; halbe Seiten gibt es nicht
+            if (paged) {
+                scrollToPage(getPage(), true, us);
+            }
+            return -1;
+        }
+        return rowAt(pressY);
+    }
+
+    drag(y, us);
+    dragging = false;
+    if (us - lastUs > (uint64_t)SCROLL_STALE_MS * 1000) {
+        velocity = 0;
+    }
+
+    if (paged) {
+        // Schwung blättert eine Seite weiter, sonst zur nächstgelegenen
+        float pageHeight = (float)rowsPerPage() * rowHeight;
+        float current = position / pageHeight;
+        int32_t page = lroundf(current);
+        if (velocity >= SCROLL_FLING_MIN_SPEED) {
+            page = (int32_t)floorf(current) + 1;
+        } else if (velocity <= -SCROLL_FLING_MIN_SPEED) {
+            page = (int32_t)ceilf(current) - 1;
+        }
+        page = constrain(page, 0, (int32_t)pageCount() - 1);
+        scrollToPage((uint16_t)page, true, us);
+    } else if (fabsf(velocity) >= SCROLL_FLING_MIN_SPEED) {
+        mode = MODE_FLING;
+        animUs = us;
+    }
+    return -1;
+}
+
+// ============================================================
+// Animation
+// ============================================================
+
+void ScrollList::startSnap(float to, uint64_t nowUs) {
+    target = clampOffset(to);
+    mode = MODE_SNAP;
+    animUs = nowUs;
+}
+
+void ScrollList::scrollTo(int32_t offset, bool animated, uint64_t nowUs) {
+    if (animated) {
+        startSnap(offset, nowUs);
+    } else {
+        mode = MODE_IDLE;
+        setPosition(offset);
+    }
+}
+
+void ScrollList::scrollToPage(uint16_t page, bool animated, uint64_t nowUs) {
+    scrollTo((int32_t)page * rowsPerPage() * rowHeight, animated, nowUs);
+}
+
+void ScrollList::stop() {
+    if (mode == MODE_SNAP) {
+        setPosition(target);
+    }
+    mode = MODE_IDLE;
+}
+
+bool ScrollList::animate(uint64_t nowUs) {
+    if (mode == MODE_IDLE || nowUs <= animUs) {
+        return false;
+    }
+    float dtMs = (nowUs - animUs) / 1000.0f;
+    animUs = nowUs;
+    int32_t before = offset;
+
+    if (mode == MODE_FLING) {
+        // v(t) = v0 * e^(-t/T), Weg = v0 * T * (1 - e^(-t/T))
+        float decay = expf(-dtMs / SCROLL_FRICTION_MS);
+        float moved = velocity * (SCROLL_FRICTION_MS / 1000.0f) * (1.0f - decay);
+        velocity *= decay;
+        setPosition(position + moved);
+
+        bool atEdge = position <= 0 || position >= getMaxOffset();
+        if (atEdge || fabsf(velocity) < SCROLL_STOP_SPEED) {
+            mode = MODE_IDLE;
+        }
+    } else {
+        float decay = expf(-dtMs / SCROLL_SNAP_MS);
+        float next = target + (position - target) * decay;
+        if (fabsf(target - next) < 0.5f) {
+            next = target;
+            mode = MODE_IDLE;
+        }
+        setPosition(next);
+    }
+    return offset != before;
+}
@@ -0,0 +1,125 @@
+#ifndef SCROLL_LIST_H
+#define SCROLL_LIST_H
+
+#include <Arduino.h>
+
+/**
+ * Virtualisierte Liste mit Ziehen, Ausrollen und Seiten
+ *
+ * Verwaltet nur die Geometrie: ein Fenster (Viewport) auf dem Display,
+ * darin count Zeilen gleicher Höhe, verschoben um offset Pixel. Gezeichnet
+ * werden nur die Zeilen firstVisible() .. visibleEnd() - die Variante
+ * entscheidet wie (Sprite-Streifen, direkt), die Lib bleibt
+ * hardwareunabhängig wie der WidgetTree.
+ *
+ * Touch: press()/drag()/release() mit den Zeiten aus TouchInput. Ein Tipp
+ * ohne Ziehen liefert die Zeile, sonst rollt die Liste mit der zuletzt
+ * gemessenen Geschwindigkeit aus (exponentiell gebremst), animate() rechnet
+ * die Position für den nächsten Frame. Mit setPaged(true) rastet die Liste
+ * stattdessen auf ganzen Seiten (Viewport-Höhe) ein.
+ */
+
+// In config.h überschreibbar
+#ifndef SCROLL_TAP_SLOP
+#define SCROLL_TAP_SLOP 8            // px, bis hier ist es ein Tipp, kein Ziehen
+#endif
+#ifndef SCROLL_FLING_MIN_SPEED
+#define SCROLL_FLING_MIN_SPEED 150   // px/s, langsamer losgelassen = stehen bleiben
+#endif
+#ifndef SCROLL_FRICTION_MS
+#define SCROLL_FRICTION_MS 325       // Zeitkonstante der Bremsung beim Ausrollen
+#endif
+#ifndef SCROLL_SNAP_MS
+#define SCROLL_SNAP_MS 60            // Zeitkonstante beim Einrasten/scrollTo()
+#endif
+#ifndef SCROLL_STOP_SPEED
+#define SCROLL_STOP_SPEED 20         // px/s, darunter steht die Liste
+#endif
+#ifndef SCROLL_STALE_MS
+#define SCROLL_STALE_MS 60           // Finger so lange still vor dem Loslassen = kein Schwung
+#endif
+
+class ScrollList {
+public:
+    ScrollList();
+
+    // Aufbau
+    void setViewport(int16_t x, int16_t y, int16_t w, int16_t h);
+    // Zeilenzahl ändern hält den Offset im gültigen Bereich
+    void setRows(uint16_t count, int16_t rowHeight);
+    void setPaged(bool paged) { this->paged = paged; }
+
+    int16_t getX() const { return viewX; }
+    int16_t getY() const { return viewY; }
+    int16_t getWidth() const { return viewW; }
+    int16_t getHeight() const { return viewH; }
+    uint16_t getCount() const { return count; }
+    int16_t getRowHeight() const { return rowHeight; }
+
+    bool contains(int16_t x, int16_t y) const {
+        return x >= viewX && x < viewX + viewW && y >= viewY && y < viewY + viewH;
+    }
+
+    // Sichtbarer Ausschnitt
+    int32_t getOffset() const { return offset; }
+    int32_t getMaxOffset() const;
+    uint16_t firstVisible() const;
+    uint16_t visibleEnd() const;            // Exklusiv
+    int32_t rowTop(uint16_t row) const;     // Display-y der Oberkante (auch außerhalb)
+    int rowAt(int16_t y) const;             // -1 = keine Zeile
+
+    // Seiten (eine Seite = ganze Zeilen im Viewport)
+    uint16_t rowsPerPage() const;
+    uint16_t pageCount() const;
+    uint16_t getPage() const;               // Beim Einrasten: Zielseite
+
+    // Touch
+    void press(int16_t y, uint64_t us);
+    bool drag(int16_t y, uint64_t us);      // true = Offset geändert
+    int release(int16_t y, uint64_t us);    // Tipp: Zeile, sonst -1
+    bool isTracking() const { return tracking; }
+    bool isDragging() const { return dragging; }
+
+    // Animation
+    void scrollTo(int32_t offset, bool animated, uint64_t nowUs = 0);
+    void scrollToPage(uint16_t page, bool animated, uint64_t nowUs = 0);
+    bool animate(uint64_t nowUs);           // true = Offset geändert
+    bool isAnimating() const { return mode != MODE_IDLE; }
+    // Anhalten; beim Einrasten direkt auf die Zielposition
+    void stop();
+
+private:
+    enum Mode : uint8_t {
+        MODE_IDLE,
+        MODE_FLING,     // Ausrollen mit velocity
+        MODE_SNAP       // Auf target zulaufen
+    };
+
+    int16_t viewX, viewY, viewW, viewH;
+    uint16_t count;
+    int16_t rowHeight;
+    bool paged;
+
+    float position;         // Exakter Offset, offset = gerundet
+    int32_t offset;
+
+    // Touch
+    bool tracking;
+    bool dragging;
+    bool caughtAnimation;   // Drücken hat eine laufende Animation angehalten
+    int16_t pressY;
+    int16_t lastY;
+    uint64_t lastUs;
+    float velocity;         // px/s in Offset-Richtung
+
+    // Animation
+    Mode mode;
+    float target;
+    uint64_t animUs;
+
+    int32_t clampOffset(float value) const;
+    void setPosition(float value);
+    void startSnap(float to, uint64_t nowUs);
+};
+
+#endif // SCROLL_LIST_H
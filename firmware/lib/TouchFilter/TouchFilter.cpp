@@ -0,0 +1,249 @@
+#include "TouchFilter.h"
+#include <math.h>
+
+// ============================================================
+// Kalibrierung
+// ============================================================
+
+TouchCalibration::TouchCalibration() {
+    // Identität: Rohwert = Bildschirmkoordinate
+    matrix.a = 1L << TOUCH_MATRIX_SHIFT;
+    matrix.b = 0;
+    matrix.c = 0;
+    matrix.d = 0;
+    matrix.e = 1L << TOUCH_MATRIX_SHIFT;
+    matrix.f = 0;
+}
+
+void TouchCalibration::targets(int16_t width, int16_t height, TouchCalPoint* points) {
+    const int16_t xs[TOUCH_CAL_POINTS] = {TOUCH_CAL_INSET, (int16_t)(width - 1 - TOUCH_CAL_INSET),
+                                          TOUCH_CAL_INSET, (int16_t)(width - 1 - TOUCH_CAL_INSET)};
+    const int16_t ys[TOUCH_CAL_POINTS] = {TOUCH_CAL_INSET, TOUCH_CAL_INSET,
+                                          (int16_t)(height - 1 - TOUCH_CAL_INSET), (int16_t)(height - 1 - TOUCH_CAL_INSET)};
+    for (uint8_t i = 0; i < TOUCH_CAL_POINTS; i++) {
+        points[i].rawX = 0;
+        points[i].rawY = 0;
+        points[i].x = xs[i];
+        points[i].y = ys[i];
+    }
+}
+
+bool TouchCalibration::capture(TouchRawReader reader, TouchCalPoint& point) {
+    uint32_t start = millis();
+    uint32_t sumX = 0;
+    uint32_t sumY = 0;
+    uint8_t held = 0;
+
+    // Erst zählen, wenn der Finger ruhig aufliegt: jeder Aussetzer beginnt neu
+    while (held < TOUCH_CAL_HOLD) {
+        if (millis() - start > TOUCH_CAL_TIMEOUT) {
+            return false;
+        }
+        uint16_t rawX, rawY;
+        if (reader(&rawX, &rawY)) {
+            sumX += rawX;
+            sumY += rawY;
+            held++;
+        } else {
+            sumX = 0;
+            sumY = 0;
+            held = 0;
+        }
+        delay(10);
+    }
+    point.rawX = (uint16_t)((sumX + TOUCH_CAL_HOLD / 2) / TOUCH_CAL_HOLD);
+    point.rawY = (uint16_t)((sumY + TOUCH_CAL_HOLD / 2) / TOUCH_CAL_HOLD);
+
+    // Loslassen abwarten, sonst zählt der Druck gleich für den nächsten Punkt
+    uint8_t released = 0;
+    while (released < 5 && millis() - start <= TOUCH_CAL_TIMEOUT) {
+        uint16_t rawX, rawY;
+        released = reader(&rawX, &rawY) ? 0 : released + 1;
+        delay(10);
+    }
+    return released >= 5;
+}
+
+void TouchCalibration::setRange(uint16_t xMin, uint16_t xMax, uint16_t yMin, uint16_t yMax,
+                                int16_t width, int16_t height) {
+    int32_t spanX = (int32_t)xMax - xMin;
+    int32_t spanY = (int32_t)yMax - yMin;
+    if (spanX == 0 || spanY == 0) {
+        return;
+    }
+    matrix.a = (int32_t)(((int64_t)width << TOUCH_MATRIX_SHIFT) / spanX);
+    matrix.b = 0;
+    matrix.c = -(int32_t)xMin * matrix.a;
+    matrix.d = 0;
+    matrix.e = (int32_t)(((int64_t)height << TOUCH_MATRIX_SHIFT) / spanY);
+    matrix.f = -(int32_t)yMin * matrix.e;
+}
+
+bool TouchCalibration::compute(const TouchCalPoint* points, uint8_t count) {
+    if (count < 3) {
+        return false;
+    }
+
+    // Normalgleichungen: [Σrx² Σrxry Σrx; Σrxry Σry² Σry; Σrx Σry n] * (a b c) = Σ(rx*X, ry*X, X)
+    double sxx = 0, sxy = 0, syy = 0, sx = 0, sy = 0;
+    double tx[3] = {0, 0, 0};
+    double ty[3] = {0, 0, 0};
+    for (uint8_t i = 0; i < count; i++) {
+        double rx = points[i].rawX;
+        double ry = points[i].rawY;
+        sxx += rx * rx;
+        sxy += rx * ry;
+        syy += ry * ry;
+        sx += rx;
+        sy += ry;
+        tx[0] += rx * points[i].x;
+        tx[1] += ry * points[i].x;
+        tx[2] += points[i].x;
+        ty[0] += rx * points[i].y;
+        ty[1] += ry * points[i].y;
+        ty[2] += points[i].y;
+    }
+    double n = count;
+
+    double det = sxx * (syy * n - sy * sy) - sxy * (sxy * n - sy * sx) + sx * (sxy * sy - syy * sx);
+    if (fabs(det) < 1.0) {
+        return false;
+    }
+
+    // Cramersche Regel, einmal für x und einmal für y
+    double solved[2][3];
+    const double* rhs[2] = {tx, ty};
+    for (int axis = 0; axis < 2; axis++) {
+        const double* t = rhs[axis];
+        solved[axis][0] = (t[0] * (syy * n - sy * sy) - sxy * (t[1] * n - sy * t[2]) + sx * (t[1] * sy - syy * t[2])) / det;
+        solved[axis][1] = (sxx * (t[1] * n - sy * t[2]) - t[0] * (sxy * n - sy * sx) + sx * (sxy * t[2] - t[1] * sx)) / det;
+        solved[axis][2] = (sxx * (syy * t[2] - t[1] * sy) - sxy * (sxy * t[2] - t[1] * sx) + t[0] * (sxy * sy - syy * sx)) / det;
+    }
+
+    const double scale = (double)(1L << TOUCH_MATRIX_SHIFT);
+    matrix.a = (int32_t)lround(solved[0][0] * scale);
+    matrix.b = (int32_t)lround(solved[0][1] * scale);
+    matrix.c = (int32_t)lround(solved[0][2] * scale);
+    matrix.d = (int32_t)lround(solved[1][0] * scale);
+    matrix.e = (int32_t)lround(solved[1][1] * scale);
+    matrix.f = (int32_t)lround(solved[1][2] * scale);
+    return true;
+}
+
+void TouchCalibration::apply(uint16_t rawX, uint16_t rawY, int32_t& x, int32_t& y) const {
+    const int64_t half = 1LL << (TOUCH_MATRIX_SHIFT - 1);
+    x = (int32_t)(((int64_t)matrix.a * rawX + (int64_t)matrix.b * rawY + matrix.c + half) >> TOUCH_MATRIX_SHIFT);
+    y = (int32_t)(((int64_t)matrix.d * rawX + (int64_t)matrix.e * rawY + matrix.f + half) >> TOUCH_MATRIX_SHIFT);
+}
+
+// ============================================================
+// Filter
+// ============================================================
+
+TouchFilter::TouchFilter()
+    : width(320), height(240)
+    , tracking(false), smoothX(0), smoothY(0)
+    , rejectedPressure(0), rejectedSpread(0) {
+}
+
+void TouchFilter::setScreenSize(int16_t width, int16_t height) {
+    this->width = width;
+    this->height = height;
+}
+
+static void sortValues(uint16_t* values, uint8_t count) {
+    // Insertion Sort: höchstens TOUCH_FILTER_MAX_SAMPLES Werte
+    for (uint8_t i = 1; i < count; i++) {
+        uint16_t value = values[i];
+        int j = i - 1;
+        while (j >= 0 && values[j] > value) {
+            values[j + 1] = values[j];
+            j--;
+        }
+        values[j + 1] = value;
+    }
+}
+
+// Kleinste Spanne über valid / 2 + 1 benachbarte (sortierte) Werte
+static uint16_t majoritySpread(const uint16_t* values, uint8_t count) {
+    uint8_t window = count / 2 + 1;
+    uint16_t spread = values[window - 1] - values[0];
+    for (uint8_t i = 1; i + window <= count; i++) {
+        uint16_t span = values[i + window - 1] - values[i];
+        if (span < spread) {
+            spread = span;
+        }
+    }
+    return spread;
+}
+
+bool TouchFilter::filterRaw(const TouchSample* samples, uint8_t count, uint16_t& rawX, uint16_t& rawY) {
+    uint16_t xs[TOUCH_FILTER_MAX_SAMPLES];
+    uint16_t ys[TOUCH_FILTER_MAX_SAMPLES];
+    uint8_t valid = 0;
+
+    if (count > TOUCH_FILTER_MAX_SAMPLES) {
+        count = TOUCH_FILTER_MAX_SAMPLES;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (samples[i].z >= TOUCH_PRESSURE_MIN) {
+            xs[valid] = samples[i].x;
+            ys[valid] = samples[i].y;
+            valid++;
+        }
+    }
+
+    // Mehrheit muss gedrückt sein, sonst Aufsetzen/Abheben mit halbem Druck
+    if (valid * 2 <= count) {
+        if (valid > 0) {
+            rejectedPressure++;
+        }
+        return false;
+    }
+
+    sortValues(xs, valid);
+    sortValues(ys, valid);
+
+    // Die Mehrheit muss eng beieinander liegen, Ausreißer der Minderheit
+    // stören nicht (jedes solche Fenster enthält den Median)
+    if (majoritySpread(xs, valid) > TOUCH_FILTER_SPREAD || majoritySpread(ys, valid) > TOUCH_FILTER_SPREAD) {
+        rejectedSpread++;
+        return false;
+    }
+
+    rawX = xs[valid / 2];
+    rawY = ys[valid / 2];
+    return true;
+}
+
+int32_t TouchFilter::smooth(int32_t state, uint16_t median) const {
+    int32_t target = (int32_t)median << 4;
+    int32_t delta = target - state;
+    if (abs(delta) > (TOUCH_FILTER_IIR_JUMP << 4)) {
+        return target;
+    }
+    return state + delta / (1 << TOUCH_FILTER_IIR_SHIFT);
+}
+
+bool TouchFilter::process(const TouchSample* samples, uint8_t count, uint16_t* x, uint16_t* y) {
+    uint16_t rawX, rawY;
+    if (!filterRaw(samples, count, rawX, rawY)) {
+        tracking = false;
+        return false;
+    }
+
+    if (tracking) {
+        smoothX = smooth(smoothX, rawX);
+        smoothY = smooth(smoothY, rawY);
+    } else {
+        smoothX = (int32_t)rawX << 4;
+        smoothY = (int32_t)rawY << 4;
+        tracking = true;
+    }
+
+    int32_t screenX, screenY;
+    calibration.apply((uint16_t)((smoothX + 8) >> 4), (uint16_t)((smoothY + 8) >> 4), screenX, screenY);
+    *x = (uint16_t)constrain(screenX, 0, width - 1);
+    *y = (uint16_t)constrain(screenY, 0, height - 1);
+    return true;
+}
@@ -0,0 +1,141 @@
+#ifndef TOUCH_FILTER_H
+#define TOUCH_FILTER_H
+
+#include <Arduino.h>
+#include <functional>
+
+/**
+ * Filter-Pipeline für resistive Touch-Controller (XPT2046)
+ *
+ * Pro Lesezugriff liefert die Variante mehrere Rohabtastungen (12 Bit x/y
+ * plus Druck z). Die Pipeline:
+ *   1. Druck-Gate: Abtastungen mit z < TOUCH_PRESSURE_MIN fallen weg,
+ *      bleibt nicht die Mehrheit übrig, gilt der Schirm als nicht berührt
+ *   2. Median über die gültigen Abtastungen (Ausreißer verschwinden);
+ *      liegt nicht einmal die Mehrheit eng beieinander, ist es Aufsetzen/
+ *      Abheben - verworfen
+ *   3. IIR über die Lesezugriffe einer Berührung gegen Zittern bei
+ *      stillstehendem Finger; größere Sprünge (Ziehen) gehen ungefiltert
+ *      durch, damit Listen nicht hinterherlaufen
+ *   4. Kalibrierung: affine Matrix Rohwert -> Bildschirm (deckt Drehung,
+ *      Spiegelung und Vertauschen der Achsen ab), in NVS gespeichert
+ *
+ * Kalibrieren: an TOUCH_CAL_POINTS Fadenkreuzen je einen ruhigen Druck
+ * aufnehmen (capture()), compute() rechnet die Matrix per Ausgleichs-
+ * rechnung - ein verrutschter Punkt verzieht sie weniger als bei 3 Punkten.
+ *
+ * Hardwareunabhängig: das SPI-Lesen macht die Variante (touch_xpt2046.h
+ * bzw. DisplayManager), hier wird nur gerechnet.
+ */
+
+// In config.h überschreibbar
+#ifndef TOUCH_PRESSURE_MIN
+#define TOUCH_PRESSURE_MIN 300       // z darunter = nicht berührt
+#endif
+#ifndef TOUCH_FILTER_SAMPLES
+#define TOUCH_FILTER_SAMPLES 5       // Rohabtastungen pro Lesezugriff
+#endif
+#ifndef TOUCH_FILTER_SPREAD
+#define TOUCH_FILTER_SPREAD 80       // Rohwert, max. Streuung der Mehrheit der Abtastungen
+#endif
+#ifndef TOUCH_FILTER_IIR_SHIFT
+#define TOUCH_FILTER_IIR_SHIFT 1     // neu = alt + (Median - alt) / 2^n, 0 = aus
+#endif
+#ifndef TOUCH_FILTER_IIR_JUMP
+#define TOUCH_FILTER_IIR_JUMP 40     // Rohwert, größere Sprünge ohne Glättung
+#endif
+
+#ifndef TOUCH_CAL_HOLD
+#define TOUCH_CAL_HOLD 8             // Lesezugriffe pro Kalibrierpunkt (gemittelt)
+#endif
+#ifndef TOUCH_CAL_TIMEOUT
+#define TOUCH_CAL_TIMEOUT 15000      // ms pro Kalibrierpunkt
+#endif
+
+#define TOUCH_FILTER_MAX_SAMPLES 16
+#define TOUCH_CAL_POINTS 4           // Fadenkreuze: die vier Ecken
+#define TOUCH_CAL_INSET 20           // px Abstand der Fadenkreuze vom Rand
+#define TOUCH_MATRIX_SHIFT 16        // Nachkommabits der Kalibrier-Matrix
+
+struct TouchSample {
+    uint16_t x;     // Rohwert 0..4095
+    uint16_t y;
+    uint16_t z;     // Druck, 0 = keiner
+};
+
+// Referenzpunkt für die Kalibrierung: Rohwert an bekannter Bildschirmposition
+struct TouchCalPoint {
+    uint16_t rawX;
+    uint16_t rawY;
+    int16_t x;
+    int16_t y;
+};
+
+// x = (a * rawX + b * rawY + c) >> TOUCH_MATRIX_SHIFT, y analog mit d, e, f
+struct TouchMatrix {
+    int32_t a, b, c;
+    int32_t d, e, f;
+};
+
+// Median-Rohwerte eines Lesezugriffs, false = nicht berührt
+typedef std::function<bool(uint16_t* rawX, uint16_t* rawY)> TouchRawReader;
+
+class TouchCalibration {
+public:
+    TouchCalibration();
+
+    // Bildschirmpositionen der Fadenkreuze (x/y von points[0..TOUCH_CAL_POINTS))
+    static void targets(int16_t width, int16_t height, TouchCalPoint* points);
+    // Wartet auf einen ruhigen Druck, mittelt TOUCH_CAL_HOLD Lesezugriffe in
+    // point.rawX/rawY und wartet aufs Loslassen. false = Timeout
+    static bool capture(TouchRawReader reader, TouchCalPoint& point);
+
+    // Lineare Abbildung wie map(): Rohbereich -> 0..width bzw. 0..height
+    void setRange(uint16_t xMin, uint16_t xMax, uint16_t yMin, uint16_t yMax,
+                  int16_t width, int16_t height);
+    // Ausgleichsrechnung über mind. 3 Punkte, false = Punkte auf einer Linie
+    bool compute(const TouchCalPoint* points, uint8_t count);
+
+    void apply(uint16_t rawX, uint16_t rawY, int32_t& x, int32_t& y) const;
+
+    const TouchMatrix& getMatrix() const { return matrix; }
+    void setMatrix(const TouchMatrix& matrix) { this->matrix = matrix; }
+
+private:
+    TouchMatrix matrix;
+};
+
+class TouchFilter {
+public:
+    TouchFilter();
+
+    void setScreenSize(int16_t width, int16_t height);
+    void setCalibration(const TouchCalibration& calibration) { this->calibration = calibration; }
+    const TouchCalibration& getCalibration() const { return calibration; }
+
+    // Ein Lesezugriff -> Bildschirmkoordinaten, false = nicht berührt
+    bool process(const TouchSample* samples, uint8_t count, uint16_t* x, uint16_t* y);
+    // Nur Druck-Gate und Median (für die Kalibrier-Routine)
+    bool filterRaw(const TouchSample* samples, uint8_t count, uint16_t& rawX, uint16_t& rawY);
+    // Neue Berührung: IIR beginnt beim nächsten Median
+    void reset() { tracking = false; }
+
+    uint32_t getRejectedPressure() const { return rejectedPressure; }
+    uint32_t getRejectedSpread() const { return rejectedSpread; }
+
+private:
+    TouchCalibration calibration;
+    int16_t width;
+    int16_t height;
+
+    bool tracking;
+    int32_t smoothX;    // Rohwert << 4, damit die Glättung nicht auf ganzen Werten stehen bleibt
+    int32_t smoothY;
+
+    uint32_t rejectedPressure;
+    uint32_t rejectedSpread;
+
+    int32_t smooth(int32_t state, uint16_t median) const;
+};
+
+#endif // TOUCH_FILTER_H
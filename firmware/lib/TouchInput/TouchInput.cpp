@@ -0,0 +1,191 @@
+#include "TouchInput.h"
+#ifndef NATIVE_BUILD
+#include <esp_timer.h>
+#endif
+
+TouchInput* TouchInput::instance = nullptr;
+
+TouchInput::TouchInput()
+    : irqPin(-1)
+    , irqQueue(1)
+    , events(TOUCH_QUEUE_LENGTH)
+    , running(false)
+    , taskActive(false)
+    , samples(0)
+    , wakeups(0)
+    , droppedEvents(0)
+{
+}
+
+// ============================================================
+// Start/Stop
+// ============================================================
+
+bool TouchInput::begin(TouchReader touchReader, int pin) {
+    if (running) {
+        return true;
+    }
+    reader = touchReader;
+    irqPin = pin;
+
+    running = true;
+    taskActive = true;
+    if (!rtosStartTask(taskEntry, "touchTask", TOUCH_TASK_STACK, this,
+                       TOUCH_TASK_PRIORITY, TOUCH_TASK_CORE)) {
+        running = false;
+        taskActive = false;
+        Serial.println("[Touch] ERROR: Touch task failed");
+        return false;
+    }
+
+    if (irqPin >= 0) {
+        instance = this;
+        pinMode(irqPin, INPUT);
+        attachInterrupt(digitalPinToInterrupt(irqPin), isr, FALLING);
+    }
+
+    Serial.printf("[Touch] Task started (%s)\n", irqPin >= 0 ? "IRQ" : "polling");
+    return true;
+}
+
+void TouchInput::end() {
+    if (!running) {
+        return;
+    }
+    if (irqPin >= 0) {
+        detachInterrupt(digitalPinToInterrupt(irqPin));
+        instance = nullptr;
+    }
+
+    running = false;
+    while (taskActive) {
+        rtosSleepMs(5);
+    }
+    irqQueue.clear();
+    events.clear();
+}
+
+bool TouchInput::receive(TouchEvent& event, uint32_t timeoutMs) {
+    return events.receive(event, timeoutMs);
+}
+
+// ============================================================
+// Interrupt
+// ============================================================
+
+void IRAM_ATTR TouchInput::isr() {
+    if (instance) {
+        instance->notifyIrq();
+    }
+}
+
+// Läuft in der ISR: alles hier muss im IRAM liegen, eine Flanke kann kommen,
+// während der Flash-Cache aus ist (Kalibrierung per Preferences/NVS schreiben).
+// esp_timer_get_time() und xQueueSendFromISR() liegen dort, rtosMicros() und
+// RtosQueue::sendFromISR() nicht
+void IRAM_ATTR TouchInput::notifyIrq() {
+    // Queue der Länge 1: weitere Flanken während einer Berührung verfallen
+#ifdef NATIVE_BUILD
+    irqQueue.sendFromISR(rtosMicros());
+#else
+    uint64_t now = esp_timer_get_time();
+    QueueHandle_t handle = irqQueue.nativeHandle();
+    BaseType_t woken = pdFALSE;
+    if (handle) {
+        xQueueSendFromISR(handle, &now, &woken);
+    }
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+#endif
+}
+
+// ============================================================
+// Touch-Task
+// ============================================================
+
+void TouchInput::taskEntry(void* arg) {
+    TouchInput* input = static_cast<TouchInput*>(arg);
+    input->taskLoop();
+    input->taskActive = false;
+    rtosEndTask();
+}
+
+void TouchInput::taskLoop() {
+    while (running) {
+        uint64_t downUs;
+        if (waitForTouch(downUs)) {
+            trackTouch(downUs);
+        }
+    }
+}
+
+bool TouchInput::waitForTouch(uint64_t& downUs) {
+    if (irqPin < 0) {
+        rtosSleepMs(TOUCH_IDLE_POLL);
+        downUs = rtosMicros();
+        return true;  // trackTouch() prüft selbst, ob berührt
+    }
+    // Timeout nur, damit end() den Task beenden kann
+    return irqQueue.receive(downUs, 100);
+}
+
+void TouchInput::trackTouch(uint64_t downUs) {
+    uint16_t x, y;
+    if (!sample(x, y)) {
+        return;  // Störimpuls bzw. keine Berührung (Polling)
+    }
+    wakeups++;
+    emit(TOUCH_PRESS, x, y, downUs);
+
+    // Abtasten, bis TOUCH_RELEASE_SAMPLES Mal in Folge nichts gemessen wurde
+    uint16_t lastX = x;
+    uint16_t lastY = y;
+    uint8_t misses = 0;
+    while (running && misses < TOUCH_RELEASE_SAMPLES) {
+        rtosSleepMs(TOUCH_SAMPLE_INTERVAL);
+        if (!sample(x, y)) {
+            misses++;
+            continue;
+        }
+        misses = 0;
+        if (abs((int)x - lastX) >= TOUCH_MOVE_THRESHOLD || abs((int)y - lastY) >= TOUCH_MOVE_THRESHOLD) {
+            emit(TOUCH_MOVE, x, y, downUs);
+            lastX = x;
+            lastY = y;
+        }
+    }
+    emit(TOUCH_RELEASE, lastX, lastY, downUs);
+
+    if (irqPin >= 0) {
+        // Die eigenen Lesezugriffe erzeugen PENIRQ-Flanken
+        irqQueue.clear();
+        // Neue Berührung, deren Flanke gerade verworfen wurde
+        if (digitalRead(irqPin) == LOW) {
+            irqQueue.send(rtosMicros());
+        }
+    }
+}
+
+bool TouchInput::sample(uint16_t& x, uint16_t& y) {
+    samples++;
+    return reader && reader(&x, &y);
+}
+
+void TouchInput::emit(TouchEventType type, uint16_t x, uint16_t y, uint64_t downUs) {
+    TouchEvent event;
+    event.type = type;
+    event.x = x;
+    event.y = y;
+    event.downUs = downUs;
+    event.sampledUs = rtosMicros();
+
+    if (!events.send(event)) {
+        droppedEvents++;
+        return;
+    }
+    // Nur beim ersten Event wecken: receive() in loop() leert die ganze Queue
+    if (events.count() == 1 && notifyListener) {
+        notifyListener();
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef TOUCH_INPUT_H
+#define TOUCH_INPUT_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <functional>
+#include "RtosCompat.h"
+
+/**
+ * Interrupt-gesteuerte Touch-Eingabe
+ *
+ * Der PENIRQ-Pin des XPT2046 geht bei Berührung auf LOW. Die ISR weckt
+ * nur den Touch-Task; der liest die Koordinaten, solange der Finger
+ * aufliegt, und reiht PRESS/MOVE/RELEASE in eine Queue. Ohne Berührung
+ * gibt es keinen einzigen SPI-Zugriff, loop() schläft.
+ *
+ * Ohne IRQ-Pin (begin(reader, -1)) fragt der Task selbst alle
+ * TOUCH_IDLE_POLL ms ab - immer noch außerhalb von loop().
+ *
+ * Entprellen: Ein Loslassen zählt erst nach TOUCH_RELEASE_SAMPLES
+ * Abtastungen ohne Berührung. Jedes Drücken wird gemeldet, auch schnelle
+ * Taps hintereinander (keine Sperrzeit mehr).
+ */
+
+// Task-Konfiguration (in config.h überschreibbar)
+#ifndef TOUCH_TASK_CORE
+#define TOUCH_TASK_CORE 1
+#endif
+#ifndef TOUCH_TASK_PRIORITY
+#define TOUCH_TASK_PRIORITY 3    // Über loop() (1) und Logger (2), unter Lap-Task (5)
+#endif
+#ifndef TOUCH_TASK_STACK
+#define TOUCH_TASK_STACK 3072
+#endif
+#ifndef TOUCH_QUEUE_LENGTH
+#define TOUCH_QUEUE_LENGTH 16
+#endif
+#ifndef TOUCH_SAMPLE_INTERVAL
+#define TOUCH_SAMPLE_INTERVAL 10 // ms zwischen zwei Abtastungen, solange gedrückt
+#endif
+#ifndef TOUCH_IDLE_POLL
+#define TOUCH_IDLE_POLL 20       // ms, nur ohne IRQ-Pin
+#endif
+#ifndef TOUCH_RELEASE_SAMPLES
+#define TOUCH_RELEASE_SAMPLES 2  // Abtastungen ohne Berührung bis RELEASE
+#endif
+#ifndef TOUCH_MOVE_THRESHOLD
+#define TOUCH_MOVE_THRESHOLD 4   // px, kleinere Bewegungen erzeugen kein MOVE
+#endif
+
+enum TouchEventType : uint8_t {
+    TOUCH_PRESS,
+    TOUCH_MOVE,
+    TOUCH_RELEASE
+};
+
+struct TouchEvent {
+    TouchEventType type;
+    uint16_t x;
+    uint16_t y;
+    uint64_t downUs;    // rtosMicros() des IRQ (bzw. der ersten Abtastung) dieser Berührung
+    uint64_t sampledUs; // rtosMicros() der Abtastung
+};
+
+// Liest die Bildschirmkoordinaten, false = nicht berührt (läuft im Touch-Task)
+typedef std::function<bool(uint16_t* x, uint16_t* y)> TouchReader;
+// Aufgerufen, wenn die Queue nicht mehr leer ist (z.B. EventLoop wecken)
+typedef std::function<void()> TouchNotify;
+
+class TouchInput {
+public:
+    TouchInput();
+
+    // irqPin < 0: ohne Interrupt, Task fragt alle TOUCH_IDLE_POLL ms ab
+    bool begin(TouchReader reader, int irqPin = -1);
+    void end();
+    void onEvent(TouchNotify notify) { notifyListener = notify; }
+
+    // Nächstes Event (aus loop()), false = Queue leer
+    bool receive(TouchEvent& event, uint32_t timeoutMs = 0);
+
+    // Weckt den Task wie eine fallende Flanke (ISR, Host-Build), liegt im IRAM
+    void IRAM_ATTR notifyIrq();
+
+    bool isInterruptDriven() const { return irqPin >= 0; }
+    uint32_t getSamples() const { return samples; }         // Lesezugriffe auf den Controller
+    uint32_t getWakeups() const { return wakeups; }         // IRQs bzw. Abfragen mit Berührung
+    uint32_t getDroppedEvents() const { return droppedEvents; }
+
+private:
+    TouchReader reader;
+    TouchNotify notifyListener;
+    int irqPin;
+
+    RtosQueue<uint64_t> irqQueue;   // Länge 1: weckt den Task, trägt den IRQ-Zeitpunkt
+    RtosQueue<TouchEvent> events;
+
+    std::atomic<bool> running;
+    std::atomic<bool> taskActive;
+    std::atomic<uint32_t> samples;
+    std::atomic<uint32_t> wakeups;
+    std::atomic<uint32_t> droppedEvents;
+
+    static TouchInput* instance;    // attachInterrupt() kennt kein Argument
+    static void IRAM_ATTR isr();
+
+    static void taskEntry(void* arg);
+    void taskLoop();
+    bool waitForTouch(uint64_t& downUs);
+    void trackTouch(uint64_t downUs);
+    bool sample(uint16_t& x, uint16_t& y);
+    void emit(TouchEventType type, uint16_t x, uint16_t y, uint64_t downUs);
+};
+
+#endif // TOUCH_INPUT_H
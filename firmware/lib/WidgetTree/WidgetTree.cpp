@@ -0,0 +1,177 @@
+#include "WidgetTree.h"
+#include <algorithm>
+
+WidgetTree::WidgetTree() : indexValid(false) {
+}
+
+// ============================================================
+// Aufbau
+// ============================================================
+
+void WidgetTree::clear() {
+    widgets.clear();
+    byTop.clear();
+    maxBottom.clear();
+    indexValid = false;
+}
+
+int WidgetTree::add(WidgetKind kind, int16_t x, int16_t y, int16_t w, int16_t h,
+                    const String& text, uint16_t color, WidgetAction action) {
+    Widget widget;
+    widget.kind = kind;
+    widget.x = x;
+    widget.y = y;
+    widget.w = w;
+    widget.h = h;
+    widget.text = text;
+    widget.color = color;
+    widget.textColor = 0x0000;
+    widget.textSize = 2;
+    widget.checked = false;
+    widget.visible = true;
+    widget.dirty = true;
+    widget.action = action;
+
+    widgets.push_back(widget);
+    indexValid = false;
+    return (int)widgets.size() - 1;
+}
+
+int WidgetTree::addButton(int16_t x, int16_t y, int16_t w, int16_t h,
+                          const String& text, uint16_t color, WidgetAction action) {
+    return add(WIDGET_BUTTON, x, y, w, h, text, color, action);
+}
+
+int WidgetTree::addLabel(int16_t x, int16_t y, int16_t w, int16_t h,
+                         const String& text, uint16_t background, uint8_t textSize) {
+    int id = add(WIDGET_LABEL, x, y, w, h, text, background);
+    widgets[id].textSize = textSize;
+    return id;
+}
+
+Widget* WidgetTree::get(int id) {
+    if (id < 0 || id >= (int)widgets.size()) {
+        return nullptr;
+    }
+    return &widgets[id];
+}
+
+// ============================================================
+// Änderungen
+// ============================================================
+
+void WidgetTree::setText(int id, const String& text) {
+    Widget* widget = get(id);
+    if (widget && widget->text != text) {
+        widget->text = text;
+        widget->dirty = true;
+    }
+}
+
+void WidgetTree::setDetail(int id, const String& detail) {
+    Widget* widget = get(id);
+    if (widget && widget->detail != detail) {
+        widget->detail = detail;
+        widget->dirty = true;
+    }
+}
+
+void WidgetTree::setColor(int id, uint16_t color) {
+    Widget* widget = get(id);
+    if (widget && widget->color != color) {
+        widget->color = color;
+        widget->dirty = true;
+    }
+}
+
+void WidgetTree::setChecked(int id, bool checked) {
+    Widget* widget = get(id);
+    if (widget && widget->checked != checked) {
+        widget->checked = checked;
+        widget->dirty = true;
+    }
+}
+
+void WidgetTree::setVisible(int id, bool visible) {
+    Widget* widget = get(id);
+    if (widget && widget->visible != visible) {
+        widget->visible = visible;
+        widget->dirty = true;
+    }
+}
+
+void WidgetTree::invalidate() {
+    for (auto& widget : widgets) {
+        widget.dirty = true;
+    }
+}
+
+uint16_t WidgetTree::render(const WidgetRenderer& renderer) {
+    uint16_t drawn = 0;
+    for (auto& widget : widgets) {
+        if (!widget.dirty) {
+            continue;
+        }
+        widget.dirty = false;
+        renderer(widget);
+        drawn++;
+    }
+    return drawn;
+}
+
+// ============================================================
+// Hit-Test
+// ============================================================
+
+void WidgetTree::buildIndex() {
+    byTop.resize(widgets.size());
+    for (size_t i = 0; i < widgets.size(); i++) {
+        byTop[i] = (uint16_t)i;
+    }
+    std::sort(byTop.begin(), byTop.end(), [this](uint16_t a, uint16_t b) {
+        return widgets[a].y < widgets[b].y;
+    });
+
+    maxBottom.resize(byTop.size());
+    int16_t bottom = INT16_MIN;
+    for (size_t i = 0; i < byTop.size(); i++) {
+        const Widget& widget = widgets[byTop[i]];
+        bottom = std::max<int16_t>(bottom, widget.y + widget.h);
+        maxBottom[i] = bottom;
+    }
+    indexValid = true;
+}
+
+int WidgetTree::hitTest(int16_t x, int16_t y) {
+    if (!indexValid) {
+        buildIndex();
+    }
+
+    // Letztes Widget mit Oberkante <= y, danach nur rückwärts, solange
+    // ein früheres Widget noch bis unter y reichen kann
+    auto upper = std::upper_bound(byTop.begin(), byTop.end(), y, [this](int16_t ty, uint16_t index) {
+        return ty < widgets[index].y;
+    });
+
+    int hit = -1;
+    for (int i = (int)(upper - byTop.begin()) - 1; i >= 0 && maxBottom[i] > y; i--) {
+        const Widget& widget = widgets[byTop[i]];
+        // Bei Überlappung gewinnt das zuletzt angelegte (oben gezeichnete)
+        if (widget.visible && widget.action && widget.contains(x, y) && byTop[i] > hit) {
+            hit = byTop[i];
+        }
+    }
+    return hit;
+}
+
+bool WidgetTree::dispatch(int16_t x, int16_t y) {
+    int id = hitTest(x, y);
+    if (id < 0) {
+        return false;
+    }
+
+    // Kopie: die Aktion darf den Baum umbauen (Screen-Wechsel)
+    WidgetAction action = widgets[id].action;
+    action();
+    return true;
+}
@@ -0,0 +1,94 @@
+#ifndef WIDGET_TREE_H
+#define WIDGET_TREE_H
+
+#include <Arduino.h>
+#include <functional>
+#include <vector>
+
+/**
+ * Retained Widget-Baum für einen Screen
+ *
+ * Ein Screen legt seine Buttons, Labels und Listeneinträge einmal beim
+ * Betreten an. Dieselben Rechtecke werden zum Zeichnen und für den
+ * Touch-Hit-Test verwendet, Zeichen- und Touch-Pfad können also nicht
+ * mehr auseinanderlaufen.
+ *
+ * Änderungen (Text, Farbe, Sichtbarkeit) markieren nur das betroffene
+ * Widget als dirty; render() zeichnet ausschließlich dirty Widgets.
+ * Das Zeichnen selbst übernimmt die Variante (TFT_eSPI/LovyanGFX) über
+ * einen WidgetRenderer, die Lib bleibt hardwareunabhängig.
+ */
+
+enum WidgetKind : uint8_t {
+    WIDGET_BUTTON,      // Beschrifteter Button (zentriert)
+    WIDGET_BACK,        // Zurück-Button im Header
+    WIDGET_LABEL,       // Text auf Hintergrund, linksbündig, nicht antippbar
+    WIDGET_LIST_ITEM,   // Listeneintrag/Eingabefeld: text + optional detail
+    WIDGET_CHECKBOX     // Listeneintrag mit Auswahlpunkt (checked)
+};
+
+typedef std::function<void()> WidgetAction;
+
+struct Widget {
+    WidgetKind kind;
+    int16_t x, y, w, h;
+    String text;
+    String detail;          // Zweite Zeile (Listeneintrag)
+    uint16_t color;         // Hintergrund
+    uint16_t textColor;
+    uint8_t textSize;
+    bool checked;
+    bool visible;
+    bool dirty;
+    WidgetAction action;    // Leer = nicht antippbar
+
+    bool contains(int16_t tx, int16_t ty) const {
+        return tx >= x && tx < x + w && ty >= y && ty < y + h;
+    }
+};
+
+typedef std::function<void(const Widget&)> WidgetRenderer;
+
+class WidgetTree {
+public:
+    WidgetTree();
+
+    // Aufbau (beim Betreten eines Screens)
+    void clear();
+    int add(WidgetKind kind, int16_t x, int16_t y, int16_t w, int16_t h,
+            const String& text, uint16_t color, WidgetAction action = nullptr);
+    int addButton(int16_t x, int16_t y, int16_t w, int16_t h,
+                  const String& text, uint16_t color, WidgetAction action);
+    int addLabel(int16_t x, int16_t y, int16_t w, int16_t h,
+                 const String& text, uint16_t background, uint8_t textSize);
+
+    Widget* get(int id);
+    size_t size() const { return widgets.size(); }
+
+    // Änderungen markieren das Widget nur dirty, wenn sich etwas ändert
+    void setText(int id, const String& text);
+    void setDetail(int id, const String& detail);
+    void setColor(int id, uint16_t color);
+    void setChecked(int id, bool checked);
+    void setVisible(int id, bool visible);
+    void invalidate();  // Alles neu zeichnen
+
+    // Zeichnet alle dirty Widgets (auch unsichtbare: der Renderer löscht sie)
+    uint16_t render(const WidgetRenderer& renderer);
+
+    // Oberstes antippbares Widget unter (x, y), -1 = keins. O(log n) über
+    // einen nach y sortierten Index.
+    int hitTest(int16_t x, int16_t y);
+    // Führt die Aktion des getroffenen Widgets aus
+    bool dispatch(int16_t x, int16_t y);
+
+private:
+    std::vector<Widget> widgets;
+    std::vector<uint16_t> byTop;        // Widget-Indizes nach y sortiert
+    std::vector<int16_t> maxBottom;     // Präfix-Maximum der Unterkanten in byTop
+    bool indexValid;
+
+    void buildIndex();
+};
+
+#endif // WIDGET_TREE_H
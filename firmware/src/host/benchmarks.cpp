@@ -0,0 +1,1110 @@
+/**
+ * MoRa-LC Host-Benchmarks: Lap-Timing Hot Paths
+ *
+ * Google-Benchmark-Suite für die Pfade, die pro Advertisement bzw. pro
+ * Runde laufen. Serial ist stumm geschaltet, die printf-Formatierung in
+ * den Libraries wird aber wie auf dem ESP32 mitgemessen.
+ *
+ * Aufruf (JSON für Regressions-Tracking):
+ *   benchmarks --benchmark_format=json --benchmark_out=bench.json
+ *
+ * Parameter: /teams bzw. /teams/laps
+ *
+ * BM_TouchFilter misst neben der Rechenzeit die Genauigkeit gegen die
+ * Abtastrate: err_px/p95_px/max_px gegen die wahre Position, dropped_pct
+ * verworfene Lesezugriffe bei aufliegendem Finger, spi_us/rate_hz die SPI-Zeit eines
+ * Lesezugriffs auf dem XPT2046 (2 MHz) und die damit höchste Rate.
+ */
+
+#include <Arduino.h>
+#include <HostBLE.h>
+#include <SD.h>
+#include <LovyanGFX.hpp>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../lib/BLEScanner/BLEScanner.h"
+#include "../../lib/DataLogger/DataLogger.h"
+#include "../../lib/Diagnostics/Diagnostics.h"
+#include "../../lib/LapCounter/LapCounter.h"
+#include "../../lib/LoRaComm/LoRaProtocol.h"
+#include "../../lib/RaceResults/CsvReader.h"
+#include "../../lib/RaceResults/LapLog.h"
+#include "../../lib/RaceResults/RaceResults.h"
+#include "../../lib/RaceResults/RssiLog.h"
+#include "../../lib/TouchFilter/TouchFilter.h"
+#include "../../lib/WidgetTree/WidgetTree.h"
+#include "../ultralight_v2/lgfx_canvas.h"
+
+#define BENCH_LAP_MS 30000
+
+static const std::vector<int64_t> TEAM_COUNTS = {1, 8, 20, 50};
+static const std::vector<int64_t> LAP_COUNTS = {10, 100, 500};
+
+// ============================================================
+// Fixtures
+// ============================================================
+
+static String teamMac(int index) {
+    char mac[18];
+    snprintf(mac, sizeof(mac), "c3:00:00:00:%02x:%02x", (index >> 8) & 0xFF, index & 0xFF);
+    return String(mac);
+}
+
+static std::string iBeaconData(int index) {
+    uint8_t uuid[16];
+    for (int i = 0; i < 16; i++) {
+        uuid[i] = (uint8_t)(0xA0 + i);
+    }
+    return HostBLE::makeIBeacon(uuid, 1, (uint16_t)index);
+}
+
+// LapCounter mit `teams` Teams und je `laps` gültigen Runden
+static void fillLapCounter(LapCounter& counter, int teams, int laps) {
+    for (int t = 0; t < teams; t++) {
+        counter.addTeam(t + 1, "Team " + String(t + 1), teamMac(t));
+    }
+    for (int lap = 0; lap <= laps; lap++) {
+        for (int t = 0; t < teams; t++) {
+            uint32_t lapMs = BENCH_LAP_MS + t * 250 + (lap % 7) * 100;
+            counter.recordLap((uint8_t)(t + 1), 1 + lap * lapMs);
+        }
+    }
+}
+
+// CSV im Format des früheren DataLogger::logLap() bzw. von exportRaceCSV()
+static String raceCSV(int teams, int laps) {
+    String csv = "Team ID,Team Name,Lap Number,Timestamp (ms),Duration (ms),Time of Day\n";
+    char line[96];
+    for (int lap = 1; lap <= laps; lap++) {
+        for (int t = 0; t < teams; t++) {
+            uint32_t duration = BENCH_LAP_MS + t * 250 + (lap % 7) * 100;
+            uint32_t timestamp = lap * duration;
+            uint32_t seconds = timestamp / 1000;
+            snprintf(line, sizeof(line), "%d,Team %d,%d,%u,%u,%02u:%02u:%02u\n",
+                     t + 1, t + 1, lap, timestamp, duration,
+                     seconds / 3600, (seconds % 3600) / 60, seconds % 60);
+            csv += line;
+        }
+    }
+    return csv;
+}
+
+// Dieselben Runden als Runden-Log (.lap) wie von DataLogger::logLap()
+static std::string raceLapLog(int teams, int laps) {
+    std::vector<LapLogTeam> table(teams);
+    for (int t = 0; t < teams; t++) {
+        lapLogInitTeam(table[t], t + 1, ("Team " + String(t + 1)).c_str());
+    }
+    LapLogHeader header;
+    lapLogInitHeader(header, "Bench", 0, table.data(), teams);
+
+    std::string log((const char*)&header, sizeof(header));
+    log.append((const char*)table.data(), table.size() * sizeof(LapLogTeam));
+    LapLogRecord record;
+    for (int lap = 1; lap <= laps; lap++) {
+        for (int t = 0; t < teams; t++) {
+            uint32_t duration = BENCH_LAP_MS + t * 250 + (lap % 7) * 100;
+            lapLogInitRecord(record, t, 0, lap, (uint64_t)lap * duration, duration);
+            log.append((const char*)&record, sizeof(record));
+        }
+    }
+    return log;
+}
+
+// ============================================================
+// BLEScanner
+// ============================================================
+
+static void BM_ParseIBeacon(benchmark::State& state) {
+    NimBLEAdvertisedDevice device("c3:00:00:00:00:01", -60, iBeaconData(1));
+    BeaconData beacon;
+    for (auto _ : state) {
+        bool ok = BLEScanner::parseIBeacon(&device, beacon);
+        benchmark::DoNotOptimize(ok);
+        benchmark::DoNotOptimize(beacon);
+    }
+}
+BENCHMARK(BM_ParseIBeacon);
+
+static void BM_ParseIBeaconReject(benchmark::State& state) {
+    // Häufigster Fall im Feld: kein iBeacon -> MAC-Fallback
+    NimBLEAdvertisedDevice device("c3:00:00:00:00:01", -60, "");
+    BeaconData beacon;
+    for (auto _ : state) {
+        bool ok = BLEScanner::parseIBeacon(&device, beacon);
+        benchmark::DoNotOptimize(ok);
+    }
+}
+BENCHMARK(BM_ParseIBeaconReject);
+
+// Komplettes onResult(): Filter, Parse, Map-Update, Callback
+static void BM_ScannerOnResult(benchmark::State& state) {
+    int teams = state.range(0);
+    BLEScanner scanner;
+    scanner.begin();
+    scanner.setUUIDFilter("c3:00:");
+    scanner.onBeaconDetected([](const BeaconData& beacon) {
+        benchmark::DoNotOptimize(beacon.rssi);
+    });
+    scanner.startScan(0);
+
+    std::vector<std::string> macs;
+    for (int t = 0; t < teams; t++) {
+        macs.push_back(teamMac(t).c_str());
+    }
+
+    size_t next = 0;
+    for (auto _ : state) {
+        HostBLE::injectAdvert(macs[next], -60);
+        if (++next == macs.size()) next = 0;
+    }
+    scanner.stopScan();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ScannerOnResult)->ArgName("teams")->ArgsProduct({TEAM_COUNTS});
+
+// ============================================================
+// LapCounter
+// ============================================================
+
+static void BM_GetTeamByBeacon(benchmark::State& state) {
+    int teams = state.range(0);
+    LapCounter counter;
+    fillLapCounter(counter, teams, 0);
+
+    std::vector<String> macs;
+    for (int t = 0; t < teams; t++) {
+        macs.push_back(teamMac(t));
+    }
+
+    size_t next = 0;
+    for (auto _ : state) {
+        TeamData* team = counter.getTeamByBeacon(macs[next]);
+        benchmark::DoNotOptimize(team);
+        if (++next == macs.size()) next = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetTeamByBeacon)->ArgName("teams")->ArgsProduct({TEAM_COUNTS});
+
+// Eine Runde für jedes Team auf einem Rennen mit `laps` Runden
+static void BM_RecordLap(benchmark::State& state) {
+    int teams = state.range(0);
+    int laps = state.range(1);
+    LapCounter prefilled;
+    fillLapCounter(prefilled, teams, laps);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        LapCounter counter = prefilled;
+        state.ResumeTiming();
+        for (int t = 0; t < teams; t++) {
+            TeamData* team = counter.getTeam(t + 1);
+            counter.recordLap((uint8_t)(t + 1), team->lastLapTime + BENCH_LAP_MS);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * teams);
+}
+BENCHMARK(BM_RecordLap)->ArgNames({"teams", "laps"})->ArgsProduct({TEAM_COUNTS, LAP_COUNTS});
+
+static void BM_GetLeaderboard(benchmark::State& state) {
+    LapCounter counter;
+    fillLapCounter(counter, state.range(0), state.range(1));
+    for (auto _ : state) {
+        std::vector<TeamData*> board = counter.getLeaderboard();
+        benchmark::DoNotOptimize(board.data());
+    }
+}
+BENCHMARK(BM_GetLeaderboard)->ArgNames({"teams", "laps"})->ArgsProduct({TEAM_COUNTS, LAP_COUNTS});
+
+static void BM_ExportAllToCSV(benchmark::State& state) {
+    LapCounter counter;
+    fillLapCounter(counter, state.range(0), state.range(1));
+    size_t bytes = 0;
+    for (auto _ : state) {
+        String csv = counter.exportAllToCSV();
+        bytes += csv.length();
+        benchmark::DoNotOptimize(csv.c_str());
+    }
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_ExportAllToCSV)->ArgNames({"teams", "laps"})->ArgsProduct({TEAM_COUNTS, LAP_COUNTS});
+
+// ============================================================
+// LoRaProtocol
+// ============================================================
+
+static void BM_LoRaChecksum(benchmark::State& state) {
+    BeaconTelemetryMsg msg = LoRaProtocol::createTelemetryMsg(7);
+    for (auto _ : state) {
+        uint8_t checksum = LoRaProtocol::calculateChecksum((const uint8_t*)&msg, sizeof(msg));
+        benchmark::DoNotOptimize(checksum);
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(msg));
+}
+BENCHMARK(BM_LoRaChecksum);
+
+static void BM_LoRaParseMessage(benchmark::State& state) {
+    BeaconTelemetryMsg msg = LoRaProtocol::createTelemetryMsg(7);
+    BeaconTelemetryMsg parsed;
+    for (auto _ : state) {
+        bool ok = LoRaProtocol::parseMessage((const uint8_t*)&msg, sizeof(msg), &parsed);
+        benchmark::DoNotOptimize(ok);
+        benchmark::DoNotOptimize(parsed);
+    }
+}
+BENCHMARK(BM_LoRaParseMessage);
+
+// ============================================================
+// Diagnostics (läuft in jedem loop()-Durchlauf, Budget < 1 %)
+// ============================================================
+
+static void BM_HistogramRecord(benchmark::State& state) {
+    LatencyHistogram histogram;
+    uint32_t sample = 1;
+    for (auto _ : state) {
+        histogram.record(sample);
+        sample = sample * 1103515245 + 12345;  // Über alle Buckets streuen
+        sample >>= 12;
+    }
+    benchmark::DoNotOptimize(histogram.getCount());
+}
+BENCHMARK(BM_HistogramRecord);
+
+static void BM_DiagnosticsCount(benchmark::State& state) {
+    for (auto _ : state) {
+        diagnostics.count(DIAG_ADVERTS_RECEIVED);
+    }
+    benchmark::DoNotOptimize(diagnostics.getCounter(DIAG_ADVERTS_RECEIVED));
+}
+BENCHMARK(BM_DiagnosticsCount);
+
+// ============================================================
+// UI: Widget-Hit-Test (pro Touch)
+// ============================================================
+
+// Liste aus `widgets` Zeilen à 2 Buttons (320 px breit, 30 px hoch)
+static void fillWidgetTree(WidgetTree& tree, int widgets) {
+    for (int i = 0; i < widgets; i++) {
+        tree.addButton((i % 2) * 160, (i / 2) * 30, 150, 28, "Button", 0x8410, []() {});
+    }
+}
+
+static void BM_WidgetHitTest(benchmark::State& state) {
+    WidgetTree tree;
+    fillWidgetTree(tree, state.range(0));
+    int16_t height = (int16_t)((state.range(0) + 1) / 2 * 30);
+    uint32_t seed = 1;
+    for (auto _ : state) {
+        seed = seed * 1103515245 + 12345;
+        int16_t x = (seed >> 8) % 320;
+        int16_t y = (seed >> 16) % height;
+        benchmark::DoNotOptimize(tree.hitTest(x, y));
+    }
+}
+BENCHMARK(BM_WidgetHitTest)->ArgName("widgets")->Arg(8)->Arg(32)->Arg(128);
+
+// Vergleich: lineare Suche wie bisher mit isTouchInRect()-Ketten
+static void BM_WidgetHitTestLinear(benchmark::State& state) {
+    WidgetTree tree;
+    fillWidgetTree(tree, state.range(0));
+    int16_t height = (int16_t)((state.range(0) + 1) / 2 * 30);
+    uint32_t seed = 1;
+    for (auto _ : state) {
+        seed = seed * 1103515245 + 12345;
+        int16_t x = (seed >> 8) % 320;
+        int16_t y = (seed >> 16) % height;
+        int hit = -1;
+        for (size_t i = 0; i < tree.size() && hit < 0; i++) {
+            if (tree.get(i)->contains(x, y)) {
+                hit = i;
+            }
+        }
+        benchmark::DoNotOptimize(hit);
+    }
+}
+BENCHMARK(BM_WidgetHitTestLinear)->ArgName("widgets")->Arg(8)->Arg(32)->Arg(128);
+
+// ============================================================
+// Touch-Filter (pro Lesezugriff im Touch-Task)
+// ============================================================
+
+#define BENCH_TOUCH_READS 4096
+#define BENCH_TOUCH_PRESS_READS 24      // Lesezugriffe pro Berührung (240 ms)
+#define BENCH_TOUCH_NOISE 10.0          // Rohwert, Standardabweichung
+#define BENCH_TOUCH_SPIKE_PCT 8         // Abtastungen mit Ausreißer
+#define BENCH_TOUCH_EDGE_READS 2        // Aufsetzen/Abheben mit wenig Druck
+
+struct BenchTouchRead {
+    TouchSample samples[TOUCH_FILTER_MAX_SAMPLES];
+    uint16_t trueX;     // Rohwert der wahren Position
+    uint16_t trueY;
+    bool newPress;
+    bool edge;          // Aufsetzen/Abheben, Verwerfen erwünscht
+};
+
+static uint16_t clampRaw(double value) {
+    return (uint16_t)std::max(0.0, std::min(4095.0, value));
+}
+
+// Berührungen an zufälligen Stellen, Finger zittert leicht. Am Anfang und
+// Ende jeder Berührung fehlt Druck, die Position zieht Richtung Rand wie
+// beim halb aufliegenden Finger.
+static std::vector<BenchTouchRead> touchReads(uint8_t samplesPerRead) {
+    std::vector<BenchTouchRead> reads(BENCH_TOUCH_READS);
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> position(400, 3600);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> pressure(600, 999);
+    std::uniform_int_distribution<int> lowPressure(0, TOUCH_PRESSURE_MIN - 1);
+    std::uniform_int_distribution<int> spike(200, 600);
+    std::normal_distribution<double> gaussian(0.0, 1.0);
+    double x = 0, y = 0;
+    for (int i = 0; i < BENCH_TOUCH_READS; i++) {
+        int inPress = i % BENCH_TOUCH_PRESS_READS;
+        BenchTouchRead& read = reads[i];
+        read.newPress = inPress == 0;
+        if (read.newPress) {
+            x = position(random);
+            y = position(random);
+        }
+        x += gaussian(random) * 2;
+        y += gaussian(random) * 2;
+        read.trueX = clampRaw(x);
+        read.trueY = clampRaw(y);
+
+        read.edge = inPress < BENCH_TOUCH_EDGE_READS || inPress >= BENCH_TOUCH_PRESS_READS - BENCH_TOUCH_EDGE_READS;
+        for (uint8_t s = 0; s < samplesPerRead; s++) {
+            TouchSample& sample = read.samples[s];
+            double sx = x + gaussian(random) * BENCH_TOUCH_NOISE;
+            double sy = y + gaussian(random) * BENCH_TOUCH_NOISE;
+            sample.z = pressure(random);
+            if (read.edge && percent(random) < 50) {
+                sample.z = lowPressure(random);
+                sx *= 0.6;
+                sy *= 0.6;
+            }
+            if (percent(random) < BENCH_TOUCH_SPIKE_PCT) {
+                sx += (percent(random) < 50 ? 1 : -1) * spike(random);
+            }
+            sample.x = clampRaw(sx);
+            sample.y = clampRaw(sy);
+        }
+    }
+    return reads;
+}
+
+static void BM_TouchFilter(benchmark::State& state) {
+    uint8_t samplesPerRead = (uint8_t)state.range(0);
+    std::vector<BenchTouchRead> reads = touchReads(samplesPerRead);
+    TouchCalibration calibration;
+    calibration.setRange(200, 3700, 200, 3800, 320, 240);
+    TouchFilter filter;
+    filter.setCalibration(calibration);
+
+    size_t index = 0;
+    for (auto _ : state) {
+        const BenchTouchRead& read = reads[index];
+        if (read.newPress) {
+            filter.reset();
+        }
+        uint16_t x, y;
+        benchmark::DoNotOptimize(filter.process(read.samples, samplesPerRead, &x, &y));
+        index = (index + 1) % reads.size();
+    }
+
+    // Genauigkeit: ein Durchlauf außerhalb der Zeitmessung
+    TouchFilter check;
+    check.setCalibration(calibration);
+    std::vector<double> errors;
+    uint32_t dropped = 0;
+    uint32_t steady = 0;
+    for (const BenchTouchRead& read : reads) {
+        if (read.newPress) {
+            check.reset();
+        }
+        uint16_t x, y;
+        steady += read.edge ? 0 : 1;
+        if (!check.process(read.samples, samplesPerRead, &x, &y)) {
+            dropped += read.edge ? 0 : 1;
+            continue;
+        }
+        int32_t trueX, trueY;
+        calibration.apply(read.trueX, read.trueY, trueX, trueY);
+        errors.push_back(hypot((double)x - trueX, (double)y - trueY));
+    }
+    std::sort(errors.begin(), errors.end());
+    double sum = 0;
+    for (double error : errors) {
+        sum += error;
+    }
+
+    // XPT2046: Befehl + pro Abtastung 5 Wandlungen à 16 Takte + Abschluss
+    double spiUs = (8 + samplesPerRead * 5 * 16 + 16) / 2.0;
+    state.counters["err_px"] = errors.empty() ? 0 : sum / errors.size();
+    state.counters["p95_px"] = errors.empty() ? 0 : errors[errors.size() * 95 / 100];
+    state.counters["max_px"] = errors.empty() ? 0 : errors.back();
+    state.counters["dropped_pct"] = 100.0 * dropped / steady;
+    state.counters["spi_us"] = spiUs;
+    state.counters["rate_hz"] = 1000000.0 / spiUs;
+}
+BENCHMARK(BM_TouchFilter)->ArgName("samples")->Arg(1)->Arg(3)->Arg(5)->Arg(7)->Arg(9);
+
+// ============================================================
+// Canvas: gemeinsame UI-Elemente, CRTP gegen virtuelle Aufrufe
+// ============================================================
+
+// Werte wie ui_helper.cpp (v2)
+static const CanvasTheme BENCH_THEME = {
+    320, 240, 0xCE59, 0x0000,
+    40, 0x2104, 0xFFFF, 2, true,
+    8, true, 0x4208, 0x0000, 3, 5,
+    true, 0x07E0
+};
+
+// Zum Vergleich: dieselben Primitive hinter einer vtable, wie es eine
+// Laufzeit-Abstraktion über TFT_eSPI/LovyanGFX bräuchte
+class BenchPrimitives {
+public:
+    virtual ~BenchPrimitives() {}
+    virtual void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) = 0;
+    virtual void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) = 0;
+    virtual void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) = 0;
+    virtual void fillCircle(int32_t x, int32_t y, int32_t r, uint16_t color) = 0;
+    virtual void drawCircle(int32_t x, int32_t y, int32_t r, uint16_t color) = 0;
+    virtual void setTextColor(uint16_t color) = 0;
+    virtual void setTextSize(uint8_t size) = 0;
+    virtual void setTextDatum(CanvasDatum datum) = 0;
+    virtual void drawString(const char* text, int32_t x, int32_t y) = 0;
+};
+
+class BenchCountingPrimitives : public BenchPrimitives {
+public:
+    explicit BenchCountingPrimitives(CountingCanvas& counter) : counter(counter) {}
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) override { counter.fillRect(x, y, w, h, color); }
+    void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) override { counter.drawRoundRect(x, y, w, h, r, color); }
+    void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) override { counter.fillRoundRect(x, y, w, h, r, color); }
+    void fillCircle(int32_t x, int32_t y, int32_t r, uint16_t color) override { counter.fillCircle(x, y, r, color); }
+    void drawCircle(int32_t x, int32_t y, int32_t r, uint16_t color) override { counter.drawCircle(x, y, r, color); }
+    void setTextColor(uint16_t color) override { counter.setTextColor(color); }
+    void setTextSize(uint8_t size) override { counter.setTextSize(size); }
+    void setTextDatum(CanvasDatum datum) override { counter.setTextDatum(datum); }
+    void drawString(const char* text, int32_t x, int32_t y) override { counter.drawString(text, x, y); }
+
+private:
+    CountingCanvas& counter;
+};
+
+class BenchVirtualCanvas : public Canvas<BenchVirtualCanvas> {
+public:
+    BenchVirtualCanvas(BenchPrimitives* primitives, const CanvasTheme& theme)
+        : Canvas<BenchVirtualCanvas>(theme), primitives(primitives) {}
+
+    void fillScreen(uint16_t color) { primitives->fillRect(0, 0, theme.screenWidth, theme.screenHeight, color); }
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) { primitives->fillRect(x, y, w, h, color); }
+    void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) { primitives->drawRoundRect(x, y, w, h, r, color); }
+    void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) { primitives->fillRoundRect(x, y, w, h, r, color); }
+    void fillCircle(int32_t x, int32_t y, int32_t r, uint16_t color) { primitives->fillCircle(x, y, r, color); }
+    void drawCircle(int32_t x, int32_t y, int32_t r, uint16_t color) { primitives->drawCircle(x, y, r, color); }
+    void setTextColor(uint16_t color) { primitives->setTextColor(color); }
+    void setTextSize(uint8_t size) { primitives->setTextSize(size); }
+    void setTextDatum(CanvasDatum datum) { primitives->setTextDatum(datum); }
+    void drawString(const char* text, int32_t x, int32_t y) { primitives->drawString(text, x, y); }
+
+private:
+    BenchPrimitives* primitives;
+};
+
+// Typischer Screen: Header, Zurück, 4 Buttons, 5 Listeneinträge (einer als
+// Checkbox), Meldungsbox
+static std::vector<Widget> benchCanvasWidgets() {
+    WidgetTree tree;
+    tree.add(WIDGET_BACK, 5, 5, 40, 30, "<", 0xFFFF);
+    for (int i = 0; i < 4; i++) {
+        tree.addButton((i % 2) * 160 + 5, 45 + (i / 2) * 45, 150, 40, "Button", 0x8410, []() {});
+    }
+    for (int i = 0; i < 5; i++) {
+        int id = tree.add(i == 0 ? WIDGET_CHECKBOX : WIDGET_LIST_ITEM, 5, 140 + i * 20, 310, 18, "Team 12", 0xFFFF);
+        tree.setDetail(id, i % 2 ? "5 Runden" : "");
+    }
+
+    std::vector<Widget> widgets;
+    for (size_t i = 0; i < tree.size(); i++) {
+        widgets.push_back(*tree.get(i));
+    }
+    return widgets;
+}
+
+template <typename Backend>
+static void drawBenchScreen(Canvas<Backend>& canvas, const std::vector<Widget>& widgets) {
+    canvas.header("Einstellungen");
+    for (const Widget& widget : widgets) {
+        canvas.widget(widget);
+    }
+    canvas.message("Gespeichert", "Team angelegt", 0x07E0, 3, 2);
+}
+
+static void BM_CanvasCounting(benchmark::State& state) {
+    std::vector<Widget> widgets = benchCanvasWidgets();
+    CountingCanvas canvas(BENCH_THEME);
+    for (auto _ : state) {
+        canvas.resetStats();
+        drawBenchScreen(canvas, widgets);
+        benchmark::DoNotOptimize(canvas.getPixels());
+    }
+    state.counters["calls"] = canvas.getCalls();
+    state.counters["pixels"] = canvas.getPixels();
+}
+BENCHMARK(BM_CanvasCounting);
+
+static void BM_CanvasVirtual(benchmark::State& state) {
+    std::vector<Widget> widgets = benchCanvasWidgets();
+    CountingCanvas counter(BENCH_THEME);
+    BenchCountingPrimitives primitives(counter);
+    BenchVirtualCanvas canvas(&primitives, BENCH_THEME);
+    for (auto _ : state) {
+        counter.resetStats();
+        drawBenchScreen(canvas, widgets);
+        benchmark::DoNotOptimize(counter.getPixels());
+    }
+    state.counters["calls"] = counter.getCalls();
+    state.counters["pixels"] = counter.getPixels();
+}
+BENCHMARK(BM_CanvasVirtual);
+
+// Dieselben Elemente gerastert in ein 320x240-Sprite (Host-Shim)
+static void BM_CanvasLgfxSprite(benchmark::State& state) {
+    std::vector<Widget> widgets = benchCanvasWidgets();
+    LGFX_Sprite sprite;
+    sprite.createSprite(BENCH_THEME.screenWidth, BENCH_THEME.screenHeight);
+    LgfxCanvas canvas(sprite, BENCH_THEME);
+    for (auto _ : state) {
+        drawBenchScreen(canvas, widgets);
+        benchmark::DoNotOptimize(sprite.getBuffer());
+    }
+    sprite.deleteSprite();
+}
+BENCHMARK(BM_CanvasLgfxSprite);
+
+// ============================================================
+// Ergebnis-Auswertung (displayRaceResultsFromFile)
+// ============================================================
+
+static void BM_RaceResultsParseCSV(benchmark::State& state) {
+    String csv = raceCSV(state.range(0), state.range(1));
+    RaceResults results;
+    for (auto _ : state) {
+        results.parseCSV(csv);
+        std::vector<const RaceTeamStats*> board = results.getLeaderboard();
+        benchmark::DoNotOptimize(board.data());
+    }
+    state.SetBytesProcessed(state.iterations() * csv.length());
+}
+BENCHMARK(BM_RaceResultsParseCSV)->ArgNames({"teams", "laps"})->ArgsProduct({TEAM_COUNTS, LAP_COUNTS});
+
+// Von der Karte (Host-Verzeichnis): wie bisher ganze Datei zeichenweise in
+// einen String und dann auswerten, gegen blockweises Streamen.
+// heap_bytes = Puffer für den Dateiinhalt
+static void useBenchCard() {
+    static char root[] = "/tmp/mora_bench_XXXXXX";
+    static bool rootReady = false;
+    if (!rootReady) {
+        rootReady = mkdtemp(root) != nullptr;
+        SD.setHostRoot(root);
+        SD.begin(5);
+    }
+}
+
+static String writeRaceFile(int teams, int laps, bool lapLog = false) {
+    useBenchCard();
+    String path = "/race_" + String(teams) + "_" + String(laps) + (lapLog ? ".lap" : ".csv");
+    File file = SD.open(path, FILE_WRITE);
+    if (lapLog) {
+        std::string log = raceLapLog(teams, laps);
+        file.write((const uint8_t*)log.data(), log.size());
+    } else {
+        String csv = raceCSV(teams, laps);
+        file.write((const uint8_t*)csv.c_str(), csv.length());
+    }
+    file.close();
+    return path;
+}
+
+static void BM_RaceResultsFileString(benchmark::State& state) {
+    String path = writeRaceFile(state.range(0), state.range(1));
+    RaceResults results;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        File file = SD.open(path, FILE_READ);
+        String content = "";
+        while (file.available()) {
+            content += (char)file.read();
+        }
+        file.close();
+        bytes = content.length();
+        results.parseCSV(content);
+        benchmark::DoNotOptimize(results.getTeamCount());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["heap_bytes"] = bytes;
+}
+BENCHMARK(BM_RaceResultsFileString)->ArgNames({"teams", "laps"})->ArgsProduct({TEAM_COUNTS, LAP_COUNTS});
+
+static void BM_RaceResultsFileStream(benchmark::State& state) {
+    String path = writeRaceFile(state.range(0), state.range(1));
+    RaceResults results;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        File file = SD.open(path, FILE_READ);
+        bytes = file.size();
+        results.parseFile(file);
+        file.close();
+        benchmark::DoNotOptimize(results.getTeamCount());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["heap_bytes"] = CSV_READER_BLOCK;
+}
+BENCHMARK(BM_RaceResultsFileStream)->ArgNames({"teams", "laps"})->ArgsProduct({TEAM_COUNTS, LAP_COUNTS});
+
+// Dieselben Runden aus dem binären Runden-Log (CRC-8 pro Datensatz)
+static void BM_RaceResultsFileLapLog(benchmark::State& state) {
+    String path = writeRaceFile(state.range(0), state.range(1), true);
+    RaceResults results;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        File file = SD.open(path, FILE_READ);
+        bytes = file.size();
+        results.parseLapLog(file);
+        file.close();
+        benchmark::DoNotOptimize(results.getTeamCount());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["file_bytes"] = bytes;
+}
+BENCHMARK(BM_RaceResultsFileLapLog)->ArgNames({"teams", "laps"})->ArgsProduct({TEAM_COUNTS, LAP_COUNTS});
+
+// Schreibpfad pro Runde: CSV-Zeile formatieren gegen Datensatz füllen
+static void BM_LogLapCsvLine(benchmark::State& state) {
+    String teamName = "Team 12";
+    char line[LAP_LOG_CSV_LINE_MAX];
+    uint32_t timestamp = 0;
+    for (auto _ : state) {
+        timestamp += BENCH_LAP_MS;
+        uint32_t seconds = timestamp / 1000;
+        int length = snprintf(line, sizeof(line), "%u,%s,%u,%lu,%lu,%02lu:%02lu:%02lu\n",
+                              12, teamName.c_str(), 7, (unsigned long)timestamp,
+                              (unsigned long)BENCH_LAP_MS, (unsigned long)seconds / 3600,
+                              (unsigned long)(seconds % 3600) / 60, (unsigned long)seconds % 60);
+        benchmark::DoNotOptimize(length);
+        benchmark::DoNotOptimize(line);
+    }
+}
+BENCHMARK(BM_LogLapCsvLine);
+
+static void BM_LogLapRecord(benchmark::State& state) {
+    LapLogRecord record;
+    uint32_t timestamp = 0;
+    for (auto _ : state) {
+        timestamp += BENCH_LAP_MS;
+        lapLogInitRecord(record, 11, 0, 7, timestamp, BENCH_LAP_MS);
+        benchmark::DoNotOptimize(record);
+    }
+}
+BENCHMARK(BM_LogLapRecord);
+
+// ============================================================
+// DataLogger: Schreiblatenz mit und ohne Vorbelegung
+// ============================================================
+
+// Ein Rennen (20 Teams x 300 Runden) durch DataLogger::logLap(). Die Host-
+// Karte kostet BENCH_SD_COMMIT_US pro geschlossener Datei und
+// BENCH_SD_ALLOC_US pro neu belegtem 32-KB-Cluster. flush_p50/p99/max_us:
+// logLap()-Aufrufe, die geschrieben haben (exakt, nicht in Buckets),
+// prealloc_ms: Vorbelegung in startNewRace()
+#define BENCH_SD_COMMIT_US 2000
+#define BENCH_SD_ALLOC_US 20000
+
+// Ein Rennen durch logLap(), Dauer der Aufrufe, die geschrieben haben
+static void runLoggerRace(DataLogger& logger, int teams, int laps, bool prealloc,
+                          std::vector<double>& flushUs) {
+    std::vector<LapLogTeam> table(teams);
+    std::vector<String> names(teams);
+    for (int t = 0; t < teams; t++) {
+        lapLogInitTeam(table[t], t + 1, ("Team " + String(t + 1)).c_str());
+        names[t] = table[t].name;
+    }
+
+    uint32_t durationMs = prealloc ? laps * (BENCH_LAP_MS + teams * 250) : 0;
+    logger.startNewRace("Bench", table.data(), teams, durationMs);
+    for (int lap = 1; lap <= laps; lap++) {
+        for (int t = 0; t < teams; t++) {
+            uint32_t flushes = logger.getLogStats().flushes;
+            auto start = std::chrono::steady_clock::now();
+            logger.logLap(t + 1, names[t], lap, lap * BENCH_LAP_MS, BENCH_LAP_MS);
+            double us = std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count();
+            if (logger.getLogStats().flushes != flushes) {
+                flushUs.push_back(us);
+            }
+        }
+    }
+    logger.finishRace();
+}
+
+static void setFlushCounters(benchmark::State& state, std::vector<double>& flushUs) {
+    std::sort(flushUs.begin(), flushUs.end());
+    state.counters["flushes"] = flushUs.size();
+    state.counters["flush_p50_us"] = flushUs.empty() ? 0 : flushUs[flushUs.size() / 2];
+    state.counters["flush_p99_us"] = flushUs.empty() ? 0 : flushUs[flushUs.size() * 99 / 100];
+    state.counters["flush_max_us"] = flushUs.empty() ? 0 : flushUs.back();
+}
+
+static void BM_DataLoggerFlush(benchmark::State& state) {
+    bool prealloc = state.range(0) != 0;
+    useBenchCard();
+    SD.setHostCommitDelayUs(BENCH_SD_COMMIT_US);
+    SD.setHostAllocDelayUs(BENCH_SD_ALLOC_US);
+
+    std::vector<double> flushUs;
+    DataLogger logger;
+    logger.begin(5);
+    for (auto _ : state) {
+        runLoggerRace(logger, 20, 300, prealloc, flushUs);
+    }
+    SD.setHostCommitDelayUs(0);
+    SD.setHostAllocDelayUs(0);
+
+    setFlushCounters(state, flushUs);
+    state.counters["prealloc_ms"] = logger.getLogStats().preallocUs / 1000.0;
+}
+BENCHMARK(BM_DataLoggerFlush)->ArgName("prealloc")->Arg(0)->Arg(1)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+// Dasselbe Rennen (20 Teams x 100 Runden, vorbelegt) auf den Kartenprofilen
+// der Host-Karte (hostCardProfile): wie stark schlagen langsame Karten und
+// Ausreißer der Karte auf logLap() durch. card_wait_ms: Summe aller
+// Wartezeiten der Karte, spikes: Ausreißer (je 250 ms)
+static const char* const BENCH_CARD_PROFILES[] = {"ideal", "class10", "slow", "spiky"};
+
+static void BM_DataLoggerCardProfile(benchmark::State& state) {
+    const char* name = BENCH_CARD_PROFILES[state.range(0)];
+    HostCardProfile profile;
+    hostCardProfile(name, profile);
+    useBenchCard();
+    SD.setHostProfile(profile);
+    SD.setHostSeed(1);
+    SD.resetHostStats();
+
+    std::vector<double> flushUs;
+    DataLogger logger;
+    logger.begin(5);
+    for (auto _ : state) {
+        runLoggerRace(logger, 20, 100, true, flushUs);
+    }
+    HostCardStats card = SD.hostStats();
+    SD.setHostProfile(HostCardProfile());
+
+    state.SetLabel(name);
+    setFlushCounters(state, flushUs);
+    state.counters["card_wait_ms"] = card.waitUs / 1000.0;
+    state.counters["spikes"] = card.spikes;
+}
+BENCHMARK(BM_DataLoggerCardProfile)->ArgName("profile")->DenseRange(0, 3)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+// ============================================================
+// DataLogger: Datei lesen (Download/Export)
+// ============================================================
+
+// Bisheriger Weg: Zeichen für Zeichen in einen String
+static void BM_DataLoggerReadBytewise(benchmark::State& state) {
+    String path = writeRaceFile(20, 500);
+    size_t bytes = 0;
+    for (auto _ : state) {
+        File file = SD.open(path, FILE_READ);
+        String content = "";
+        while (file.available()) {
+            content += (char)file.read();
+        }
+        file.close();
+        bytes = content.length();
+        benchmark::DoNotOptimize(content.c_str());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["heap_bytes"] = bytes;
+}
+BENCHMARK(BM_DataLoggerReadBytewise);
+
+// streamFile() mit Puffer des Aufrufers, ein read() pro Block
+static void BM_DataLoggerStreamFile(benchmark::State& state) {
+    String path = writeRaceFile(20, 500);
+    DataLogger logger;
+    logger.begin(5);
+    std::vector<uint8_t> buffer(state.range(0));
+    uint32_t streamed = 0;
+    uint32_t blocks = 0;
+    uint32_t crc = 0;
+    for (auto _ : state) {
+        blocks = 0;
+        logger.streamFile(path, buffer.data(), buffer.size(),
+                          [&](const uint8_t* data, size_t length, uint32_t) {
+                              crc = crc32Update(crc, data, length);
+                              blocks++;
+                              return true;
+                          }, 0, FILE_STREAM_TO_END, &streamed);
+        benchmark::DoNotOptimize(crc);
+    }
+    state.SetBytesProcessed(state.iterations() * streamed);
+    state.counters["blocks"] = blocks;
+    state.counters["heap_bytes"] = buffer.size();
+}
+BENCHMARK(BM_DataLoggerStreamFile)->ArgName("block")->Arg(64)->Arg(512)->Arg(4096);
+
+// ============================================================
+// Rennliste: Verzeichnis aufzählen gegen Katalog
+// ============================================================
+
+// Karte mit races beendeten Rennen (je .lap, .sum, _summary.txt) und
+// frischem Katalog
+static void writeRaceCard(DataLogger& logger, int races) {
+    useBenchCard();
+    File dir = SD.open("/races");
+    std::vector<String> old;
+    for (File file = dir.openNextFile(); file; file = dir.openNextFile()) {
+        old.push_back(String("/races/") + file.name());
+    }
+    dir.close();
+    for (const String& path : old) {
+        SD.remove(path);
+    }
+
+    logger.begin(5);
+    LapLogTeam team;
+    lapLogInitTeam(team, 1, "Team 1");
+    for (int race = 0; race < races; race++) {
+        logger.startNewRace("Bench " + String(race), &team, 1);
+        logger.logLap(1, "Team 1", 1, BENCH_LAP_MS, BENCH_LAP_MS);
+        logger.finishRace();
+    }
+}
+
+// Bisheriger getRaceFileList(): alle Dateien aufzählen, höchstens 20
+// sammeln, nach getLastWrite() bubble-sortieren
+static uint8_t listRacesByDirectory(String& fileList, uint8_t maxFiles) {
+    struct FileInfo {
+        String name;
+        unsigned long timestamp;
+    };
+    FileInfo files[20];
+    uint8_t fileCount = 0;
+    File dir = SD.open("/races");
+    File file = dir.openNextFile();
+    while (file && fileCount < 20) {
+        String fileName = String(file.name());
+        bool exported = fileName.endsWith(".csv") &&
+                        SD.exists(("/races/" + fileName.substring(0, fileName.length() - 4) + ".lap").c_str());
+        if ((fileName.endsWith(".lap") || fileName.endsWith(".csv")) && !exported) {
+            files[fileCount].name = fileName;
+            files[fileCount].timestamp = file.getLastWrite();
+            fileCount++;
+        }
+        file = dir.openNextFile();
+    }
+    dir.close();
+    for (uint8_t i = 0; i + 1 < fileCount; i++) {
+        for (uint8_t j = 0; j < fileCount - i - 1; j++) {
+            if (files[j].timestamp < files[j + 1].timestamp) {
+                FileInfo temp = files[j];
+                files[j] = files[j + 1];
+                files[j + 1] = temp;
+            }
+        }
+    }
+    fileList = "";
+    uint8_t count = (fileCount < maxFiles) ? fileCount : maxFiles;
+    for (uint8_t i = 0; i < count; i++) {
+        if (i > 0) fileList += "\n";
+        fileList += files[i].name;
+    }
+    return fileCount;
+}
+
+static void BM_RaceListDirectory(benchmark::State& state) {
+    DataLogger logger;
+    writeRaceCard(logger, state.range(0));
+    String fileList;
+    uint8_t seen = 0;
+    for (auto _ : state) {
+        seen = listRacesByDirectory(fileList, 10);
+        benchmark::DoNotOptimize(fileList.c_str());
+    }
+    state.counters["races_seen"] = seen;
+}
+BENCHMARK(BM_RaceListDirectory)->ArgName("races")->Arg(20)->Arg(200)->Arg(500);
+
+// getRaceFileList() über den Katalog: erste Seite, neueste zuerst
+static void BM_RaceListCatalog(benchmark::State& state) {
+    DataLogger logger;
+    writeRaceCard(logger, state.range(0));
+    String fileList;
+    for (auto _ : state) {
+        fileList = logger.getRaceFileList(10);
+        benchmark::DoNotOptimize(fileList.c_str());
+    }
+    state.counters["races_seen"] = logger.getRaceCatalog().getRaceCount();
+    auto rebuildStart = std::chrono::steady_clock::now();
+    logger.getRaceCatalog().rebuild();
+    state.counters["rebuild_ms"] = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - rebuildStart).count();
+}
+BENCHMARK(BM_RaceListCatalog)->ArgName("races")->Arg(20)->Arg(200)->Arg(500);
+
+// Vergangenes Rennen über die .sum (erster loadRace() legt sie an)
+static void BM_RaceResultsLoadSummary(benchmark::State& state) {
+    String path = writeRaceFile(state.range(0), state.range(1));
+    SD.remove(RaceResults::summaryPath(path));
+    RaceResults results;
+    results.loadRace(SD, path);
+    for (auto _ : state) {
+        results.loadRace(SD, path);
+        benchmark::DoNotOptimize(results.getTeamCount());
+    }
+    File summary = SD.open(RaceResults::summaryPath(path), FILE_READ);
+    state.counters["sum_bytes"] = summary.size();
+    state.counters["from_sum"] = results.isFromSummary();
+    summary.close();
+}
+BENCHMARK(BM_RaceResultsLoadSummary)->ArgNames({"teams", "laps"})->ArgsProduct({TEAM_COUNTS, LAP_COUNTS});
+
+// ============================================================
+// RSSI-Telemetrie: Kodieren pro Sample und Bytes pro Sample
+// ============================================================
+
+// Advertisements wie auf der Strecke: pro Team alle 100 ms plus 0-10 ms
+// advDelay, RSSI als langsam wandernder Pegel plus Rauschen (noise_db =
+// Standardabweichung). bytes_per_sample: ganze 4-KB-Blöcke / Samples,
+// csv_bytes_per_sample: dieselben Samples als "team,timestamp,rssi"
+static std::vector<RssiSample> rssiStream(int teams, int noiseDb, size_t count) {
+    std::mt19937 random(11);
+    std::normal_distribution<double> noise(0.0, noiseDb);
+    std::vector<uint32_t> next(teams);
+    std::vector<double> level(teams, -70.0);
+    for (int t = 0; t < teams; t++) {
+        next[t] = random() % 100;
+    }
+    std::vector<RssiSample> samples;
+    samples.reserve(count);
+    while (samples.size() < count) {
+        int t = std::min_element(next.begin(), next.end()) - next.begin();
+        level[t] = std::max(-100.0, std::min(-40.0, level[t] + (int)(random() % 3) - 1));
+        int rssi = (int)lround(level[t] + noise(random));
+        samples.push_back({next[t], (uint8_t)(t + 1), (int8_t)std::max(-127, std::min(0, rssi))});
+        next[t] += 100 + random() % 11;
+    }
+    return samples;
+}
+
+static void BM_RssiLogEncode(benchmark::State& state) {
+    std::vector<RssiSample> samples = rssiStream(state.range(0), state.range(1), 100000);
+    RssiFrameEncoder* encoder = new RssiFrameEncoder();
+    std::vector<uint8_t> block(RSSI_LOG_BLOCK_BYTES);
+    size_t blocks = 0;
+    for (auto _ : state) {
+        blocks = 0;
+        encoder->clear();
+        for (const RssiSample& sample : samples) {
+            if (!encoder->add(sample.teamId, sample.timestamp, sample.rssi)) {
+                encoder->finish(block.data());
+                blocks++;
+                encoder->clear();
+                encoder->add(sample.teamId, sample.timestamp, sample.rssi);
+            }
+        }
+        encoder->finish(block.data());
+        blocks++;
+        benchmark::DoNotOptimize(block.data());
+    }
+    delete encoder;
+
+    size_t csvBytes = 0;
+    for (const RssiSample& sample : samples) {
+        char line[32];
+        csvBytes += snprintf(line, sizeof(line), "%u,%lu,%d\n", sample.teamId,
+                             (unsigned long)sample.timestamp, sample.rssi);
+    }
+    state.SetItemsProcessed(state.iterations() * samples.size());
+    state.counters["bytes_per_sample"] = (double)blocks * RSSI_LOG_BLOCK_BYTES / samples.size();
+    state.counters["csv_bytes_per_sample"] = (double)csvBytes / samples.size();
+}
+BENCHMARK(BM_RssiLogEncode)->ArgNames({"teams", "noise_db"})->ArgsProduct({{10, 50}, {1, 3, 6}});
+
+// ============================================================
+// SD formatieren: Dateien einzeln löschen gegen mkfs
+// ============================================================
+
+// Bisheriges formatSD(): alles rekursiv löschen
+static uint32_t deleteFilesRecursive(const String& dirPath) {
+    File dir = SD.open(dirPath.c_str());
+    uint32_t deleted = 0;
+    for (File file = dir.openNextFile(); file; file = dir.openNextFile()) {
+        String filePath = String(file.path());
+        bool isDir = file.isDirectory();
+        file.close();
+        if (isDir) {
+            deleted += deleteFilesRecursive(filePath);
+            SD.rmdir(filePath.c_str());
+        } else if (SD.remove(filePath.c_str())) {
+            deleted++;
+        }
+    }
+    dir.close();
+    return deleted;
+}
+
+// Karte mit races Rennen leeren, jedes Löschen kostet BENCH_SD_COMMIT_US.
+// mkfs = 1: formatSD() inkl. der Schreibtests davor und danach (Host: mkfs
+// leert das Verzeichnis, ein Commit; das Schreiben der FAT auf der Karte
+// ist nicht nachgebildet). format_ms: bis /races und Katalog stehen
+static void BM_FormatSD(benchmark::State& state) {
+    bool mkfs = state.range(0) != 0;
+    DataLogger logger;
+    for (auto _ : state) {
+        state.PauseTiming();
+        writeRaceCard(logger, state.range(1));
+        SD.setHostCommitDelayUs(BENCH_SD_COMMIT_US);
+        state.ResumeTiming();
+
+        auto start = std::chrono::steady_clock::now();
+        if (mkfs) {
+            logger.formatSD();
+        } else {
+            deleteFilesRecursive("/");
+            SD.mkdir("/races");
+            logger.getRaceCatalog().rebuild();
+        }
+        state.counters["format_ms"] = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        SD.setHostCommitDelayUs(0);
+    }
+}
+BENCHMARK(BM_FormatSD)->ArgNames({"mkfs", "races"})->ArgsProduct({{0, 1}, {200}})
+    ->Iterations(1)->Unit(benchmark::kMillisecond);
+
+// ============================================================
+// Main
+// ============================================================
+
+int main(int argc, char** argv) {
+    Serial.setHostOutput(nullptr);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
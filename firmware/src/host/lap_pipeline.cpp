@@ -0,0 +1,473 @@
+/**
+ * MoRa-LC Host-Simulation: Lap-Pipeline
+ *
+ * Läuft als Linux-Programm (env:native) und fährt die komplette Kette
+ * BLE-Advertisement -> BLEScanner -> Hysterese -> LapCounter -> DataLogger
+ * mit den echten Libraries aus lib/. Zeit läuft über eine virtuelle Uhr,
+ * die SD-Karte ist ein Host-Verzeichnis.
+ *
+ * Aufruf:
+ *   lap_pipeline [--teams N] [--laps N] [--lap-ms MS] [--sd DIR] [--quiet]
+ *                [--inline] [--ui-load MS] [--sd-delay-us US] [--sd-profile NAME]
+ *                [--sd-fault fail|remove] [--sd-fault-at S] [--sd-fault-ms MS]
+ *
+ * --inline         LapPipeline ohne Tasks (Verarbeitung im BLE-Callback)
+ * --ui-load MS     UI-Thread zeichnet alle 500 ms den Race-Screen (MS lang)
+ * --sd-delay-us US Kosten pro geschlossener SD-Datei (Commit auf die Karte)
+ * --sd-profile     Zeitverhalten der Karte: ideal, class10, slow, spiky
+ *                  (siehe hostCardProfile(), --sd-delay-us ersetzt den Commit)
+ * --sd-fault       Ab Rennsekunde --sd-fault-at (Standard 25) für --sd-fault-ms
+ *                  (Standard 10000): fail = jeder Schreibzugriff schlägt fehl,
+ *                  remove = Karte gezogen, danach gesteckt und neu gemountet
+ *
+ * Am Ende wird gegengeprüft, was auf der Karte steht: Runden-Log, CSV-Export,
+ * Zusammenfassung, Download, Katalog und RSSI-Telemetrie (jedes eingespeiste
+ * Advertisement muss dekodiert wieder herauskommen). Mit --sd-fault muss
+ * jedes Sample entweder im Log stehen oder als verloren gezählt sein.
+ */
+
+#include <Arduino.h>
+#include <SD.h>
+#include <HostBLE.h>
+#include <HostClock.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "BLEScanner.h"
+#include "CsvReader.h"
+#include "LapCounter.h"
+#include "DataLogger.h"
+#include "Diagnostics.h"
+#include "LapPipeline.h"
+#include "RaceCatalog.h"
+#include "RaceResults.h"
+#include "RssiLog.h"
+#include <algorithm>
+
+// Werte wie in src/ultralight_v2/config.h
+#define BLE_RSSI_THRESHOLD -100
+#define BEACON_TIMEOUT    3000
+#define BLE_UUID_PREFIX "c3:00:"
+#define DEFAULT_LAP_RSSI_NEAR -65
+#define DEFAULT_LAP_RSSI_FAR  -80
+#define SD_CS_PIN 5
+
+// Simulation
+#define SIM_TICK_MS       100    // Ein Advertisement pro Team und Tick
+#define SIM_NEAR_MS       1500   // So lange ist ein Beacon an der Ziellinie
+#define SIM_RSSI_NEAR     -55
+#define SIM_RSSI_FAR      -90
+#define SIM_RSSI_MAX_BYTES_PER_SAMPLE 2.0   // Telemetrie-Datei pro Sample, RssiLog.h
+
+struct SimOptions {
+    uint8_t teams = 8;
+    uint16_t laps = 10;
+    uint32_t lapMs = 30000;
+    String sdRoot = "sdcard";
+    bool quiet = false;
+    bool inlineMode = false;
+    uint32_t uiLoadMs = 0;
+    uint32_t sdDelayUs = 0;
+    String sdProfile = "ideal";
+    String sdFault;
+    uint32_t sdFaultAtMs = 25000;
+    uint32_t sdFaultMs = 10000;
+};
+
+BLEScanner bleScanner;
+LapCounter lapCounter;
+DataLogger dataLogger;
+LapPipeline lapPipeline(lapCounter, dataLogger);
+
+std::atomic<bool> raceRunning(false);
+uint32_t advertCount = 0;
+std::vector<RssiSample> injected;       // Gegenprobe für die Telemetrie
+
+// Wie onBeaconDetected() in src/ultralight_v2/main.cpp
+void onBeaconDetected(const BeaconData& beacon) {
+    if (!raceRunning) {
+        return;
+    }
+    lapPipeline.ingest(beacon);
+}
+
+// Race-Screen: Snapshot unter Lock holen, dann ohne Lock "zeichnen"
+static void uiThread(uint32_t loadMs) {
+    std::vector<TeamStanding> standings;
+    while (raceRunning) {
+        lapPipeline.getStandings(standings);
+        auto drawEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds(loadMs);
+        while (std::chrono::steady_clock::now() < drawEnd) {
+            // Busy wie fillScreen() + Text
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(500 - min(loadMs, 500U)));
+    }
+}
+
+// ============================================================
+// Hilfsfunktionen
+// ============================================================
+
+static bool parseArgs(int argc, char** argv, SimOptions& opts) {
+    for (int i = 1; i < argc; i++) {
+        String arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--teams" && hasValue) {
+            opts.teams = constrain(atoi(argv[++i]), 1, 250);
+        } else if (arg == "--laps" && hasValue) {
+            opts.laps = constrain(atoi(argv[++i]), 1, 10000);
+        } else if (arg == "--lap-ms" && hasValue) {
+            opts.lapMs = max(atoi(argv[++i]), 6000);
+        } else if (arg == "--sd" && hasValue) {
+            opts.sdRoot = argv[++i];
+        } else if (arg == "--quiet") {
+            opts.quiet = true;
+        } else if (arg == "--inline") {
+            opts.inlineMode = true;
+        } else if (arg == "--ui-load" && hasValue) {
+            opts.uiLoadMs = constrain(atoi(argv[++i]), 0, 500);
+        } else if (arg == "--sd-delay-us" && hasValue) {
+            opts.sdDelayUs = max(atoi(argv[++i]), 0);
+        } else if (arg == "--sd-profile" && hasValue) {
+            opts.sdProfile = argv[++i];
+        } else if (arg == "--sd-fault" && hasValue && (String(argv[i + 1]) == "fail" ||
+                                                       String(argv[i + 1]) == "remove")) {
+            opts.sdFault = argv[++i];
+        } else if (arg == "--sd-fault-at" && hasValue) {
+            opts.sdFaultAtMs = max(atoi(argv[++i]), 0) * 1000;
+        } else if (arg == "--sd-fault-ms" && hasValue) {
+            opts.sdFaultMs = max(atoi(argv[++i]), 1);
+        } else {
+            printf("Usage: %s [--teams N] [--laps N] [--lap-ms MS] [--sd DIR] [--quiet]"
+                   " [--inline] [--ui-load MS] [--sd-delay-us US] [--sd-profile NAME]"
+                   " [--sd-fault fail|remove] [--sd-fault-at S] [--sd-fault-ms MS]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static String teamMac(int index) {
+    char mac[18];
+    snprintf(mac, sizeof(mac), "c3:00:00:00:%02x:%02x", (index >> 8) & 0xFF, index & 0xFF);
+    return String(mac);
+}
+
+// Rundenzeit pro Team leicht unterschiedlich (+/- 10%)
+static uint32_t teamLapMs(const SimOptions& opts, uint8_t index) {
+    return opts.lapMs + (opts.lapMs / 10) * (index % 5) / 2 - opts.lapMs / 10;
+}
+
+// ============================================================
+// Main
+// ============================================================
+
+int main(int argc, char** argv) {
+    SimOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        return 1;
+    }
+
+    HostClock::setManual(true);
+    HostClock::setMicros(0);
+    randomSeed(42);
+    if (opts.quiet) {
+        Serial.setHostOutput(nullptr);
+    }
+
+    HostCardProfile profile;
+    if (!hostCardProfile(opts.sdProfile.c_str(), profile)) {
+        printf("Unknown SD profile '%s' (ideal, class10, slow, spiky)\n", opts.sdProfile.c_str());
+        return 1;
+    }
+    SD.setHostRoot(opts.sdRoot.c_str());
+    SD.setHostProfile(profile);
+    if (opts.sdDelayUs > 0) {
+        SD.setHostCommitDelayUs(opts.sdDelayUs);
+    }
+    if (!dataLogger.begin(SD_CS_PIN)) {
+        printf("SD root '%s' not usable\n", opts.sdRoot.c_str());
+        return 1;
+    }
+
+    bleScanner.begin();
+    bleScanner.setRSSIThreshold(BLE_RSSI_THRESHOLD);
+    bleScanner.setUUIDFilter(BLE_UUID_PREFIX);
+    bleScanner.onBeaconDetected(onBeaconDetected);
+
+    for (uint8_t i = 0; i < opts.teams; i++) {
+        lapCounter.addTeam(i + 1, "Team " + String(i + 1), teamMac(i));
+    }
+
+    lapPipeline.setRssiThresholds(DEFAULT_LAP_RSSI_NEAR, DEFAULT_LAP_RSSI_FAR);
+    if (!opts.inlineMode) {
+        lapPipeline.begin();
+    }
+
+    // Alle Teams überqueren die Linie beim Start, danach alle teamLapMs()
+    // Zielzeit: Start + laps Runden + eine Runde Reserve
+    uint32_t longestLap = 0;
+    for (uint8_t i = 0; i < opts.teams; i++) {
+        longestLap = max(longestLap, teamLapMs(opts, i));
+    }
+    uint32_t raceMs = (uint32_t)(opts.laps + 1) * longestLap;
+
+    lapPipeline.logRaceStart("Host Sim", raceMs);
+    lapPipeline.resetRace();
+    lapPipeline.waitIdle(1000);
+    String raceFile = dataLogger.getCurrentRaceFile();
+    lapPipeline.resetStats();
+    diagnostics.reset();
+    SD.resetHostStats();
+    bleScanner.startScan(0);
+    raceRunning = true;
+
+    std::thread ui;
+    if (opts.uiLoadMs > 0) {
+        ui = std::thread(uiThread, opts.uiLoadMs);
+    }
+
+    uint32_t raceEnd = millis() + raceMs;
+
+    auto wallStart = std::chrono::steady_clock::now();
+    uint32_t lastBeaconCleanup = millis();
+    uint32_t raceStart = millis();
+    bool faultActive = false;
+    bool faultDone = opts.sdFault.isEmpty();
+
+    while (millis() < raceEnd) {
+        uint32_t elapsed = millis() - raceStart;
+
+        // Kartenfehler mitten im Rennen, Lap-Task und Logger laufen weiter
+        if (!faultDone && !faultActive && elapsed >= opts.sdFaultAtMs) {
+            lapPipeline.waitIdle(1000);
+            if (opts.sdFault == "remove") {
+                SD.hostRemoveCard();
+            } else {
+                SD.hostFailWritesAfter(0);
+            }
+            faultActive = true;
+        } else if (faultActive && elapsed >= opts.sdFaultAtMs + opts.sdFaultMs) {
+            lapPipeline.waitIdle(1000);
+            if (opts.sdFault == "remove") {
+                // Wie ein Card-Detect-Handler: neu mounten, Rennen läuft weiter
+                SD.hostInsertCard();
+                SD.end();
+                dataLogger.begin(SD_CS_PIN);
+            } else {
+                SD.hostClearFaults();
+            }
+            faultActive = false;
+            faultDone = true;
+        }
+
+        for (uint8_t i = 0; i < opts.teams; i++) {
+            uint32_t phase = elapsed % teamLapMs(opts, i);
+            bool finished;
+            {
+                RtosLock lock(lapPipeline.stateMutex());
+                finished = lapCounter.getTeam(i + 1)->laps.size() >= opts.laps;
+            }
+            int rssi = (!finished && phase < SIM_NEAR_MS) ? SIM_RSSI_NEAR : SIM_RSSI_FAR;
+            rssi += random(-3, 4);
+            HostBLE::injectAdvert(teamMac(i).c_str(), rssi);
+            injected.push_back({millis(), (uint8_t)(i + 1), (int8_t)rssi});
+            advertCount++;
+        }
+        // Virtuelle Uhr erst weiterschalten wenn der Lap-Task fertig ist
+        lapPipeline.waitIdle(1000);
+
+        lapPipeline.poll();
+
+        if (millis() - lastBeaconCleanup > 1000) {
+            bleScanner.clearOldBeacons(BEACON_TIMEOUT);
+            lastBeaconCleanup = millis();
+        }
+
+        delay(SIM_TICK_MS);
+    }
+
+    raceRunning = false;
+    if (ui.joinable()) {
+        ui.join();
+    }
+    bleScanner.stopScan();
+    lapPipeline.logRaceFinish();
+
+    double wallMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - wallStart).count();
+
+    // Ergebnis (immer auf stdout, auch mit --quiet)
+    printf("\n=== Leaderboard (%u teams, %u laps target) ===\n", opts.teams, opts.laps);
+    std::vector<TeamData*> board = lapCounter.getLeaderboard();
+    for (size_t i = 0; i < board.size(); i++) {
+        TeamData* team = board[i];
+        uint32_t best = team->laps.empty() ? 0 : team->bestLapDuration;
+        printf("%2u. %-10s laps=%3u best=%6.3fs total=%8.3fs\n",
+               (unsigned)(i + 1), team->teamName.c_str(), (unsigned)team->laps.size(),
+               best / 1000.0, team->totalDuration / 1000.0);
+    }
+    printf("\nsimulated: %.1f s, wall: %.1f ms, adverts: %u (%.0f/s), lap events: %u\n",
+           (millis() - raceStart) / 1000.0, wallMs, advertCount,
+           wallMs > 0 ? advertCount * 1000.0 / wallMs : 0.0, lapPipeline.getLapEvents());
+    printf("mode: %s, max advert->lap: %u us, max BLE callback: %u us, dropped: %u\n",
+           lapPipeline.isThreaded() ? "tasks" : "inline",
+           lapPipeline.getMaxLatencyUs(), lapPipeline.getMaxIngestUs(),
+           lapPipeline.getDroppedEvents());
+
+    const LogStats& log = dataLogger.getLogStats();
+    printf("log: %u laps in %u writes (%u on full buffer), %u bytes, max pending %u bytes,"
+           " errors %u, dropped %u, preallocated %u bytes\n",
+           log.records, log.flushes, log.fullFlushes, log.bytesWritten, log.maxPendingBytes,
+           log.writeErrors, log.droppedRecords, log.preallocBytes);
+    HostCardStats card = SD.hostStats();
+    printf("sd card: %s%s%s, %llu writes (%u failed), %u commits, %u clusters, %u spikes,"
+           " waited %.1f ms (max %.1f ms)\n",
+           opts.sdProfile.c_str(), opts.sdFault.isEmpty() ? "" : ", fault ", opts.sdFault.c_str(),
+           (unsigned long long)card.writes, card.failedWrites, card.commits, card.clusters,
+           card.spikes, card.waitUs / 1000.0, card.maxWaitUs / 1000.0);
+
+    // Gegenprobe: Runden-Log von der "Karte" streamen wie der Ergebnis-Screen,
+    // als CSV exportieren und beides mit der Zusammenfassung vergleichen,
+    // die finishRace() geschrieben hat
+    lapPipeline.waitIdle(1000);
+    RaceResults results;
+    File lapLog = dataLogger.openFile(raceFile);
+    auto parseStart = std::chrono::steady_clock::now();
+    bool parsed = lapLog && results.parseLapLog(lapLog);
+    double parseMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - parseStart).count();
+    size_t logBytes = lapLog ? lapLog.size() : 0;
+    lapLog.close();
+    printf("lap log: %s, %u bytes, %u teams, %u laps, parsed in %.2f ms%s\n",
+           raceFile.c_str(), (unsigned)logBytes, results.getTeamCount(), results.getLapCount(),
+           parseMs, parsed ? "" : " (FAILED)");
+
+    String csvFile = raceFile.substring(0, raceFile.length() - 4) + ".csv";
+    RaceResults exported;
+    bool csvOk = dataLogger.exportRaceCSV(raceFile, csvFile);
+    File csv = dataLogger.openFile(csvFile);
+    csvOk = csvOk && csv && exported.parseFile(csv);
+    size_t csvBytes = csv ? csv.size() : 0;
+    csv.close();
+
+    RaceResults summary;
+    auto loadStart = std::chrono::steady_clock::now();
+    bool loaded = dataLogger.loadRaceResults(raceFile, summary);
+    double loadMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - loadStart).count();
+
+    auto sameBoard = [](const RaceResults& x, const RaceResults& y) {
+        std::vector<const RaceTeamStats*> a = x.getLeaderboard();
+        std::vector<const RaceTeamStats*> b = y.getLeaderboard();
+        bool same = a.size() == b.size() && x.getLapCount() == y.getLapCount();
+        for (size_t i = 0; same && i < a.size(); i++) {
+            same = a[i]->teamId == b[i]->teamId && a[i]->teamName == b[i]->teamName &&
+                   a[i]->lapCount == b[i]->lapCount && a[i]->bestLapDuration == b[i]->bestLapDuration &&
+                   a[i]->totalDuration == b[i]->totalDuration;
+        }
+        return same;
+    };
+    printf("csv export: %s, %u bytes (%.1fx the log), %s\n",
+           csvFile.c_str(), (unsigned)csvBytes, logBytes > 0 ? (double)csvBytes / logBytes : 0.0,
+           csvOk && sameBoard(results, exported) ? "matches log" : "MISMATCH");
+    bool matches = loaded && sameBoard(results, summary) &&
+                   summary.getSourceChecksum() == results.getSourceChecksum();
+    printf("summary: %s, loaded in %.2f ms, %s\n",
+           summary.isFromSummary() ? "from .sum" : "rebuilt", loadMs,
+           matches ? "matches log" : "MISMATCH");
+
+    // Download mit Abbruch und Fortsetzen: erste Hälfte, dann ab dem Offset
+    // weiter (wie HTTP Range), beides zusammen muss die ganze Datei ergeben
+    uint8_t block[LOG_SECTOR_BYTES];
+    uint32_t streamCrc = 0;
+    uint32_t blocks = 0;
+    auto checksumBlock = [&](const uint8_t* data, size_t length, uint32_t) {
+        streamCrc = crc32Update(streamCrc, data, length);
+        blocks++;
+        return true;
+    };
+    uint32_t fileSize = dataLogger.getFileSize(raceFile);
+    uint32_t firstPart = 0;
+    uint32_t secondPart = 0;
+    bool streamOk = dataLogger.streamFile(raceFile, block, sizeof(block), checksumBlock,
+                                          0, fileSize / 2, &firstPart) &&
+                    dataLogger.streamFile(raceFile, block, sizeof(block), checksumBlock,
+                                          firstPart, FILE_STREAM_TO_END, &secondPart);
+    printf("stream: %u + %u bytes in %u blocks of %u, %s\n",
+           firstPart, secondPart, blocks, (unsigned)sizeof(block),
+           streamOk && firstPart + secondPart == logBytes && streamCrc == results.getSourceChecksum()
+               ? "matches log" : "MISMATCH");
+
+    // Telemetrie blockweise dekodieren, muss genau die eingespeisten
+    // Advertisements enthalten (Reihenfolge zwischen Teams egal), abzüglich
+    // der als verloren gezählten, und im Platzbudget bleiben
+    std::vector<RssiSample> decoded;
+    std::vector<uint8_t> rssiBlock(RSSI_LOG_BLOCK_BYTES);
+    uint32_t rssiBlocks = 0;
+    uint32_t badBlocks = 0;
+    size_t rssiBytes = 0;
+    size_t read;
+    File rssiLog = dataLogger.openFile(DataLogger::rssiPath(raceFile));
+    while (rssiLog && (read = rssiLog.read(rssiBlock.data(), rssiBlock.size())) > 0) {
+        // Letzter Block nur so lang wie sein Inhalt
+        memset(rssiBlock.data() + read, 0, rssiBlock.size() - read);
+        rssiBytes += read;
+        rssiBlocks++;
+        if (!rssiLogDecodeBlock(rssiBlock.data(), decoded)) {
+            badBlocks++;
+        }
+    }
+    rssiLog.close();
+    auto bySample = [](const RssiSample& a, const RssiSample& b) {
+        return a.timestamp != b.timestamp ? a.timestamp < b.timestamp :
+               a.teamId != b.teamId ? a.teamId < b.teamId : a.rssi < b.rssi;
+    };
+    std::sort(decoded.begin(), decoded.end(), bySample);
+    std::sort(injected.begin(), injected.end(), bySample);
+    size_t csvBytesRssi = 0;
+    bool sameSamples = decoded.size() + log.rssiDropped == injected.size() && badBlocks == 0 &&
+                       std::includes(injected.begin(), injected.end(), decoded.begin(), decoded.end(), bySample);
+    for (size_t i = 0; i < decoded.size(); i++) {
+        char line[32];
+        csvBytesRssi += snprintf(line, sizeof(line), "%u,%lu,%d\n", decoded[i].teamId,
+                                 (unsigned long)decoded[i].timestamp, decoded[i].rssi);
+    }
+    double perSample = decoded.empty() ? 0.0 : (double)rssiBytes / decoded.size();
+    printf("rssi: %u samples in %u blocks, %.2f bytes/sample (budget %.1f, csv %.1f), dropped %u, %s\n",
+           (unsigned)decoded.size(), rssiBlocks, perSample, SIM_RSSI_MAX_BYTES_PER_SAMPLE,
+           decoded.empty() ? 0.0 : (double)csvBytesRssi / decoded.size(), log.rssiDropped,
+           !sameSamples ? "MISMATCH" : perSample < SIM_RSSI_MAX_BYTES_PER_SAMPLE ? "matches log" : "OVER BUDGET");
+
+    // Rennliste aus dem Katalog, dann Kartenwechsel nachstellen: Katalog
+    // löschen, neu mounten, begin() baut ihn aus /races wieder auf
+    // (Logger-Task läuft noch und räumt ggf. auf: Katalog nur unter dem Lock)
+    {
+        RtosLock storeLock(dataLogger.getStoreMutex());
+        RaceCatalog& catalog = dataLogger.getRaceCatalog();
+        std::vector<RaceCatalogEntry> newest;
+        catalog.getPage(0, 1, newest);
+        bool listed = newest.size() == 1 && RaceCatalog::racePath(newest[0]) == raceFile &&
+                      newest[0].state == RACE_FINISHED && newest[0].lapCount == results.getLapCount() &&
+                      newest[0].logBytes == logBytes;
+        uint32_t races = catalog.getRaceCount();
+        SD.remove(RACE_CATALOG_PATH);
+        auto rebuildStart = std::chrono::steady_clock::now();
+        dataLogger.begin(SD_CS_PIN);
+        double rebuildMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - rebuildStart).count();
+        RaceCatalogEntry rebuilt;
+        bool found = catalog.find(raceFile, rebuilt) && rebuilt.lapCount == results.getLapCount() &&
+                     catalog.getRaceCount() == races;
+        printf("catalog: %u races, newest %s, rebuilt in %.2f ms, %s\n",
+               races, listed ? "matches log" : "MISMATCH", rebuildMs, found ? "matches log" : "MISMATCH");
+    }
+
+    // Diagnose-Report wie über Serial auf dem Gerät
+    Serial.setHostOutput(stdout);
+    diagnostics.printReport();
+
+    lapPipeline.end();
+
+    return 0;
+}
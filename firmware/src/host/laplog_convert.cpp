@@ -0,0 +1,247 @@
+/**
+ * MoRa-LC Host-Tool: Runden-Log (.lap) und RSSI-Telemetrie (.rssi) nach CSV/JSON
+ *
+ * Liest ein binäres Runden-Log von der SD-Karte des Displays (Format siehe
+ * lib/RaceResults/LapLog.h) und schreibt es als CSV im Format der früheren
+ * Race-CSV oder als JSON. Datensätze mit falscher CRC-8 werden übersprungen
+ * und auf stderr gemeldet, ein angefangener Datensatz am Ende ebenfalls.
+ * Null-Datensätze (Vorbelegung eines nicht beendeten Rennens) zählen nicht.
+ *
+ * Eine .rssi-Datei (erkannt am Magic, Format siehe lib/RaceResults/RssiLog.h)
+ * wird Block für Block dekodiert und nach Zeit sortiert ausgegeben
+ * (Team ID, Timestamp, RSSI); kaputte Blöcke werden gemeldet und übersprungen.
+ *
+ * Aufruf:
+ *   laplog_convert FILE.lap|FILE.rssi [--csv | --json] [--out FILE]
+ *
+ * --csv            CSV (Standard), Namen mit Komma werden gequotet
+ * --json           {"race", "startTime", "teams": [...], "laps": [...]}
+ *                  bzw. {"samples": [...]} für .rssi
+ * --out FILE       Ausgabedatei statt stdout
+ *
+ * Exit-Code: 0 ok, 1 Aufruf/Datei, 2 Header ungültig, 3 kaputte Datensätze
+ */
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "LapLog.h"
+#include "RssiLog.h"
+
+struct Options {
+    const char* input = nullptr;
+    const char* output = nullptr;
+    bool json = false;
+};
+
+static bool parseArgs(int argc, char** argv, Options& opts) {
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--csv")) {
+            opts.json = false;
+        } else if (!strcmp(argv[i], "--json")) {
+            opts.json = true;
+        } else if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+            opts.output = argv[++i];
+        } else if (argv[i][0] != '-' && !opts.input) {
+            opts.input = argv[i];
+        } else {
+            return false;
+        }
+    }
+    return opts.input != nullptr;
+}
+
+static void printJsonString(FILE* out, const char* text) {
+    fputc('"', out);
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(out, "\\%c", *c);
+        } else if ((uint8_t)*c < 0x20) {
+            fprintf(out, "\\u%04x", (uint8_t)*c);
+        } else {
+            fputc(*c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+// Name aus der Tabelle, auch wenn ein fremdes Tool ihn nicht terminiert hat
+static void teamName(const LapLogTeam& team, char* name) {
+    memcpy(name, team.name, LAP_LOG_TEAM_NAME_LEN);
+    name[LAP_LOG_TEAM_NAME_LEN - 1] = '\0';
+}
+
+// Telemetrie: alle Blöcke dekodieren, nach Zeit sortiert ausgeben
+static int convertRssi(FILE* in, const Options& opts) {
+    std::vector<RssiSample> samples;
+    std::vector<uint8_t> block(RSSI_LOG_BLOCK_BYTES);
+    uint32_t index = 0;
+    uint32_t bad = 0;
+    uint32_t empty = 0;
+    size_t read;
+    while ((read = fread(block.data(), 1, block.size(), in)) > 0) {
+        // Letzter Block nur so lang wie sein Inhalt
+        memset(block.data() + read, 0, block.size() - read);
+        index++;
+        if (rssiLogIsEmpty(block.data())) {
+            empty++;
+        } else if (!rssiLogDecodeBlock(block.data(), samples)) {
+            fprintf(stderr, "%s: block %u: invalid frame, skipped\n", opts.input, index);
+            bad++;
+        }
+    }
+    fclose(in);
+
+    // Innerhalb eines Blocks stehen die Samples nach Team gruppiert
+    std::stable_sort(samples.begin(), samples.end(), [](const RssiSample& a, const RssiSample& b) {
+        return a.timestamp < b.timestamp;
+    });
+
+    FILE* out = opts.output ? fopen(opts.output, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "%s: cannot create\n", opts.output);
+        return 1;
+    }
+    if (opts.json) {
+        fprintf(out, "{\n  \"samples\": [");
+    } else {
+        fputs("Team ID,Timestamp (ms),RSSI (dBm)\n", out);
+    }
+    for (size_t i = 0; i < samples.size(); i++) {
+        const RssiSample& sample = samples[i];
+        if (opts.json) {
+            fprintf(out, "%s\n    {\"team\": %u, \"timestamp\": %lu, \"rssi\": %d}",
+                    i ? "," : "", sample.teamId, (unsigned long)sample.timestamp, sample.rssi);
+        } else {
+            fprintf(out, "%u,%lu,%d\n", sample.teamId, (unsigned long)sample.timestamp, sample.rssi);
+        }
+    }
+    if (opts.json) {
+        fprintf(out, "\n  ],\n  \"badBlocks\": %u\n}\n", bad);
+    }
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    fprintf(stderr, "%s: %u samples in %u blocks (%.2f bytes/sample), %u bad, %u empty\n",
+            opts.input, (unsigned)samples.size(), index,
+            samples.empty() ? 0.0 : (double)index * RSSI_LOG_BLOCK_BYTES / samples.size(), bad, empty);
+    return bad > 0 ? 3 : 0;
+}
+
+int main(int argc, char** argv) {
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        fprintf(stderr, "usage: %s FILE.lap|FILE.rssi [--csv | --json] [--out FILE]\n", argv[0]);
+        return 1;
+    }
+
+    FILE* in = fopen(opts.input, "rb");
+    if (!in) {
+        fprintf(stderr, "%s: cannot open\n", opts.input);
+        return 1;
+    }
+
+    // Telemetrie am Magic des ersten Blocks erkennen
+    uint32_t magic = 0;
+    if (fread(&magic, sizeof(magic), 1, in) == 1 && magic == RSSI_LOG_MAGIC) {
+        rewind(in);
+        return convertRssi(in, opts);
+    }
+    rewind(in);
+
+    // Header und Teamtabelle
+    LapLogHeader header;
+    if (fread(&header, sizeof(header), 1, in) != 1 || !lapLogCheckHeader(header)) {
+        fprintf(stderr, "%s: not a lap log (version %u expected)\n", opts.input, LAP_LOG_VERSION);
+        fclose(in);
+        return 2;
+    }
+    std::vector<LapLogTeam> teams(header.teamCount);
+    if (fread(teams.data(), sizeof(LapLogTeam), teams.size(), in) != teams.size() ||
+        lapLogHeaderChecksum(header, teams.data()) != header.checksum) {
+        fprintf(stderr, "%s: header checksum mismatch\n", opts.input);
+        fclose(in);
+        return 2;
+    }
+    header.raceName[LAP_LOG_RACE_NAME_LEN - 1] = '\0';
+
+    FILE* out = opts.output ? fopen(opts.output, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "%s: cannot create\n", opts.output);
+        fclose(in);
+        return 1;
+    }
+
+    char name[LAP_LOG_TEAM_NAME_LEN];
+    if (opts.json) {
+        fprintf(out, "{\n  \"race\": ");
+        printJsonString(out, header.raceName);
+        fprintf(out, ",\n  \"startTime\": %llu,\n  \"teams\": [", (unsigned long long)header.startTime);
+        for (size_t i = 0; i < teams.size(); i++) {
+            teamName(teams[i], name);
+            fprintf(out, "%s\n    {\"id\": %u, \"name\": ", i ? "," : "", teams[i].teamId);
+            printJsonString(out, name);
+            fputc('}', out);
+        }
+        fprintf(out, "\n  ],\n  \"laps\": [");
+    } else {
+        fputs(LAP_LOG_CSV_HEADER, out);
+    }
+
+    // Datensätze
+    LapLogRecord record;
+    uint32_t index = 0;
+    uint32_t laps = 0;
+    uint32_t bad = 0;
+    uint32_t empty = 0;
+    size_t read;
+    while ((read = fread(&record, 1, sizeof(record), in)) == sizeof(record)) {
+        index++;
+        if (lapLogIsEmpty(record)) {
+            empty++;
+            continue;
+        }
+        if (!lapLogCheckRecord(record)) {
+            fprintf(stderr, "%s: record %u: CRC mismatch, skipped\n", opts.input, index);
+            bad++;
+            continue;
+        }
+
+        bool listed = !(record.flags & LAP_FLAG_UNLISTED) && record.teamIndex < teams.size();
+        uint8_t teamId = listed ? teams[record.teamIndex].teamId : record.teamIndex;
+        if (listed) {
+            teamName(teams[record.teamIndex], name);
+        } else {
+            name[0] = '\0';
+        }
+
+        if (opts.json) {
+            fprintf(out, "%s\n    {\"team\": %u, \"lap\": %u, \"timestamp\": %llu, \"duration\": %u, \"flags\": %u}",
+                    laps ? "," : "", teamId, record.lapNumber,
+                    (unsigned long long)record.timestamp, record.duration, record.flags);
+        } else {
+            char line[LAP_LOG_CSV_LINE_MAX];
+            size_t length = lapLogFormatCsv(line, sizeof(line), record, teamId, name, header.startTime);
+            fwrite(line, 1, length, out);
+        }
+        laps++;
+    }
+    if (read > 0) {
+        fprintf(stderr, "%s: %u trailing bytes (incomplete record) ignored\n", opts.input, (unsigned)read);
+    }
+
+    if (opts.json) {
+        fprintf(out, "\n  ],\n  \"badRecords\": %u\n}\n", bad);
+    }
+    if (out != stdout) {
+        fclose(out);
+    }
+    fclose(in);
+
+    fprintf(stderr, "%s: %u teams, %u laps, %u bad records, %u empty (preallocated)\n",
+            opts.input, (unsigned)teams.size(), laps, bad, empty);
+    return bad > 0 ? 3 : 0;
+}
@@ -0,0 +1,339 @@
+/**
+ * MoRa-LC Host-Tool: UI-Rendering (UltraLight v2)
+ *
+ * Läuft als Linux-Programm (env:native_ui) und zeichnet jeden Screen der
+ * v2-UI mit den echten ui_screens.cpp/ui_helper.cpp/DisplayManager in den
+ * Framebuffer von host/LovyanGFXShim. Pro Screen wird einmal komplett
+ * (Screen betreten) und einmal inkrementell (6 s später, eine Runde
+ * mehr) gezeichnet; gemessen werden Zeichenzeit, Adressfenster,
+ * SPI-Bytes und die daraus folgende Buszeit. Danach wird auf den Listen
+ * gewischt (Ziehen mit 10-ms-Abtastung, Loslassen, Ausrollen) und die
+ * Kosten pro Frame gemessen.
+ *
+ * Aufruf:
+ *   ui_render [--out DIR] [--sd DIR] [--golden DIR] [--update-golden] [--teams N]
+ *             [--quiet]
+ *
+ * --out DIR         PPM-Bilder pro Screen (Standard: ui_frames)
+ * --sd DIR          Emulierte SD-Karte (Standard: .pio/ui_sdcard), nicht unter --out
+ * --golden DIR      Vergleich mit Referenzbildern, Exit-Code 1 bei Abweichung
+ * --update-golden   Referenzbilder in --golden DIR neu schreiben
+ */
+
+#include <Arduino.h>
+#include <SD.h>
+#include <HostBLE.h>
+#include <HostClock.h>
+#include <HostDisplay.h>
+#include <chrono>
+#include <sys/stat.h>
+#include "../ultralight_v2/config.h"
+#include "../ultralight_v2/display_manager.h"
+#include "../ultralight_v2/ui_state.h"
+#include "../ultralight_v2/ui_screens.h"
+#include "../../lib/BLEScanner/BLEScanner.h"
+#include "../../lib/LapCounter/LapCounter.h"
+#include "../../lib/DataLogger/DataLogger.h"
+#include "../../lib/LapPipeline/LapPipeline.h"
+#include "../ultralight/persistence.h"
+
+#define REFRESH_STEP_MS 6000   // LapCounter verwirft Runden unter 5 s
+
+struct RenderOptions {
+    String outDir = "ui_frames";
+    String sdRoot = ".pio/ui_sdcard";
+    String goldenDir = "";
+    bool updateGolden = false;
+    uint8_t teams = 6;
+    bool quiet = false;
+};
+
+// Globale Instanzen wie in src/ultralight_v2/main.cpp
+DisplayManager display;
+BLEScanner bleScanner;
+LapCounter lapCounter;
+DataLogger dataLogger;
+PersistenceManager persistence;
+LapPipeline lapPipeline(lapCounter, dataLogger);
+
+bool raceRunning = false;
+uint32_t raceStartTime = 0;
+uint32_t raceDuration = 60000;
+String currentRaceName = "Host Render";
+int8_t lapRssiNear = DEFAULT_LAP_RSSI_NEAR;
+int8_t lapRssiFar = DEFAULT_LAP_RSSI_FAR;
+
+// Wie in main.cpp, nur ohne Touch-Task zum Anhalten
+void recalibrateTouch() {
+    if (display.calibrateTouch()) {
+        persistence.saveTouchCalibration(display.getTouchCalibration());
+    }
+}
+
+static const char* const screenNames[] = {
+    "home", "teams", "team_edit", "beacon_assign", "beacon_list", "race_setup",
+    "race_running", "race_paused", "race_results", "settings", "diagnostics"
+};
+static const uint8_t screenCount = sizeof(screenNames) / sizeof(screenNames[0]);
+
+struct DrawCost {
+    double ms;
+    HostDisplay::SpiStats spi;
+};
+
+struct ScrollCost {
+    uint32_t frames;
+    double maxMs;
+    double busMs;           // Summe
+    double maxBusMs;
+    int32_t offset;         // Offset am Ende
+};
+
+// ============================================================
+// Hilfsfunktionen
+// ============================================================
+
+static bool parseArgs(int argc, char** argv, RenderOptions& opts) {
+    for (int i = 1; i < argc; i++) {
+        String arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--out" && hasValue) {
+            opts.outDir = argv[++i];
+        } else if (arg == "--sd" && hasValue) {
+            opts.sdRoot = argv[++i];
+        } else if (arg == "--golden" && hasValue) {
+            opts.goldenDir = argv[++i];
+        } else if (arg == "--update-golden") {
+            opts.updateGolden = true;
+        } else if (arg == "--teams" && hasValue) {
+            opts.teams = constrain(atoi(argv[++i]), 0, MAX_TEAMS);
+        } else if (arg == "--quiet") {
+            opts.quiet = true;
+        } else {
+            printf("Usage: %s [--out DIR] [--sd DIR] [--golden DIR] [--update-golden] [--teams N] [--quiet]\n",
+                   argv[0]);
+            return false;
+        }
+    }
+    if (opts.updateGolden && opts.goldenDir.length() == 0) {
+        printf("--update-golden needs --golden DIR\n");
+        return false;
+    }
+    return true;
+}
+
+// Verzeichnis samt fehlender Eltern anlegen (SD legt nur die letzte Ebene an)
+static void makeDirs(const String& path) {
+    for (int slash = path.indexOf('/', 1); slash > 0; slash = path.indexOf('/', slash + 1)) {
+        mkdir(path.substring(0, slash).c_str(), 0755);
+    }
+    mkdir(path.c_str(), 0755);
+}
+
+static String teamMac(uint8_t index) {
+    char mac[18];
+    snprintf(mac, sizeof(mac), "c3:00:00:00:00:%02x", index);
+    return String(mac);
+}
+
+// Teams mit Runden, Beacons in Reichweite, laufendes Rennen
+static void loadFixtures(const RenderOptions& opts) {
+    bleScanner.begin();
+    bleScanner.setRSSIThreshold(BLE_RSSI_THRESHOLD);
+    bleScanner.setUUIDFilter(BLE_UUID_PREFIX);
+    bleScanner.startScan(0);
+
+    for (uint8_t i = 0; i < opts.teams; i++) {
+        lapCounter.addTeam(i + 1, "Team " + String(i + 1), teamMac(i));
+        uiState.selectedTeams[i] = true;
+    }
+    // Zwei Beacons ohne Team für die Zuweisung
+    for (uint8_t i = 0; i < opts.teams + 2; i++) {
+        HostBLE::injectAdvert(teamMac(i).c_str(), -50 - i * 4);
+    }
+
+    raceDuration = 20 * 60 * 1000;
+    raceStartTime = millis();
+    raceRunning = true;
+    for (uint8_t lap = 0; lap < 12; lap++) {
+        delay(30000);
+        for (uint8_t i = 0; i < opts.teams; i++) {
+            if (lap < 12 - i) {
+                lapCounter.recordLap(i + 1, millis() + i * 700);
+            }
+        }
+    }
+    uiState.editingTeamId = 1;
+    uiState.editingTeamName = "Team 1";
+}
+
+static DrawCost drawMeasured() {
+    HostDisplay::resetStats();
+    auto start = std::chrono::steady_clock::now();
+
+    // Wie drawScreen() in main.cpp
+    if (uiState.currentScreen != SCREEN_RACE_RUNNING) {
+        releaseRaceSprites();
+    }
+    drawScreenContent();
+    uiState.needsRedraw = false;
+
+    DrawCost cost;
+    cost.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    cost.spi = HostDisplay::stats();
+    return cost;
+}
+
+static void printCost(const char* label, const DrawCost& cost) {
+    printf("  %-7s %8.3f %8u %10.1f %9.2f", label, cost.ms, cost.spi.windows,
+           cost.spi.bytes / 1024.0, cost.spi.busMicros() / 1000.0);
+}
+
+// Eine Touch-Abtastung wie vom Touch-Task, Zeit = virtuelle Uhr
+static void injectTouch(TouchEventType type, uint16_t y) {
+    static uint64_t downUs = 0;
+    TouchEvent touch;
+    touch.type = type;
+    touch.x = SCREEN_WIDTH / 2;
+    touch.y = y;
+    touch.sampledUs = micros();
+    if (type == TOUCH_PRESS) {
+        downUs = touch.sampledUs;
+    }
+    touch.downUs = downUs;
+    handleTouch(touch);
+    lapPipeline.finishRequestedRace();
+}
+
+static void drawFrame(ScrollCost& cost) {
+    if (!uiState.needsRedraw) {
+        return;
+    }
+    DrawCost frame = drawMeasured();
+    double busMs = frame.spi.busMicros() / 1000.0;
+    cost.frames++;
+    cost.maxMs = std::max(cost.maxMs, frame.ms);
+    cost.busMs += busMs;
+    cost.maxBusMs = std::max(cost.maxBusMs, busMs);
+}
+
+// Finger ab fromY in 8 Abtastungen um je step px ziehen, loslassen, ausrollen.
+// Gezeichnet wird nach jeder Abtastung (auf dem Gerät fasst onTouch() zusammen).
+static ScrollCost measureScroll(Screen screen, uint16_t fromY, int16_t step) {
+    uiState.changeScreen(screen);
+    drawMeasured();
+    
+    ScrollCost cost = {};
+    uint16_t y = fromY;
+    injectTouch(TOUCH_PRESS, y);
+    drawFrame(cost);
+    for (int i = 0; i < 8; i++) {
+        delay(TOUCH_SAMPLE_INTERVAL);
+        y += step;
+        injectTouch(TOUCH_MOVE, y);
+        drawFrame(cost);
+    }
+    delay(TOUCH_SAMPLE_INTERVAL * TOUCH_RELEASE_SAMPLES);
+    injectTouch(TOUCH_RELEASE, y);
+    drawFrame(cost);
+    
+    while (isListScrolling()) {
+        delay(LIST_FRAME_INTERVAL);
+        stepListScroll(micros());
+        drawFrame(cost);
+    }
+    cost.offset = uiState.scrollOffset;
+    return cost;
+}
+
+// ============================================================
+// Main
+// ============================================================
+
+int main(int argc, char** argv) {
+    RenderOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        return 1;
+    }
+
+    HostClock::setManual(true);
+    HostClock::setMicros(0);
+    if (opts.quiet) {
+        Serial.setHostOutput(nullptr);
+    }
+
+    mkdir(opts.outDir.c_str(), 0755);
+    if (opts.updateGolden) {
+        mkdir(opts.goldenDir.c_str(), 0755);
+    }
+    makeDirs(opts.sdRoot);
+    SD.setHostRoot(opts.sdRoot.c_str());
+    dataLogger.begin(SD_CS_PIN);
+
+    display.begin();
+    loadFixtures(opts);
+
+    printf("\n%-14s  %-7s %8s %8s %10s %9s  %-7s %8s %8s %10s %9s  %s\n",
+           "screen", "", "ms", "windows", "KB", "bus ms", "", "ms", "windows", "KB", "bus ms", "golden");
+
+    int mismatches = 0;
+    for (uint8_t screen = 0; screen < screenCount; screen++) {
+        uiState.changeScreen((Screen)screen);
+        DrawCost full = drawMeasured();
+
+        String path = opts.outDir + "/" + screenNames[screen] + ".ppm";
+        HostDisplay::writePPM(path.c_str());
+
+        // Golden vor dem Refresh: Referenz ist der frisch betretene Screen
+        String golden = "-";
+        if (opts.goldenDir.length() > 0) {
+            String goldenPath = opts.goldenDir + "/" + screenNames[screen] + ".ppm";
+            if (opts.updateGolden) {
+                golden = HostDisplay::writePPM(goldenPath.c_str()) ? "written" : "FAILED";
+            } else {
+                int64_t diff = HostDisplay::diffPPM(goldenPath.c_str());
+                if (diff == 0) {
+                    golden = "ok";
+                } else {
+                    golden = diff < 0 ? String("missing") : String((long)diff) + " px";
+                    mismatches++;
+                }
+            }
+        }
+
+        // Etwas später (über der Mindest-Rundenzeit), Führender mit einer Runde mehr
+        delay(REFRESH_STEP_MS);
+        lapCounter.recordLap((uint8_t)1, millis());
+        uiState.needsRedraw = true;
+        DrawCost refresh = drawMeasured();
+
+        printf("%-14s", screenNames[screen]);
+        printCost("full", full);
+        printCost("refresh", refresh);
+        printf("  %s\n", golden.c_str());
+    }
+
+    // Wischen nach oben auf den Listen, Rangliste eine Seite weiter
+    static const Screen scrollScreens[] = {
+        SCREEN_TEAMS, SCREEN_BEACON_LIST, SCREEN_RACE_RESULTS, SCREEN_RACE_RUNNING
+    };
+    static const uint16_t scrollFromY[] = { 165, 225, 225, 170 };   // Unten in der Liste
+    printf("\n%-14s  %6s %8s %10s %10s %8s %7s\n",
+           "scroll", "frames", "max ms", "avg bus ms", "max bus ms", "fps bus", "offset");
+    for (uint8_t i = 0; i < sizeof(scrollScreens) / sizeof(scrollScreens[0]); i++) {
+        Screen screen = scrollScreens[i];
+        ScrollCost cost = measureScroll(screen, scrollFromY[i], -15);
+        double avgBus = cost.frames ? cost.busMs / cost.frames : 0;
+        printf("%-14s  %6u %8.3f %10.2f %10.2f %8.0f %7d\n", screenNames[screen], cost.frames,
+               cost.maxMs, avgBus, cost.maxBusMs, cost.maxBusMs > 0 ? 1000.0 / cost.maxBusMs : 0.0,
+               (int)cost.offset);
+    }
+    
+    printf("\nbus: %u Hz, window overhead: %u bytes, frames: %s/\n",
+           HostDisplay::stats().freqHz, HOST_SPI_WINDOW_BYTES, opts.outDir.c_str());
+    if (mismatches > 0) {
+        printf("%d screen(s) differ from golden images in %s/\n", mismatches, opts.goldenDir.c_str());
+        return 1;
+    }
+    return 0;
+}
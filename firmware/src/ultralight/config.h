@@ -54,7 +54,13 @@
 #define MAX_RSSI -30               // dBm - Maximum
 
 // Touch
-#define TOUCH_DEBOUNCE 200         // ms
+// PENIRQ weckt den Touch-Task (TouchInput), -1 = Task fragt selbst ab
+#if defined(USE_XPT2046_TOUCH) && XPT2046_IRQ != 255
+#define TOUCH_INPUT_IRQ XPT2046_IRQ
+#else
+#define TOUCH_INPUT_IRQ -1
+#endif
+#define XPT2046_CALIBRATION_MODE 0  // 1 = beim Start kalibrieren, Matrix landet in NVS
 
 // Race Settings
 #define MIN_LAP_TIME 10000         // ms (10 seconds)
@@ -1,11 +1,14 @@
 #include <Arduino.h>
 #include <TFT_eSPI.h>
 #include <SPI.h>
-#include <map>
 #include "config.h"
 #include "BLEScanner.h"
 #include "LapCounter.h"
 #include "DataLogger.h"
+#include "LapPipeline.h"
+#include "EventLoop.h"
+#include "Diagnostics.h"
+#include "TouchInput.h"
 #include "persistence.h"
 #include "ui_screens.h"
 
@@ -34,6 +37,9 @@ BLEScanner bleScanner;
 LapCounter lapCounter;
 DataLogger dataLogger;
 PersistenceManager persistence;
+LapPipeline lapPipeline(lapCounter, dataLogger);
+EventLoop eventLoop;
+TouchInput touchInput;
 
 // Race State
 bool raceRunning = false;
@@ -41,9 +47,6 @@ uint32_t raceStartTime = 0;
 uint32_t raceDuration = 60 * 60 * 1000;  // 60 minutes default
 String currentRaceName = "";
 
-// Beacon Presence Tracking (für Lap Detection)
-std::map<uint8_t, bool> beaconPresence;
-
 // RSSI Thresholds (anpassbar in Settings!)
 int8_t lapRssiNear = DEFAULT_LAP_RSSI_NEAR;  // -65 dBm
 int8_t lapRssiFar = DEFAULT_LAP_RSSI_FAR;    // -80 dBm
@@ -56,9 +59,15 @@ void initDisplay();
 void initBLE();
 void initSD();
 void initPersistence();
-void processTouch();
+void initEvents();
+#if defined(USE_XPT2046_TOUCH) && XPT2046_CALIBRATION_MODE
+void calibrateXPT2046();
+#endif
+void onTouch(const Event& event);
 void drawScreen();
+void drawScreenContent();
 void onBeaconDetected(const BeaconData& beacon);
+void onLapCounted(const LapEvent& lap);
 
 // ============================================================
 // Setup
@@ -99,12 +108,23 @@ void setup() {
     tft.setCursor(10, 190);
     tft.println("Loading Teams...");
     
+    // Lap/Logger Tasks (Core 0: Rundenerkennung, Core 1: SD)
+    lapPipeline.setPresenceTimeout(BEACON_TIMEOUT);
+    lapPipeline.onLap(onLapCounted);
+    lapPipeline.begin();
+    
     delay(2000);
     
+    #if defined(USE_XPT2046_TOUCH) && XPT2046_CALIBRATION_MODE
+    calibrateXPT2046();
+    #endif
+    
     Serial.println("\nSetup complete!");
     Serial.println("Ready to scan for beacons.\n");
     
     uiState.needsRedraw = true;
+    
+    initEvents();
 }
 
 // ============================================================
@@ -112,57 +132,51 @@ void setup() {
 // ============================================================
 
 void loop() {
-    // Handle Touch Input
-    processTouch();
+    // Schläft bis zum nächsten Timer oder Event (kein delay() mehr)
+    eventLoop.setScreen(uiState.currentScreen);
+    eventLoop.runOnce();
+}
+
+// Nach jeder Scheduler-Runde: Screen-Wechsel und Redraw
+void updateScreen() {
+    eventLoop.setScreen(uiState.currentScreen);
     
-    // Update Screen if needed
     if (uiState.needsRedraw) {
-        drawScreen();
         uiState.needsRedraw = false;
+        drawScreen();
     }
-    
-    // Auto-refresh beacon screens while scanning
-    if (bleScanner.isScanning()) {
-        if (uiState.currentScreen == SCREEN_TEAM_BEACON_ASSIGN || 
-            uiState.currentScreen == SCREEN_BEACON_LIST) {
-            static uint32_t lastBeaconRefresh = 0;
-            if (millis() - lastBeaconRefresh > 1000) {  // Refresh every second
-                drawScreen();
-                lastBeaconRefresh = millis();
-            }
+}
+
+void initEvents() {
+    eventLoop.on(EVENT_TOUCH, "touch", onTouch);
+    eventLoop.on(EVENT_LAP, "lap", [](const Event&) {
+        uiState.needsRedraw = true;
+    });
+    
+    // Touch: IRQ weckt den Touch-Task, kein SPI-Zugriff im Leerlauf.
+    // TouchXPT2046 und TFT_eSPI sperren den Bus in
+    // SPI.beginTransaction() (wie beim Logger-Task).
+    touchInput.onEvent([]() {
+        eventLoop.post(EVENT_TOUCH);
+    });
+    touchInput.begin(getTouchCoordinates, TOUCH_INPUT_IRQ);
+    
+    // Beacon-Screens: höchstens einmal pro Sekunde, nur bei neuen Daten
+    static bool beaconsChanged = false;
+    eventLoop.on(EVENT_SCANNER, "scanner", [](const Event&) {
+        beaconsChanged = true;
+    }, EVENT_SCREEN(SCREEN_TEAM_BEACON_ASSIGN) | EVENT_SCREEN(SCREEN_BEACON_LIST));
+    eventLoop.addTimer("beaconRefresh", 1000, []() {
+        if (beaconsChanged && bleScanner.isScanning()) {
+            beaconsChanged = false;
+            drawScreen();
         }
-    }
+    }, EVENT_SCREEN(SCREEN_TEAM_BEACON_ASSIGN) | EVENT_SCREEN(SCREEN_BEACON_LIST));
     
-    // Race Running: Update display & check beacon timeouts
-    if (raceRunning) {
-        // Update every second
-        static uint32_t lastUpdate = 0;
-        if (millis() - lastUpdate > 1000) {
-            drawRaceRunningScreen();
-            lastUpdate = millis();
-        }
-        
-        // Check for Timeout (Beacon nicht mehr gesehen) - alle 500ms
-        static uint32_t lastPresenceCheck = 0;
-        if (millis() - lastPresenceCheck > 500) {
-            // Durch alle Teams gehen
-            for (uint8_t teamId = 1; teamId <= lapCounter.getTeamCount(); teamId++) {
-                TeamData* team = lapCounter.getTeam(teamId);
-                if (!team || team->beaconUUID.length() == 0) continue;
-                
-                // Beacon im Scanner suchen (per MAC-Adresse = beaconUUID)
-                BeaconData* beacon = bleScanner.getBeacon(team->beaconUUID);
-                
-                // Wenn Beacon nicht mehr im Scanner ODER zu alt → "weg"
-                if (!beacon || (millis() - beacon->lastSeen > BEACON_TIMEOUT)) {
-                    if (beaconPresence[teamId]) {
-                        Serial.printf("[Lap] Team %u: WEG (timeout: %s)\n", 
-                                     teamId, !beacon ? "not found" : "too old");
-                        beaconPresence[teamId] = false;
-                    }
-                }
-            }
-            lastPresenceCheck = millis();
+    // Race Running: Update display every second & check race time
+    eventLoop.addTimer("raceClock", 1000, []() {
+        if (!raceRunning) {
+            return;
         }
         
         // Check if race time is up
@@ -173,23 +187,33 @@ void loop() {
             
             bleScanner.stopScan();
             
-            // Reset presence tracking
-            beaconPresence.clear();
-            
             Serial.println("\n=== RACE FINISHED ===");
+            return;
         }
-    }
+        
+        drawScreen();
+    }, EVENT_SCREEN(SCREEN_RACE_RUNNING));
+    
+    // Diagnose-Screen aktualisieren
+    eventLoop.addTimer("diagRefresh", 1000, []() {
+        uiState.needsRedraw = true;
+    }, EVENT_SCREEN(SCREEN_DIAGNOSTICS));
+    
+    // Beacon-Timeout (WEG) prüft der Lap-Task, ohne Tasks hier
+    eventLoop.addTimer("presence", 500, []() {
+        if (raceRunning) {
+            lapPipeline.poll();
+        }
+    });
     
     // Clean up old beacons (only when NOT racing, for beacon assignment UI)
-    if (bleScanner.isScanning() && !raceRunning) {
-        static uint32_t lastCleanup = 0;
-        if (millis() - lastCleanup > 5000) {  // Check every 5 seconds
+    eventLoop.addTimer("beaconExpiry", 5000, []() {
+        if (bleScanner.isScanning() && !raceRunning) {
             bleScanner.clearOldBeacons(BEACON_TIMEOUT);
-            lastCleanup = millis();
         }
-    }
+    });
     
-    delay(10);
+    eventLoop.afterDispatch("redraw", updateScreen);
 }
 
 // ============================================================
@@ -281,10 +305,52 @@ void initPersistence() {
     
     // Load RSSI thresholds
     persistence.loadRssiThresholds(lapRssiNear, lapRssiFar);
+    lapPipeline.setRssiThresholds(lapRssiNear, lapRssiFar);
+    
+    #ifdef USE_XPT2046_TOUCH
+    // Touch-Kalibrierung, sonst bleibt der Rohbereich aus touch_xpt2046.h
+    TouchMatrix touchMatrix;
+    if (persistence.loadTouchCalibration(touchMatrix)) {
+        touchXPT2046.setCalibration(touchMatrix);
+    }
+    #endif
     
     Serial.printf("[Persistence] Loaded %u teams\n", lapCounter.getTeamCount());
 }
 
+#if defined(USE_XPT2046_TOUCH) && XPT2046_CALIBRATION_MODE
+// Fadenkreuze an den Ecken, die Matrix landet in NVS (wie bei v2).
+// Läuft vor initEvents(), der Touch-Task liest also nicht mit.
+void calibrateXPT2046() {
+    Serial.println("[Touch XPT2046] Calibration: touch each crosshair");
+    
+    TouchCalPoint points[TOUCH_CAL_POINTS];
+    TouchCalibration::targets(320, 240, points);
+    bool captured = true;
+    for (uint8_t i = 0; i < TOUCH_CAL_POINTS && captured; i++) {
+        tft.fillScreen(TFT_BLACK);
+        tft.drawFastHLine(points[i].x - 10, points[i].y, 21, TFT_WHITE);
+        tft.drawFastVLine(points[i].x, points[i].y - 10, 21, TFT_WHITE);
+        tft.drawCircle(points[i].x, points[i].y, 4, TFT_RED);
+        captured = TouchCalibration::capture([](uint16_t* rawX, uint16_t* rawY) {
+            return touchXPT2046.getRaw(rawX, rawY);
+        }, points[i]);
+        Serial.printf("[Touch XPT2046] Point %u: screen=(%d, %d) raw=(%u, %u)\n",
+                      i + 1, points[i].x, points[i].y, points[i].rawX, points[i].rawY);
+    }
+    
+    TouchCalibration calibration;
+    if (captured && calibration.compute(points, TOUCH_CAL_POINTS)) {
+        touchXPT2046.setCalibration(calibration.getMatrix());
+        persistence.saveTouchCalibration(calibration.getMatrix());
+        Serial.println("[Touch XPT2046] Calibration saved");
+    } else {
+        Serial.println("[Touch XPT2046] Calibration failed - keeping previous");
+    }
+    tft.fillScreen(BACKGROUND_COLOR);
+}
+#endif
+
 // ============================================================
 // Touch Handler
 // ============================================================
@@ -300,20 +366,42 @@ bool getTouchCoordinates(uint16_t* x, uint16_t* y) {
     #endif
 }
 
-void processTouch() {
-    uint16_t x, y;
-    
-    if (getTouchCoordinates(&x, &y)) {
-        // Debounce
-        if (millis() - uiState.lastTouchTime < TOUCH_DEBOUNCE) {
-            return;
+// Modale Dialoge (Tastatur, Bestätigung) warten in einer eigenen Schleife
+// im Touch-Handler: ein Tipp zählt beim Loslassen, an der letzten Position.
+// Das Loslassen des Touches, der den Dialog geöffnet hat, zählt nicht.
+bool getTouchTap(uint16_t* x, uint16_t* y) {
+    static bool pressed = false;
+    TouchEvent touch;
+    while (touchInput.receive(touch)) {
+        if (touch.type == TOUCH_PRESS) {
+            pressed = true;
+        } else if (touch.type == TOUCH_RELEASE && pressed) {
+            pressed = false;
+            *x = touch.x;
+            *y = touch.y;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Touch-Task hat Events eingereiht: alle abarbeiten, Buttons reagieren aufs Drücken
+void onTouch(const Event&) {
+    TouchEvent touch;
+    while (touchInput.receive(touch)) {
+        if (touch.type != TOUCH_PRESS) {
+            continue;
         }
-        uiState.lastTouchTime = millis();
         
-        Serial.printf("[Touch] X=%u, Y=%u, Screen=%d\n", x, y, uiState.currentScreen);
+        // Call screen-specific handler (Lap-Task wartet solange)
+        {
+            RtosLock lock(lapPipeline.stateMutex());
+            handleTouch(touch.x, touch.y);
+        }
+        lapPipeline.finishRequestedRace();
+        diagnostics.touchToAction.record((uint32_t)(rtosMicros() - touch.downUs));
         
-        // Call screen-specific handler
-        handleTouch(x, y);
+        Serial.printf("[Touch] X=%u, Y=%u, Screen=%d\n", touch.x, touch.y, uiState.currentScreen);
     }
 }
 
@@ -321,7 +409,24 @@ void processTouch() {
 // Screen Dispatcher
 // ============================================================
 
+// Zeichnet den aktuellen Screen und misst die Zeichenzeit
 void drawScreen() {
+    uint8_t screen = uiState.currentScreen;
+    uint64_t start = rtosMicros();
+    
+    drawScreenContent();
+    
+    diagnostics.recordDraw(screen, (uint32_t)(rtosMicros() - start));
+}
+
+void drawScreenContent() {
+    // Race-Screen zeichnet aus getStandings() und hält den Lock nicht
+    if (uiState.currentScreen == SCREEN_RACE_RUNNING) {
+        drawRaceRunningScreen();
+        return;
+    }
+    
+    RtosLock lock(lapPipeline.stateMutex());
     switch (uiState.currentScreen) {
         case SCREEN_HOME:
             drawHomeScreen();
@@ -353,6 +458,9 @@ void drawScreen() {
         case SCREEN_SETTINGS:
             drawSettingsScreen();
             break;
+        case SCREEN_DIAGNOSTICS:
+            drawDiagnosticsScreen();
+            break;
     }
 }
 
@@ -363,54 +471,20 @@ void drawScreen() {
 void onBeaconDetected(const BeaconData& beacon) {
     // NUR während des Rennens Runden zählen!
     if (!raceRunning) {
+        eventLoop.post(EVENT_SCANNER);
         return;
     }
     
-    // Check if beacon belongs to a team (per MAC-Adresse!)
-    TeamData* team = lapCounter.getTeamByBeacon(beacon.macAddress);
-    
-    if (!team) {
-        // Unknown beacon - silent (zu viel spam)
-        return;
-    }
-    
-    // RSSI-basierte Presence Detection mit Hysterese:
-    // - "NAH" (present) wenn RSSI > lapRssiNear
-    // - "WEG" (absent) wenn RSSI < lapRssiFar
+    // Läuft im NimBLE-Task: nur einreihen, Hysterese + Zählung im Lap-Task
+    // (NAH wenn RSSI > lapRssiNear, WEG wenn RSSI < lapRssiFar)
+    lapPipeline.ingest(beacon);
+}
+
+void onLapCounted(const LapEvent& lap) {
+    Serial.printf("[Lap] ✅ Team %u (%s): Runde %u gezahlt! (%lu us)\n",
+                 lap.teamId, lap.teamName, lap.lapCount, lap.latencyUs);
     
-    if (beacon.rssi > lapRssiNear) {
-        // Beacon ist NAH (starkes Signal)!
-        if (!beaconPresence[team->teamId]) {
-            // War vorher WEG, jetzt NAH → Runde zählen!
-            Serial.printf("[Lap] Team %u: NAH! (RSSI=%d dBm) - Runde zählen...\n", 
-                         team->teamId, beacon.rssi);
-            
-            if (lapCounter.recordLap(team->teamId, beacon.lastSeen)) {
-                Serial.printf("[Lap] ✅ Team %u (%s): Runde %u gezahlt!\n",
-                             team->teamId, team->teamName.c_str(), team->lapCount);
-                
-                // Log to SD
-                if (dataLogger.isReady() && team->laps.size() > 0) {
-                    LapTime& lap = team->laps.back();
-                    dataLogger.logLap(team->teamId, team->teamName, 
-                                     lap.lapNumber, lap.timestamp, lap.duration);
-                }
-                
-                // Update screen
-                uiState.needsRedraw = true;
-            }
-            
-            // Beacon ist jetzt "present"
-            beaconPresence[team->teamId] = true;
-        }
-        // Else: Beacon war schon "present", kein Spam
-    } else if (beacon.rssi < lapRssiFar) {
-        // Beacon ist WEG (schwaches Signal)!
-        if (beaconPresence[team->teamId]) {
-            Serial.printf("[Lap] Team %u: WEG! (RSSI=%d dBm)\n", team->teamId, beacon.rssi);
-            beaconPresence[team->teamId] = false;
-        }
-    }
-    // Else: Zwischen -80 und -65 dBm → Hysterese, Status beibehalten
+    // Update screen (weckt loop())
+    eventLoop.post(EVENT_LAP);
 }
 
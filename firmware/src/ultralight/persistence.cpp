@@ -11,6 +11,7 @@ const char* PersistenceManager::KEY_RACE_NAME = "racename";
 const char* PersistenceManager::KEY_RACE_DURATION = "duration";
 const char* PersistenceManager::KEY_RSSI_NEAR = "rssinear";
 const char* PersistenceManager::KEY_RSSI_FAR = "rssifar";
+const char* PersistenceManager::KEY_TOUCH_CAL = "touchcal";
 
 PersistenceManager::PersistenceManager() 
     : initialized(false) {
@@ -184,6 +185,34 @@ bool PersistenceManager::loadRssiThresholds(int8_t& rssiNear, int8_t& rssiFar) {
     return true;
 }
 
+bool PersistenceManager::saveTouchCalibration(const TouchMatrix& matrix) {
+    if (!initialized) return false;
+    
+    preferences.begin(NAMESPACE_CONFIG, false);
+    size_t written = preferences.putBytes(KEY_TOUCH_CAL, &matrix, sizeof(matrix));
+    preferences.end();
+    
+    Serial.printf("[Persistence] Touch calibration saved: x=(%ld, %ld, %ld), y=(%ld, %ld, %ld)\n",
+                 (long)matrix.a, (long)matrix.b, (long)matrix.c,
+                 (long)matrix.d, (long)matrix.e, (long)matrix.f);
+    return written == sizeof(matrix);
+}
+
+bool PersistenceManager::loadTouchCalibration(TouchMatrix& matrix) {
+    if (!initialized) return false;
+    
+    preferences.begin(NAMESPACE_CONFIG, true);
+    // Andere Größe = anderes Format, dann gilt der Default der Variante
+    bool found = preferences.getBytesLength(KEY_TOUCH_CAL) == sizeof(matrix) &&
+                 preferences.getBytes(KEY_TOUCH_CAL, &matrix, sizeof(matrix)) == sizeof(matrix);
+    preferences.end();
+    
+    if (found) {
+        Serial.println("[Persistence] Touch calibration loaded");
+    }
+    return found;
+}
+
 bool PersistenceManager::isInitialized() {
     return initialized;
 }
@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include <Preferences.h>
 #include "LapCounter.h"
+#include "TouchFilter.h"
 
 /**
  * Persistenz-Layer für Teams
@@ -33,6 +34,10 @@ public:
     bool saveRssiThresholds(int8_t rssiNear, int8_t rssiFar);
     bool loadRssiThresholds(int8_t& rssiNear, int8_t& rssiFar);
     
+    // Touch-Kalibrierung (beide Varianten), false = keine gespeichert
+    bool saveTouchCalibration(const TouchMatrix& matrix);
+    bool loadTouchCalibration(TouchMatrix& matrix);
+    
     // Stats
     uint8_t getTeamCount();
     bool isInitialized();
@@ -52,6 +57,7 @@ private:
     static const char* KEY_RACE_DURATION;
     static const char* KEY_RSSI_NEAR;
     static const char* KEY_RSSI_FAR;
+    static const char* KEY_TOUCH_CAL;
 };
 
 #endif // PERSISTENCE_H
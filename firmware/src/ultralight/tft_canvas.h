@@ -0,0 +1,43 @@
+#ifndef TFT_CANVAS_H
+#define TFT_CANVAS_H
+
+#include <TFT_eSPI.h>
+#include "Canvas.h"
+
+// Canvas-Backend für TFT_eSPI. Nur Weiterleitungen, die der Compiler in
+// die Canvas-Elemente inlinet.
+class TftCanvas : public Canvas<TftCanvas> {
+public:
+    TftCanvas(TFT_eSPI& tft, const CanvasTheme& theme)
+        : Canvas<TftCanvas>(theme), tft(tft) {}
+
+    int32_t width() { return tft.width(); }
+    int32_t height() { return tft.height(); }
+
+    void fillScreen(uint16_t color) { tft.fillScreen(color); }
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) { tft.fillRect(x, y, w, h, color); }
+    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) { tft.drawRect(x, y, w, h, color); }
+    void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) { tft.fillRoundRect(x, y, w, h, r, color); }
+    void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) { tft.drawRoundRect(x, y, w, h, r, color); }
+    void fillCircle(int32_t x, int32_t y, int32_t r, uint16_t color) { tft.fillCircle(x, y, r, color); }
+    void drawCircle(int32_t x, int32_t y, int32_t r, uint16_t color) { tft.drawCircle(x, y, r, color); }
+    void drawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t color) { tft.drawFastHLine(x, y, w, color); }
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint16_t color) { tft.drawFastVLine(x, y, h, color); }
+
+    void setTextColor(uint16_t color) { tft.setTextColor(color); }
+    void setTextColor(uint16_t color, uint16_t background) { tft.setTextColor(color, background); }
+    void setTextSize(uint8_t size) { tft.setTextSize(size); }
+    void setTextDatum(CanvasDatum datum) {
+        // TFT_eSPI: ML_DATUM = 3, bei LovyanGFX 4
+        static const uint8_t datums[] = {TL_DATUM, TC_DATUM, TR_DATUM, ML_DATUM, MC_DATUM, MR_DATUM};
+        tft.setTextDatum(datums[datum]);
+    }
+    int32_t textWidth(const char* text) { return tft.textWidth(text); }
+    int32_t fontHeight() { return tft.fontHeight(); }
+    void drawString(const char* text, int32_t x, int32_t y) { tft.drawString(text, x, y); }
+
+private:
+    TFT_eSPI& tft;
+};
+
+#endif // TFT_CANVAS_H
@@ -1,8 +1,10 @@
 #include "ui_screens.h"
 #include "persistence.h"
 #include "DataLogger.h"
+#include "Diagnostics.h"
+#include "LapPipeline.h"
+#include "touch_wrapper.h"
 #include <algorithm>  // For std::sort
-#include <map>
 
 extern bool raceRunning;
 extern uint32_t raceStartTime;
@@ -10,7 +12,7 @@ extern uint32_t raceDuration;
 extern String currentRaceName;
 extern DataLogger dataLogger;
 extern PersistenceManager persistence;
-extern std::map<uint8_t, bool> beaconPresence;
+extern LapPipeline lapPipeline;
 
 // ============================================================
 // Main Touch Handler
@@ -48,6 +50,9 @@ void handleTouch(uint16_t x, uint16_t y) {
         case SCREEN_SETTINGS:
             handleSettingsTouch(x, y);
             break;
+        case SCREEN_DIAGNOSTICS:
+            handleDiagnosticsTouch(x, y);
+            break;
         default:
             break;
     }
@@ -452,7 +457,7 @@ void handleRaceSetupTouch(uint16_t x, uint16_t y) {
         
         // Start data logging
         if (dataLogger.isReady()) {
-            dataLogger.startNewRace(currentRaceName);
+            lapPipeline.logRaceStart(currentRaceName, raceDuration);
         }
         
         // Start BLE scanning
@@ -460,12 +465,8 @@ void handleRaceSetupTouch(uint16_t x, uint16_t y) {
             bleScanner.startScan();
         }
         
-        // Reset all teams
-        lapCounter.reset();
-        
-        // Reset beacon presence tracking
-        beaconPresence.clear();
-        Serial.println("[Race] Beacon presence tracking reset");
+        // Reset all teams and beacon presence tracking
+        lapPipeline.resetRace();
         
         uiState.currentScreen = SCREEN_RACE_RUNNING;
         uiState.needsRedraw = true;
@@ -495,9 +496,9 @@ void handleRaceRunningTouch(uint16_t x, uint16_t y) {
         uiState.currentScreen = SCREEN_RACE_RESULTS;
         uiState.needsRedraw = true;
         
-        // Finish race
+        // Finish race (geschrieben wird nach dem Lock)
         if (dataLogger.isReady()) {
-            dataLogger.finishRace();
+            lapPipeline.requestRaceFinish();
         }
         bleScanner.stopScan();
         
@@ -532,7 +533,7 @@ void handleRacePausedTouch(uint16_t x, uint16_t y) {
         uiState.needsRedraw = true;
         
         if (dataLogger.isReady()) {
-            dataLogger.finishRace();
+            lapPipeline.requestRaceFinish();    // Geschrieben wird nach dem Lock
         }
         bleScanner.stopScan();
         
@@ -614,6 +615,8 @@ void handleSettingsTouch(uint16_t x, uint16_t y) {
         if (lapRssiNear > MIN_RSSI) {
             lapRssiNear -= 5;
             
+            lapPipeline.setRssiThresholds(lapRssiNear, lapRssiFar);
+            
             // Save to NVS
             if (persistence.isInitialized()) {
                 persistence.saveRssiThresholds(lapRssiNear, lapRssiFar);
@@ -630,6 +633,8 @@ void handleSettingsTouch(uint16_t x, uint16_t y) {
         if (lapRssiNear < MAX_RSSI) {
             lapRssiNear += 5;
             
+            lapPipeline.setRssiThresholds(lapRssiNear, lapRssiFar);
+            
             // Save to NVS
             if (persistence.isInitialized()) {
                 persistence.saveRssiThresholds(lapRssiNear, lapRssiFar);
@@ -649,6 +654,8 @@ void handleSettingsTouch(uint16_t x, uint16_t y) {
         if (lapRssiFar > MIN_RSSI) {
             lapRssiFar -= 5;
             
+            lapPipeline.setRssiThresholds(lapRssiNear, lapRssiFar);
+            
             // Save to NVS
             if (persistence.isInitialized()) {
                 persistence.saveRssiThresholds(lapRssiNear, lapRssiFar);
@@ -665,6 +672,8 @@ void handleSettingsTouch(uint16_t x, uint16_t y) {
         if (lapRssiFar < MAX_RSSI) {
             lapRssiFar += 5;
             
+            lapPipeline.setRssiThresholds(lapRssiNear, lapRssiFar);
+            
             // Save to NVS
             if (persistence.isInitialized()) {
                 persistence.saveRssiThresholds(lapRssiNear, lapRssiFar);
@@ -676,6 +685,14 @@ void handleSettingsTouch(uint16_t x, uint16_t y) {
         return;
     }
     
+    // === Diagnose Button (Status-Zeile) ===
+    int yStatus = yStart + 38 + 10 + 38 + 8;
+    if (isTouchInRect(x, y, SCREEN_WIDTH - 70, yStatus - 5, 60, 18)) {
+        uiState.currentScreen = SCREEN_DIAGNOSTICS;
+        uiState.needsRedraw = true;
+        return;
+    }
+    
     // === SD Format Button ===
     if (dataLogger.isReady()) {
         int yFormat = HEADER_HEIGHT + 8 + 18 + 33 + 38 + 8 + 18 + 18 + 18;
@@ -708,10 +725,7 @@ void handleSettingsTouch(uint16_t x, uint16_t y) {
             
             while (!confirmed && !cancelled && (millis() - waitStart < 30000)) {
                 uint16_t tx, ty;
-                if (getTouchCoordinates(&tx, &ty)) {
-                    delay(50);
-                    while (getTouchCoordinates(&tx, &ty)) delay(10);
-                    
+                if (getTouchTap(&tx, &ty)) {
                     // Cancel button
                     if (isTouchInRect(tx, ty, 10, 180, 90, 30)) {
                         cancelled = true;
@@ -744,3 +758,26 @@ void handleSettingsTouch(uint16_t x, uint16_t y) {
     }
 }
 
+void handleDiagnosticsTouch(uint16_t x, uint16_t y) {
+    // Back button
+    if (isTouchInRect(x, y, SCREEN_WIDTH - 60, 0, 60, HEADER_HEIGHT)) {
+        uiState.currentScreen = SCREEN_SETTINGS;
+        uiState.needsRedraw = true;
+        return;
+    }
+    
+    int btnY = SCREEN_HEIGHT - 40;
+    
+    // Reset
+    if (isTouchInRect(x, y, 10, btnY, 145, 30)) {
+        diagnostics.reset();
+        uiState.needsRedraw = true;
+        return;
+    }
+    
+    // Report über Serial
+    if (isTouchInRect(x, y, 165, btnY, 145, 30)) {
+        diagnostics.printReport();
+        return;
+    }
+}
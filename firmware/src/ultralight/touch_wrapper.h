@@ -6,7 +6,8 @@
 // Global Touch Wrapper
 // Unterstützt sowohl GT911 (I2C) als auch XPT2046 (SPI)
 
-extern bool getTouchCoordinates(uint16_t* x, uint16_t* y);
+extern bool getTouchCoordinates(uint16_t* x, uint16_t* y);  // Nur Touch-Task
+extern bool getTouchTap(uint16_t* x, uint16_t* y);          // Modale Dialoge: Tipp (Loslassen)
 
 #endif // TOUCH_WRAPPER_H
 
@@ -2,73 +2,128 @@
 #define TOUCH_XPT2046_H
 
 #include <Arduino.h>
-#include <XPT2046_Touchscreen.h>
 #include <SPI.h>
 #include "config.h"
+#include "TouchFilter.h"
 
 // XPT2046 Touch Controller Wrapper
 // für ESP32-2432S028 (CYD - Cheap Yellow Display)
+//
+// Liest den Controller direkt: TOUCH_FILTER_SAMPLES Abtastungen (z1, z2,
+// x, y) in einer SPI-Transaktion, TouchFilter macht daraus eine Position.
+// XPT2046_Touchscreen hält Messwerte 3 ms vor und liefert bei schnellem
+// Abtasten immer denselben Punkt, daher ohne die Lib.
+
+#ifndef XPT2046_SPI_FREQ
+#define XPT2046_SPI_FREQ 2000000
+#endif
+
+// Rohbereich für die Default-Kalibrierung (ohne gespeicherte Matrix)
+#define XPT2046_RAW_X_MIN 200
+#define XPT2046_RAW_X_MAX 3700
+#define XPT2046_RAW_Y_MIN 200
+#define XPT2046_RAW_Y_MAX 3800
 
 class TouchXPT2046 {
 public:
-    TouchXPT2046() : ts(nullptr), initialized(false) {}
+    TouchXPT2046() : initialized(false) {}
     
     bool begin() {
         Serial.println("[Touch XPT2046] Initializing...");
-        Serial.printf("[Touch XPT2046] Pins: CS=%d, IRQ=%d, MOSI=%d, MISO=%d, CLK=%d\n", 
+        Serial.printf("[Touch XPT2046] Pins: CS=%d, IRQ=%d, MOSI=%d, MISO=%d, CLK=%d\n",
                       XPT2046_CS, XPT2046_IRQ, XPT2046_MOSI, XPT2046_MISO, XPT2046_CLK);
         
         // Explizit SPI initialisieren mit korrekten Pins
         SPI.begin(XPT2046_CLK, XPT2046_MISO, XPT2046_MOSI, XPT2046_CS);
+        pinMode(XPT2046_CS, OUTPUT);
+        digitalWrite(XPT2046_CS, HIGH);
         
-        // XPT2046 initialisieren (nutzt automatisch das SPI Object)
-        ts = new XPT2046_Touchscreen(XPT2046_CS, XPT2046_IRQ);
-        ts->begin();
-        ts->setRotation(1);  // Landscape
+        // Landscape: Rohwert x/y laufen wie Bildschirm x/y (Rotation 1)
+        TouchCalibration calibration;
+        calibration.setRange(XPT2046_RAW_X_MIN, XPT2046_RAW_X_MAX,
+                             XPT2046_RAW_Y_MIN, XPT2046_RAW_Y_MAX, 320, 240);
+        filter.setCalibration(calibration);
+        filter.setScreenSize(320, 240);
         
         initialized = true;
         Serial.println("[Touch XPT2046] Initialized");
         return true;
     }
     
+    // Gespeicherte Matrix aus Persistence ersetzt den Default
+    void setCalibration(const TouchMatrix& matrix) {
+        TouchCalibration calibration;
+        calibration.setMatrix(matrix);
+        filter.setCalibration(calibration);
+    }
+    
     bool getTouch(uint16_t* x, uint16_t* y) {
-        if (!initialized || !ts) return false;
+        if (!initialized) return false;
         
-        if (ts->touched()) {
-            TS_Point p = ts->getPoint();
-            
-            // Debug: Raw values anzeigen
-            static uint32_t lastDebug = 0;
-            if (millis() - lastDebug > 1000) {
-                Serial.printf("[Touch XPT2046] Raw: x=%d, y=%d, z=%d\n", p.x, p.y, p.z);
-                lastDebug = millis();
-            }
-            
-            // Map touch coordinates to screen coordinates
-            // XPT2046 raw: 0-4095 (typisch 200-3800)
-            // Screen: 0-320 (width) x 0-240 (height) in landscape
-            *x = map(p.x, 200, 3700, 0, 320);
-            *y = map(p.y, 200, 3800, 0, 240);
-            
-            // Clamp to screen bounds
-            *x = constrain(*x, 0, 319);
-            *y = constrain(*y, 0, 239);
-            
-            return true;
+        TouchSample samples[TOUCH_FILTER_SAMPLES];
+        readSamples(samples, TOUCH_FILTER_SAMPLES);
+        if (!filter.process(samples, TOUCH_FILTER_SAMPLES, x, y)) {
+            return false;
         }
         
-        return false;
+        // Debug: gefilterte Position und verworfene Lesezugriffe
+        static uint32_t lastDebug = 0;
+        if (millis() - lastDebug > 1000) {
+            Serial.printf("[Touch XPT2046] x=%u, y=%u (verworfen: Druck %u, Streuung %u)\n",
+                          *x, *y, filter.getRejectedPressure(), filter.getRejectedSpread());
+            lastDebug = millis();
+        }
+        return true;
     }
     
-    bool isPressed() {
-        if (!initialized || !ts) return false;
-        return ts->touched();
+    // Median der Rohwerte, für die Kalibrier-Routine
+    bool getRaw(uint16_t* rawX, uint16_t* rawY) {
+        if (!initialized) return false;
+        
+        TouchSample samples[TOUCH_FILTER_SAMPLES];
+        readSamples(samples, TOUCH_FILTER_SAMPLES);
+        return filter.filterRaw(samples, TOUCH_FILTER_SAMPLES, *rawX, *rawY);
     }
     
+    bool isPressed() {
+        if (!initialized) return false;
+        TouchSample sample;
+        readSamples(&sample, 1);
+        return sample.z >= TOUCH_PRESSURE_MIN;
+    }
+
 private:
-    XPT2046_Touchscreen* ts;
+    // Steuerbytes: Start, Kanal, 12 Bit, differentiell, PD0 = Referenz an
+    static const uint8_t CMD_Z1 = 0xB1;
+    static const uint8_t CMD_Z2 = 0xC1;
+    static const uint8_t CMD_X = 0x91;
+    static const uint8_t CMD_Y = 0xD1;
+    static const uint8_t CMD_Y_POWER_DOWN = 0xD0;   // Danach wieder PENIRQ
+    
+    TouchFilter filter;
     bool initialized;
+    
+    // Jedes transfer16() liest das Ergebnis des vorigen Befehls und startet
+    // den nächsten. TFT_eSPI sperrt den Bus ebenfalls per beginTransaction().
+    void readSamples(TouchSample* samples, uint8_t count) {
+        SPI.beginTransaction(SPISettings(XPT2046_SPI_FREQ, MSBFIRST, SPI_MODE0));
+        digitalWrite(XPT2046_CS, LOW);
+        
+        SPI.transfer(CMD_Z1);
+        for (uint8_t i = 0; i < count; i++) {
+            int32_t z1 = SPI.transfer16(CMD_Z2) >> 3;
+            int32_t z2 = SPI.transfer16(CMD_X) >> 3;
+            SPI.transfer16(CMD_X);  // Erste X-Wandlung nach dem Druck rauscht
+            samples[i].x = SPI.transfer16(CMD_Y) >> 3;
+            samples[i].y = SPI.transfer16(i + 1 < count ? CMD_Z1 : CMD_Y_POWER_DOWN) >> 3;
+            int32_t z = z1 + 4095 - z2;
+            samples[i].z = z > 0 ? (uint16_t)z : 0;
+        }
+        SPI.transfer16(0);  // Power-Down-Wandlung abschließen
+        
+        digitalWrite(XPT2046_CS, HIGH);
+        SPI.endTransaction();
+    }
 };
 
 #endif // TOUCH_XPT2046_H
-
@@ -21,13 +21,7 @@ String OnScreenKeyboard::getText(const String& prompt, const String& defaultText
     // Touch loop
     while (!done && !cancelled) {
         uint16_t x, y;
-        if (getTouchCoordinates(&x, &y)) {
-            // Debounce
-            delay(50);
-            while (getTouchCoordinates(&x, &y)) {
-                delay(10);
-            }
-            
+        if (getTouchTap(&x, &y)) {
             // Check special buttons
             int btnY = 190;
             int btnH = 28;
@@ -88,13 +82,7 @@ uint32_t OnScreenKeyboard::getNumber(const String& prompt, uint32_t defaultValue
     // Touch loop
     while (!done && !cancelled) {
         uint16_t x, y;
-        if (getTouchCoordinates(&x, &y)) {
-            // Debounce
-            delay(50);
-            while (getTouchCoordinates(&x, &y)) {
-                delay(10);
-            }
-            
+        if (getTouchTap(&x, &y)) {
             int centerX = SCREEN_WIDTH / 2;
             int centerY = 120;
             
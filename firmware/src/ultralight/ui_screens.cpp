@@ -1,9 +1,14 @@
 #include "ui_screens.h"
 #include "DataLogger.h"
+#include "Diagnostics.h"
+#include "LapPipeline.h"
+#include "RaceResults.h"
+#include "tft_canvas.h"
 #include "ui_keyboard.h"
 #include <algorithm>
 
 extern DataLogger dataLogger;
+extern LapPipeline lapPipeline;
 extern bool raceRunning;
 extern uint32_t raceStartTime;
 extern uint32_t raceDuration;
@@ -420,33 +425,32 @@ void drawRaceRunningScreen() {
     tft.setCursor(10, 8);
     tft.printf("Zeit: %02lu:%02lu", minutes, seconds);
     
-    // Leaderboard
-    auto leaderboard = lapCounter.getLeaderboard(true);
+    // Leaderboard (Snapshot, der Lap-Task zählt parallel weiter)
+    std::vector<TeamStanding> leaderboard;
+    lapPipeline.getStandings(leaderboard);
     
     int y = HEADER_HEIGHT + 10;
     int pos = 1;
     
-    for (auto* team : leaderboard) {
+    for (auto& team : leaderboard) {
         if (y > SCREEN_HEIGHT - 80) break;
         
         // Position & Name
         tft.setTextColor(TFT_WHITE);
         tft.setTextSize(2);
         tft.setCursor(10, y);
-        tft.printf("%u. %s", pos, team->teamName.c_str());
+        tft.printf("%u. %s", pos, team.teamName.c_str());
         
         // Laps
         tft.setCursor(220, y);
-        uint16_t laps = team->lapCount > 0 ? team->lapCount - 1 : 0;
-        tft.printf("%uR", laps);
+        tft.printf("%uR", team.laps);
         
         // Last Lap Time
-        if (!team->laps.empty()) {
-            LapTime& lastLap = team->laps.back();
+        if (team.lastLapDuration > 0) {
             tft.setTextSize(1);
             tft.setCursor(20, y + 18);
             tft.printf("Letzte: %lu.%03lu s", 
-                      lastLap.duration / 1000, lastLap.duration % 1000);
+                      team.lastLapDuration / 1000, team.lastLapDuration % 1000);
         }
         
         y += 35;
@@ -602,9 +606,9 @@ void displayRaceResultsFromFile(const String& filename, int startY) {
         return;
     }
     
-    // Read CSV file
-    String content = dataLogger.readFile(filename);
-    if (content.length() == 0) {
+    // Zusammenfassung laden (O(Teams)), sonst das Runden-Log streamen und .sum anlegen
+    RaceResults results;
+    if (!dataLogger.loadRaceResults(filename, results)) {
         tft.setTextColor(TFT_DARKGREY);
         tft.setTextSize(1);
         tft.setCursor(10, startY + 20);
@@ -612,108 +616,7 @@ void displayRaceResultsFromFile(const String& filename, int startY) {
         return;
     }
     
-    // Parse CSV and build leaderboard
-    // Format: Team ID,Team Name,Lap Number,Timestamp,Duration,Time of Day
-    struct TeamStats {
-        uint8_t teamId;
-        String teamName;
-        uint16_t lapCount;
-        uint32_t bestLapDuration;
-        uint32_t totalDuration;
-    };
-    
-    std::map<uint8_t, TeamStats> teamStats;
-    
-    int lineStart = 0;
-    bool firstLine = true;
-    
-    while (lineStart < content.length()) {
-        int lineEnd = content.indexOf('\n', lineStart);
-        if (lineEnd < 0) lineEnd = content.length();
-        
-        String line = content.substring(lineStart, lineEnd);
-        
-        if (firstLine) {
-            firstLine = false;
-            lineStart = lineEnd + 1;
-            continue;  // Skip header
-        }
-        
-        // Parse CSV line
-        int pos = 0;
-        int commaPos = line.indexOf(',', pos);
-        if (commaPos < 0) {
-            lineStart = lineEnd + 1;
-            continue;
-        }
-        
-        uint8_t teamId = line.substring(pos, commaPos).toInt();
-        
-        pos = commaPos + 1;
-        commaPos = line.indexOf(',', pos);
-        if (commaPos < 0) {
-            lineStart = lineEnd + 1;
-            continue;
-        }
-        String teamName = line.substring(pos, commaPos);
-        
-        pos = commaPos + 1;
-        commaPos = line.indexOf(',', pos);
-        if (commaPos < 0) {
-            lineStart = lineEnd + 1;
-            continue;
-        }
-        uint16_t lapNumber = line.substring(pos, commaPos).toInt();
-        
-        pos = commaPos + 1;
-        commaPos = line.indexOf(',', pos);
-        if (commaPos < 0) {
-            lineStart = lineEnd + 1;
-            continue;
-        }
-        
-        pos = commaPos + 1;
-        commaPos = line.indexOf(',', pos);
-        if (commaPos < 0) {
-            lineStart = lineEnd + 1;
-            continue;
-        }
-        uint32_t duration = line.substring(pos, commaPos).toULong();
-        
-        // Update stats
-        if (teamStats.find(teamId) == teamStats.end()) {
-            TeamStats stats;
-            stats.teamId = teamId;
-            stats.teamName = teamName;
-            stats.lapCount = 0;
-            stats.bestLapDuration = UINT32_MAX;
-            stats.totalDuration = 0;
-            teamStats[teamId] = stats;
-        }
-        
-        TeamStats& stats = teamStats[teamId];
-        stats.lapCount++;
-        stats.totalDuration += duration;
-        if (duration < stats.bestLapDuration) {
-            stats.bestLapDuration = duration;
-        }
-        
-        lineStart = lineEnd + 1;
-    }
-    
-    // Convert to vector and sort
-    std::vector<TeamStats*> leaderboard;
-    for (auto& pair : teamStats) {
-        leaderboard.push_back(&pair.second);
-    }
-    
-    std::sort(leaderboard.begin(), leaderboard.end(), 
-              [](const TeamStats* a, const TeamStats* b) {
-                  if (a->lapCount != b->lapCount) {
-                      return a->lapCount > b->lapCount;
-                  }
-                  return a->bestLapDuration < b->bestLapDuration;
-              });
+    std::vector<const RaceTeamStats*> leaderboard = results.getLeaderboard();
     
     // Display leaderboard
     int y = startY + 5;
@@ -845,6 +748,9 @@ void drawSettingsScreen() {
     tft.setCursor(173, y);
     tft.print(dataLogger.isReady() ? "OK" : "NO");
     
+    // Diagnose (same line)
+    drawButton(SCREEN_WIDTH - 70, y - 5, 60, 18, "Diag", COLOR_BUTTON);
+    
     y += 15;
     
     y += 18;
@@ -865,31 +771,91 @@ void drawSettingsScreen() {
     tft.printf("v%s | RAM: %uK", VERSION, ESP.getFreeHeap() / 1024);
 }
 
+// Eine Zeile: n / p50 / p99 / max in µs
+static void drawHistogramRow(int y, const char* name, const LatencyHistogram& histogram) {
+    tft.setCursor(10, y);
+    tft.printf("%-9s%7lu%8lu%8lu%9lu", name,
+               (unsigned long)histogram.getCount(),
+               (unsigned long)histogram.percentile(50),
+               (unsigned long)histogram.percentile(99),
+               (unsigned long)histogram.getMax());
+}
+
+void drawDiagnosticsScreen() {
+    static const char* screenNames[] = {
+        "Home", "Teams", "TeamEdit", "Assign", "Beacons", "Setup",
+        "Rennen", "Pause", "Ergebn.", "Settings", "Diagnose"
+    };
+    
+    tft.fillScreen(BACKGROUND_COLOR);
+    drawHeader("Diagnose", true);
+    
+    int y = HEADER_HEIGHT + 6;
+    tft.setTextColor(TFT_WHITE);
+    tft.setTextSize(1);
+    tft.setTextDatum(TL_DATUM);
+    
+    // Zähler
+    tft.setCursor(10, y);
+    tft.printf("Adv:%lu Drop:%lu  Runden:%lu Verw:%lu  LogDrop:%lu",
+               (unsigned long)diagnostics.getCounter(DIAG_ADVERTS_RECEIVED),
+               (unsigned long)diagnostics.getCounter(DIAG_ADVERTS_DROPPED),
+               (unsigned long)diagnostics.getCounter(DIAG_LAPS_ACCEPTED),
+               (unsigned long)diagnostics.getCounter(DIAG_LAPS_REJECTED),
+               (unsigned long)diagnostics.getCounter(DIAG_LOGS_DROPPED));
+    y += 14;
+    
+    // Histogramme
+    tft.setTextColor(TFT_LIGHTGREY);
+    tft.setCursor(10, y);
+    tft.print("us             n     p50     p99      max");
+    y += 11;
+    tft.setTextColor(TFT_WHITE);
+    drawHistogramRow(y, "Loop", diagnostics.loopTime);
+    y += 10;
+    drawHistogramRow(y, "Jitter", diagnostics.timerJitter);
+    y += 10;
+    drawHistogramRow(y, "Adv>Lap", diagnostics.advertToLap);
+    y += 10;
+    drawHistogramRow(y, "SD-Write", diagnostics.sdWrite);
+    y += 10;
+    drawHistogramRow(y, "Touch", diagnostics.touchToAction);
+    y += 10;
+    
+    // Zeichenzeit pro Screen (nur bereits gezeichnete)
+    uint8_t screenCount = sizeof(screenNames) / sizeof(screenNames[0]);
+    for (uint8_t screen = 0; screen < screenCount && y < SCREEN_HEIGHT - 50; screen++) {
+        const LatencyHistogram& draw = diagnostics.getDraw(screen);
+        if (draw.getCount() == 0) continue;
+        drawHistogramRow(y, screenNames[screen], draw);
+        y += 10;
+    }
+    
+    // Buttons
+    int btnY = SCREEN_HEIGHT - 40;
+    drawButton(10, btnY, 145, 30, "Reset", COLOR_WARNING);
+    drawButton(165, btnY, 145, 30, "Serial", COLOR_BUTTON);
+}
+
 // ============================================================
 // Helper Functions
 // ============================================================
 
+// Aussehen der v1-UI: blauer Header linksbündig, Buttons ohne Rand,
+// Meldungen bildschirmfüllend
+static const CanvasTheme uiTheme = {
+    SCREEN_WIDTH, SCREEN_HEIGHT, BACKGROUND_COLOR, TEXT_COLOR,
+    HEADER_HEIGHT, COLOR_PRIMARY, TFT_WHITE, 2, false,
+    5, false, 0, TFT_BLACK, 2, 3,
+    false, COLOR_BUTTON
+};
+
 void drawHeader(const String& title, bool showBack) {
-    tft.fillRect(0, 0, SCREEN_WIDTH, HEADER_HEIGHT, COLOR_PRIMARY);
-    tft.setTextColor(TFT_WHITE);
-    tft.setTextSize(2);
-    tft.setCursor(10, 8);
-    tft.print(title);
-    
-    if (showBack) {
-        tft.setCursor(SCREEN_WIDTH - 50, 8);
-        tft.print("[<]");
-    }
+    TftCanvas(tft, uiTheme).header(title.c_str(), showBack);
 }
 
 void drawButton(int x, int y, int w, int h, const String& text, uint16_t color) {
-    tft.fillRoundRect(x, y, w, h, 5, color);
-    tft.setTextColor(TFT_BLACK);
-    
-    // Center text
-    tft.setTextSize(2);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString(text, x + w / 2, y + h / 2);
+    TftCanvas(tft, uiTheme).button(x, y, w, h, text.c_str(), color, 2);
 }
 
 bool isTouchInRect(uint16_t tx, uint16_t ty, int x, int y, int w, int h) {
@@ -897,17 +863,7 @@ bool isTouchInRect(uint16_t tx, uint16_t ty, int x, int y, int w, int h) {
 }
 
 void showMessage(const String& title, const String& message, uint16_t color) {
-    tft.fillScreen(BACKGROUND_COLOR);
-    tft.setTextColor(color);
-    tft.setTextSize(2);
-    
-    tft.setTextDatum(TC_DATUM);  // Top Center
-    tft.drawString(title, SCREEN_WIDTH / 2, 80);
-    
-    tft.setTextSize(1);
-    tft.setTextColor(TFT_WHITE);
-    tft.setTextDatum(TC_DATUM);
-    tft.drawString(message, SCREEN_WIDTH / 2, 120);
+    TftCanvas(tft, uiTheme).message(title.c_str(), message.c_str(), color, 2, 1);
     
     delay(2000);
     uiState.needsRedraw = true;
@@ -31,7 +31,8 @@ enum Screen {
     SCREEN_RACE_RUNNING,
     SCREEN_RACE_PAUSED,
     SCREEN_RACE_RESULTS,
-    SCREEN_SETTINGS
+    SCREEN_SETTINGS,
+    SCREEN_DIAGNOSTICS
 };
 
 // UI State
@@ -57,12 +58,11 @@ struct UIState {
     uint16_t touchX;
     uint16_t touchY;
     bool touched;
-    uint32_t lastTouchTime;
     
     UIState() : currentScreen(SCREEN_HOME), previousScreen(SCREEN_HOME),
                 needsRedraw(true), editingTeamId(0), editingTeamName(""),
                 scrollOffset(0), raceName("Rennen"), raceDuration(60),
-                touchX(0), touchY(0), touched(false), lastTouchTime(0),
+                touchX(0), touchY(0), touched(false),
                 resultsPage(0) {
         memset(selectedTeams, false, sizeof(selectedTeams));
     }
@@ -81,6 +81,7 @@ void drawRaceRunningScreen();
 void drawRacePausedScreen();
 void drawRaceResultsScreen();
 void drawSettingsScreen();
+void drawDiagnosticsScreen();
 void displayRaceResultsFromFile(const String& filename, int startY);
 
 // Touch Handler
@@ -95,6 +96,7 @@ void handleRaceRunningTouch(uint16_t x, uint16_t y);
 void handleRacePausedTouch(uint16_t x, uint16_t y);
 void handleRaceResultsTouch(uint16_t x, uint16_t y);
 void handleSettingsTouch(uint16_t x, uint16_t y);
+void handleDiagnosticsTouch(uint16_t x, uint16_t y);
 
 // Helper Functions
 void drawHeader(const String& title, bool showBack = false);
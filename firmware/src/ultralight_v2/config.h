@@ -28,7 +28,7 @@
 
 // XPT2046 Touch Controller (Resistive)
 #define TOUCH_CS_PIN      33
-#define TOUCH_IRQ_PIN     36   // Optional
+#define TOUCH_IRQ_PIN     36   // PENIRQ, weckt den Touch-Task (-1 = Task fragt ab)
 #define TOUCH_MOSI_PIN    32   // Separate SPI bus for Touch
 #define TOUCH_MISO_PIN    39
 #define TOUCH_CLK_PIN     25
@@ -54,12 +54,11 @@
 #define MAX_RSSI -30
 
 // Touch
-#define TOUCH_DEBOUNCE    200
 #define TOUCH_CALIBRATION_MODE  0  // Set to 1 to enable calibration on startup
 
-// Touch Calibration Data (from calibrateTouch() - update after calibration)
+// Touch Calibration Data: Default, solange keine Kalibrierung in NVS liegt
+// (Settings -> Kalibrieren speichert die Matrix, siehe TouchFilter)
 // Format: { x_min, y_min, x_min, y_max, x_max, y_min, x_max, y_max }
-// Calibrated values (update this after running calibration):
 #define TOUCH_CAL_DATA_ENABLED  1  // Set to 1 to use calibration data
 #if TOUCH_CAL_DATA_ENABLED
 static const uint16_t TOUCH_CAL_DATA[8] = { 3754, 241, 3757, 3700, 448, 257, 423, 3663 };
@@ -69,7 +68,7 @@ static const uint16_t* TOUCH_CAL_DATA = nullptr;
 
 // Race Settings
 #define MIN_LAP_TIME      10000
-#define MAX_TEAMS         20
+#define MAX_TEAMS         64        // Listen scrollen, Rangliste blättert
 #define MAX_RACE_DURATION 7200000
 
 // UI - Größere Elemente für bessere Bedienbarkeit
@@ -80,6 +79,18 @@ static const uint16_t* TOUCH_CAL_DATA = nullptr;
 #define TEXT_SIZE_NORMAL  2         // Standard Text-Größe
 #define TEXT_SIZE_LARGE   3         // Große Überschriften
 
+// Race-Screen Sprites (DMA-fähiges internes RAM, NimBLE braucht den Rest)
+#define RACE_SPRITE_BUDGET       32768   // 2 Zeilen je 9.7 KB + Glyphen-Atlas Uhr 8.4 KB / Runden 4.1 KB
+#define RACE_SPRITE_HEAP_RESERVE 40960   // Mindestens so viel bleibt frei
+
+// Rangliste im Rennen: 3 Teams pro Seite, blättert automatisch weiter
+#define RACE_PAGE_INTERVAL 5000    // ms pro Seite
+#define RACE_PAGE_HOLD     15000   // ms Pause nach Wischen von Hand
+
+// Scroll-Listen (Teams, Beacons, Ergebnisse): sichtbare Zeilen in Streifen-Sprites
+#define LIST_BAND_HEIGHT   16      // 2 Streifen je 306 x 16 x 2 B = 19.6 KB, wie Race-Sprites reserviert
+#define LIST_FRAME_INTERVAL 33     // ms pro Frame beim Ausrollen (30 fps)
+
 // Colors (RGB565) - Helles Design für bessere Lesbarkeit draußen
 #define COLOR_PRIMARY     0x001F     // Dark Blue (dunkler auf hellem Hintergrund)
 #define COLOR_SECONDARY   0x07E0     // Green
@@ -2,6 +2,7 @@
 
 DisplayManager::DisplayManager() 
     : _initialized(false)
+    , _asyncOpen(false)
 {
 }
 
@@ -28,6 +29,29 @@ bool DisplayManager::begin() {
     Serial.println("[Display] No touch calibration data - using defaults");
     #endif
     
+    // Default-Matrix für TouchFilter: LovyanGFX rechnet Rohpunkte mit
+    // TOUCH_CAL_DATA und Rotation um, die affine Abbildung folgt daraus.
+    // Eine gespeicherte Kalibrierung ersetzt sie (setTouchCalibration).
+    const uint16_t rawPoints[TOUCH_CAL_POINTS][2] = {
+        {1000, 1000}, {3000, 1000}, {1000, 3000}, {3000, 3000}
+    };
+    TouchCalPoint points[TOUCH_CAL_POINTS];
+    for (uint8_t i = 0; i < TOUCH_CAL_POINTS; i++) {
+        lgfx::touch_point_t tp;
+        tp.x = rawPoints[i][0];
+        tp.y = rawPoints[i][1];
+        _display.convertRawXY(&tp, 1);
+        points[i].rawX = rawPoints[i][0];
+        points[i].rawY = rawPoints[i][1];
+        points[i].x = tp.x;
+        points[i].y = tp.y;
+    }
+    TouchCalibration calibration;
+    if (calibration.compute(points, TOUCH_CAL_POINTS)) {
+        _touchFilter.setCalibration(calibration);
+    }
+    _touchFilter.setScreenSize(SCREEN_WIDTH, SCREEN_HEIGHT);
+    
     // Fill screen with background color
     _display.fillScreen(BACKGROUND_COLOR);
     
@@ -36,43 +60,80 @@ bool DisplayManager::begin() {
     return true;
 }
 
+void DisplayManager::beginAsync() {
+    finishAsync();
+    _display.startWrite();
+    _asyncOpen = true;
+}
+
+void DisplayManager::pushSpriteAsync(LGFX_Sprite& sprite, int32_t x, int32_t y) {
+    pushSpriteRowsAsync(sprite, 0, sprite.height(), x, y);
+}
+
+void DisplayManager::pushSpriteRowsAsync(LGFX_Sprite& sprite, int32_t row, int32_t rows,
+                                         int32_t x, int32_t y) {
+    // Zeilen liegen im Sprite-Puffer hintereinander, ein Ausschnitt ist also
+    // ein zusammenhängender Block. Wartet nur auf einen noch laufenden
+    // Transfer, nicht auf diesen.
+    const lgfx::swap565_t* pixels = (const lgfx::swap565_t*)sprite.getBuffer() + row * sprite.width();
+    _display.pushImageDMA(x, y, sprite.width(), rows, pixels);
+}
+
+void DisplayManager::finishAsync() {
+    if (_asyncOpen) {
+        _display.endWrite();  // Wartet auf den letzten DMA-Transfer
+        _asyncOpen = false;
+    }
+}
+
 bool DisplayManager::getTouch(uint16_t* x, uint16_t* y) {
     if (!_initialized) return false;
     
-    // LovyanGFX getTouch() returns calibrated coordinates
-    // On this hardware, we need to transform coordinates to match screen layout
-    uint16_t rawX, rawY;
-    if (_display.getTouch(&rawX, &rawY)) {
-        // Debug: Print raw coordinates
-        // Serial.printf("[Touch Raw] rawX=%u, rawY=%u\n", rawX, rawY);
-        
-        // Based on user feedback: y=18 when touching top means rawY is already correct
-        // BUT we need to check: If user touches top and gets y=18, that's wrong!
-        // Top should be y=0 or close to it. y=18 means we're 18px from bottom after inversion.
-        // So rawY must have been ~222 (240-18=222), which is bottom.
-        
-        // Let's try: NO inversion first, just use raw coordinates
-        // If that doesn't work, we'll try swapping and/or inverting
-        
-        // Current assumption: raw coordinates from LovyanGFX are already in screen space
-        // But might need adjustment for hardware orientation
-        *x = rawX;
-        *y = rawY;
-        
-        // Clamp to screen bounds
-        *x = constrain(*x, 0, SCREEN_WIDTH - 1);
-        *y = constrain(*y, 0, SCREEN_HEIGHT - 1);
-        
-        return true;
-    }
-    
-    return false;
+    TouchSample samples[TOUCH_FILTER_SAMPLES];
+    readTouchSamples(samples, TOUCH_FILTER_SAMPLES);
+    return _touchFilter.process(samples, TOUCH_FILTER_SAMPLES, x, y);
 }
 
 bool DisplayManager::isTouched() {
     if (!_initialized) return false;
-    uint16_t x, y;
-    return _display.getTouch(&x, &y);
+    TouchSample sample;
+    readTouchSamples(&sample, 1);
+    return sample.z >= TOUCH_PRESSURE_MIN;
+}
+
+void DisplayManager::readTouchSamples(TouchSample* samples, uint8_t count) {
+    // LovyanGFX liest den XPT2046 ohne Kalibrierung/Rotation, size trägt
+    // den Druck. Keine Berührung = z 0, das Druck-Gate sortiert aus.
+    for (uint8_t i = 0; i < count; i++) {
+        lgfx::touch_point_t tp;
+        if (_display.getTouchRaw(&tp, 1)) {
+            samples[i].x = tp.x;
+            samples[i].y = tp.y;
+            samples[i].z = tp.size;
+        } else {
+            samples[i].x = 0;
+            samples[i].y = 0;
+            samples[i].z = 0;
+        }
+    }
+}
+
+bool DisplayManager::getTouchRaw(uint16_t* rawX, uint16_t* rawY) {
+    TouchSample samples[TOUCH_FILTER_SAMPLES];
+    readTouchSamples(samples, TOUCH_FILTER_SAMPLES);
+    return _touchFilter.filterRaw(samples, TOUCH_FILTER_SAMPLES, *rawX, *rawY);
+}
+
+void DisplayManager::setTouchCalibration(const TouchMatrix& matrix) {
+    TouchCalibration calibration;
+    calibration.setMatrix(matrix);
+    _touchFilter.setCalibration(calibration);
+}
+
+void DisplayManager::drawCrosshair(int16_t x, int16_t y, uint16_t color) {
+    _display.drawFastHLine(x - 10, y, 21, color);
+    _display.drawFastVLine(x, y - 10, 21, color);
+    _display.drawCircle(x, y, 4, color);
 }
 
 bool DisplayManager::calibrateTouch() {
@@ -85,10 +146,6 @@ bool DisplayManager::calibrateTouch() {
     Serial.println("when it appears on screen.");
     Serial.println("=================================\n");
     
-    // LovyanGFX calibrate_touch function
-    // Parameters: calibration array (output), foreground color, background color, crosshair size
-    uint16_t calData[8];
-    
     _display.fillScreen(BACKGROUND_COLOR);
     _display.setTextColor(TEXT_COLOR);
     _display.setTextSize(2);
@@ -100,42 +157,39 @@ bool DisplayManager::calibrateTouch() {
     
     delay(2000);
     
-    // Run calibration (this will show crosshairs at corners)
-    // Use the public template method calibrateTouch() which accepts RGB565 colors
-    // It automatically converts colors internally using _write_conv.convert()
-    // Template signature: calibrateTouch(uint16_t *parameters, const T& color_fg, const T& color_bg, uint8_t size = 10)
-    _display.calibrateTouch(calData, TEXT_COLOR, BACKGROUND_COLOR, 15);
-    
-    // Print calibration data
-    Serial.println("\n=== TOUCH CALIBRATION DATA ===");
-    Serial.print("uint16_t calData[8] = { ");
-    for (int i = 0; i < 8; i++) {
-        Serial.print(calData[i]);
-        if (i < 7) Serial.print(", ");
+    // Fadenkreuz halten, bis genug ruhige Rohwerte gemittelt sind
+    TouchCalPoint points[TOUCH_CAL_POINTS];
+    TouchCalibration::targets(SCREEN_WIDTH, SCREEN_HEIGHT, points);
+    bool captured = true;
+    for (uint8_t i = 0; i < TOUCH_CAL_POINTS && captured; i++) {
+        _display.fillScreen(BACKGROUND_COLOR);
+        drawCrosshair(points[i].x, points[i].y, TEXT_COLOR);
+        captured = TouchCalibration::capture([this](uint16_t* rawX, uint16_t* rawY) {
+            return getTouchRaw(rawX, rawY);
+        }, points[i]);
+        Serial.printf("[Touch] Point %u: screen=(%d, %d) raw=(%u, %u)\n",
+                      i + 1, points[i].x, points[i].y, points[i].rawX, points[i].rawY);
     }
-    Serial.println(" };");
-    Serial.println("=================================\n");
     
-    // Save calibration to display (LovyanGFX uses setTouchCalibrate for uint16_t array)
-    _display.setTouchCalibrate(calData);
+    TouchCalibration calibration;
+    bool valid = captured && calibration.compute(points, TOUCH_CAL_POINTS);
+    if (valid) {
+        _touchFilter.setCalibration(calibration);
+    }
     
-    // Show success message
+    // Show result
     _display.fillScreen(BACKGROUND_COLOR);
-    _display.setTextColor(COLOR_SECONDARY);
+    _display.setTextColor(valid ? COLOR_SECONDARY : COLOR_DANGER);
     _display.setTextSize(2);
     _display.setTextDatum(MC_DATUM);
     _display.drawString("Calibration", SCREEN_WIDTH / 2, 100);
-    _display.drawString("Complete!", SCREEN_WIDTH / 2, 125);
-    _display.setTextSize(1);
-    _display.setTextColor(TEXT_COLOR);
-    _display.drawString("Check Serial Monitor", SCREEN_WIDTH / 2, 160);
-    _display.drawString("for calibration data", SCREEN_WIDTH / 2, 175);
+    _display.drawString(valid ? "Complete!" : "Failed!", SCREEN_WIDTH / 2, 125);
     
-    delay(3000);
+    delay(valid ? 1500 : 3000);
     _display.fillScreen(BACKGROUND_COLOR);
     
-    Serial.println("[Touch] Calibration complete!");
-    return true;
+    Serial.println(valid ? "[Touch] Calibration complete!" : "[Touch] Calibration failed - keeping previous");
+    return valid;
 }
 
 void DisplayManager::fillScreen(uint16_t color) {
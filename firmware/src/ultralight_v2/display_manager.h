@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include "LGFX_Config.hpp"  // Must be included before using LGFX
 #include "config.h"
+#include "TouchFilter.h"
 
 // LovyanGFX Display Manager for ESP32-2432S028
 // Uses ST7789 driver with XPT2046 touch
@@ -19,10 +20,23 @@ public:
     // Display functions
     LGFX& getDisplay() { return _display; }
     
+    // Asynchrone DMA-Transfers: pushSpriteAsync() kehrt sofort zurück,
+    // finishAsync() wartet auf den letzten Transfer und gibt den SPI-Bus
+    // frei (die SD-Karte hängt am selben Host)
+    void beginAsync();
+    void pushSpriteAsync(LGFX_Sprite& sprite, int32_t x, int32_t y);
+    // Nur die Zeilen [row, row + rows) des Sprites, z.B. eine Glyphe aus einem Atlas
+    void pushSpriteRowsAsync(LGFX_Sprite& sprite, int32_t row, int32_t rows, int32_t x, int32_t y);
+    void finishAsync();
+    
     // Touch functions
+    // Mehrere Rohabtastungen pro Aufruf, gefiltert (TouchFilter)
     bool getTouch(uint16_t* x, uint16_t* y);
     bool isTouched();
+    // Fadenkreuze an den Ecken, Ergebnis über getTouchCalibration() speichern
     bool calibrateTouch();
+    void setTouchCalibration(const TouchMatrix& matrix);
+    const TouchMatrix& getTouchCalibration() const { return _touchFilter.getCalibration().getMatrix(); }
     
     // Utility
     void fillScreen(uint16_t color);
@@ -35,7 +49,13 @@ public:
     
 private:
     LGFX _display;
+    TouchFilter _touchFilter;
     bool _initialized;
+    bool _asyncOpen;
+    
+    void readTouchSamples(TouchSample* samples, uint8_t count);
+    bool getTouchRaw(uint16_t* rawX, uint16_t* rawY);
+    void drawCrosshair(int16_t x, int16_t y, uint16_t color);
 };
 
 #endif // DISPLAY_MANAGER_H
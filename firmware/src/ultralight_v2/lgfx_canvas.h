@@ -0,0 +1,46 @@
+#ifndef LGFX_CANVAS_H
+#define LGFX_CANVAS_H
+
+#ifndef LGFX_USE_V1
+#define LGFX_USE_V1
+#endif
+#include <LovyanGFX.hpp>
+#include "Canvas.h"
+
+// Canvas-Backend für LovyanGFX: Display, LGFX_Sprite und den Host-Shim
+// (alle leiten von lgfx::LGFXBase ab). Nur Weiterleitungen, die der
+// Compiler in die Canvas-Elemente inlinet.
+class LgfxCanvas : public Canvas<LgfxCanvas> {
+public:
+    LgfxCanvas(lgfx::LGFXBase& gfx, const CanvasTheme& theme)
+        : Canvas<LgfxCanvas>(theme), gfx(gfx) {}
+
+    int32_t width() const { return gfx.width(); }
+    int32_t height() const { return gfx.height(); }
+
+    void fillScreen(uint16_t color) { gfx.fillScreen(color); }
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) { gfx.fillRect(x, y, w, h, color); }
+    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) { gfx.drawRect(x, y, w, h, color); }
+    void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) { gfx.fillRoundRect(x, y, w, h, r, color); }
+    void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint16_t color) { gfx.drawRoundRect(x, y, w, h, r, color); }
+    void fillCircle(int32_t x, int32_t y, int32_t r, uint16_t color) { gfx.fillCircle(x, y, r, color); }
+    void drawCircle(int32_t x, int32_t y, int32_t r, uint16_t color) { gfx.drawCircle(x, y, r, color); }
+    void drawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t color) { gfx.drawFastHLine(x, y, w, color); }
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint16_t color) { gfx.drawFastVLine(x, y, h, color); }
+
+    void setTextColor(uint16_t color) { gfx.setTextColor(color); }
+    void setTextColor(uint16_t color, uint16_t background) { gfx.setTextColor(color, background); }
+    void setTextSize(uint8_t size) { gfx.setTextSize(size); }
+    void setTextDatum(CanvasDatum datum) {
+        static const uint8_t datums[] = {TL_DATUM, TC_DATUM, TR_DATUM, ML_DATUM, MC_DATUM, MR_DATUM};
+        gfx.setTextDatum(datums[datum]);
+    }
+    int32_t textWidth(const char* text) { return gfx.textWidth(text); }
+    int32_t fontHeight() { return gfx.fontHeight(); }
+    void drawString(const char* text, int32_t x, int32_t y) { gfx.drawString(text, x, y); }
+
+private:
+    lgfx::LGFXBase& gfx;
+};
+
+#endif // LGFX_CANVAS_H
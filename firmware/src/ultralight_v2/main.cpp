@@ -7,8 +7,11 @@
 #include "../../lib/BLEScanner/BLEScanner.h"
 #include "../../lib/LapCounter/LapCounter.h"
 #include "../../lib/DataLogger/DataLogger.h"
+#include "../../lib/LapPipeline/LapPipeline.h"
+#include "../../lib/EventLoop/EventLoop.h"
+#include "../../lib/Diagnostics/Diagnostics.h"
+#include "../../lib/TouchInput/TouchInput.h"
 #include "../ultralight/persistence.h"
-#include <map>
 
 // Disable ESP-IDF logging for NimBLE completely
 #include "esp_log.h"
@@ -23,6 +26,10 @@ BLEScanner bleScanner;
 LapCounter lapCounter;
 DataLogger dataLogger;
 PersistenceManager persistence;
+LapPipeline lapPipeline(lapCounter, dataLogger);
+EventLoop eventLoop;
+TouchInput touchInput;
+int listScrollTimer = -1;
 
 // Global state
 bool raceRunning = false;
@@ -31,51 +38,25 @@ uint32_t raceDuration = 60000;  // 1 minute default (will be loaded from persist
 String currentRaceName = "Test Race";
 int8_t lapRssiNear = DEFAULT_LAP_RSSI_NEAR;
 int8_t lapRssiFar = DEFAULT_LAP_RSSI_FAR;
-std::map<uint8_t, bool> beaconPresence;
 
-// BLE Callback for lap detection
+// BLE Callback (NimBLE-Task): nur einreihen, Rundenerkennung im Lap-Task
 void onBeaconDetected(const BeaconData& beacon) {
     // Only count laps during race
     if (!raceRunning) {
+        eventLoop.post(EVENT_SCANNER);
         return;
     }
     
-    // Check if beacon belongs to a team (by MAC address)
-    TeamData* team = lapCounter.getTeamByBeacon(beacon.macAddress);
-    
-    if (!team) {
-        // Unknown beacon - silent
-        return;
-    }
+    lapPipeline.ingest(beacon);
+}
+
+// Lap-Task: Runde gezählt (SD-Log übernimmt der Logger-Task)
+void onLapCounted(const LapEvent& lap) {
+    Serial.printf("[Lap] ✅ Team %u (%s): Lap %u (%lu us)\n",
+                 lap.teamId, lap.teamName, lap.lapCount, lap.latencyUs);
     
-    // RSSI-based presence detection with hysteresis
-    if (beacon.rssi > lapRssiNear) {
-        // Beacon is NEAR (strong signal)
-        if (!beaconPresence[team->teamId]) {
-            // Was away, now near → count lap!
-            if (lapCounter.recordLap(team->teamId, beacon.lastSeen)) {
-                Serial.printf("[Lap] ✅ Team %u (%s): Lap %u\n",
-                             team->teamId, team->teamName.c_str(), team->lapCount);
-                
-                // Log to SD
-                if (dataLogger.isReady() && !team->laps.empty()) {
-                    LapTime& lap = team->laps.back();
-                    dataLogger.logLap(team->teamId, team->teamName, 
-                                     lap.lapNumber, lap.timestamp, lap.duration);
-                }
-                
-                // Update screen
-                uiState.needsRedraw = true;
-            }
-            
-            beaconPresence[team->teamId] = true;
-        }
-    } else if (beacon.rssi < lapRssiFar) {
-        // Beacon is AWAY (weak signal)
-        if (beaconPresence[team->teamId]) {
-            beaconPresence[team->teamId] = false;
-        }
-    }
+    // Update screen (weckt loop())
+    eventLoop.post(EVENT_LAP);
 }
 
 // ============================================================
@@ -134,6 +115,13 @@ void initPersistence() {
     persistence.loadRssiThresholds(rssiNear, rssiFar);
     lapRssiNear = rssiNear;
     lapRssiFar = rssiFar;
+    lapPipeline.setRssiThresholds(lapRssiNear, lapRssiFar);
+    
+    // Touch-Kalibrierung, sonst bleibt der Default aus TOUCH_CAL_DATA
+    TouchMatrix touchMatrix;
+    if (persistence.loadTouchCalibration(touchMatrix)) {
+        display.setTouchCalibration(touchMatrix);
+    }
     
     Serial.printf("[Persistence] Loaded %u teams\n", lapCounter.getTeamCount());
 }
@@ -142,6 +130,10 @@ void initPersistence() {
 // Setup & Loop
 // ============================================================
 
+// Forward declarations
+void initEvents();
+void drawScreen();
+
 void setup() {
     Serial.begin(115200);
     delay(1000);
@@ -203,64 +195,64 @@ void setup() {
     display.setCursor(10, 120);
     display.println("Persistence: OK");
     
+    // 5. Lap/Logger Tasks (Core 0: Rundenerkennung, Core 1: SD)
+    lapPipeline.onLap(onLapCounted);
+    lapPipeline.begin();
+    
     Serial.println("\nSetup complete!");
     delay(2000);
     
     // Touch calibration (if enabled)
     #if TOUCH_CALIBRATION_MODE
     Serial.println("\n[Init] Starting touch calibration...");
-    display.calibrateTouch();
+    if (display.calibrateTouch()) {
+        persistence.saveTouchCalibration(display.getTouchCalibration());
+    }
     #endif
     
     // Initialize UI state and show home screen
     uiState.changeScreen(SCREEN_HOME);
+    
+    initEvents();
 }
 
-// Forward declaration
-void drawScreen();
 
 void loop() {
-    // Touch handling
-    uint16_t x, y;
-    if (display.getTouch(&x, &y)) {
-        // Debounce
-        if (millis() - uiState.lastTouchTime < TOUCH_DEBOUNCE) {
-            delay(10);
-            return;
+    // Schläft bis zum nächsten Timer oder Event (kein delay() mehr)
+    eventLoop.setScreen(uiState.currentScreen);
+    eventLoop.runOnce();
+}
+
+// ============================================================
+// Event Handlers
+// ============================================================
+
+// Touch-Task hat Events eingereiht: alle abarbeiten. Buttons reagieren aufs
+// Drücken, Listen folgen dem Finger; gezeichnet wird einmal danach
+void onTouch(const Event&) {
+    TouchEvent touch;
+    while (touchInput.receive(touch)) {
+        {
+            RtosLock lock(lapPipeline.stateMutex());
+            handleTouch(touch);
         }
-        uiState.lastTouchTime = millis();
-        
-        Serial.printf("[Touch] x=%u, y=%u, Screen=%d\n", x, y, uiState.currentScreen);
-        
-        // Debug: Show which buttons would be hit on HOME screen
-        if (uiState.currentScreen == SCREEN_HOME) {
-            int btnHeight = 42;
-            int btnSpacing = 8;
-            int btnY = HEADER_HEIGHT + 10;
-            int btnWidth = SCREEN_WIDTH - 2 * BUTTON_MARGIN;
-            Serial.printf("  -> Button Y ranges: B1=%d-%d, B2=%d-%d, B3=%d-%d, B4=%d-%d\n",
-                         btnY, btnY+btnHeight,
-                         btnY+btnHeight+btnSpacing, btnY+2*btnHeight+btnSpacing,
-                         btnY+2*(btnHeight+btnSpacing), btnY+3*btnHeight+2*btnSpacing,
-                         btnY+3*(btnHeight+btnSpacing), btnY+4*btnHeight+3*btnSpacing);
-            Serial.printf("  -> Touch Y=%u is ", y);
-            if (y >= btnY && y < btnY + btnHeight) Serial.println("in Button 1 (Neues Rennen)");
-            else if (y >= btnY + btnHeight + btnSpacing && y < btnY + 2*btnHeight + btnSpacing) Serial.println("in Button 2 (Teams)");
-            else if (y >= btnY + 2*(btnHeight+btnSpacing) && y < btnY + 3*btnHeight + 2*btnSpacing) Serial.println("in Button 3 (Ergebnisse)");
-            else if (y >= btnY + 3*(btnHeight+btnSpacing) && y < btnY + 4*btnHeight + 3*btnSpacing) Serial.println("in Button 4 (Einstellungen)");
-            else Serial.println("NOT in any button!");
+        lapPipeline.finishRequestedRace();
+        if (touch.type != TOUCH_PRESS) {
+            continue;
         }
+        diagnostics.touchToAction.record((uint32_t)(rtosMicros() - touch.downUs));
         
-        handleTouch(x, y);
+        Serial.printf("[Touch] x=%u, y=%u, Screen=%d\n", touch.x, touch.y, uiState.currentScreen);
     }
     
-    // Screen redraw if needed
-    if (uiState.needsRedraw) {
-        drawScreen();
-        uiState.needsRedraw = false;
+    // Losgelassen mit Schwung: Liste rollt aus
+    if (isListScrolling()) {
+        eventLoop.setTimerEnabled(listScrollTimer, true);
     }
-    
-    // BLE scanning - start continuous scan if not already scanning (only when needed)
+}
+
+// BLE scanning - start continuous scan if not already scanning (only when needed)
+void updateScanning() {
     if (!raceRunning && !bleScanner.isScanning()) {
         // Only scan when in beacon assignment or race setup
         if (uiState.currentScreen == SCREEN_TEAM_BEACON_ASSIGN || 
@@ -277,66 +269,94 @@ void loop() {
         esp_log_level_set("NimBLEScan", ESP_LOG_NONE);
         bleScanner.startScan(0);
     }
+}
+
+// Nach jeder Scheduler-Runde: Screen-Wechsel und Redraw
+void updateScreen() {
+    eventLoop.setScreen(uiState.currentScreen);
+    updateScanning();
     
-    // Periodically re-disable logging (NimBLE might reset it)
-    static uint32_t lastLogDisable = 0;
-    if (millis() - lastLogDisable > 5000) {  // Every 5 seconds
-        esp_log_level_set("*", ESP_LOG_NONE);
-        esp_log_level_set("NimBLEScan", ESP_LOG_NONE);
-        esp_log_level_set("NimBLE", ESP_LOG_NONE);
-        lastLogDisable = millis();
+    if (uiState.needsRedraw) {
+        uiState.needsRedraw = false;
+        drawScreen();
     }
-    
-    // Clean up old beacons (only every second to reduce overhead)
-    static uint32_t lastBeaconCleanup = 0;
-    if (millis() - lastBeaconCleanup > 1000) {
-        bleScanner.clearOldBeacons(BEACON_TIMEOUT);
-        lastBeaconCleanup = millis();
+}
+
+void startTouchInput() {
+    touchInput.begin([](uint16_t* x, uint16_t* y) {
+        return display.getTouch(x, y);
+    }, TOUCH_IRQ_PIN);
+}
+
+// Settings -> Kalibrieren: der Touch-Task darf nicht mitlesen, die
+// Fadenkreuz-Drücke landen sonst danach als Taps im Settings-Screen
+void recalibrateTouch() {
+    touchInput.end();
+    if (display.calibrateTouch()) {
+        persistence.saveTouchCalibration(display.getTouchCalibration());
     }
+    startTouchInput();
+}
+
+void initEvents() {
+    eventLoop.on(EVENT_TOUCH, "touch", onTouch);
+    eventLoop.on(EVENT_LAP, "lap", [](const Event&) {
+        uiState.needsRedraw = true;
+    });
     
-    // Update race running screen if active
-    if (raceRunning && uiState.currentScreen == SCREEN_RACE_RUNNING) {
-        static uint32_t lastRaceUpdate = 0;
-        if (millis() - lastRaceUpdate > 500) {  // Update every 500ms
-            drawRaceRunningScreen();
-            lastRaceUpdate = millis();
+    // Touch: IRQ weckt den Touch-Task, kein SPI-Zugriff im Leerlauf.
+    // Display (VSPI) und Touch (HSPI) haben eigene Busse, kein Lock nötig.
+    touchInput.onEvent([]() {
+        eventLoop.post(EVENT_TOUCH);
+    });
+    startTouchInput();
+    
+    // Ausrollen/Einrasten der Scroll-Listen, nur solange sich eine bewegt
+    listScrollTimer = eventLoop.addTimer("listScroll", LIST_FRAME_INTERVAL, []() {
+        if (!stepListScroll(rtosMicros())) {
+            eventLoop.setTimerEnabled(listScrollTimer, false);
         }
-    }
+    });
+    eventLoop.setTimerEnabled(listScrollTimer, false);
+    
+    // Race running screen: Uhr/Rangliste
+    eventLoop.addTimer("raceClock", 500, []() {
+        if (raceRunning) {
+            drawScreen();
+        }
+    }, EVENT_SCREEN(SCREEN_RACE_RUNNING));
     
-    delay(10);
+    // Diagnose-Screen aktualisieren
+    eventLoop.addTimer("diagRefresh", 1000, []() {
+        uiState.needsRedraw = true;
+    }, EVENT_SCREEN(SCREEN_DIAGNOSTICS));
+    
+    // Clean up old beacons
+    eventLoop.addTimer("beaconExpiry", 1000, []() {
+        bleScanner.clearOldBeacons(BEACON_TIMEOUT);
+    });
+    
+    // Periodically re-disable logging (NimBLE might reset it)
+    eventLoop.addTimer("logSilence", 5000, []() {
+        esp_log_level_set("*", ESP_LOG_NONE);
+        esp_log_level_set("NimBLEScan", ESP_LOG_NONE);
+        esp_log_level_set("NimBLE", ESP_LOG_NONE);
+    });
+    
+    eventLoop.afterDispatch("redraw", updateScreen);
 }
 
+// Zeichnet den aktuellen Screen und misst die Zeichenzeit
 void drawScreen() {
-    switch (uiState.currentScreen) {
-        case SCREEN_HOME:
-            drawHomeScreen();
-            break;
-        case SCREEN_TEAMS:
-            drawTeamsScreen();
-            break;
-        case SCREEN_TEAM_EDIT:
-            drawTeamEditScreen();
-            break;
-        case SCREEN_TEAM_BEACON_ASSIGN:
-            drawTeamBeaconAssignScreen();
-            break;
-        case SCREEN_BEACON_LIST:
-            drawBeaconListScreen();
-            break;
-        case SCREEN_RACE_SETUP:
-            drawRaceSetupScreen();
-            break;
-        case SCREEN_RACE_RUNNING:
-            drawRaceRunningScreen();
-            break;
-        case SCREEN_RACE_PAUSED:
-            drawRacePausedScreen();
-            break;
-        case SCREEN_RACE_RESULTS:
-            drawRaceResultsScreen();
-            break;
-        case SCREEN_SETTINGS:
-            drawSettingsScreen();
-            break;
+    uint8_t screen = uiState.currentScreen;
+    uint64_t start = rtosMicros();
+    
+    // Race-Sprites nur auf dem Race-Screen belegen
+    if (screen != SCREEN_RACE_RUNNING) {
+        releaseRaceSprites();
     }
+    
+    drawScreenContent();
+    
+    diagnostics.recordDraw(screen, (uint32_t)(rtosMicros() - start));
 }
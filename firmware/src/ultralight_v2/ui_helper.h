@@ -4,15 +4,17 @@
 #include <Arduino.h>
 #include "display_manager.h"
 #include "config.h"
+#include "../../lib/WidgetTree/WidgetTree.h"
 
 // Forward declarations
 extern DisplayManager display;
 
 // Helper Functions
-void drawHeader(const String& title, bool showBack);
-void drawButton(int x, int y, int w, int h, const String& text, uint16_t color);
-bool isTouchInRect(uint16_t tx, uint16_t ty, int x, int y, int w, int h);
+void drawHeader(const String& title);
+void drawButton(int x, int y, int w, int h, const String& text, uint16_t color,
+                uint8_t textSize = TEXT_SIZE_NORMAL);
+void drawWidget(const Widget& widget);
+void drawListItem(lgfx::LGFXBase& canvas, const Widget& widget);
 void showMessage(const String& title, const String& message, uint16_t color);
 
 #endif // UI_HELPER_H
-
@@ -1,8 +1,13 @@
 #include "ui_screens.h"
 #include "ui_helper.h"
 #include "../../lib/DataLogger/DataLogger.h"
+#include "../../lib/LapPipeline/LapPipeline.h"
+#include "../../lib/Diagnostics/Diagnostics.h"
+#include "../../lib/WidgetTree/WidgetTree.h"
+#include "../../lib/ScrollList/ScrollList.h"
 #include "../ultralight/persistence.h"
 #include <algorithm>
+#include <esp_heap_caps.h>
 
 // Forward declarations
 extern DataLogger dataLogger;
@@ -11,1089 +16,1459 @@ extern bool raceRunning;
 extern uint32_t raceStartTime;
 extern uint32_t raceDuration;
 extern String currentRaceName;
-extern std::map<uint8_t, bool> beaconPresence;
+extern LapPipeline lapPipeline;
 
 // ============================================================
-// Screen Drawing
+// Scroll-Liste des aktuellen Screens
 // ============================================================
 
-void drawHomeScreen() {
-    LGFX& lcd = display.getDisplay();
-    lcd.fillScreen(BACKGROUND_COLOR);
-    drawHeader(DEVICE_NAME, false);
-    
-    // Reduced button height to fit all 4 buttons on screen
-    int btnHeight = 42;  // Slightly smaller to fit all buttons
-    int btnSpacing = 8;  // Reduced spacing
-    int y = HEADER_HEIGHT + 10;
-    int btnWidth = SCREEN_WIDTH - 2 * BUTTON_MARGIN;
-    
-    // Button: Neues Rennen
-    drawButton(BUTTON_MARGIN, y, btnWidth, btnHeight, "Neues Rennen", COLOR_SECONDARY);
-    y += btnHeight + btnSpacing;
-    
-    // Button: Teams verwalten
-    drawButton(BUTTON_MARGIN, y, btnWidth, btnHeight, "Teams verwalten", COLOR_BUTTON);
-    y += btnHeight + btnSpacing;
-    
-    // Button: Ergebnisse
-    drawButton(BUTTON_MARGIN, y, btnWidth, btnHeight, "Ergebnisse", COLOR_BUTTON);
-    y += btnHeight + btnSpacing;
+// Zeichnet Zeile index mit linker oberer Ecke (x, y) auf canvas (Sprite-Streifen oder Display)
+typedef std::function<void(lgfx::LGFXBase& canvas, uint16_t index, int32_t x, int32_t y)> ListRowRenderer;
+typedef std::function<void(uint16_t index)> ListTapAction;
+
+#define LIST_SCROLLBAR_WIDTH 4
+
+// Höchstens eine Liste pro Screen, beim Betreten angelegt. Gezeichnet werden
+// nur die sichtbaren Zeilen, Streifen für Streifen: komponieren im einen
+// Sprite, während der andere per DMA läuft. Der ST7789 kann in Querformat
+// nicht in Listenrichtung hardware-scrollen, also wird der Viewport pro
+// Frame neu geschoben: bei 40 MHz 15-20 ms Buszeit.
+static ScrollList list;
+static bool listActive = false;
+static ListRowRenderer listRowRenderer;     // Leer = Screen zeichnet selbst (Rangliste)
+static ListTapAction listTapAction;
+static int32_t listShownOffset = -1;        // -1 = Viewport noch nicht gezeichnet
+static uint32_t listTouchTime = 0;          // millis() der letzten Berührung
+
+static LGFX_Sprite* listBands[2] = { nullptr, nullptr };
+static uint8_t nextListBand = 0;
+
+static bool allocListBands(LGFX& lcd) {
+    if (listBands[0]) {
+        return true;
+    }
     
-    // Button: Einstellungen
-    drawButton(BUTTON_MARGIN, y, btnWidth, btnHeight, "Einstellungen", COLOR_BUTTON);
+    // Gleiche Reserve wie beim Race-Screen: NimBLE braucht den Rest
+    size_t needed = 2 * list.getWidth() * LIST_BAND_HEIGHT * 2;
+    size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_DMA);
+    if (largest < needed + RACE_SPRITE_HEAP_RESERVE) {
+        Serial.printf("[UI] List sprites skipped (need %u B, largest DMA block %u B)\n",
+                      (unsigned)needed, (unsigned)largest);
+        return false;
+    }
     
-    // Footer: Status - kleiner, oben zwischen Header und Buttons
-    lcd.setTextSize(1);  // Smaller text for footer
-    lcd.setTextColor(TEXT_COLOR);
-    lcd.setCursor(10, SCREEN_HEIGHT - 12);
-    lcd.printf("T:%u SD:%s BLE:%s", 
-               lapCounter.getTeamCount(),
-               dataLogger.isReady() ? "OK" : "-",
-               bleScanner.isScanning() ? "ON" : "-");
+    bool ok = true;
+    for (LGFX_Sprite*& band : listBands) {
+        band = new LGFX_Sprite(&lcd);
+        band->setColorDepth(16);
+        band->setPsram(false);
+        ok &= band->createSprite(list.getWidth(), LIST_BAND_HEIGHT) != nullptr;
+    }
+    if (!ok) {
+        Serial.println("[UI] ERROR: List sprite allocation failed, drawing direct");
+        delete listBands[0];
+        delete listBands[1];
+        listBands[0] = nullptr;
+        listBands[1] = nullptr;
+        return false;
+    }
+    return true;
 }
 
-void drawTeamsScreen() {
-    LGFX& lcd = display.getDisplay();
-    lcd.fillScreen(BACKGROUND_COLOR);
-    drawHeader("Teams", true);
-    
-    auto teams = lapCounter.getAllTeams();
-    int y = HEADER_HEIGHT + 10;
+static void releaseListBands() {
+    if (!listBands[0]) {
+        return;
+    }
     
-    if (teams.empty()) {
-        // Größerer Text für bessere Lesbarkeit
-        lcd.setTextColor(TEXT_COLOR);
-        lcd.setTextSize(TEXT_SIZE_LARGE);
-        lcd.setTextDatum(TC_DATUM);
-        lcd.drawString("Keine Teams", SCREEN_WIDTH / 2, y + 50);
-        lcd.setTextSize(TEXT_SIZE_NORMAL);
-        lcd.drawString("Tippe unten zum Hinzufugen", SCREEN_WIDTH / 2, y + 90);
+    display.finishAsync();
+    delete listBands[0];
+    delete listBands[1];
+    listBands[0] = nullptr;
+    listBands[1] = nullptr;
+}
+
+// Liste im Bereich (x, y, w, h) anlegen; Offset aus uiState überlebt einen
+// Neuaufbau desselben Screens (z.B. nach showMessage())
+static void beginList(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t count, int16_t rowHeight,
+                      ListRowRenderer renderer, ListTapAction onTap, bool paged = false) {
+    list = ScrollList();
+    list.setViewport(x, y, w, h);
+    list.setPaged(paged);
+    list.setRows(count, rowHeight);
+    list.scrollTo(uiState.scrollOffset, false);
+    
+    listActive = true;
+    listRowRenderer = renderer;
+    listTapAction = onTap;
+    listShownOffset = -1;
+    listTouchTime = 0;
+    
+    if (renderer) {
+        allocListBands(display.getDisplay());
+    }
+}
+
+static void endList() {
+    list.stop();
+    listActive = false;
+    listRowRenderer = nullptr;
+    listTapAction = nullptr;
+    releaseListBands();
+}
+
+// Zeile als Listeneintrag (wie WIDGET_LIST_ITEM), Breite bis zum Scrollbalken
+static Widget listItem(int32_t x, int32_t y, int16_t h, const String& text, const String& detail,
+                       uint16_t color) {
+    Widget item = {};
+    item.kind = WIDGET_LIST_ITEM;
+    item.x = x;
+    item.y = y;
+    item.w = list.getWidth() - LIST_SCROLLBAR_WIDTH - 2;
+    item.h = h;
+    item.text = text;
+    item.detail = detail;
+    item.color = color;
+    item.textSize = TEXT_SIZE_NORMAL;
+    item.visible = true;
+    return item;
+}
+
+static void drawListScrollbar(lgfx::LGFXBase& canvas, int32_t x, int32_t y) {
+    int32_t content = (int32_t)list.getCount() * list.getRowHeight();
+    int32_t viewH = list.getHeight();
+    if (content <= viewH) {
+        return;
+    }
+    int32_t thumbH = std::max<int32_t>(12, viewH * viewH / content);
+    int32_t thumbY = list.getOffset() * (viewH - thumbH) / list.getMaxOffset();
+    canvas.fillRect(x + list.getWidth() - LIST_SCROLLBAR_WIDTH, y + thumbY,
+                    LIST_SCROLLBAR_WIDTH, thumbH, 0x4208);
+}
+
+// Streifen [bandY, bandY + bandH) des Viewports: Hintergrund, angeschnittene
+// Zeilen, Scrollbalken
+static void drawListBand(LGFX& lcd, int32_t bandY, int32_t bandH) {
+    int32_t rowHeight = list.getRowHeight();
+    int32_t contentY = bandY + list.getOffset();
+    uint16_t first = contentY / rowHeight;
+    uint16_t end = std::min<int32_t>(list.getCount(), (contentY + bandH + rowHeight - 1) / rowHeight);
+    int32_t screenY = list.getY() + bandY;
+    
+    if (listBands[0]) {
+        LGFX_Sprite* band = listBands[nextListBand];
+        nextListBand ^= 1;
+        
+        band->fillSprite(BACKGROUND_COLOR);
+        for (uint16_t row = first; row < end; row++) {
+            listRowRenderer(*band, row, 0, row * rowHeight - contentY);
+        }
+        drawListScrollbar(*band, 0, -bandY);
+        display.pushSpriteRowsAsync(*band, 0, bandH, list.getX(), screenY);
     } else {
-        int displayCount = 0;
-        for (auto* team : teams) {
-            if (displayCount >= 3) break;  // Max 3 sichtbar (mit größeren Items)
-            
-            // Team Item - größer und besser lesbar
-            lcd.fillRoundRect(10, y, SCREEN_WIDTH - 20, LIST_ITEM_HEIGHT, 5, COLOR_BUTTON);
-            lcd.drawRoundRect(10, y, SCREEN_WIDTH - 20, LIST_ITEM_HEIGHT, 5, 0x4208);  // Border
-            
-            // Team Name - größer
-            lcd.setTextColor(COLOR_BUTTON_TEXT);
-            lcd.setTextSize(TEXT_SIZE_NORMAL);
-            lcd.setCursor(15, y + 8);
-            lcd.printf("%u. %s", team->teamId, team->teamName.c_str());
-            
-            // Beacon Info - klar lesbar
-            lcd.setTextSize(TEXT_SIZE_NORMAL);
-            lcd.setCursor(15, y + 30);
-            if (team->beaconUUID.length() > 0) {
-                lcd.printf("Beacon: %.8s...", team->beaconUUID.c_str());
-            } else {
-                lcd.print("Kein Beacon");
-            }
-            
-            y += LIST_ITEM_HEIGHT + BUTTON_MARGIN;
-            displayCount++;
+        // Ohne Sprites: direkt, auf den Streifen beschnitten (flackert beim Ziehen)
+        lcd.setClipRect(list.getX(), screenY, list.getWidth(), bandH);
+        lcd.fillRect(list.getX(), screenY, list.getWidth(), bandH, BACKGROUND_COLOR);
+        for (uint16_t row = first; row < end; row++) {
+            listRowRenderer(lcd, row, list.getX(), screenY + row * rowHeight - contentY);
         }
+        drawListScrollbar(lcd, list.getX(), list.getY());
+        lcd.clearClipRect();
     }
-    
-    // Add button
-    int btnY = SCREEN_HEIGHT - 60;
-    drawButton(BUTTON_MARGIN, btnY, SCREEN_WIDTH - 2*BUTTON_MARGIN, 
-              BUTTON_HEIGHT, "+ Neues Team", COLOR_SECONDARY);
+    diagnostics.count(DIAG_DISPLAY_BYTES, list.getWidth() * bandH * 2);
 }
 
-void drawTeamEditScreen() {
-    LGFX& lcd = display.getDisplay();
-    lcd.fillScreen(BACKGROUND_COLOR);
-    drawHeader("Team bearbeiten", true);
-    
-    int y = HEADER_HEIGHT + 15;
-    
-    // Team Name
-    lcd.setTextColor(TEXT_COLOR);
-    lcd.setTextSize(2);
-    lcd.setCursor(10, y);
-    lcd.print("Name:");
-    
-    lcd.fillRoundRect(10, y + 25, SCREEN_WIDTH - 20, 36, 5, COLOR_BUTTON);
-    lcd.setTextColor(0x0000);  // Black
-    lcd.setCursor(15, y + 33);
-    lcd.print(uiState.editingTeamName.length() > 0 ? uiState.editingTeamName : "Team eingeben");
-    
-    y += 70;
-    
-    // Beacon Assignment
-    lcd.setTextColor(TEXT_COLOR);
-    lcd.setCursor(10, y);
-    lcd.print("Beacon:");
-    
-    TeamData* team = lapCounter.getTeam(uiState.editingTeamId);
-    String beaconText = "Nicht zugeordnet";
-    if (team && team->beaconUUID.length() > 0) {
-        beaconText = team->beaconUUID.substring(0, 12) + "...";
+// Viewport nur nach dem Betreten und wenn sich der Offset geändert hat
+static void drawList() {
+    if (!listActive || !listRowRenderer || list.getOffset() == listShownOffset) {
+        return;
     }
     
-    drawButton(10, y + 25, SCREEN_WIDTH - 20, 36, beaconText, COLOR_BUTTON);
+    LGFX& lcd = display.getDisplay();
+    display.beginAsync();
+    for (int32_t bandY = 0; bandY < list.getHeight(); bandY += LIST_BAND_HEIGHT) {
+        drawListBand(lcd, bandY, std::min<int32_t>(LIST_BAND_HEIGHT, list.getHeight() - bandY));
+    }
+    display.finishAsync();
+    listShownOffset = list.getOffset();
+}
+
+// Ziehen/Ausrollen; ein Tipp ohne Ziehen zählt beim Loslassen
+static void handleListTouch(const TouchEvent& touch) {
+    listTouchTime = millis();
+    int tapped = -1;
+    
+    switch (touch.type) {
+        case TOUCH_PRESS:
+            list.press(touch.y, touch.sampledUs);
+            break;
+        case TOUCH_MOVE:
+            list.drag(touch.y, touch.sampledUs);
+            break;
+        case TOUCH_RELEASE:
+            tapped = list.release(touch.y, touch.sampledUs);
+            if (!listRowRenderer) {
+                list.stop();  // Ganze Seiten: direkt auf die Zielseite
+            }
+            break;
+    }
     
-    y += 70;
+    if (list.getOffset() != listShownOffset || list.isAnimating()) {
+        uiState.needsRedraw = true;
+    }
+    // Vor der Aktion: ein Screen-Wechsel setzt den Offset zurück
+    uiState.scrollOffset = list.getOffset();
     
-    // Buttons
-    drawButton(10, y, (SCREEN_WIDTH - 30) / 2, BUTTON_HEIGHT, "Speichern", COLOR_SECONDARY);
-    drawButton((SCREEN_WIDTH + 10) / 2, y, (SCREEN_WIDTH - 30) / 2, BUTTON_HEIGHT, "Loschen", COLOR_DANGER);
+    if (tapped >= 0 && listTapAction) {
+        ListTapAction action = listTapAction;
+        action((uint16_t)tapped);
+    }
 }
 
-void drawTeamBeaconAssignScreen() {
-    LGFX& lcd = display.getDisplay();
-    lcd.fillScreen(BACKGROUND_COLOR);
-    drawHeader("Beacon zuordnen", true);
-    
-    int y = HEADER_HEIGHT + 12;
+bool stepListScroll(uint64_t nowUs) {
+    if (!listActive || !list.isAnimating()) {
+        return false;
+    }
+    if (list.animate(nowUs)) {
+        uiState.scrollOffset = list.getOffset();
+        uiState.needsRedraw = true;
+    }
+    return list.isAnimating();
+}
+
+bool isListScrolling() {
+    return listActive && list.isAnimating();
+}
+
+// ============================================================
+// Widget-Baum des aktuellen Screens
+// ============================================================
+
+// Wird beim Betreten eines Screens aufgebaut; Zeichnen und Touch nutzen
+// dieselben Rechtecke
+static WidgetTree widgets;
+static Screen widgetScreen = SCREEN_HOME;
+
+static WidgetAction goTo(Screen screen) {
+    return [screen]() {
+        uiState.changeScreen(screen);
+    };
+}
+
+// Screen betreten: Baum leeren, Hintergrund und Header zeichnen.
+// false = Screen steht schon, nur dirty Widgets neu zeichnen.
+static bool beginScreen(const String& title, WidgetAction onBack) {
+    if (!uiState.needsFullRedraw) {
+        return false;
+    }
+    uiState.needsFullRedraw = false;
     
-    // Instruction - größer und dunkel
-    lcd.setTextColor(TEXT_COLOR);
-    lcd.setTextSize(TEXT_SIZE_NORMAL);
-    lcd.setCursor(10, y);
-    lcd.print("Halte Mofa mit Beacon");
-    lcd.setCursor(10, y + 20);
-    lcd.print("direkt vor Display (< 1m)");
+    widgets.clear();
+    widgetScreen = uiState.currentScreen;
+    endList();
     
-    y += 35;
+    LGFX& lcd = display.getDisplay();
+    lcd.fillScreen(BACKGROUND_COLOR);
+    drawHeader(title);
     
-    // Nearest Beacon - größer
-    BeaconData* nearest = bleScanner.getNearestBeacon();
-    if (nearest) {
-        float dist = BLEScanner::rssiToDistance(nearest->rssi, nearest->txPower);
+    // Back button - größer und besser sichtbar
+    if (onBack) {
+        widgets.add(WIDGET_BACK, 5, 5, 40, 30, "<", COLOR_BUTTON, onBack);
+    }
+    return true;
+}
+
+// Nur Geändertes: dirty Widgets, gescrollte oder geänderte Listenzeilen
+static void renderWidgets() {
+    widgets.render(drawWidget);
+    drawList();
+}
+
+// ============================================================
+// Screen Drawing
+// ============================================================
+
+void drawHomeScreen() {
+    if (beginScreen(DEVICE_NAME, nullptr)) {
+        // Reduced button height to fit all 4 buttons on screen
+        int btnHeight = 42;  // Slightly smaller to fit all buttons
+        int btnSpacing = 8;  // Reduced spacing
+        int y = HEADER_HEIGHT + 10;
+        int btnWidth = SCREEN_WIDTH - 2 * BUTTON_MARGIN;
         
-        uint16_t bgColor = dist < 1.0 ? COLOR_SECONDARY : COLOR_BUTTON;
-        int boxH = 65;
-        lcd.fillRoundRect(10, y, SCREEN_WIDTH - 20, boxH, 8, bgColor);
-        lcd.drawRoundRect(10, y, SCREEN_WIDTH - 20, boxH, 8, 0x4208);
+        // Button: Neues Rennen
+        widgets.addButton(BUTTON_MARGIN, y, btnWidth, btnHeight, "Neues Rennen", COLOR_SECONDARY,
+                          goTo(SCREEN_RACE_SETUP));
+        y += btnHeight + btnSpacing;
         
-        lcd.setTextColor(COLOR_BUTTON_TEXT);
-        lcd.setTextSize(TEXT_SIZE_NORMAL);
-        lcd.setCursor(15, y + 8);
-        lcd.print("Nachster Beacon:");
+        // Button: Teams verwalten
+        widgets.addButton(BUTTON_MARGIN, y, btnWidth, btnHeight, "Teams verwalten", COLOR_BUTTON,
+                          goTo(SCREEN_TEAMS));
+        y += btnHeight + btnSpacing;
         
-        lcd.setCursor(15, y + 28);
-        lcd.printf("MAC: %s", nearest->macAddress.c_str());
-        lcd.setCursor(15, y + 48);
-        lcd.printf("RSSI: %d dBm | %.2fm", nearest->rssi, dist);
+        // Button: Ergebnisse
+        widgets.addButton(BUTTON_MARGIN, y, btnWidth, btnHeight, "Ergebnisse", COLOR_BUTTON, []() {
+            if (lapCounter.getTeamCount() > 0) {
+                uiState.changeScreen(SCREEN_RACE_RESULTS);
+            } else {
+                showMessage("Info", "Keine Ergebnisse vorhanden", COLOR_WARNING);
+            }
+        });
+        y += btnHeight + btnSpacing;
         
-        y += boxH + 12;
+        // Button: Einstellungen
+        widgets.addButton(BUTTON_MARGIN, y, btnWidth, btnHeight, "Einstellungen", COLOR_BUTTON,
+                          goTo(SCREEN_SETTINGS));
+        renderWidgets();
         
-        if (dist < 1.0) {
-            int btnW = (SCREEN_WIDTH - 30) / 2;
-            drawButton(10, y, btnW, BUTTON_HEIGHT, "Zuordnen", COLOR_SECONDARY);
-            drawButton(20 + btnW, y, btnW, BUTTON_HEIGHT, "Liste", COLOR_BUTTON);
-            y += BUTTON_HEIGHT + 10;
+        // Footer: Status - kleiner, liegt über dem letzten Button
+        LGFX& lcd = display.getDisplay();
+        lcd.setTextSize(1);  // Smaller text for footer
+        lcd.setTextColor(TEXT_COLOR);
+        lcd.setTextDatum(TL_DATUM);
+        lcd.setCursor(10, SCREEN_HEIGHT - 12);
+        lcd.printf("T:%u SD:%s BLE:%s", 
+                   lapCounter.getTeamCount(),
+                   dataLogger.isReady() ? "OK" : "-",
+                   bleScanner.isScanning() ? "ON" : "-");
+    }
+    renderWidgets();
+}
+
+void drawTeamsScreen() {
+    if (beginScreen("Teams", goTo(SCREEN_HOME))) {
+        LGFX& lcd = display.getDisplay();
+        auto teams = lapCounter.getAllTeams();
+        int y = HEADER_HEIGHT + 10;
+        
+        if (teams.empty()) {
+            // Größerer Text für bessere Lesbarkeit
+            lcd.setTextColor(TEXT_COLOR);
+            lcd.setTextSize(TEXT_SIZE_LARGE);
+            lcd.setTextDatum(TC_DATUM);
+            lcd.drawString("Keine Teams", SCREEN_WIDTH / 2, y + 50);
+            lcd.setTextSize(TEXT_SIZE_NORMAL);
+            lcd.drawString("Tippe unten zum Hinzufugen", SCREEN_WIDTH / 2, y + 90);
         } else {
-            y += 10;
+            // Team-IDs statt Zeiger: die Zeile liest beim Zeichnen den aktuellen Stand
+            std::vector<uint8_t> teamIds;
+            for (auto* team : teams) {
+                teamIds.push_back(team->teamId);
+            }
+            int listH = SCREEN_HEIGHT - 60 - BUTTON_MARGIN / 2 - y;
+            beginList(10, y, SCREEN_WIDTH - 14, listH, teamIds.size(), LIST_ITEM_HEIGHT + BUTTON_MARGIN,
+                      [teamIds](lgfx::LGFXBase& canvas, uint16_t index, int32_t x, int32_t y) {
+                TeamData* team = lapCounter.getTeam(teamIds[index]);
+                if (!team) return;
+                
+                // Team Item: Name + Beacon Info - klar lesbar
+                String beacon = "Kein Beacon";
+                if (team->beaconUUID.length() > 0) {
+                    beacon = "Beacon: " + team->beaconUUID.substring(0, 8) + "...";
+                }
+                Widget item = listItem(x, y, LIST_ITEM_HEIGHT, String(team->teamId) + ". " + team->teamName,
+                                       beacon, COLOR_BUTTON);
+                drawListItem(canvas, item);
+            }, [teamIds](uint16_t index) {
+                // Edit this team
+                TeamData* team = lapCounter.getTeam(teamIds[index]);
+                if (team) {
+                    uiState.editingTeamId = team->teamId;
+                    uiState.editingTeamName = team->teamName;
+                    uiState.changeScreen(SCREEN_TEAM_EDIT);
+                }
+            });
         }
-    } else {
-        int boxH = 60;
-        lcd.fillRoundRect(10, y, SCREEN_WIDTH - 20, boxH, 8, COLOR_BUTTON);
-        lcd.drawRoundRect(10, y, SCREEN_WIDTH - 20, boxH, 8, 0x4208);
-        lcd.setTextColor(COLOR_BUTTON_TEXT);
-        lcd.setTextSize(TEXT_SIZE_LARGE);
-        lcd.setTextDatum(MC_DATUM);
-        lcd.drawString("Kein Beacon", SCREEN_WIDTH / 2, y + 15);
-        lcd.setTextSize(TEXT_SIZE_NORMAL);
-        lcd.drawString("gefunden...", SCREEN_WIDTH / 2, y + 40);
-        y += boxH + 12;
+        
+        // Add button
+        int btnY = SCREEN_HEIGHT - 60;
+        widgets.addButton(BUTTON_MARGIN, btnY, SCREEN_WIDTH - 2*BUTTON_MARGIN, BUTTON_HEIGHT,
+                          "+ Neues Team", COLOR_SECONDARY, []() {
+            if (lapCounter.getTeamCount() >= MAX_TEAMS) {
+                showMessage("Fehler", "Maximale Teams erreicht", COLOR_DANGER);
+                return;
+            }
+            
+            // Create new team with default name
+            uint8_t newId = lapCounter.getTeamCount() + 1;
+            String newName = "Team " + String(newId);
+            
+            if (lapCounter.addTeam(newId, newName, "")) {
+                persistence.saveTeams(lapCounter);
+                uiState.editingTeamId = newId;
+                uiState.editingTeamName = newName;
+                uiState.changeScreen(SCREEN_TEAM_EDIT);
+            } else {
+                showMessage("Fehler", "Team konnte nicht erstellt werden", COLOR_DANGER);
+            }
+        });
     }
-    
-    // Separator
-    y = SCREEN_HEIGHT - 65;
-    lcd.drawLine(10, y, SCREEN_WIDTH - 10, y, 0x4208);
-    
-    // Alternative: Manual list - größer
-    y += 12;
-    lcd.setTextColor(TEXT_COLOR);
-    lcd.setTextSize(TEXT_SIZE_NORMAL);
-    lcd.setCursor(10, y);
-    lcd.print("Alle Beacons:");
-    
-    y += 20;
-    drawButton(10, y, SCREEN_WIDTH - 20, BUTTON_HEIGHT, "Beacon-Liste anzeigen", COLOR_BUTTON);
+    renderWidgets();
 }
 
-void drawBeaconListScreen() {
-    LGFX& lcd = display.getDisplay();
-    lcd.fillScreen(BACKGROUND_COLOR);
-    drawHeader("Beacon-Liste", true);
-    
-    auto beacons = bleScanner.getBeacons();
-    
-    // Sort by RSSI (strongest first)
-    std::sort(beacons.begin(), beacons.end(), [](const BeaconData& a, const BeaconData& b) {
-        return a.rssi > b.rssi;
-    });
-    
-    int y = HEADER_HEIGHT + 12;
-    
-    if (beacons.empty()) {
+void drawTeamEditScreen() {
+    if (beginScreen("Team bearbeiten", goTo(SCREEN_TEAMS))) {
+        LGFX& lcd = display.getDisplay();
+        int y = HEADER_HEIGHT + 15;
+        
+        // Team Name (TODO: Keyboard input)
         lcd.setTextColor(TEXT_COLOR);
-        lcd.setTextSize(TEXT_SIZE_LARGE);
-        lcd.setTextDatum(TC_DATUM);
-        lcd.drawString("Keine Beacons", SCREEN_WIDTH / 2, y + 50);
-        lcd.setTextSize(TEXT_SIZE_NORMAL);
-        lcd.drawString("gefunden...", SCREEN_WIDTH / 2, y + 90);
-    } else {
+        lcd.setTextSize(2);
+        lcd.setTextDatum(TL_DATUM);
+        lcd.drawString("Name:", 10, y);
+        
+        widgets.add(WIDGET_LIST_ITEM, 10, y + 25, SCREEN_WIDTH - 20, 36,
+                    uiState.editingTeamName.length() > 0 ? uiState.editingTeamName : "Team eingeben",
+                    COLOR_BUTTON, []() {
+            showMessage("Info", "Keyboard wird implementiert", COLOR_WARNING);
+        });
+        
+        y += 70;
+        
+        // Beacon Assignment
+        lcd.drawString("Beacon:", 10, y);
+        
+        TeamData* team = lapCounter.getTeam(uiState.editingTeamId);
+        String beaconText = "Nicht zugeordnet";
+        if (team && team->beaconUUID.length() > 0) {
+            beaconText = team->beaconUUID.substring(0, 12) + "...";
+        }
+        
+        widgets.addButton(10, y + 25, SCREEN_WIDTH - 20, 36, beaconText, COLOR_BUTTON, []() {
+            uiState.changeScreen(SCREEN_TEAM_BEACON_ASSIGN);
+            
+            // Start BLE scanning
+            if (!bleScanner.isScanning()) {
+                bleScanner.startScan(0);
+            }
+        });
+        
+        y += 70;
+        
+        // Buttons
+        widgets.addButton(10, y, (SCREEN_WIDTH - 30) / 2, BUTTON_HEIGHT, "Speichern", COLOR_SECONDARY, []() {
+            TeamData* team = lapCounter.getTeam(uiState.editingTeamId);
+            if (team) {
+                team->teamName = uiState.editingTeamName;
+                persistence.saveTeams(lapCounter);
+                showMessage("Gespeichert", team->teamName, COLOR_SECONDARY);
+                uiState.changeScreen(SCREEN_TEAMS);
+            }
+        });
+        widgets.addButton((SCREEN_WIDTH + 10) / 2, y, (SCREEN_WIDTH - 30) / 2, BUTTON_HEIGHT, "Loschen", COLOR_DANGER, []() {
+            if (lapCounter.removeTeam(uiState.editingTeamId)) {
+                persistence.saveTeams(lapCounter);
+                showMessage("Geloscht", "Team wurde entfernt", COLOR_DANGER);
+                uiState.changeScreen(SCREEN_TEAMS);
+            }
+        });
+    }
+    renderWidgets();
+}
+
+// Beacon dem bearbeiteten Team zuordnen und zurück zu Team bearbeiten
+static void assignBeacon(const String& macAddress) {
+    TeamData* team = lapCounter.getTeam(uiState.editingTeamId);
+    if (team) {
+        team->beaconUUID = macAddress;
+        persistence.saveTeams(lapCounter);
+        showMessage("Zuordnung", "Beacon zugeordnet", COLOR_SECONDARY);
+        bleScanner.stopScan();
+        uiState.changeScreen(SCREEN_TEAM_EDIT);
+    }
+}
+
+void drawTeamBeaconAssignScreen() {
+    if (beginScreen("Beacon zuordnen", []() {
+            bleScanner.stopScan();
+            uiState.changeScreen(SCREEN_TEAM_EDIT);
+        })) {
+        LGFX& lcd = display.getDisplay();
+        int y = HEADER_HEIGHT + 12;
+        
+        // Instruction - größer und dunkel
         lcd.setTextColor(TEXT_COLOR);
         lcd.setTextSize(TEXT_SIZE_NORMAL);
-        lcd.setCursor(10, y);
-        lcd.printf("Gefunden: %u Beacon(s)", beacons.size());
+        lcd.setTextDatum(TL_DATUM);
+        lcd.drawString("Halte Mofa mit Beacon", 10, y);
+        lcd.drawString("direkt vor Display (< 1m)", 10, y + 20);
         
-        y += 25;
+        y += 35;
         
-        int displayCount = 0;
-        for (auto& beacon : beacons) {
-            if (displayCount >= 6) break;  // Max 6 visible (größere Items)
-            
-            float dist = BLEScanner::rssiToDistance(beacon.rssi, beacon.txPower);
+        // Nearest Beacon - größer
+        BeaconData* nearest = bleScanner.getNearestBeacon();
+        if (nearest) {
+            float dist = BLEScanner::rssiToDistance(nearest->rssi, nearest->txPower);
             
             uint16_t bgColor = dist < 1.0 ? COLOR_SECONDARY : COLOR_BUTTON;
-            int itemH = 42;
-            lcd.fillRoundRect(10, y, SCREEN_WIDTH - 20, itemH, 6, bgColor);
-            lcd.drawRoundRect(10, y, SCREEN_WIDTH - 20, itemH, 6, 0x4208);
+            int boxH = 65;
+            lcd.fillRoundRect(10, y, SCREEN_WIDTH - 20, boxH, 8, bgColor);
+            lcd.drawRoundRect(10, y, SCREEN_WIDTH - 20, boxH, 8, 0x4208);
             
             lcd.setTextColor(COLOR_BUTTON_TEXT);
             lcd.setTextSize(TEXT_SIZE_NORMAL);
-            lcd.setCursor(15, y + 6);
+            lcd.setCursor(15, y + 8);
+            lcd.print("Nachster Beacon:");
             
-            // Always show MAC address
-            lcd.printf("%s", beacon.macAddress.c_str());
+            lcd.setCursor(15, y + 28);
+            lcd.printf("MAC: %s", nearest->macAddress.c_str());
+            lcd.setCursor(15, y + 48);
+            lcd.printf("RSSI: %d dBm | %.2fm", nearest->rssi, dist);
             
-            lcd.setCursor(15, y + 22);
-            lcd.printf("%d dBm | %.2fm", beacon.rssi, dist);
+            y += boxH + 12;
             
-            lcd.setCursor(15, y + 34);
             if (dist < 1.0) {
-                lcd.setTextColor(COLOR_SECONDARY);
-                lcd.print("< Tippen zum Zuordnen!");
-            } else {
-                lcd.setTextColor(TEXT_COLOR);
-                lcd.print("zu weit");
+                // Der angezeigte Beacon wird zugeordnet, nicht der beim Tippen nächste
+                String mac = nearest->macAddress;
+                int btnW = (SCREEN_WIDTH - 30) / 2;
+                widgets.addButton(10, y, btnW, BUTTON_HEIGHT, "Zuordnen", COLOR_SECONDARY, [mac]() {
+                    assignBeacon(mac);
+                });
+                widgets.addButton(20 + btnW, y, btnW, BUTTON_HEIGHT, "Liste", COLOR_BUTTON,
+                                  goTo(SCREEN_BEACON_LIST));
             }
-            
-            y += itemH + BUTTON_MARGIN;
-            displayCount++;
-        }
-    }
-}
-
-void drawRaceSetupScreen() {
-    LGFX& lcd = display.getDisplay();
-    lcd.fillScreen(BACKGROUND_COLOR);
-    drawHeader("Rennen einrichten", true);
-    
-    int y = HEADER_HEIGHT + 10;
-    
-    // Race Name Label - dunkel und klar
-    lcd.setTextColor(TEXT_COLOR);
-    lcd.setTextSize(TEXT_SIZE_NORMAL);
-    lcd.setCursor(10, y);
-    lcd.print("RENNEN-NAME");
-    
-    // Input field - größer
-    int inputH = 45;
-    lcd.fillRoundRect(10, y + 20, SCREEN_WIDTH - 20, inputH, 8, COLOR_BUTTON);
-    lcd.drawRoundRect(10, y + 20, SCREEN_WIDTH - 20, inputH, 8, 0x4208);
-    lcd.setTextColor(COLOR_BUTTON_TEXT);
-    lcd.setTextSize(TEXT_SIZE_NORMAL);
-    lcd.setCursor(15, y + 33);
-    if (uiState.raceName.length() > 0) {
-        lcd.print(uiState.raceName);
-    } else {
-        lcd.setTextColor(0x630C);  // Darker gray placeholder
-        lcd.print("Tippen...");
-    }
-    
-    y += inputH + 25;
-    
-    // Duration with +/- Controls - Label dunkel
-    lcd.setTextColor(TEXT_COLOR);
-    lcd.setTextSize(TEXT_SIZE_NORMAL);
-    lcd.setCursor(10, y);
-    lcd.print("DAUER (MINUTEN)");
-    
-    y += 12;
-    
-    // Time display (large in center)
-    int timeBoxX = 60;
-    int timeBoxW = 120;
-    lcd.fillRoundRect(timeBoxX, y, timeBoxW, 38, 5, COLOR_SECONDARY);
-    lcd.setTextColor(0x0000);
-    lcd.setTextSize(3);
-    lcd.setTextDatum(MC_DATUM);
-    lcd.drawString(String(uiState.raceDuration), timeBoxX + timeBoxW/2, y + 19);
-    
-    // "-5" Button (left) - größer und besser lesbar
-    int btnSize = BUTTON_HEIGHT - 10;
-    lcd.fillRoundRect(10, y, 45, btnSize, 5, COLOR_BUTTON);
-    lcd.drawRoundRect(10, y, 45, btnSize, 5, 0x4208);
-    lcd.setTextColor(COLOR_BUTTON_TEXT);
-    lcd.setTextSize(TEXT_SIZE_NORMAL);
-    lcd.setTextDatum(MC_DATUM);
-    lcd.drawString("-5", 32, y + btnSize/2);
-    
-    // Value Display - größer
-    lcd.fillRoundRect(60, y, 120, btnSize, 5, COLOR_SECONDARY);
-    lcd.drawRoundRect(60, y, 120, btnSize, 5, 0x4208);
-    lcd.setTextColor(COLOR_BUTTON_TEXT);
-    lcd.setTextSize(TEXT_SIZE_LARGE);
-    lcd.setTextDatum(MC_DATUM);
-    lcd.drawString(String(uiState.raceDuration), 120, y + btnSize/2);
-    
-    // "+5" Button (right) - größer und besser lesbar
-    lcd.fillRoundRect(185, y, 45, btnSize, 5, COLOR_BUTTON);
-    lcd.drawRoundRect(185, y, 45, btnSize, 5, 0x4208);
-    lcd.setTextColor(COLOR_BUTTON_TEXT);
-    lcd.setTextSize(TEXT_SIZE_NORMAL);
-    lcd.setTextDatum(MC_DATUM);
-    lcd.drawString("+5", 207, y + btnSize/2);
-    
-    // "+15" Button (far right) - größer
-    lcd.fillRoundRect(235, y, 45, btnSize, 5, COLOR_BUTTON);
-    lcd.drawRoundRect(235, y, 45, btnSize, 5, 0x4208);
-    lcd.setTextColor(COLOR_BUTTON_TEXT);
-    lcd.setTextSize(TEXT_SIZE_NORMAL);
-    lcd.setTextDatum(MC_DATUM);
-    lcd.drawString("+15", 257, y + btnSize/2);
-    
-    y += 48;
-    
-    // Teams Label - dunkel
-    lcd.setTextColor(TEXT_COLOR);
-    lcd.setTextSize(TEXT_SIZE_NORMAL);
-    lcd.setTextDatum(TL_DATUM);
-    lcd.setCursor(10, y);
-    
-    int teamCount = lapCounter.getTeamCount();
-    if (teamCount == 0) {
-        lcd.print("KEINE TEAMS");
-    } else {
-        lcd.printf("TEAMS (%d)", teamCount);
-    }
-    
-    y += 12;
-    
-    // Team list (compact)
-    if (teamCount > 0) {
-        for (uint8_t i = 1; i <= MAX_TEAMS && i <= teamCount; i++) {
-            TeamData* team = lapCounter.getTeam(i);
-            if (!team) continue;
-            
-            if (y > SCREEN_HEIGHT - 60) break;  // Space for Start button
-            
-            // Team box - größer
-            uint16_t bgColor = uiState.selectedTeams[i-1] ? COLOR_SECONDARY : COLOR_BUTTON;
-            int teamH = 28;
-            lcd.fillRoundRect(10, y, SCREEN_WIDTH - 20, teamH, 5, bgColor);
-            lcd.drawRoundRect(10, y, SCREEN_WIDTH - 20, teamH, 5, 0x4208);
-            
-            // Checkbox - größer
-            lcd.fillCircle(25, y + teamH/2, 6, uiState.selectedTeams[i-1] ? 0x0000 : 0xFFFF);
-            lcd.drawCircle(25, y + teamH/2, 6, 0x0000);
-            
-            // Team name - größer und dunkel
+        } else {
+            int boxH = 60;
+            lcd.fillRoundRect(10, y, SCREEN_WIDTH - 20, boxH, 8, COLOR_BUTTON);
+            lcd.drawRoundRect(10, y, SCREEN_WIDTH - 20, boxH, 8, 0x4208);
             lcd.setTextColor(COLOR_BUTTON_TEXT);
+            lcd.setTextSize(TEXT_SIZE_LARGE);
+            lcd.setTextDatum(MC_DATUM);
+            lcd.drawString("Kein Beacon", SCREEN_WIDTH / 2, y + 15);
             lcd.setTextSize(TEXT_SIZE_NORMAL);
-            lcd.setCursor(38, y + 8);
-            lcd.print(team->teamName);
-            
-            y += teamH + BUTTON_MARGIN;
+            lcd.drawString("gefunden...", SCREEN_WIDTH / 2, y + 40);
         }
+        
+        // Separator
+        y = SCREEN_HEIGHT - 65;
+        lcd.drawLine(10, y, SCREEN_WIDTH - 10, y, 0x4208);
+        
+        // Alternative: Manual list - größer
+        y += 12;
+        lcd.setTextColor(TEXT_COLOR);
+        lcd.setTextSize(TEXT_SIZE_NORMAL);
+        lcd.setTextDatum(TL_DATUM);
+        lcd.drawString("Alle Beacons:", 10, y);
+        
+        y += 20;
+        widgets.addButton(10, y, SCREEN_WIDTH - 20, BUTTON_HEIGHT, "Beacon-Liste anzeigen", COLOR_BUTTON,
+                          goTo(SCREEN_BEACON_LIST));
     }
-    
-    // Start button
-    int btnY = SCREEN_HEIGHT - 50;
-    uint16_t btnColor = (teamCount > 0) ? COLOR_SECONDARY : COLOR_BUTTON;
-    drawButton(10, btnY, SCREEN_WIDTH - 20, BUTTON_HEIGHT, "RENNEN STARTEN", btnColor);
+    renderWidgets();
 }
 
-void drawRaceRunningScreen() {
-    LGFX& lcd = display.getDisplay();
-    lcd.fillScreen(BACKGROUND_COLOR);
-    
-    // Header with time - größer und klarer
-    uint32_t elapsed = millis() - raceStartTime;
-    uint32_t remaining = (raceDuration > elapsed) ? (raceDuration - elapsed) : 0;
-    uint32_t minutes = remaining / 60000;
-    uint32_t seconds = (remaining % 60000) / 1000;
-    
-    lcd.fillRect(0, 0, SCREEN_WIDTH, HEADER_HEIGHT, COLOR_HEADER_BG);
-    lcd.setTextColor(COLOR_HEADER_TEXT);
-    lcd.setTextSize(TEXT_SIZE_LARGE);
-    lcd.setTextDatum(MC_DATUM);
-    char timeStr[10];
-    sprintf(timeStr, "%02lu:%02lu", minutes, seconds);
-    lcd.drawString("Zeit: " + String(timeStr), SCREEN_WIDTH / 2, HEADER_HEIGHT / 2);
-    
-    // Leaderboard - größere Items, besser lesbar
-    auto leaderboard = lapCounter.getLeaderboard(true);
-    
-    int y = HEADER_HEIGHT + 15;
-    int pos = 1;
-    
-    for (auto* team : leaderboard) {
-        if (y > SCREEN_HEIGHT - 90) break;  // Platz für Buttons
+void drawBeaconListScreen() {
+    if (beginScreen("Beacon-Liste", goTo(SCREEN_TEAM_BEACON_ASSIGN))) {
+        LGFX& lcd = display.getDisplay();
+        auto beacons = bleScanner.getBeacons();
         
-        // Position & Name - größer
-        lcd.setTextColor(TEXT_COLOR);
-        lcd.setTextSize(TEXT_SIZE_NORMAL);
-        lcd.setCursor(10, y);
-        lcd.printf("%u. %s", pos, team->teamName.c_str());
+        // Sort by RSSI (strongest first)
+        std::sort(beacons.begin(), beacons.end(), [](const BeaconData& a, const BeaconData& b) {
+            return a.rssi > b.rssi;
+        });
         
-        // Laps - klar lesbar
-        lcd.setCursor(240, y);
-        uint16_t laps = team->lapCount > 0 ? team->lapCount - 1 : 0;
-        lcd.printf("%uR", laps);
+        int y = HEADER_HEIGHT + 12;
         
-        // Last lap time - größer
-        if (!team->laps.empty()) {
-            LapTime& lastLap = team->laps.back();
+        if (beacons.empty()) {
+            lcd.setTextColor(TEXT_COLOR);
+            lcd.setTextSize(TEXT_SIZE_LARGE);
+            lcd.setTextDatum(TC_DATUM);
+            lcd.drawString("Keine Beacons", SCREEN_WIDTH / 2, y + 50);
+            lcd.setTextSize(TEXT_SIZE_NORMAL);
+            lcd.drawString("gefunden...", SCREEN_WIDTH / 2, y + 90);
+        } else {
+            lcd.setTextColor(TEXT_COLOR);
             lcd.setTextSize(TEXT_SIZE_NORMAL);
-            lcd.setCursor(20, y + 22);
-            lcd.printf("Letzte: %lu.%03lu s", 
-                      lastLap.duration / 1000, lastLap.duration % 1000);
+            lcd.setCursor(10, y);
+            lcd.printf("Gefunden: %u Beacon(s)", beacons.size());
+            
+            y += 25;
+            
+            // Grün = nah genug, Tippen ordnet zu
+            int itemH = 42;
+            beginList(10, y, SCREEN_WIDTH - 14, SCREEN_HEIGHT - 4 - y, beacons.size(), itemH + BUTTON_MARGIN,
+                      [beacons, itemH](lgfx::LGFXBase& canvas, uint16_t index, int32_t x, int32_t y) {
+                const BeaconData& beacon = beacons[index];
+                float dist = BLEScanner::rssiToDistance(beacon.rssi, beacon.txPower);
+                char detail[32];
+                snprintf(detail, sizeof(detail), "%d dBm | %.2fm", beacon.rssi, dist);
+                drawListItem(canvas, listItem(x, y, itemH, beacon.macAddress, detail,
+                                              dist < 1.0 ? COLOR_SECONDARY : COLOR_BUTTON));
+            }, [beacons](uint16_t index) {
+                const BeaconData& beacon = beacons[index];
+                if (BLEScanner::rssiToDistance(beacon.rssi, beacon.txPower) < 1.0) {
+                    assignBeacon(beacon.macAddress);
+                } else {
+                    showMessage("Hinweis", "Beacon zu weit!\nNaher halten (<1m)", COLOR_WARNING);
+                }
+            });
         }
-        
-        y += 42;  // Mehr Abstand
-        pos++;
     }
-    
-    // Buttons - größer
-    int btnY = SCREEN_HEIGHT - 60;
-    int btnW = (SCREEN_WIDTH - BUTTON_MARGIN * 3) / 2;
-    drawButton(BUTTON_MARGIN, btnY, btnW, BUTTON_HEIGHT, "Pause", COLOR_WARNING);
-    drawButton(BUTTON_MARGIN * 2 + btnW, btnY, btnW, BUTTON_HEIGHT, "Stop", COLOR_DANGER);
+    renderWidgets();
 }
 
-void drawRacePausedScreen() {
-    LGFX& lcd = display.getDisplay();
-    lcd.fillScreen(BACKGROUND_COLOR);
-    drawHeader("RENNEN PAUSIERT", false);
+// Dauer in 5/15-Minuten-Schritten, 1..180 min
+static void changeRaceDuration(int delta, int valueWidget) {
+    int duration = (int)uiState.raceDuration + delta;
+    uiState.raceDuration = constrain(duration, 1, 180);
+    widgets.setText(valueWidget, String(uiState.raceDuration));
+    uiState.needsRedraw = true;
+}
+
+static void startRace() {
+    if (lapCounter.getTeamCount() == 0) {
+        showMessage("Fehler", "Keine Teams!", COLOR_DANGER);
+        return;
+    }
     
-    int y = HEADER_HEIGHT + 30;
+    // Start race
+    currentRaceName = uiState.raceName.length() > 0 ? uiState.raceName : "Rennen";
+    raceDuration = uiState.raceDuration * 60 * 1000;  // Convert to ms
+    raceStartTime = millis();
+    raceRunning = true;
     
-    // PAUSE Text - sehr groß und dunkel
-    lcd.setTextColor(TEXT_COLOR);
-    lcd.setTextSize(TEXT_SIZE_LARGE + 1);  // Size 4
-    lcd.setTextDatum(TC_DATUM);
-    lcd.drawString("PAUSE", SCREEN_WIDTH / 2, y);
+    // Save race config
+    persistence.saveConfig(currentRaceName, uiState.raceDuration);
     
-    y += 50;
+    // Start data logging
+    if (dataLogger.isReady()) {
+        lapPipeline.logRaceStart(currentRaceName, raceDuration);
+    }
     
-    // Time - größer
-    uint32_t elapsed = millis() - raceStartTime;
-    uint32_t minutes = elapsed / 60000;
-    uint32_t seconds = (elapsed % 60000) / 1000;
+    // Start BLE scanning
+    if (!bleScanner.isScanning()) {
+        bleScanner.startScan(0);
+    }
     
-    lcd.setTextSize(TEXT_SIZE_LARGE);
-    lcd.setTextDatum(TC_DATUM);
-    char timeStr[10];
-    sprintf(timeStr, "%02lu:%02lu", minutes, seconds);
-    lcd.drawString("Zeit: " + String(timeStr), SCREEN_WIDTH / 2, y);
+    // Reset all teams and beacon presence
+    lapPipeline.resetRace();
     
-    // Buttons - größer mit mehr Abstand
-    y = SCREEN_HEIGHT - 120;
-    drawButton(BUTTON_MARGIN, y, SCREEN_WIDTH - 2*BUTTON_MARGIN, 
-              BUTTON_HEIGHT, "Weitermachen", COLOR_SECONDARY);
+    uiState.changeScreen(SCREEN_RACE_RUNNING);
     
-    y += BUTTON_HEIGHT + BUTTON_MARGIN;
-    drawButton(BUTTON_MARGIN, y, SCREEN_WIDTH - 2*BUTTON_MARGIN, 
-              BUTTON_HEIGHT, "Rennen beenden", COLOR_DANGER);
+    Serial.println("\n=== RACE STARTED ===");
+    Serial.printf("Name: %s\n", currentRaceName.c_str());
+    Serial.printf("Duration: %lu minutes\n", uiState.raceDuration);
+    Serial.printf("Teams: %u\n", lapCounter.getTeamCount());
 }
 
-void drawRaceResultsScreen() {
-    LGFX& lcd = display.getDisplay();
-    lcd.fillScreen(BACKGROUND_COLOR);
-    drawHeader("Ergebnisse", true);
-    
-    // Show current race leaderboard (from memory)
-    auto leaderboard = lapCounter.getLeaderboard(true);
-    
-    int y = HEADER_HEIGHT + 10;
-    
-    if (leaderboard.empty()) {
-        lcd.setTextColor(TEXT_COLOR);
-        lcd.setTextSize(TEXT_SIZE_LARGE);
-        lcd.setTextDatum(TC_DATUM);
-        lcd.drawString("Keine Daten", SCREEN_WIDTH / 2, y + 60);
-    } else {
+void drawRaceSetupScreen() {
+    if (beginScreen("Rennen einrichten", goTo(SCREEN_HOME))) {
+        LGFX& lcd = display.getDisplay();
+        int y = HEADER_HEIGHT + 10;
+        
+        // Race Name Label - dunkel und klar
         lcd.setTextColor(TEXT_COLOR);
         lcd.setTextSize(TEXT_SIZE_NORMAL);
-        lcd.setCursor(10, y);
-        lcd.print("Aktuelles Rennen:");
+        lcd.setTextDatum(TL_DATUM);
+        lcd.drawString("RENNEN-NAME", 10, y);
         
-        y += 20;
+        // Input field - größer (TODO: Keyboard)
+        int inputH = 45;
+        bool hasName = uiState.raceName.length() > 0;
+        int nameField = widgets.add(WIDGET_LIST_ITEM, 10, y + 20, SCREEN_WIDTH - 20, inputH,
+                                    hasName ? uiState.raceName : "Tippen...", COLOR_BUTTON, []() {
+            showMessage("Info", "Keyboard wird implementiert", COLOR_WARNING);
+        });
+        if (!hasName) {
+            widgets.get(nameField)->textColor = 0x630C;  // Darker gray placeholder
+        }
         
-        int pos = 1;
-        for (auto* team : leaderboard) {
-            if (y > SCREEN_HEIGHT - BUTTON_HEIGHT - BUTTON_MARGIN) break;
-            
-            // Position & Name - größer
-            lcd.setTextColor(TEXT_COLOR);
-            lcd.setTextSize(TEXT_SIZE_NORMAL);
-            lcd.setCursor(10, y);
-            lcd.printf("%u. %s", pos, team->teamName.c_str());
+        y += inputH + 25;
+        
+        // Duration with +/- Controls - Label dunkel
+        lcd.setTextColor(TEXT_COLOR);
+        lcd.drawString("DAUER (MINUTEN)", 10, y);
+        
+        y += 12;
+        
+        // Value Display in der Mitte, nur dieser Wert wird bei +/- neu gezeichnet
+        int btnSize = BUTTON_HEIGHT - 10;
+        int value = widgets.add(WIDGET_BUTTON, 60, y, 120, btnSize, String(uiState.raceDuration), COLOR_SECONDARY);
+        widgets.get(value)->textSize = TEXT_SIZE_LARGE;
+        
+        widgets.addButton(10, y, 45, btnSize, "-5", COLOR_BUTTON, [value]() {
+            changeRaceDuration(-5, value);
+        });
+        widgets.addButton(185, y, 45, btnSize, "+5", COLOR_BUTTON, [value]() {
+            changeRaceDuration(5, value);
+        });
+        widgets.addButton(235, y, 45, btnSize, "+15", COLOR_BUTTON, [value]() {
+            changeRaceDuration(15, value);
+        });
+        
+        y += 48;
+        
+        // Teams Label - dunkel
+        int teamCount = lapCounter.getTeamCount();
+        if (teamCount == 0) {
+            lcd.drawString("KEINE TEAMS", 10, y);
+        } else {
+            lcd.drawString("TEAMS (" + String(teamCount) + ")", 10, y);
+        }
+        
+        y += 12;
+        
+        // Team list (compact) - Antippen wählt an/ab, nur der Eintrag wird neu gezeichnet
+        for (uint8_t i = 1; i <= MAX_TEAMS && i <= teamCount; i++) {
+            TeamData* team = lapCounter.getTeam(i);
+            if (!team) continue;
             
-            // Laps - klar lesbar
-            lcd.setCursor(240, y);
-            uint16_t laps = team->lapCount > 0 ? team->lapCount - 1 : 0;
-            lcd.printf("%uR", laps);
+            if (y > SCREEN_HEIGHT - 60) break;  // Space for Start button
             
-            // Best lap if available - größer
-            if (team->bestLapDuration < UINT32_MAX) {
-                lcd.setTextSize(TEXT_SIZE_NORMAL);
-                lcd.setCursor(20, y + 22);
-                lcd.printf("Beste: %lu.%03lu s", 
-                          team->bestLapDuration / 1000, team->bestLapDuration % 1000);
-            }
+            int teamH = 28;
+            bool selected = uiState.selectedTeams[i-1];
+            int item = widgets.add(WIDGET_CHECKBOX, 10, y, SCREEN_WIDTH - 20, teamH, team->teamName,
+                                   selected ? COLOR_SECONDARY : COLOR_BUTTON);
+            widgets.setChecked(item, selected);
+            widgets.get(item)->action = [i, item]() {
+                bool selected = !uiState.selectedTeams[i-1];
+                uiState.selectedTeams[i-1] = selected;
+                widgets.setChecked(item, selected);
+                widgets.setColor(item, selected ? COLOR_SECONDARY : COLOR_BUTTON);
+                uiState.needsRedraw = true;
+            };
             
-            y += LIST_ITEM_HEIGHT + BUTTON_MARGIN;
-            pos++;
+            y += teamH + BUTTON_MARGIN;
         }
+        
+        // Start button
+        int btnY = SCREEN_HEIGHT - 50;
+        uint16_t btnColor = (teamCount > 0) ? COLOR_SECONDARY : COLOR_BUTTON;
+        widgets.addButton(10, btnY, SCREEN_WIDTH - 20, BUTTON_HEIGHT, "RENNEN STARTEN", btnColor, startRace);
     }
-}
-
-void drawSettingsScreen() {
-    LGFX& lcd = display.getDisplay();
-    lcd.fillScreen(BACKGROUND_COLOR);
-    drawHeader("Einstellungen", true);
-    
-    int y = HEADER_HEIGHT + 15;
-    
-    // SD Card Format/Init Button - größer
-    lcd.setTextColor(TEXT_COLOR);
-    lcd.setTextSize(TEXT_SIZE_NORMAL);
-    lcd.setCursor(10, y);
-    if (dataLogger.isReady()) {
-        lcd.print("SD-Format:");
-        drawButton(SCREEN_WIDTH - 120, y - 2, 110, BUTTON_HEIGHT - 10, "Formatieren", COLOR_WARNING);
-    } else {
-        lcd.print("SD-Karte:");
-        drawButton(SCREEN_WIDTH - 120, y - 2, 110, BUTTON_HEIGHT - 10, "Init/Format", COLOR_SECONDARY);
-    }
-    y += BUTTON_HEIGHT + 5;
-    
-    // Touch Calibration Button - größer
-    lcd.setTextColor(TEXT_COLOR);
-    lcd.setTextSize(TEXT_SIZE_NORMAL);
-    lcd.setCursor(10, y);
-    lcd.print("Touch:");
-    drawButton(SCREEN_WIDTH - 120, y - 2, 110, BUTTON_HEIGHT - 10, "Kalibrieren", COLOR_SECONDARY);
-    y += BUTTON_HEIGHT + 5;
-    
-    // RSSI Thresholds - größer
-    lcd.setTextColor(TEXT_COLOR);
-    lcd.setTextSize(TEXT_SIZE_NORMAL);
-    lcd.setCursor(10, y);
-    lcd.print("RSSI Near/Far:");
-    lcd.setTextColor(TEXT_COLOR);
-    char rssiStr[20];
-    sprintf(rssiStr, "%d / %d", lapRssiNear, lapRssiFar);
-    lcd.setCursor(130, y);
-    lcd.print(rssiStr);
+    renderWidgets();
 }
 
 // ============================================================
-// Touch Handler
+// Race Running: nur geänderte Bereiche zeichnen
 // ============================================================
 
-void handleTouch(uint16_t x, uint16_t y) {
-    // Back button in header - match exact button dimensions from drawHeader
-    // Button is at (5, 5) with size (40, 30)
-    // Only check if current screen has a back button (not HOME)
-    if (uiState.currentScreen != SCREEN_HOME) {
-        if (isTouchInRect(x, y, 5, 5, 40, 30)) {
-            // Stop BLE scanning if on beacon assignment screens
-            if (uiState.currentScreen == SCREEN_TEAM_BEACON_ASSIGN || 
-                uiState.currentScreen == SCREEN_BEACON_LIST) {
-                bleScanner.stopScan();
-            }
-            uiState.changeScreen(uiState.previousScreen);
-            return;
-        }
-    }
-    
-    switch (uiState.currentScreen) {
-        case SCREEN_HOME:
-            handleHomeTouch(x, y);
-            break;
-        case SCREEN_TEAMS:
-            handleTeamsTouch(x, y);
-            break;
-        case SCREEN_TEAM_EDIT:
-            handleTeamEditTouch(x, y);
-            break;
-        case SCREEN_SETTINGS:
-            handleSettingsTouch(x, y);
-            break;
-        default:
-            break;
-    }
+#define RACE_ROWS 3
+#define RACE_ROW_Y (HEADER_HEIGHT + 15)
+#define RACE_ROW_HEIGHT 42
+#define RACE_LINE_X 8
+#define RACE_LINE_WIDTH (SCREEN_WIDTH - 2 * RACE_LINE_X)
+#define RACE_LINE_HEIGHT 16         // Textgröße 2
+#define RACE_NAME_X 10
+#define RACE_LAPS_X 240
+#define RACE_LAST_X 20
+
+// Uhr "Zeit: MMM:SS" in Textgröße 3 (18x24 pro Zeichen), nur die Ziffern
+// werden aktualisiert; "Zeit:" und ":" stehen fest im Header
+#define RACE_CLOCK_CHAR_WIDTH 18
+#define RACE_CLOCK_CHAR_HEIGHT 24
+#define RACE_CLOCK_X (SCREEN_WIDTH / 2 - 6 * RACE_CLOCK_CHAR_WIDTH)
+#define RACE_CLOCK_Y (HEADER_HEIGHT / 2 - RACE_CLOCK_CHAR_HEIGHT / 2)
+#define RACE_CLOCK_CELLS 5          // MMM SS
+#define RACE_LAP_CELLS 4            // "999R"
+#define RACE_LAP_MAX 999            // Mehr Runden passen nicht in die Zellen
+
+// Was aktuell auf dem Display steht
+struct RaceRowView {
+    bool valid;
+    uint16_t rank;
+    uint8_t teamId;
+    uint16_t laps;
+    uint32_t lastLapDuration;
+};
+
+static uint32_t shownSeconds = UINT32_MAX;
+static char shownClock[RACE_CLOCK_CELLS + 1];
+static RaceRowView shownRows[RACE_ROWS];
+static uint16_t shownPage = UINT16_MAX;     // Seitenanzeige "2/17" im Header
+static uint16_t shownPageCount = 0;
+static uint32_t racePageTime = 0;           // millis() des letzten Blätterns
+
+// Vorgerenderte Zeichen: eine Glyphe pro Zelle, untereinander im Sprite,
+// damit jede Glyphe ein zusammenhängender Block für pushImageDMA ist
+struct GlyphAtlas {
+    const char* glyphs;
+    uint8_t textSize;
+    uint8_t width;
+    uint8_t height;
+    uint16_t color;
+    uint16_t background;
+    LGFX_Sprite* sprite;
+};
+
+static GlyphAtlas clockGlyphs = { "0123456789", TEXT_SIZE_LARGE, RACE_CLOCK_CHAR_WIDTH,
+                                  RACE_CLOCK_CHAR_HEIGHT, COLOR_HEADER_TEXT, COLOR_HEADER_BG, nullptr };
+static GlyphAtlas lapGlyphs = { "0123456789R", TEXT_SIZE_NORMAL, 12, RACE_LINE_HEIGHT,
+                                TEXT_COLOR, BACKGROUND_COLOR, nullptr };
+
+// Off-Screen-Puffer (DMA-fähiges internes RAM): zwei Zeilen im Wechsel,
+// damit die nächste Zeile komponiert wird, während die vorige per DMA läuft
+static LGFX_Sprite* lineSprites[2] = { nullptr, nullptr };
+static uint8_t nextLineSprite = 0;
+
+static size_t glyphAtlasBytes(const GlyphAtlas& atlas) {
+    return (size_t)atlas.width * atlas.height * strlen(atlas.glyphs) * 2;
 }
 
-void handleHomeTouch(uint16_t x, uint16_t y) {
-    // Match exact button dimensions from drawHomeScreen
-    int btnHeight = 42;
-    int btnSpacing = 8;
-    int btnY = HEADER_HEIGHT + 10;
-    int btnWidth = SCREEN_WIDTH - 2 * BUTTON_MARGIN;
+static bool buildGlyphAtlas(LGFX& lcd, GlyphAtlas& atlas) {
+    atlas.sprite = new LGFX_Sprite(&lcd);
+    atlas.sprite->setColorDepth(16);
+    atlas.sprite->setPsram(false);
+    if (!atlas.sprite->createSprite(atlas.width, atlas.height * strlen(atlas.glyphs))) {
+        return false;
+    }
     
-    // Neues Rennen
-    if (isTouchInRect(x, y, BUTTON_MARGIN, btnY, btnWidth, btnHeight)) {
-        uiState.changeScreen(SCREEN_RACE_SETUP);
-        return;
+    atlas.sprite->fillSprite(atlas.background);
+    atlas.sprite->setTextSize(atlas.textSize);
+    atlas.sprite->setTextColor(atlas.color);
+    atlas.sprite->setTextDatum(TL_DATUM);
+    for (size_t i = 0; i < strlen(atlas.glyphs); i++) {
+        char glyph[2] = { atlas.glyphs[i], '\0' };
+        atlas.sprite->drawString(glyph, 0, i * atlas.height);
+    }
+    return true;
+}
+
+static void releaseGlyphAtlas(GlyphAtlas& atlas) {
+    delete atlas.sprite;
+    atlas.sprite = nullptr;
+}
+
+static bool allocRaceSprites(LGFX& lcd) {
+    if (lineSprites[0]) {
+        return true;
     }
-    btnY += btnHeight + btnSpacing;
     
-    // Teams verwalten
-    if (isTouchInRect(x, y, BUTTON_MARGIN, btnY, btnWidth, btnHeight)) {
-        uiState.changeScreen(SCREEN_TEAMS);
-        return;
+    size_t needed = 2 * RACE_LINE_WIDTH * RACE_LINE_HEIGHT * 2 +
+                    glyphAtlasBytes(clockGlyphs) + glyphAtlasBytes(lapGlyphs);
+    size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_DMA);
+    if (needed > RACE_SPRITE_BUDGET || largest < needed + RACE_SPRITE_HEAP_RESERVE) {
+        Serial.printf("[UI] Race sprites skipped (need %u B, largest DMA block %u B)\n",
+                      (unsigned)needed, (unsigned)largest);
+        return false;
     }
-    btnY += btnHeight + btnSpacing;
     
-    // Ergebnisse
-    if (isTouchInRect(x, y, BUTTON_MARGIN, btnY, btnWidth, btnHeight)) {
-        if (lapCounter.getTeamCount() > 0) {
-            uiState.changeScreen(SCREEN_RACE_RESULTS);
-        } else {
-            showMessage("Info", "Keine Ergebnisse vorhanden", COLOR_WARNING);
-        }
-        return;
+    lineSprites[0] = new LGFX_Sprite(&lcd);
+    lineSprites[1] = new LGFX_Sprite(&lcd);
+    
+    bool ok = true;
+    for (LGFX_Sprite* sprite : lineSprites) {
+        sprite->setColorDepth(16);
+        sprite->setPsram(false);
+        ok &= sprite->createSprite(RACE_LINE_WIDTH, RACE_LINE_HEIGHT) != nullptr;
     }
-    btnY += btnHeight + btnSpacing;
+    ok = ok && buildGlyphAtlas(lcd, clockGlyphs) && buildGlyphAtlas(lcd, lapGlyphs);
     
-    // Einstellungen
-    if (isTouchInRect(x, y, BUTTON_MARGIN, btnY, btnWidth, btnHeight)) {
-        uiState.changeScreen(SCREEN_SETTINGS);
-        return;
+    if (!ok) {
+        Serial.println("[UI] ERROR: Race sprite allocation failed, drawing direct");
+        releaseRaceSprites();
+        return false;
     }
+    
+    Serial.printf("[UI] Race sprites: %u B\n", (unsigned)needed);
+    return true;
 }
 
-void handleTeamsTouch(uint16_t x, uint16_t y) {
-    // Back button
-    if (isTouchInRect(x, y, 5, 5, 60, HEADER_HEIGHT)) {
-        uiState.changeScreen(SCREEN_HOME);
+void releaseRaceSprites() {
+    if (!lineSprites[0]) {
         return;
     }
     
-    // Team items (can click to edit)
-    auto teams = lapCounter.getAllTeams();
-    int itemY = HEADER_HEIGHT + 10;
-    int itemNum = 0;
-    
-    for (auto* team : teams) {
-        if (itemNum >= 3) break;  // Max 3 visible
+    display.finishAsync();
+    delete lineSprites[0];
+    delete lineSprites[1];
+    lineSprites[0] = nullptr;
+    lineSprites[1] = nullptr;
+    releaseGlyphAtlas(clockGlyphs);
+    releaseGlyphAtlas(lapGlyphs);
+}
+
+// Eine Textzeile (links + optional rechts) komplett ersetzen
+static void drawRaceLine(LGFX& lcd, int y, const char* left, int leftX,
+                         const char* right, int rightX) {
+    if (lineSprites[0]) {
+        LGFX_Sprite* sprite = lineSprites[nextLineSprite];
+        nextLineSprite ^= 1;
         
-        if (isTouchInRect(x, y, 10, itemY, SCREEN_WIDTH - 20, LIST_ITEM_HEIGHT)) {
-            // Edit this team
-            uiState.editingTeamId = team->teamId;
-            uiState.editingTeamName = team->teamName;
-            uiState.changeScreen(SCREEN_TEAM_EDIT);
-            return;
+        sprite->fillSprite(BACKGROUND_COLOR);
+        sprite->setTextSize(TEXT_SIZE_NORMAL);
+        sprite->setTextColor(TEXT_COLOR);
+        sprite->setTextDatum(TL_DATUM);
+        sprite->drawString(left, leftX - RACE_LINE_X, 0);
+        if (right) {
+            sprite->drawString(right, rightX - RACE_LINE_X, 0);
         }
-        
-        itemY += LIST_ITEM_HEIGHT + 5;
-        itemNum++;
-    }
-    
-    // Add button
-    int btnY = SCREEN_HEIGHT - 60;
-    if (isTouchInRect(x, y, BUTTON_MARGIN, btnY, SCREEN_WIDTH - 2*BUTTON_MARGIN, BUTTON_HEIGHT)) {
-        if (lapCounter.getTeamCount() >= MAX_TEAMS) {
-            showMessage("Fehler", "Maximale Teams erreicht", COLOR_DANGER);
-        } else {
-            // Create new team with default name
-            uint8_t newId = lapCounter.getTeamCount() + 1;
-            String newName = "Team " + String(newId);
-            
-            if (lapCounter.addTeam(newId, newName, "")) {
-                persistence.saveTeams(lapCounter);
-                uiState.editingTeamId = newId;
-                uiState.editingTeamName = newName;
-                uiState.changeScreen(SCREEN_TEAM_EDIT);
-            } else {
-                showMessage("Fehler", "Team konnte nicht erstellt werden", COLOR_DANGER);
-            }
+        display.pushSpriteAsync(*sprite, RACE_LINE_X, y);
+    } else {
+        // Ohne Sprites: Text mit Hintergrund und fester Breite überschreiben
+        lcd.setTextSize(TEXT_SIZE_NORMAL);
+        lcd.setTextColor(TEXT_COLOR, BACKGROUND_COLOR);
+        lcd.setTextDatum(TL_DATUM);
+        lcd.setTextPadding((right ? rightX : RACE_LINE_X + RACE_LINE_WIDTH) - leftX);
+        lcd.drawString(left, leftX, y);
+        if (right) {
+            lcd.setTextPadding(RACE_LINE_X + RACE_LINE_WIDTH - rightX);
+            lcd.drawString(right, rightX, y);
         }
-        return;
+        lcd.setTextPadding(0);
     }
+    diagnostics.count(DIAG_DISPLAY_BYTES, RACE_LINE_WIDTH * RACE_LINE_HEIGHT * 2);
 }
 
-void handleTeamEditTouch(uint16_t x, uint16_t y) {
-    // Back button
-    if (isTouchInRect(x, y, 5, 5, 60, HEADER_HEIGHT)) {
-        uiState.changeScreen(SCREEN_TEAMS);
-        return;
-    }
-    
-    int btnY = HEADER_HEIGHT + 15;
-    
-    // Team Name edit (TODO: Keyboard input - for now just toggle)
-    if (isTouchInRect(x, y, 10, btnY + 25, SCREEN_WIDTH - 20, 36)) {
-        // TODO: Implement keyboard input
-        showMessage("Info", "Keyboard wird implementiert", COLOR_WARNING);
-        return;
+// Eine Zeichenzelle ersetzen: Glyphe aus dem Atlas, ohne Atlas direkt
+// gerendert; Zeichen außerhalb des Atlas (Leerzeichen, '\0') = leere Zelle
+static void drawGlyphCell(LGFX& lcd, const GlyphAtlas& atlas, int x, int y, char c) {
+    const char* glyph = c ? strchr(atlas.glyphs, c) : nullptr;
+    
+    if (!glyph) {
+        lcd.fillRect(x, y, atlas.width, atlas.height, atlas.background);
+    } else if (atlas.sprite) {
+        display.pushSpriteRowsAsync(*atlas.sprite, (glyph - atlas.glyphs) * atlas.height,
+                                    atlas.height, x, y);
+    } else {
+        char text[2] = { c, '\0' };
+        lcd.setTextSize(atlas.textSize);
+        lcd.setTextColor(atlas.color, atlas.background);
+        lcd.setTextDatum(TL_DATUM);
+        lcd.drawString(text, x, y);
     }
-    
-    btnY += 70;
-    
-    // Beacon assignment
-    if (isTouchInRect(x, y, 10, btnY + 25, SCREEN_WIDTH - 20, 36)) {
-        uiState.previousScreen = SCREEN_TEAM_EDIT;
-        uiState.changeScreen(SCREEN_TEAM_BEACON_ASSIGN);
-        
-        // Start BLE scanning
-        if (!bleScanner.isScanning()) {
-            bleScanner.startScan(0);
+    diagnostics.count(DIAG_DISPLAY_BYTES, atlas.width * atlas.height * 2);
+}
+
+// Zeichenfolge ab x zellenweise aktualisieren, nur geänderte Zellen
+static void drawGlyphCells(LGFX& lcd, const GlyphAtlas& atlas, int x, int y,
+                           const char* shown, const char* text, uint8_t cells) {
+    for (uint8_t i = 0; i < cells; i++) {
+        if (text[i] != shown[i]) {
+            drawGlyphCell(lcd, atlas, x + i * atlas.width, y, text[i]);
         }
-        return;
     }
+}
+
+static void drawRaceClock(LGFX& lcd, uint32_t seconds) {
+    // Minuten rechtsbündig in 3 Zellen, mindestens zweistellig
+    char minutes[8];
+    char cells[12];
+    snprintf(minutes, sizeof(minutes), "%02lu", (unsigned long)(seconds / 60 % 1000));
+    snprintf(cells, sizeof(cells), "%3s%02lu", minutes, (unsigned long)(seconds % 60));
+    
+    // Zellen: Minuten ab "Zeit: ", Sekunden hinter dem festen ":"
+    int minutesX = RACE_CLOCK_X + 6 * RACE_CLOCK_CHAR_WIDTH;
+    drawGlyphCells(lcd, clockGlyphs, minutesX, RACE_CLOCK_Y, shownClock, cells, 3);
+    drawGlyphCells(lcd, clockGlyphs, minutesX + 4 * RACE_CLOCK_CHAR_WIDTH, RACE_CLOCK_Y,
+                   shownClock + 3, cells + 3, 2);
+    memcpy(shownClock, cells, RACE_CLOCK_CELLS);
+}
+
+// Rundenzahl "12R" in RACE_LAP_CELLS Zeichen: ab RACE_LAP_MAX bleibt
+// "999R" stehen statt abgeschnittener Ziffern
+static void formatRaceLaps(char (&text)[RACE_LAP_CELLS + 1], uint16_t laps) {
+    snprintf(text, sizeof(text), "%uR", laps < RACE_LAP_MAX ? laps : RACE_LAP_MAX);
+}
+
+// Bei gleichem Team nur die geänderten Ziffern
+static void drawRaceLaps(LGFX& lcd, int y, uint16_t shownLaps, uint16_t laps) {
+    char before[RACE_LAP_CELLS + 1] = "";
+    char after[RACE_LAP_CELLS + 1] = "";
+    formatRaceLaps(before, shownLaps);
+    formatRaceLaps(after, laps);
+    drawGlyphCells(lcd, lapGlyphs, RACE_LAPS_X, y, before, after, RACE_LAP_CELLS);
+}
+
+static void stopRace() {
+    raceRunning = false;
+    uiState.changeScreen(SCREEN_RACE_RESULTS);
     
-    btnY += 70;
-    
-    // Save button
-    if (isTouchInRect(x, y, 10, btnY, (SCREEN_WIDTH - 30) / 2, BUTTON_HEIGHT)) {
-        TeamData* team = lapCounter.getTeam(uiState.editingTeamId);
-        if (team) {
-            team->teamName = uiState.editingTeamName;
-            persistence.saveTeams(lapCounter);
-            showMessage("Gespeichert", team->teamName, COLOR_SECONDARY);
-            uiState.changeScreen(SCREEN_TEAMS);
-        }
-        return;
+    // Finish race: läuft unter stateMutex, geschrieben wird nach dem Lock
+    if (dataLogger.isReady()) {
+        lapPipeline.requestRaceFinish();
     }
+    bleScanner.stopScan();
+}
+
+static void drawRaceChrome(LGFX& lcd) {
+    // Header ohne Titel: dort steht die Uhr
+    beginScreen("", nullptr);
     
-    // Delete button
-    if (isTouchInRect(x, y, (SCREEN_WIDTH + 10) / 2, btnY, (SCREEN_WIDTH - 30) / 2, BUTTON_HEIGHT)) {
-        if (lapCounter.removeTeam(uiState.editingTeamId)) {
-            persistence.saveTeams(lapCounter);
-            showMessage("Geloscht", "Team wurde entfernt", COLOR_DANGER);
-            uiState.changeScreen(SCREEN_TEAMS);
-        }
-        return;
-    }
+    // Buttons - größer
+    int btnY = SCREEN_HEIGHT - 60;
+    int btnW = (SCREEN_WIDTH - BUTTON_MARGIN * 3) / 2;
+    widgets.addButton(BUTTON_MARGIN, btnY, btnW, BUTTON_HEIGHT, "Pause", COLOR_WARNING, []() {
+        raceRunning = false;
+        uiState.changeScreen(SCREEN_RACE_PAUSED);
+        Serial.println("\n=== RACE PAUSED ===");
+    });
+    widgets.addButton(BUTTON_MARGIN * 2 + btnW, btnY, btnW, BUTTON_HEIGHT, "Stop", COLOR_DANGER, []() {
+        stopRace();
+        Serial.println("\n=== RACE STOPPED ===");
+    });
+    renderWidgets();
+    
+    // Feste Teile der Uhr, die Ziffern kommen aus dem Atlas
+    lcd.setTextSize(TEXT_SIZE_LARGE);
+    lcd.setTextColor(COLOR_HEADER_TEXT);
+    lcd.setTextDatum(TL_DATUM);
+    lcd.drawString("Zeit:", RACE_CLOCK_X, RACE_CLOCK_Y);
+    lcd.drawString(":", RACE_CLOCK_X + 9 * RACE_CLOCK_CHAR_WIDTH, RACE_CLOCK_Y);
+    
+    diagnostics.count(DIAG_DISPLAY_BYTES, (SCREEN_WIDTH * SCREEN_HEIGHT +
+                                           SCREEN_WIDTH * HEADER_HEIGHT +
+                                           2 * btnW * BUTTON_HEIGHT) * 2);
+    
+    // Rangliste seitenweise: Wischen blättert, Zeilen zeichnet drawRaceRow()
+    beginList(0, RACE_ROW_Y, SCREEN_WIDTH, RACE_ROWS * RACE_ROW_HEIGHT, 0, RACE_ROW_HEIGHT,
+              nullptr, nullptr, true);
+    
+    allocRaceSprites(lcd);
+    shownSeconds = UINT32_MAX;
+    memset(shownClock, 0, sizeof(shownClock));
+    memset(shownRows, 0, sizeof(shownRows));
+    shownPage = UINT16_MAX;
+    shownPageCount = 0;
+    racePageTime = millis();
 }
 
-void handleBeaconAssignTouch(uint16_t x, uint16_t y) {
-    // Back button
-    if (isTouchInRect(x, y, 5, 5, 60, HEADER_HEIGHT)) {
-        bleScanner.stopScan();
-        uiState.changeScreen(uiState.previousScreen);
+// Nächste Seite alle RACE_PAGE_INTERVAL ms, nach Wischen erst nach RACE_PAGE_HOLD ms
+static void autoPageRace() {
+    uint32_t now = millis();
+    bool touched = list.isTracking() || (listTouchTime > 0 && now - listTouchTime < RACE_PAGE_HOLD);
+    if (list.pageCount() <= 1 || touched) {
+        racePageTime = now;
         return;
     }
-    
-    // Assign nearest beacon button (if visible and close enough)
-    BeaconData* nearest = bleScanner.getNearestBeacon();
-    if (nearest) {
-        float dist = BLEScanner::rssiToDistance(nearest->rssi, nearest->txPower);
-        
-        if (dist < 1.0) {
-            int btnY = HEADER_HEIGHT + 107;
-            int btnW = (SCREEN_WIDTH - 30) / 2;
-            
-            // "Zuordnen" Button (links)
-            if (isTouchInRect(x, y, 10, btnY, btnW, BUTTON_HEIGHT)) {
-                TeamData* team = lapCounter.getTeam(uiState.editingTeamId);
-                if (team) {
-                    team->beaconUUID = nearest->macAddress;
-                    persistence.saveTeams(lapCounter);
-                    showMessage("Zuordnung", "Beacon zugeordnet", COLOR_SECONDARY);
-                    bleScanner.stopScan();
-                    uiState.changeScreen(SCREEN_TEAM_EDIT);
-                }
-                return;
-            }
-            
-            // "Liste" Button (rechts)
-            if (isTouchInRect(x, y, 20 + btnW, btnY, btnW, BUTTON_HEIGHT)) {
-                uiState.changeScreen(SCREEN_BEACON_LIST);
-                return;
-            }
-        }
+    if (now - racePageTime >= RACE_PAGE_INTERVAL) {
+        list.scrollToPage((list.getPage() + 1) % list.pageCount(), false);
+        uiState.scrollOffset = list.getOffset();
+        racePageTime = now;
     }
-    
-    // Beacon list button (at bottom)
-    int btnY = SCREEN_HEIGHT - 55;
-    if (isTouchInRect(x, y, 10, btnY, SCREEN_WIDTH - 20, BUTTON_HEIGHT)) {
-        uiState.changeScreen(SCREEN_BEACON_LIST);
-        return;
+}
+
+// Seitenanzeige rechts im Header, nur bei mehr als einer Seite
+static void drawRacePage(LGFX& lcd, uint16_t page, uint16_t pageCount) {
+    char text[12] = "";
+    if (pageCount > 1) {
+        snprintf(text, sizeof(text), "%u/%u", page + 1, pageCount);
     }
+    lcd.setTextSize(1);
+    lcd.setTextColor(COLOR_HEADER_TEXT, COLOR_HEADER_BG);
+    lcd.setTextDatum(MR_DATUM);
+    lcd.setTextPadding(36);
+    lcd.drawString(text, SCREEN_WIDTH - 4, HEADER_HEIGHT / 2);
+    lcd.setTextPadding(0);
 }
 
-void handleBeaconListTouch(uint16_t x, uint16_t y) {
-    // Back button
-    if (isTouchInRect(x, y, 5, 5, 60, HEADER_HEIGHT)) {
-        uiState.changeScreen(SCREEN_TEAM_BEACON_ASSIGN);
+static void drawRaceRow(LGFX& lcd, int index, uint16_t rank, const TeamStanding* team) {
+    RaceRowView& shown = shownRows[index];
+    int y = RACE_ROW_Y + index * RACE_ROW_HEIGHT;
+    
+    if (!team) {
+        if (shown.valid) {
+            drawRaceLine(lcd, y, "", RACE_NAME_X, nullptr, 0);
+            drawRaceLine(lcd, y + 22, "", RACE_LAST_X, nullptr, 0);
+            shown.valid = false;
+        }
         return;
     }
     
-    auto beacons = bleScanner.getBeacons();
-    if (beacons.empty()) return;
-    
-    // Same sort as in drawBeaconListScreen
-    std::sort(beacons.begin(), beacons.end(), [](const BeaconData& a, const BeaconData& b) {
-        return a.rssi > b.rssi;
-    });
-    
-    int y_start = HEADER_HEIGHT + 30;
-    int itemHeight = 34;
+    bool teamChanged = !shown.valid || shown.teamId != team->teamId || shown.rank != rank;
+    
+    // Position, Name & Runden
+    if (teamChanged) {
+        char name[40];
+        char laps[RACE_LAP_CELLS + 1];
+        snprintf(name, sizeof(name), "%u. %s", rank, team->teamName.c_str());
+        formatRaceLaps(laps, team->laps);
+        drawRaceLine(lcd, y, name, RACE_NAME_X, laps, RACE_LAPS_X);
+    } else if (shown.laps != team->laps) {
+        drawRaceLaps(lcd, y, shown.laps, team->laps);
+    }
     
-    int index = 0;
-    for (auto& beacon : beacons) {
-        if (index >= 8) break;
-        
-        int itemY = y_start + (index * itemHeight);
-        
-        if (isTouchInRect(x, y, 10, itemY, SCREEN_WIDTH - 20, 32)) {
-            float dist = BLEScanner::rssiToDistance(beacon.rssi, beacon.txPower);
-            
-            if (dist < 1.0) {
-                TeamData* team = lapCounter.getTeam(uiState.editingTeamId);
-                if (team) {
-                    team->beaconUUID = beacon.macAddress;
-                    persistence.saveTeams(lapCounter);
-                    showMessage("Zugeordnet", "Beacon zugeordnet", COLOR_SECONDARY);
-                    bleScanner.stopScan();
-                    uiState.changeScreen(SCREEN_TEAM_EDIT);
-                }
-            } else {
-                showMessage("Hinweis", "Beacon zu weit!\nNaher halten (<1m)", COLOR_WARNING);
-            }
-            return;
+    // Last lap time
+    if (teamChanged || shown.lastLapDuration != team->lastLapDuration) {
+        char last[32] = "";
+        if (team->lastLapDuration > 0) {
+            snprintf(last, sizeof(last), "Letzte: %lu.%03lu s",
+                     (unsigned long)(team->lastLapDuration / 1000),
+                     (unsigned long)(team->lastLapDuration % 1000));
         }
-        
-        index++;
+        drawRaceLine(lcd, y + 22, last, RACE_LAST_X, nullptr, 0);
     }
+    
+    shown.valid = true;
+    shown.rank = rank;
+    shown.teamId = team->teamId;
+    shown.laps = team->laps;
+    shown.lastLapDuration = team->lastLapDuration;
 }
 
-void handleRaceSetupTouch(uint16_t x, uint16_t y) {
-    // Back button
-    if (isTouchInRect(x, y, 5, 5, 60, HEADER_HEIGHT)) {
-        uiState.changeScreen(SCREEN_HOME);
-        return;
-    }
-    
-    int btnY = HEADER_HEIGHT + 10;
+void drawRaceRunningScreen() {
+    LGFX& lcd = display.getDisplay();
     
-    // Race Name input (TODO: Keyboard - for now just placeholder)
-    if (isTouchInRect(x, y, 10, btnY + 12, SCREEN_WIDTH - 20, 32)) {
-        // TODO: Implement keyboard input
-        showMessage("Info", "Keyboard wird implementiert", COLOR_WARNING);
-        return;
+    // Statische Elemente nur beim Betreten des Screens
+    if (uiState.needsFullRedraw) {
+        drawRaceChrome(lcd);
     }
     
-    btnY += 50 + 12;
+    // Nächste Zeile wird komponiert, während die vorige per DMA läuft
+    display.beginAsync();
     
-    // Duration controls
-    int btnSize = 38;
-    
-    // "-5" Button
-    if (isTouchInRect(x, y, 10, btnY, 45, btnSize)) {
-        if (uiState.raceDuration >= 5) {
-            uiState.raceDuration -= 5;
-        } else {
-            uiState.raceDuration = 1;
-        }
-        uiState.needsRedraw = true;
-        return;
+    // Header with time - nur wenn sich die Sekunde ändert
+    uint32_t elapsed = millis() - raceStartTime;
+    uint32_t remaining = (raceDuration > elapsed) ? (raceDuration - elapsed) : 0;
+    uint32_t remainingSeconds = remaining / 1000;
+    if (remainingSeconds != shownSeconds) {
+        drawRaceClock(lcd, remainingSeconds);
+        shownSeconds = remainingSeconds;
     }
     
-    // "+5" Button
-    if (isTouchInRect(x, y, 185, btnY, 45, btnSize)) {
-        if (uiState.raceDuration <= 175) {
-            uiState.raceDuration += 5;
-        } else {
-            uiState.raceDuration = 180;
-        }
-        uiState.needsRedraw = true;
-        return;
+    // Leaderboard - Snapshot statt LapCounter: der Lap-Task zählt parallel weiter
+    std::vector<TeamStanding> leaderboard;
+    lapPipeline.getStandings(leaderboard);
+    
+    // Eine Seite der Rangliste
+    list.setRows(leaderboard.size(), RACE_ROW_HEIGHT);
+    autoPageRace();
+    uint16_t page = list.getPage();
+    for (int i = 0; i < RACE_ROWS; i++) {
+        size_t rank = (size_t)page * RACE_ROWS + i;
+        drawRaceRow(lcd, i, rank + 1, rank < leaderboard.size() ? &leaderboard[rank] : nullptr);
     }
-    
-    // "+15" Button
-    if (isTouchInRect(x, y, 235, btnY, 45, btnSize)) {
-        if (uiState.raceDuration <= 165) {
-            uiState.raceDuration += 15;
-        } else {
-            uiState.raceDuration = 180;
-        }
-        uiState.needsRedraw = true;
-        return;
+    if (page != shownPage || list.pageCount() != shownPageCount) {
+        drawRacePage(lcd, page, list.pageCount());
+        shownPage = page;
+        shownPageCount = list.pageCount();
     }
     
-    btnY += 48 + 12;
-    
-    // Team checkboxes
-    int teamCount = lapCounter.getTeamCount();
-    if (teamCount > 0) {
-        btnY += 12;
+    // SPI-Bus für den Logger-Task freigeben
+    display.finishAsync();
+}
+
+
+void drawRacePausedScreen() {
+    if (beginScreen("RENNEN PAUSIERT", nullptr)) {
+        LGFX& lcd = display.getDisplay();
+        int y = HEADER_HEIGHT + 30;
         
-        for (uint8_t i = 1; i <= MAX_TEAMS && i <= teamCount; i++) {
-            if (btnY > SCREEN_HEIGHT - 60) break;
+        // PAUSE Text - sehr groß und dunkel
+        lcd.setTextColor(TEXT_COLOR);
+        lcd.setTextSize(TEXT_SIZE_LARGE + 1);  // Size 4
+        lcd.setTextDatum(TC_DATUM);
+        lcd.drawString("PAUSE", SCREEN_WIDTH / 2, y);
+        
+        y += 50;
+        
+        // Time - größer
+        uint32_t elapsed = millis() - raceStartTime;
+        uint32_t minutes = elapsed / 60000;
+        uint32_t seconds = (elapsed % 60000) / 1000;
+        
+        lcd.setTextSize(TEXT_SIZE_LARGE);
+        lcd.setTextDatum(TC_DATUM);
+        char timeStr[10];
+        sprintf(timeStr, "%02lu:%02lu", minutes, seconds);
+        lcd.drawString("Zeit: " + String(timeStr), SCREEN_WIDTH / 2, y);
+        
+        // Buttons - größer mit mehr Abstand
+        y = SCREEN_HEIGHT - 120;
+        widgets.addButton(BUTTON_MARGIN, y, SCREEN_WIDTH - 2*BUTTON_MARGIN, 
+                          BUTTON_HEIGHT, "Weitermachen", COLOR_SECONDARY, []() {
+            raceRunning = true;
+            uiState.changeScreen(SCREEN_RACE_RUNNING);
             
-            if (isTouchInRect(x, y, 10, btnY, SCREEN_WIDTH - 20, 20)) {
-                uiState.selectedTeams[i-1] = !uiState.selectedTeams[i-1];
-                uiState.needsRedraw = true;
-                return;
+            if (!bleScanner.isScanning()) {
+                bleScanner.startScan(0);
             }
             
-            btnY += 23;
-        }
-    }
-    
-    // Start button
-    btnY = SCREEN_HEIGHT - 50;
-    if (isTouchInRect(x, y, 10, btnY, SCREEN_WIDTH - 20, BUTTON_HEIGHT)) {
-        if (lapCounter.getTeamCount() == 0) {
-            showMessage("Fehler", "Keine Teams!", COLOR_DANGER);
-            return;
-        }
+            Serial.println("\n=== RACE RESUMED ===");
+        });
         
-        // Start race
-        currentRaceName = uiState.raceName.length() > 0 ? uiState.raceName : "Rennen";
-        raceDuration = uiState.raceDuration * 60 * 1000;  // Convert to ms
-        raceStartTime = millis();
-        raceRunning = true;
+        y += BUTTON_HEIGHT + BUTTON_MARGIN;
+        widgets.addButton(BUTTON_MARGIN, y, SCREEN_WIDTH - 2*BUTTON_MARGIN, 
+                          BUTTON_HEIGHT, "Rennen beenden", COLOR_DANGER, []() {
+            stopRace();
+            Serial.println("\n=== RACE ENDED ===");
+        });
+    }
+    renderWidgets();
+}
+
+void drawRaceResultsScreen() {
+    if (beginScreen("Ergebnisse", goTo(SCREEN_HOME))) {
+        LGFX& lcd = display.getDisplay();
         
-        // Save race config
-        persistence.saveConfig(currentRaceName, uiState.raceDuration);
+        // Show current race leaderboard (from memory)
+        auto leaderboard = lapCounter.getLeaderboard(true);
         
-        // Start data logging
-        if (dataLogger.isReady()) {
-            dataLogger.startNewRace(currentRaceName);
-        }
+        int y = HEADER_HEIGHT + 10;
         
-        // Start BLE scanning
-        if (!bleScanner.isScanning()) {
-            bleScanner.startScan(0);
+        if (leaderboard.empty()) {
+            lcd.setTextColor(TEXT_COLOR);
+            lcd.setTextSize(TEXT_SIZE_LARGE);
+            lcd.setTextDatum(TC_DATUM);
+            lcd.drawString("Keine Daten", SCREEN_WIDTH / 2, y + 60);
+        } else {
+            lcd.setTextColor(TEXT_COLOR);
+            lcd.setTextSize(TEXT_SIZE_NORMAL);
+            lcd.setCursor(10, y);
+            lcd.print("Aktuelles Rennen:");
+            
+            y += 20;
+            
+            // Reihenfolge beim Betreten, Werte beim Zeichnen
+            std::vector<uint8_t> teamIds;
+            for (auto* team : leaderboard) {
+                teamIds.push_back(team->teamId);
+            }
+            beginList(10, y, SCREEN_WIDTH - 14, SCREEN_HEIGHT - y, teamIds.size(),
+                      LIST_ITEM_HEIGHT + BUTTON_MARGIN,
+                      [teamIds](lgfx::LGFXBase& canvas, uint16_t index, int32_t x, int32_t y) {
+                TeamData* team = lapCounter.getTeam(teamIds[index]);
+                if (!team) return;
+                
+                // Position & Name - größer
+                canvas.setTextColor(TEXT_COLOR);
+                canvas.setTextSize(TEXT_SIZE_NORMAL);
+                canvas.setCursor(x, y);
+                canvas.printf("%u. %s", index + 1, team->teamName.c_str());
+                
+                // Laps - klar lesbar
+                canvas.setCursor(x + 230, y);
+                uint16_t laps = team->lapCount > 0 ? team->lapCount - 1 : 0;
+                canvas.printf("%uR", laps);
+                
+                // Best lap if available - größer
+                if (team->bestLapDuration < UINT32_MAX) {
+                    canvas.setCursor(x + 10, y + 22);
+                    canvas.printf("Beste: %lu.%03lu s", 
+                                  team->bestLapDuration / 1000, team->bestLapDuration % 1000);
+                }
+            }, nullptr);
         }
+    }
+    renderWidgets();
+}
+
+void drawSettingsScreen() {
+    if (beginScreen("Einstellungen", goTo(SCREEN_HOME))) {
+        LGFX& lcd = display.getDisplay();
+        int y = HEADER_HEIGHT + 15;
         
-        // Reset all teams
-        lapCounter.reset();
+        // SD Card Format/Init Button - größer
+        lcd.setTextColor(TEXT_COLOR);
+        lcd.setTextSize(TEXT_SIZE_NORMAL);
+        lcd.setTextDatum(TL_DATUM);
+        bool sdReady = dataLogger.isReady();
+        lcd.drawString(sdReady ? "SD-Format:" : "SD-Karte:", 10, y);
+        widgets.addButton(SCREEN_WIDTH - 120, y - 2, 110, BUTTON_HEIGHT - 10,
+                          sdReady ? "Formatieren" : "Init/Format",
+                          sdReady ? COLOR_WARNING : COLOR_SECONDARY, []() {
+            if (dataLogger.isReady()) {
+                showMessage("WARNUNG!", "Alle Daten werden geloscht!", COLOR_DANGER);
+                delay(2000);
+                if (dataLogger.formatSD()) {
+                    showMessage("Erfolg", "SD-Karte formatiert", COLOR_SECONDARY);
+                    dataLogger.begin(SD_CS_PIN);
+                }
+            } else {
+                if (dataLogger.begin(SD_CS_PIN)) {
+                    showMessage("Erfolg", "SD-Karte initialisiert", COLOR_SECONDARY);
+                } else {
+                    showMessage("Fehler", "SD-Init fehlgeschlagen", COLOR_DANGER);
+                }
+            }
+            // Beschriftung hängt vom SD-Status ab
+            uiState.rebuild();
+        });
+        y += BUTTON_HEIGHT + 5;
         
-        // Reset beacon presence
-        beaconPresence.clear();
+        // Touch Calibration Button - größer
+        lcd.drawString("Touch:", 10, y);
+        widgets.addButton(SCREEN_WIDTH - 120, y - 2, 110, BUTTON_HEIGHT - 10, "Kalibrieren", COLOR_SECONDARY, []() {
+            recalibrateTouch();
+            uiState.rebuild();
+        });
+        y += BUTTON_HEIGHT + 5;
         
-        uiState.changeScreen(SCREEN_RACE_RUNNING);
+        // RSSI Thresholds - größer
+        lcd.drawString("RSSI Near/Far:", 10, y);
+        char rssiStr[20];
+        sprintf(rssiStr, "%d / %d", lapRssiNear, lapRssiFar);
+        lcd.drawString(rssiStr, 130, y);
+        y += 30;
         
-        Serial.println("\n=== RACE STARTED ===");
-        Serial.printf("Name: %s\n", currentRaceName.c_str());
-        Serial.printf("Duration: %lu minutes\n", uiState.raceDuration);
-        Serial.printf("Teams: %u\n", lapCounter.getTeamCount());
+        // Diagnose
+        lcd.drawString("Diagnose:", 10, y);
+        widgets.addButton(SCREEN_WIDTH - 120, y - 2, 110, BUTTON_HEIGHT - 10, "Anzeigen", COLOR_BUTTON,
+                          goTo(SCREEN_DIAGNOSTICS));
     }
+    renderWidgets();
 }
 
-void handleRaceRunningTouch(uint16_t x, uint16_t y) {
-    int btnY = SCREEN_HEIGHT - 60;
-    int btnW = (SCREEN_WIDTH - BUTTON_MARGIN * 3) / 2;
-    
-    // Pause button
-    if (isTouchInRect(x, y, BUTTON_MARGIN, btnY, btnW, BUTTON_HEIGHT)) {
-        raceRunning = false;
-        uiState.changeScreen(SCREEN_RACE_PAUSED);
-        Serial.println("\n=== RACE PAUSED ===");
-        return;
+// Eine Zeile: n / p50 / p99 / max in µs
+static String histogramRow(const char* name, const LatencyHistogram& histogram) {
+    char row[64];
+    snprintf(row, sizeof(row), "%-9s%7lu%8lu%8lu%9lu", name,
+             (unsigned long)histogram.getCount(),
+             (unsigned long)histogram.percentile(50),
+             (unsigned long)histogram.percentile(99),
+             (unsigned long)histogram.getMax());
+    return String(row);
+}
+
+// Diagnose-Labels: Zähler, Display-Bytes, 5 Histogramme, dann je gezeichnetem Screen
+#define DIAG_FIXED_ROWS 7
+static int diagLabels[DIAG_FIXED_ROWS + DIAG_MAX_SCREENS];
+static uint32_t diagBuiltMask = 0;      // Gezeichnete Screens beim Aufbau
+static uint32_t diagScreenMask = 0;     // Davon Screens mit eigener Zeile
+
+void drawDiagnosticsScreen() {
+    static const char* screenNames[] = {
+        "Home", "Teams", "TeamEdit", "Assign", "Beacons", "Setup",
+        "Rennen", "Pause", "Ergebn.", "Settings", "Diagnose"
+    };
+    uint8_t screenCount = sizeof(screenNames) / sizeof(screenNames[0]);
+    
+    // Zeichenzeit pro Screen (nur bereits gezeichnete): neue Zeilen = neues Layout
+    uint32_t screenMask = 0;
+    for (uint8_t screen = 0; screen < screenCount; screen++) {
+        if (diagnostics.getDraw(screen).getCount() > 0) {
+            screenMask |= 1UL << screen;
+        }
+    }
+    if (screenMask != diagBuiltMask) {
+        uiState.needsFullRedraw = true;
     }
     
-    // Stop button
-    if (isTouchInRect(x, y, BUTTON_MARGIN * 2 + btnW, btnY, btnW, BUTTON_HEIGHT)) {
-        raceRunning = false;
-        uiState.changeScreen(SCREEN_RACE_RESULTS);
+    if (beginScreen("Diagnose", goTo(SCREEN_SETTINGS))) {
+        LGFX& lcd = display.getDisplay();
+        int y = HEADER_HEIGHT + 6;
+        int rows = 0;
         
-        // Finish race
-        if (dataLogger.isReady()) {
-            dataLogger.finishRace();
-        }
-        bleScanner.stopScan();
+        // Zähler
+        diagLabels[rows++] = widgets.addLabel(10, y, SCREEN_WIDTH - 10, 8, "", BACKGROUND_COLOR, 1);
+        y += 10;
+        diagLabels[rows++] = widgets.addLabel(10, y, SCREEN_WIDTH - 10, 8, "", BACKGROUND_COLOR, 1);
+        y += 14;
         
-        Serial.println("\n=== RACE STOPPED ===");
-        return;
-    }
-}
-
-void handleRacePausedTouch(uint16_t x, uint16_t y) {
-    int btnY = SCREEN_HEIGHT - 110;
-    
-    // Continue button
-    if (isTouchInRect(x, y, BUTTON_MARGIN, btnY, SCREEN_WIDTH - 2*BUTTON_MARGIN, BUTTON_HEIGHT)) {
-        raceRunning = true;
-        uiState.changeScreen(SCREEN_RACE_RUNNING);
+        // Histogramme
+        lcd.setTextColor(TEXT_COLOR);
+        lcd.setTextSize(1);
+        lcd.setTextDatum(TL_DATUM);
+        lcd.drawString("us             n     p50     p99      max", 10, y);
+        y += 11;
+        for (int i = 0; i < 5; i++) {
+            diagLabels[rows++] = widgets.addLabel(10, y, SCREEN_WIDTH - 10, 8, "", BACKGROUND_COLOR, 1);
+            y += 10;
+        }
         
-        if (!bleScanner.isScanning()) {
-            bleScanner.startScan(0);
+        diagBuiltMask = screenMask;
+        diagScreenMask = 0;
+        for (uint8_t screen = 0; screen < screenCount && y < SCREEN_HEIGHT - 60; screen++) {
+            if (!(screenMask & (1UL << screen))) continue;
+            diagLabels[rows++] = widgets.addLabel(10, y, SCREEN_WIDTH - 10, 8, "", BACKGROUND_COLOR, 1);
+            diagScreenMask |= 1UL << screen;
+            y += 10;
         }
         
-        Serial.println("\n=== RACE RESUMED ===");
-        return;
+        // Buttons
+        int btnY = SCREEN_HEIGHT - 50;
+        widgets.addButton(10, btnY, 145, 40, "Reset", COLOR_WARNING, []() {
+            diagnostics.reset();
+            uiState.needsRedraw = true;
+        });
+        widgets.addButton(165, btnY, 145, 40, "Serial", COLOR_BUTTON, []() {
+            diagnostics.printReport();
+        });
     }
     
-    btnY += BUTTON_HEIGHT + 10;
-    
-    // End race button
-    if (isTouchInRect(x, y, BUTTON_MARGIN, btnY, SCREEN_WIDTH - 2*BUTTON_MARGIN, BUTTON_HEIGHT)) {
-        raceRunning = false;
-        uiState.changeScreen(SCREEN_RACE_RESULTS);
-        
-        if (dataLogger.isReady()) {
-            dataLogger.finishRace();
+    // Werte aktualisieren: nur geänderte Zeilen werden neu gezeichnet
+    char line[64];
+    int rows = 0;
+    snprintf(line, sizeof(line), "Adv:%lu Drop:%lu  Runden:%lu Verw:%lu  LogDrop:%lu",
+             (unsigned long)diagnostics.getCounter(DIAG_ADVERTS_RECEIVED),
+             (unsigned long)diagnostics.getCounter(DIAG_ADVERTS_DROPPED),
+             (unsigned long)diagnostics.getCounter(DIAG_LAPS_ACCEPTED),
+             (unsigned long)diagnostics.getCounter(DIAG_LAPS_REJECTED),
+             (unsigned long)diagnostics.getCounter(DIAG_LOGS_DROPPED));
+    widgets.setText(diagLabels[rows++], line);
+    snprintf(line, sizeof(line), "Display (Rennen): %lu KB", 
+             (unsigned long)(diagnostics.getCounter(DIAG_DISPLAY_BYTES) / 1024));
+    widgets.setText(diagLabels[rows++], line);
+    
+    widgets.setText(diagLabels[rows++], histogramRow("Loop", diagnostics.loopTime));
+    widgets.setText(diagLabels[rows++], histogramRow("Jitter", diagnostics.timerJitter));
+    widgets.setText(diagLabels[rows++], histogramRow("Adv>Lap", diagnostics.advertToLap));
+    widgets.setText(diagLabels[rows++], histogramRow("SD-Write", diagnostics.sdWrite));
+    widgets.setText(diagLabels[rows++], histogramRow("Touch", diagnostics.touchToAction));
+    
+    for (uint8_t screen = 0; screen < screenCount; screen++) {
+        if (diagScreenMask & (1UL << screen)) {
+            widgets.setText(diagLabels[rows++], histogramRow(screenNames[screen], diagnostics.getDraw(screen)));
         }
-        bleScanner.stopScan();
-        
-        Serial.println("\n=== RACE ENDED ===");
-        return;
     }
+    
+    renderWidgets();
 }
 
-void handleRaceResultsTouch(uint16_t x, uint16_t y) {
-    // Back button
-    if (isTouchInRect(x, y, 5, 5, 60, HEADER_HEIGHT)) {
-        uiState.changeScreen(SCREEN_HOME);
+// ============================================================
+// Screen-Dispatch
+// ============================================================
+
+// Zeichnet den aktuellen Screen (ohne Zeitmessung, siehe drawScreen())
+void drawScreenContent() {
+    // Race-Screen zeichnet aus getStandings() und hält den Lock nicht
+    if (uiState.currentScreen == SCREEN_RACE_RUNNING) {
+        drawRaceRunningScreen();
         return;
     }
+    
+    RtosLock lock(lapPipeline.stateMutex());
+    switch (uiState.currentScreen) {
+        case SCREEN_HOME:
+            drawHomeScreen();
+            break;
+        case SCREEN_TEAMS:
+            drawTeamsScreen();
+            break;
+        case SCREEN_TEAM_EDIT:
+            drawTeamEditScreen();
+            break;
+        case SCREEN_TEAM_BEACON_ASSIGN:
+            drawTeamBeaconAssignScreen();
+            break;
+        case SCREEN_BEACON_LIST:
+            drawBeaconListScreen();
+            break;
+        case SCREEN_RACE_SETUP:
+            drawRaceSetupScreen();
+            break;
+        case SCREEN_RACE_RUNNING:
+            drawRaceRunningScreen();
+            break;
+        case SCREEN_RACE_PAUSED:
+            drawRacePausedScreen();
+            break;
+        case SCREEN_RACE_RESULTS:
+            drawRaceResultsScreen();
+            break;
+        case SCREEN_SETTINGS:
+            drawSettingsScreen();
+            break;
+        case SCREEN_DIAGNOSTICS:
+            drawDiagnosticsScreen();
+            break;
+    }
 }
 
-void handleSettingsTouch(uint16_t x, uint16_t y) {
-    // Back button
-    if (isTouchInRect(x, y, 5, 5, 25, 20)) {
-        uiState.changeScreen(SCREEN_HOME);
+// ============================================================
+// Touch Handler
+// ============================================================
+
+// Buttons reagieren aufs Drücken (Hit-Test über dieselben Widgets, die
+// gezeichnet wurden), eine Berührung in der Liste gehört bis zum Loslassen ihr
+void handleTouch(const TouchEvent& touch) {
+    // Screen gewechselt, aber noch nicht gezeichnet: Baum gehört zum alten Screen
+    if (widgetScreen != uiState.currentScreen) {
         return;
     }
-    
-    int btnY = HEADER_HEIGHT + 15;
-    
-    // SD Format/Init button - größer
-    if (isTouchInRect(x, y, SCREEN_WIDTH - 120, btnY - 2, 110, BUTTON_HEIGHT - 10)) {
-        if (dataLogger.isReady()) {
-            showMessage("WARNUNG!", "Alle Daten werden geloscht!", COLOR_DANGER);
-            delay(2000);
-            if (dataLogger.formatSD()) {
-                showMessage("Erfolg", "SD-Karte formatiert", COLOR_SECONDARY);
-                dataLogger.begin(SD_CS_PIN);
-            }
-        } else {
-            if (dataLogger.begin(SD_CS_PIN)) {
-                showMessage("Erfolg", "SD-Karte initialisiert", COLOR_SECONDARY);
-            } else {
-                showMessage("Fehler", "SD-Init fehlgeschlagen", COLOR_DANGER);
-            }
-        }
-        uiState.needsRedraw = true;
+    if (touch.type == TOUCH_PRESS && widgets.dispatch(touch.x, touch.y)) {
         return;
     }
-    btnY += BUTTON_HEIGHT + 5;
-    
-    // Touch Calibration button - größer
-    if (isTouchInRect(x, y, SCREEN_WIDTH - 120, btnY - 2, 110, BUTTON_HEIGHT - 10)) {
-        display.calibrateTouch();
-        uiState.needsRedraw = true;
-        return;
+    if (listActive && (list.isTracking() || (touch.type == TOUCH_PRESS && list.contains(touch.x, touch.y)))) {
+        handleListTouch(touch);
     }
 }
-
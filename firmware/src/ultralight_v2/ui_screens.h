@@ -7,6 +7,7 @@
 #include "config.h"
 #include "../../lib/BLEScanner/BLEScanner.h"
 #include "../../lib/LapCounter/LapCounter.h"
+#include "../../lib/TouchInput/TouchInput.h"
 
 // Forward declarations
 extern DisplayManager display;
@@ -25,22 +26,25 @@ void drawTeamBeaconAssignScreen();
 void drawBeaconListScreen();
 void drawRaceSetupScreen();
 void drawRaceRunningScreen();
+void releaseRaceSprites();
 void drawRacePausedScreen();
 void drawRaceResultsScreen();
 void drawSettingsScreen();
+void drawDiagnosticsScreen();
 
-// Touch Handler
-void handleTouch(uint16_t x, uint16_t y);
-void handleHomeTouch(uint16_t x, uint16_t y);
-void handleTeamsTouch(uint16_t x, uint16_t y);
-void handleTeamEditTouch(uint16_t x, uint16_t y);
-void handleBeaconAssignTouch(uint16_t x, uint16_t y);
-void handleBeaconListTouch(uint16_t x, uint16_t y);
-void handleRaceSetupTouch(uint16_t x, uint16_t y);
-void handleRaceRunningTouch(uint16_t x, uint16_t y);
-void handleRacePausedTouch(uint16_t x, uint16_t y);
-void handleRaceResultsTouch(uint16_t x, uint16_t y);
-void handleSettingsTouch(uint16_t x, uint16_t y);
+// Zeichnet uiState.currentScreen (Race-Screen ohne Lock, sonst unter stateMutex)
+void drawScreenContent();
+
+// Touch Handler: Buttons beim Drücken (Widget-Baum), Listen ziehen/tippen
+void handleTouch(const TouchEvent& touch);
+
+// Ausrollende Liste einen Frame weiter (alle LIST_FRAME_INTERVAL ms),
+// false = steht wieder
+bool stepListScroll(uint64_t nowUs);
+bool isListScrolling();
+
+// Touch kalibrieren und in NVS speichern (main.cpp, hält den Touch-Task an)
+void recalibrateTouch();
 
 // Helper Functions (from ui_helper.h) - declarations here for convenience
 
@@ -19,7 +19,8 @@ enum Screen {
     SCREEN_RACE_RUNNING,
     SCREEN_RACE_PAUSED,
     SCREEN_RACE_RESULTS,
-    SCREEN_SETTINGS
+    SCREEN_SETTINGS,
+    SCREEN_DIAGNOSTICS
 };
 
 // UI State
@@ -27,11 +28,12 @@ struct UIState {
     Screen currentScreen;
     Screen previousScreen;
     bool needsRedraw;
+    bool needsFullRedraw;   // Screen neu betreten: auch statische Elemente zeichnen
     
     // Team Edit
     uint8_t editingTeamId;
     String editingTeamName;
-    int scrollOffset;
+    int scrollOffset;       // Scroll-Liste, überlebt den Neuaufbau desselben Screens
     
     // Race Setup
     String raceName;
@@ -45,12 +47,11 @@ struct UIState {
     uint16_t touchX;
     uint16_t touchY;
     bool touched;
-    uint32_t lastTouchTime;
     
     UIState() : currentScreen(SCREEN_HOME), previousScreen(SCREEN_HOME),
-                needsRedraw(true), editingTeamId(0), editingTeamName(""),
+                needsRedraw(true), needsFullRedraw(true), editingTeamId(0), editingTeamName(""),
                 scrollOffset(0), raceName("Rennen"), raceDuration(60),
-                touchX(0), touchY(0), touched(false), lastTouchTime(0),
+                touchX(0), touchY(0), touched(false),
                 resultsPage(0) {
         memset(selectedTeams, false, sizeof(selectedTeams));
     }
@@ -59,8 +60,15 @@ struct UIState {
         previousScreen = currentScreen;
         currentScreen = newScreen;
         needsRedraw = true;
+        needsFullRedraw = true;
         scrollOffset = 0;
     }
+    
+    // Aktuellen Screen komplett neu aufbauen (Layout hängt von geändertem Zustand ab)
+    void rebuild() {
+        needsRedraw = true;
+        needsFullRedraw = true;
+    }
 };
 
 extern UIState uiState;